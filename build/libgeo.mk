@@ -28,6 +28,7 @@ GEO_SOURCES := \
 	$(GEO_SRC_DIR)/GeoClip.cpp \
 	$(GEO_SRC_DIR)/Quadrilateral.cpp \
 	$(GEO_SRC_DIR)/SearchPoint.cpp \
+	$(GEO_SRC_DIR)/PolygonIndex.cpp \
 	$(GEO_SRC_DIR)/SearchPointVector.cpp \
 	$(GEO_SRC_DIR)/GeoEllipse.cpp \
 	$(GEO_SRC_DIR)/UTM.cpp
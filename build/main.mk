@@ -250,6 +250,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/RadarRenderer.cpp \
 	$(SRC)/Renderer/FrequencyListRenderer.cpp \
 	\
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
@@ -530,6 +531,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Math/SunEphemeris.cpp \
 	\
 	$(SRC)/Screen/Layout.cpp \
+	$(SRC)/Screen/Profiler.cpp \
 	$(SRC)/ui/control/TerminalWindow.cpp \
 	\
 	$(SRC)/Look/FontDescription.cpp \
@@ -2,6 +2,7 @@ LIBMAPWINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowBlackboard.cpp \
 	$(SRC)/MapWindow/MapCanvas.cpp \
 	$(SRC)/MapWindow/StencilMapCanvas.cpp \
+	$(SRC)/MapWindow/StaticLayerCache.cpp \
 	$(SRC)/MapWindow/Items/MapItem.cpp \
 	$(SRC)/MapWindow/Items/OverlayMapItem.cpp \
 	$(SRC)/MapWindow/Items/List.cpp \
@@ -39,6 +39,13 @@ endif
 # compile without UI?
 HEADLESS ?= n
 
+# keep scaled-down copies of the terrain in memory?  (up to 8 MB on
+# desktop and 2 MB on Android and Kobo)
+TERRAIN_PYRAMID ?= y
+ifeq ($(TERRAIN_PYRAMID),n)
+  TARGET_CPPFLAGS += -DNO_TERRAIN_PYRAMID
+endif
+
 ifeq ($(TARGET_IS_KOBO),y)
   DITHER ?= y
 else
@@ -78,6 +78,8 @@ TEST_NAMES = \
 	test_task \
 	TestInputTransformMode \
 	TestOverwritingRingBuffer \
+	TestPhaseHistory \
+	TestSnapshotBuffer \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestPolylineDecoder \
 	TestTransponderCode \
@@ -88,11 +90,14 @@ TEST_NAMES = \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM \
 	TestAllocatedGrid \
-	TestRadixTree TestGeoBounds TestGeoClip \
+	TestRadixTree TestPackedRTree TestGeoBounds TestGeoClip \
 	TestLogger TestGRecord TestClimbAvCalc \
 	TestThermalBase \
+	TestReachUpdate \
+	TestContestIncremental \
+	TestArrayTrace \
 	TestFlarmNet TestFlarmMessaging \
-	TestColorRamp TestGeoPoint TestDiffFilter \
+	TestColorRamp TestGeoPoint TestPolygonIndex TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint TestTaskSave \
@@ -103,6 +108,8 @@ TEST_NAMES = \
 	TestTeamCode \
 	TestZeroFinder \
 	TestAirspaceParser \
+	TestAirspaceCache \
+	TestTopographyFile \
 	TestMETARParser \
 	TestIGCParser \
 	TestStrings TestUTF8 \
@@ -202,6 +209,16 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_PHASE_HISTORY_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPhaseHistory.cpp
+$(eval $(call link-program,TestPhaseHistory,TEST_PHASE_HISTORY))
+
+TEST_SNAPSHOT_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSnapshotBuffer.cpp
+$(eval $(call link-program,TestSnapshotBuffer,TEST_SNAPSHOT_BUFFER))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -231,6 +248,37 @@ TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 TEST_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE UNITS ZZIP GEO MATH UTIL UNITS
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
+TEST_AIRSPACE_CACHE_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceCache.cpp
+TEST_AIRSPACE_CACHE_LDADD = $(FAKE_LIBS)
+TEST_AIRSPACE_CACHE_DEPENDS = AIRSPACE IO OS ZZIP GEO MATH UTIL UNITS
+$(eval $(call link-program,TestAirspaceCache,TEST_AIRSPACE_CACHE))
+
+TEST_TOPOGRAPHY_FILE_SOURCES = \
+	$(SRC)/Topography/ShapeFile.cpp \
+	$(SRC)/Topography/ShapeCache.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTopographyFile.cpp
+ifeq ($(OPENGL),y)
+TEST_TOPOGRAPHY_FILE_SOURCES += \
+	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp
+endif
+TEST_TOPOGRAPHY_FILE_DEPENDS = SHAPELIB ZZIP GEO MATH THREAD IO OS UTIL
+TEST_TOPOGRAPHY_FILE_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,TestTopographyFile,TEST_TOPOGRAPHY_FILE))
+
 TEST_DATE_TIME_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestDateTime.cpp
@@ -484,6 +532,12 @@ TEST_GEO_CLIP_SOURCES = \
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_POLYGON_INDEX_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPolygonIndex.cpp
+TEST_POLYGON_INDEX_DEPENDS = GEO MATH
+$(eval $(call link-program,TestPolygonIndex,TEST_POLYGON_INDEX))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -683,6 +737,32 @@ TEST_THERMALBASE_SOURCES = \
 TEST_THERMALBASE_DEPENDS = GEO MATH THREAD
 $(eval $(call link-program,TestThermalBase,TEST_THERMALBASE))
 
+TEST_REACH_UPDATE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/TestReachUpdate.cpp
+TEST_REACH_UPDATE_DEPENDS = TERRAIN OPERATION IO ZZIP OS ROUTE GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestReachUpdate,TEST_REACH_UPDATE))
+
+TEST_CONTEST_INCREMENTAL_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestContestIncremental.cpp
+TEST_CONTEST_INCREMENTAL_DEPENDS = CONTEST IO OS GEO TIME MATH UTIL
+$(eval $(call link-program,TestContestIncremental,TEST_CONTEST_INCREMENTAL))
+
+TEST_ARRAY_TRACE_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/ArrayTrace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestArrayTrace.cpp
+TEST_ARRAY_TRACE_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestArrayTrace,TEST_ARRAY_TRACE))
+
 TEST_EARTH_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestEarth.cpp
@@ -726,6 +806,12 @@ TEST_RADIX_TREE_SOURCES = \
 TEST_RADIX_TREE_DEPENDS = UTIL
 $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 
+TEST_PACKED_RTREE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPackedRTree.cpp
+TEST_PACKED_RTREE_DEPENDS = UTIL
+$(eval $(call link-program,TestPackedRTree,TEST_PACKED_RTREE))
+
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
@@ -838,7 +924,16 @@ DEBUG_PROGRAM_NAMES = \
 	TestTrace \
 	FlightTable \
 	BenchmarkProjection \
+	BenchmarkTerrainSampling \
+	BenchmarkReach \
+	BenchmarkTrace \
+	BenchmarkAirspaceCache \
+	BenchmarkAirspacePolygon \
+	BenchmarkAirspaceWarnings \
+	BenchmarkTopography \
 	BenchmarkFAITriangleSector \
+	BenchmarkNMEA \
+	BenchmarkPorts \
 	DumpTextInflate \
 	DumpHexColor \
 	RunXMLParser \
@@ -846,7 +941,7 @@ DEBUG_PROGRAM_NAMES = \
 	RunMD5 RunSHA256 \
 	ReadGRecord VerifyGRecord AppendGRecord FixGRecord \
 	AddChecksum \
-	LoadTopography LoadTerrain \
+	LoadTopography LoadTerrain ConvertTerrain \
 	RunHeightMatrix \
 	RunInputParser \
 	RunWaypointParser RunAirspaceParser \
@@ -858,6 +953,7 @@ DEBUG_PROGRAM_NAMES = \
 	DumpFlarmNet \
 	RunRepositoryParser \
 	NearestWaypoints \
+	BenchmarkWaypoints \
 	RunKalmanFilter1d \
 	ArcApprox
 
@@ -1015,6 +1111,69 @@ BENCHMARK_PROJECTION_DEPENDS = MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
+BENCHMARK_TERRAIN_SAMPLING_SOURCES = \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTerrainSampling.cpp
+BENCHMARK_TERRAIN_SAMPLING_CPPFLAGS = $(SCREEN_CPPFLAGS)
+BENCHMARK_TERRAIN_SAMPLING_DEPENDS = TERRAIN OPERATION GEO MATH OS IO ZZIP UTIL
+$(eval $(call link-program,BenchmarkTerrainSampling,BENCHMARK_TERRAIN_SAMPLING))
+
+BENCHMARK_REACH_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkReach.cpp
+BENCHMARK_REACH_DEPENDS = TERRAIN OPERATION IO ZZIP OS THREAD ROUTE GLIDE GEO MATH UTIL
+$(eval $(call link-program,BenchmarkReach,BENCHMARK_REACH))
+
+BENCHMARK_TRACE_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/ArrayTrace.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTrace.cpp
+BENCHMARK_TRACE_DEPENDS = IO OS GEO MATH TIME UTIL
+$(eval $(call link-program,BenchmarkTrace,BENCHMARK_TRACE))
+
+BENCHMARK_AIRSPACE_CACHE_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspaceCache.cpp
+BENCHMARK_AIRSPACE_CACHE_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACE_CACHE_DEPENDS = AIRSPACE IO OS ZZIP GEO MATH UTIL UNITS
+$(eval $(call link-program,BenchmarkAirspaceCache,BENCHMARK_AIRSPACE_CACHE))
+
+BENCHMARK_AIRSPACE_POLYGON_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspacePolygon.cpp
+BENCHMARK_AIRSPACE_POLYGON_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACE_POLYGON_DEPENDS = AIRSPACE IO OS ZZIP GEO MATH UTIL UNITS
+$(eval $(call link-program,BenchmarkAirspacePolygon,BENCHMARK_AIRSPACE_POLYGON))
+
+BENCHMARK_AIRSPACE_WARNINGS_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspaceWarnings.cpp
+BENCHMARK_AIRSPACE_WARNINGS_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACE_WARNINGS_DEPENDS = AIRSPACE TASK ROUTE GLIDE IO OS ZZIP GEO MATH TIME UTIL UNITS
+$(eval $(call link-program,BenchmarkAirspaceWarnings,BENCHMARK_AIRSPACE_WARNINGS))
+
 BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleSettings.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
@@ -1022,6 +1181,39 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_NMEA_SOURCES = \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/FLARM/Error.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FakeMessage.cpp \
+	$(TEST_SRC_DIR)/FakeTraffic.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNMEA.cpp
+BENCHMARK_NMEA_DEPENDS = LIBNMEA GEO MATH IO OS UTIL TIME UNITS
+$(eval $(call link-program,BenchmarkNMEA,BENCHMARK_NMEA))
+
+BENCHMARK_PORTS_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/Device/Util/NMEAReader.cpp \
+	$(SRC)/Device/Driver/FLARM/BinaryProtocol.cpp \
+	$(SRC)/Device/Driver/FLARM/CRC16.cpp \
+	$(SRC)/io/CSVLine.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(SRC)/Formatter/NMEAFormatter.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FLARMEmulator.cpp \
+	$(TEST_SRC_DIR)/VegaEmulator.cpp \
+	$(TEST_SRC_DIR)/BenchmarkPorts.cpp
+BENCHMARK_PORTS_DEPENDS = PORT ASYNC LIBNET OPERATION IO OS THREAD LIBNMEA GEO MATH TIME UTIL UNITS
+$(eval $(call link-program,BenchmarkPorts,BENCHMARK_PORTS))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1248,6 +1440,20 @@ LOAD_TOPOGRAPHY_DEPENDS = TOPO RESOURCE GEO MATH THREAD IO SYSTEM UTIL ZZIP
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,LoadTopography,LOAD_TOPOGRAPHY))
 
+BENCHMARK_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/system/Path.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTopography.cpp
+ifeq ($(OPENGL),y)
+BENCHMARK_TOPOGRAPHY_SOURCES += \
+	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp
+endif
+BENCHMARK_TOPOGRAPHY_DEPENDS = TOPO RESOURCE GEO MATH THREAD IO SYSTEM UTIL ZZIP
+BENCHMARK_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkTopography,BENCHMARK_TOPOGRAPHY))
+
 LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
@@ -1258,6 +1464,14 @@ LOAD_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
 LOAD_TERRAIN_DEPENDS = TERRAIN OPERATION GEO MATH OS IO ZZIP UTIL
 $(eval $(call link-program,LoadTerrain,LOAD_TERRAIN))
 
+CONVERT_TERRAIN_SOURCES = \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/ConvertTerrain.cpp
+CONVERT_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
+CONVERT_TERRAIN_DEPENDS = TERRAIN OPERATION GEO MATH OS IO ZZIP UTIL
+$(eval $(call link-program,ConvertTerrain,CONVERT_TERRAIN))
+
 RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
@@ -1303,6 +1517,17 @@ NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
 NEAREST_WAYPOINTS_DEPENDS = WAYPOINTFILE OPERATION IO OS THREAD ZZIP GEO MATH UTIL
 $(eval $(call link-program,NearestWaypoints,NEAREST_WAYPOINTS))
 
+BENCHMARK_WAYPOINTS_SOURCES = \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkWaypoints.cpp
+BENCHMARK_WAYPOINTS_LDADD = $(FAKE_LIBS)
+BENCHMARK_WAYPOINTS_DEPENDS = WAYPOINTFILE OPERATION IO OS THREAD ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkWaypoints,BENCHMARK_WAYPOINTS))
+
 RUN_FLIGHT_PARSER_SOURCES = \
 	$(SRC)/Logger/FlightParser.cpp \
 	$(TEST_SRC_DIR)/RunFlightParser.cpp
@@ -1805,12 +2030,14 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Airspace/ActivePredicate.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/GeoBitmapRenderer.cpp \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
+	$(SRC)/Screen/Profiler.cpp \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Projection/Projection.cpp \
@@ -2310,6 +2537,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Airspace/ActivePredicate.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
@@ -2362,6 +2590,7 @@ RUN_AIRSPACE_WARNING_DIALOG_SOURCES = \
 	$(SRC)/Dialogs/DialogSettings.cpp \
 	$(SRC)/Dialogs/WidgetDialog.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/TransponderCode.cpp \
 	$(SRC)/Audio/Sound.cpp \
@@ -31,10 +31,9 @@ XCSoarInterface::ReceiveGPS() noexcept
 {
   {
     auto &device_blackboard = *backend_components->device_blackboard;
-    const std::lock_guard lock{device_blackboard.mutex};
-
-    ReadBlackboardBasic(device_blackboard.Basic());
+    ReadBlackboardBasic(device_blackboard.LeaseBasic());
 
+    const std::lock_guard lock{device_blackboard.mutex};
     const NMEAInfo &real = device_blackboard.RealState();
     Private::movement_detected = real.alive && real.gps.real &&
       real.MovementDetected();
@@ -52,9 +51,9 @@ XCSoarInterface::ReceiveCalculated() noexcept
 {
   {
     auto &device_blackboard = *backend_components->device_blackboard;
-    const std::lock_guard lock{device_blackboard.mutex};
+    ReadBlackboardCalculated(device_blackboard.LeaseCalculated());
 
-    ReadBlackboardCalculated(device_blackboard.Calculated());
+    const std::lock_guard lock{device_blackboard.mutex};
     device_blackboard.ReadComputerSettings(GetComputerSettings());
   }
 
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/SpanCast.hxx"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <string.h>
+
+namespace {
+
+struct Header {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+  uint32_t n_airspaces;
+  uint32_t n_points;
+  uint32_t n_chars;
+};
+
+struct Record {
+  AirspaceAltitude base, top;
+
+  /**
+   * Only used for #AbstractAirspace::Shape::CIRCLE.
+   */
+  GeoPoint center;
+  double radius;
+
+  /**
+   * The vertices of a #AbstractAirspace::Shape::POLYGON in the
+   * point array.
+   */
+  uint32_t first_point, n_points;
+
+  /* the names in the string array */
+  uint32_t name_offset, name_length;
+  uint32_t station_name_offset, station_name_length;
+
+  RadioFrequency radio_frequency;
+  TransponderCode transponder_code;
+
+  AbstractAirspace::Shape shape;
+  AirspaceClass asclass, astype;
+  AirspaceActivity days;
+};
+
+static_assert(std::is_trivially_copyable_v<Record>);
+static_assert(std::is_trivially_copyable_v<GeoPoint>);
+
+} // anonymous namespace
+
+template<typename T>
+static std::span<const std::byte>
+TakeArray(std::span<const std::byte> &data, std::size_t n)
+{
+  if (n > data.size() / sizeof(T))
+    throw std::runtime_error("Malformed airspace cache");
+
+  const auto result = data.first(n * sizeof(T));
+  data = data.subspan(result.size());
+  return result;
+}
+
+static std::string_view
+GetString(std::span<const std::byte> chars, uint32_t offset, uint32_t length)
+{
+  if (offset > chars.size() || length > chars.size() - offset)
+    throw std::runtime_error("Malformed airspace cache string");
+
+  return ToStringView(chars.subspan(offset, length));
+}
+
+static AirspacePtr
+LoadAirspace(const Record &record, std::span<const std::byte> points,
+             std::span<const std::byte> chars,
+             std::vector<GeoPoint> &buffer)
+{
+  std::shared_ptr<AbstractAirspace> as;
+
+  switch (record.shape) {
+  case AbstractAirspace::Shape::CIRCLE:
+    as = std::make_shared<AirspaceCircle>(record.center, record.radius);
+    break;
+
+  case AbstractAirspace::Shape::POLYGON:
+    if (record.n_points < 3 ||
+        record.first_point > points.size() / sizeof(GeoPoint) ||
+        record.n_points > points.size() / sizeof(GeoPoint) - record.first_point)
+      throw std::runtime_error("Malformed airspace cache polygon");
+
+    /* the mapping is not necessarily aligned, so copy the points */
+    buffer.resize(record.n_points);
+    memcpy(buffer.data(), points.data() + record.first_point * sizeof(GeoPoint),
+           record.n_points * sizeof(GeoPoint));
+
+    as = std::make_shared<AirspacePolygon>(buffer);
+    break;
+
+  default:
+    throw std::runtime_error("Malformed airspace cache shape");
+  }
+
+  as->SetProperties(std::string{GetString(chars, record.name_offset,
+                                          record.name_length)},
+                    GetString(chars, record.station_name_offset,
+                              record.station_name_length),
+                    record.transponder_code,
+                    record.asclass, record.astype,
+                    record.base, record.top);
+  as->SetRadioFrequency(record.radio_frequency);
+  as->SetDays(record.days);
+  return as;
+}
+
+bool
+LoadAirspaceCache(FileCache &cache, Path path, Airspaces &airspaces)
+{
+  const auto name = FileCache::MakeName("airspace", {path.c_str()});
+
+  std::span<const std::byte> data;
+  const auto mapping = cache.Map(name.c_str(), path, data);
+  if (!mapping)
+    return false;
+
+  Header header;
+  if (data.size() < sizeof(header))
+    throw std::runtime_error("Malformed airspace cache");
+
+  memcpy(&header, data.data(), sizeof(header));
+  data = data.subspan(sizeof(header));
+
+  if (header.version != Header::VERSION)
+    return false;
+
+  const auto records = TakeArray<Record>(data, header.n_airspaces);
+  const auto points = TakeArray<GeoPoint>(data, header.n_points);
+  const auto chars = TakeArray<char>(data, header.n_chars);
+
+  /* parse all records before adding any airspace, so a malformed
+     cache does not leave half of them in the database */
+  std::vector<AirspacePtr> result;
+  result.reserve(header.n_airspaces);
+
+  std::vector<GeoPoint> buffer;
+  for (std::size_t i = 0; i < header.n_airspaces; ++i) {
+    Record record;
+    memcpy(&record, records.data() + i * sizeof(record), sizeof(record));
+    result.emplace_back(LoadAirspace(record, points, chars, buffer));
+  }
+
+  for (auto &i : result)
+    airspaces.Add(std::move(i));
+
+  return true;
+}
+
+void
+SaveAirspaceCache(FileCache &cache, Path path,
+                  std::deque<AirspacePtr>::const_iterator begin,
+                  std::deque<AirspacePtr>::const_iterator end)
+{
+  std::vector<Record> records;
+  records.reserve(std::distance(begin, end));
+
+  std::vector<GeoPoint> points;
+  std::string chars;
+
+  for (auto i = begin; i != end; ++i) {
+    const AbstractAirspace &as = **i;
+
+    Record &record = records.emplace_back();
+
+    /* zero-fill all implicit padding bytes (to make valgrind happy) */
+    memset(static_cast<void *>(&record), 0, sizeof(record));
+
+    record.base = as.GetBase();
+    record.top = as.GetTop();
+    record.shape = as.GetShape();
+
+    switch (as.GetShape()) {
+    case AbstractAirspace::Shape::CIRCLE: {
+      const auto &circle = (const AirspaceCircle &)as;
+      record.center = circle.GetCenter();
+      record.radius = circle.GetRadius();
+      break;
+    }
+
+    case AbstractAirspace::Shape::POLYGON:
+      record.first_point = points.size();
+      record.n_points = as.GetPoints().size();
+      for (const auto &p : as.GetPoints())
+        points.push_back(p.GetLocation());
+      break;
+    }
+
+    const std::string_view name = as.GetName();
+    record.name_offset = chars.size();
+    record.name_length = name.size();
+    chars.append(name);
+
+    const std::string_view station_name = as.GetStationName();
+    record.station_name_offset = chars.size();
+    record.station_name_length = station_name.size();
+    chars.append(station_name);
+
+    record.radio_frequency = as.GetRadioFrequency();
+    record.transponder_code = as.GetTransponderCode();
+    record.asclass = as.GetClass();
+    record.astype = as.GetType();
+    record.days = as.GetDays();
+  }
+
+  Header header;
+  header.version = Header::VERSION;
+  header.n_airspaces = records.size();
+  header.n_points = points.size();
+  header.n_chars = chars.size();
+
+  const auto name = FileCache::MakeName("airspace", {path.c_str()});
+  const auto os = cache.Save(name.c_str(), path);
+
+  BufferedOutputStream bos(*os);
+  bos.WriteT(header);
+  bos.Write(std::as_bytes(std::span{records}));
+  bos.Write(std::as_bytes(std::span{points}));
+  bos.Write(AsBytes(chars));
+  bos.Flush();
+
+  os->Commit();
+}
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Airspace/Ptr.hpp"
+
+#include <deque>
+
+class Airspaces;
+class FileCache;
+class Path;
+
+/*
+ * A binary cache of the airspaces parsed from one airspace file.  It
+ * is stored in the #FileCache (which invalidates it when the source
+ * file changes) and gets mapped into memory; loading it creates the
+ * airspace objects directly from fixed-size records, without any
+ * text parsing.
+ *
+ * File layout: a header, followed by one record per airspace, all
+ * polygon vertices (as #GeoPoint) and all names.
+ *
+ * Ground levels are not stored; they depend on the terrain and are
+ * set by SetAirspaceGroundLevels() afterwards, as usual.
+ */
+
+/**
+ * Load airspaces from the cache and add them to the #Airspaces
+ * object (without calling Airspaces::Optimise()).
+ *
+ * Throws on error.
+ *
+ * @param path the airspace file
+ * @return false if there is no valid cache for this file
+ */
+bool
+LoadAirspaceCache(FileCache &cache, Path path, Airspaces &airspaces);
+
+/**
+ * Save the given airspaces (which were parsed from the given file) to
+ * the cache.
+ *
+ * Throws on error.
+ */
+void
+SaveAirspaceCache(FileCache &cache, Path path,
+                  std::deque<AirspacePtr>::const_iterator begin,
+                  std::deque<AirspacePtr>::const_iterator end);
@@ -3,6 +3,7 @@
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Language/Language.hpp"
@@ -21,6 +22,8 @@
 #include "lib/fmt/RuntimeError.hxx"
 #include "system/Path.hpp"
 
+#include <iterator>
+
 #include <string.h>
 
 bool
@@ -68,9 +71,45 @@ try {
   return false;
 }
 
+/**
+ * Like ParseAirspaceFile(), but load the airspaces from the binary
+ * cache if possible, and update the cache after parsing.
+ */
+static bool
+LoadAirspaceFile(Airspaces &airspaces, Path path, FileCache *cache,
+                 OperationEnvironment &operation) noexcept
+{
+  if (cache != nullptr) {
+    try {
+      if (LoadAirspaceCache(*cache, path, airspaces))
+        return true;
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to load airspace cache");
+    }
+  }
+
+  const std::size_t n_pending = airspaces.GetPending().size();
+  if (!ParseAirspaceFile(airspaces, path, operation))
+    return false;
+
+  if (cache != nullptr) {
+    try {
+      const auto &pending = airspaces.GetPending();
+      SaveAirspaceCache(*cache, path,
+                        std::next(pending.begin(), n_pending),
+                        pending.end());
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save airspace cache");
+    }
+  }
+
+  return true;
+}
+
 void
 ReadAirspace(Airspaces &airspaces,
              AtmosphericPressure press,
+             FileCache *cache,
              OperationEnvironment &operation)
 {
   LogFormat("Loading airspaces");
@@ -82,7 +121,7 @@ ReadAirspace(Airspaces &airspaces,
   const auto paths = Profile::GetMultiplePaths(ProfileKeys::AirspaceFileList,
                                                AIRSPACE_FILE_PATTERNS);
   for (const auto& path : paths) {
-  airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
+  airspace_ok |= LoadAirspaceFile(airspaces, path, cache, operation);
   }
 
   try {
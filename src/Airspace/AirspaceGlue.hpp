@@ -7,14 +7,19 @@ class RasterTerrain;
 class AtmosphericPressure;
 class Airspaces;
 class OperationEnvironment;
+class FileCache;
 class Path;
 
 /**
  * Reads the airspace files into the memory
+ *
+ * @param cache if not nullptr, then a binary cache of each airspace
+ * file is used (see AirspaceCache.hpp)
  */
 void
 ReadAirspace(Airspaces &airspaces,
              AtmosphericPressure press,
+             FileCache *cache,
              OperationEnvironment &operation);
 
 void
@@ -2,6 +2,7 @@
 set(_SOURCES
         Airspace/ActivePredicate.cpp
         Airspace/AirspaceComputerSettings.cpp
+        Airspace/AirspaceCache.cpp
         Airspace/AirspaceGlue.cpp
         Airspace/AirspaceParser.cpp
         Airspace/AirspaceVisibility.cpp
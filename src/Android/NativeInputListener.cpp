@@ -27,7 +27,8 @@ Java_de_opensoar_NativeInputListener_dataReceived(JNIEnv *env, jobject obj,
   DataHandler &handler = *(DataHandler *)(void *)ptr;
 
   const Java::ByteArrayElements elems{env, data};
-  handler.DataReceived({(const std::byte *)elems.get(), std::size_t(length)});
+  handler.DataReceived({(const std::byte *)elems.get(), std::size_t(length)},
+                       false);
 }
 
 void
@@ -28,6 +28,9 @@ DeviceBlackboard::DeviceBlackboard() noexcept
 
   simulator.Init(simulator_data);
 
+  PublishBasic();
+  calculated_snapshot.Publish(calculated_info);
+
   real_clock.Reset();
   replay_clock.Reset();
 }
@@ -45,7 +48,7 @@ DeviceBlackboard::SetStartupLocation(const GeoPoint &loc,
 {
   const std::lock_guard lock{mutex};
 
-  if (Calculated().flight.flying)
+  if (LeaseCalculated()->flight.flying)
     return;
 
   for (auto &i : per_device_data)
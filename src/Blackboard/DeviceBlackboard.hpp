@@ -8,6 +8,7 @@
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "thread/Mutex.hxx"
+#include "thread/SnapshotBuffer.hpp"
 #include "time/WrapClock.hpp"
 
 #include <array>
@@ -22,6 +23,10 @@ class RadioFrequency;
  * 
  * The DeviceBlackboard is used as the global ground truth-state
  * since it is accessed quickly with only one mutex
+ *
+ * Basic() and Calculated() are additionally published as snapshots
+ * (see #SnapshotBuffer), which other threads can read without
+ * locking the mutex; see LeaseBasic() and LeaseCalculated().
  */
 class DeviceBlackboard
   : public BaseBlackboard, public ComputerSettingsBlackboard
@@ -55,20 +60,67 @@ class DeviceBlackboard
    */
   WrapClock real_clock, replay_clock;
 
+  SnapshotBuffer<MoreData> basic_snapshot;
+  SnapshotBuffer<DerivedInfo> calculated_snapshot;
+
+  /**
+   * Only the snapshot of #calculated_info is up to date; see
+   * LeaseCalculated().
+   */
+  using BaseBlackboard::Calculated;
+
 public:
   Mutex mutex;
 
+  using BasicLease = SnapshotBuffer<MoreData>::Lease;
+  using CalculatedLease = SnapshotBuffer<DerivedInfo>::Lease;
+
 public:
   DeviceBlackboard() noexcept;
 
   /**
-   * Reads the given derived_info usually provided by the
-   * GlideComputerBlackboard and saves it to the own Blackboard
+   * Publishes the given derived_info usually provided by the
+   * GlideComputerBlackboard.  The caller doesn't need to hold the
+   * lock, but this must not be called by more than one thread at a
+   * time.
    * @param derived_info Calculated information usually provided
    * by the GlideComputerBlackboard
    */
   void ReadBlackboard(const DerivedInfo &derived_info) noexcept {
-    calculated_info = derived_info;
+    calculated_snapshot.Publish(derived_info);
+  }
+
+  /**
+   * Publish a snapshot of Basic().  Must be called by the thread
+   * which modifies it (i.e. the #MergeThread); that thread doesn't
+   * need to hold the lock.
+   */
+  void PublishBasic() noexcept {
+    basic_snapshot.Publish(gps_info);
+  }
+
+  /**
+   * Obtain the most recent snapshot of Basic() without locking the
+   * mutex.
+   */
+  BasicLease LeaseBasic() const noexcept {
+    return BasicLease{basic_snapshot};
+  }
+
+  /**
+   * Obtain the most recent snapshot of the calculated values without
+   * locking the mutex.
+   */
+  CalculatedLease LeaseCalculated() const noexcept {
+    return CalculatedLease{calculated_snapshot};
+  }
+
+  const SnapshotBuffer<MoreData> &GetBasicSnapshot() const noexcept {
+    return basic_snapshot;
+  }
+
+  const SnapshotBuffer<DerivedInfo> &GetCalculatedSnapshot() const noexcept {
+    return calculated_snapshot;
   }
 
   /**
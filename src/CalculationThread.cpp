@@ -6,6 +6,15 @@
 #include "Protection.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Hardware/CPU.hpp"
+#include "util/Macros.hpp"
+
+/**
+ * The maximum number of consecutive ticks which may defer
+ * GlideComputer::ProcessIdle() because a newer fix is waiting.  This
+ * limit prevents the slow calculations from starving when fixes
+ * arrive faster than they can be processed.
+ */
+static constexpr unsigned MAX_IDLE_DEFERRALS = 4;
 
 /**
  * Constructor of the CalculationThread class
@@ -61,14 +70,16 @@ CalculationThread::Tick() noexcept
 
   bool gps_updated;
 
+  stop_watch.Mark("ReadBlackboard");
+
   // update and transfer master info to glide computer
   {
-    const std::lock_guard lock{device_blackboard.mutex};
+    const auto basic = device_blackboard.LeaseBasic();
 
-    gps_updated = device_blackboard.Basic().location_available.Modified(glide_computer.Basic().location_available);
+    gps_updated = basic->location_available.Modified(glide_computer.Basic().location_available);
 
     // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard.Basic());
+    glide_computer.ReadBlackboard(basic);
   }
 
   bool force;
@@ -84,31 +95,126 @@ CalculationThread::Tick() noexcept
     }
   }
 
-  glide_computer.Expire();
+  stop_watch.Mark("ProcessGPS");
 
-  bool do_idle = false;
+  glide_computer.SetMeasureTime(Profiler::IsEnabled());
+  glide_computer.Expire();
 
   if (gps_updated || force)
     // perform idle call if time advanced and slow calculations need to be updated
-    do_idle |= glide_computer.ProcessGPS(force);
+    idle_pending |= glide_computer.ProcessGPS(force);
+
+  stop_watch.Mark("WriteBlackboard");
 
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
-  {
-    const std::lock_guard lock{device_blackboard.mutex};
-    device_blackboard.ReadBlackboard(glide_computer.Calculated());
-  }
+  device_blackboard.ReadBlackboard(glide_computer.Calculated());
 
   // if (new GPS data)
   if (gps_updated || force)
     // inform map new data is ready
     TriggerCalculatedUpdate();
 
-  if (do_idle) {
-    // do slow calculations last, to minimise latency
-    glide_computer.ProcessIdle();
+  if (idle_pending) {
+    if (idle_deferrals < MAX_IDLE_DEFERRALS && IsNewFixPending()) {
+      /* process the next fix first, and do the slow calculations
+         in the next idle slot */
+      ++idle_deferrals;
+      ++total_idle_deferrals;
+    } else {
+      // do slow calculations last, to minimise latency
+      stop_watch.Mark("ProcessIdle");
+      glide_computer.ProcessIdle();
+      idle_pending = false;
+      idle_deferrals = 0;
+    }
+  }
+
+  stop_watch.Finish();
+
+  if (Profiler::IsEnabled())
+    UpdateProfilerCounters();
+}
+
+bool
+CalculationThread::IsNewFixPending() const noexcept
+{
+  return device_blackboard.LeaseBasic()->location_available !=
+    glide_computer.Basic().location_available;
+}
+
+static constexpr struct {
+  const char *name, *runs, *skips;
+} computer_step_names[] = {
+  { "Basic", "BasicRuns", "BasicSkips" },
+  { "Task", "TaskRuns", "TaskSkips" },
+  { "Flight", "FlightRuns", "FlightSkips" },
+  { "AutoQNH", "AutoQNHRuns", "AutoQNHSkips" },
+  { "Circling", "CirclingRuns", "CirclingSkips" },
+  { "Wave", "WaveRuns", "WaveSkips" },
+  { "Wind", "WindRuns", "WindSkips" },
+  { "ThermalLocator", "ThermalLocatorRuns", "ThermalLocatorSkips" },
+  { "Climb", "ClimbRuns", "ClimbSkips" },
+  { "ClimbEvents", "ClimbEventsRuns", "ClimbEventsSkips" },
+  { "Cu", "CuRuns", "CuSkips" },
+  { "TeamCode", "TeamCodeRuns", "TeamCodeSkips" },
+  { "Trace", "TraceRuns", "TraceSkips" },
+  { "Route", "RouteRuns", "RouteSkips" },
+  { "ConditionMonitors", "ConditionMonitorsRuns", "ConditionMonitorsSkips" },
+  { "Logging", "LoggingRuns", "LoggingSkips" },
+  { "Contest", "ContestRuns", "ContestSkips" },
+  { "Warnings", "WarningsRuns", "WarningsSkips" },
+  { "IdleConditionMonitors", "IdleConditionMonitorsRuns",
+    "IdleConditionMonitorsSkips" },
+  { "Retrospective", "RetrospectiveRuns", "RetrospectiveSkips" },
+};
+
+static_assert(ARRAY_SIZE(computer_step_names) == NUM_COMPUTER_STEPS);
+
+template<typename T>
+static void
+SetSnapshotCounters(const char *reads, const char *read_retries,
+                    const char *writes, const char *written_bytes,
+                    const char *write_waits,
+                    const SnapshotBuffer<T> &buffer) noexcept
+{
+  const auto s = buffer.GetStatistics();
+  Profiler::SetCounter("Blackboard", reads, s.reads);
+  Profiler::SetCounter("Blackboard", read_retries, s.read_retries);
+  Profiler::SetCounter("Blackboard", writes, s.writes);
+  Profiler::SetCounter("Blackboard", written_bytes, s.GetWrittenBytes());
+  Profiler::SetCounter("Blackboard", write_waits, s.write_waits);
+}
+
+void
+CalculationThread::UpdateProfilerCounters() noexcept
+{
+  const auto &statistics = glide_computer.GetStatistics();
+  for (std::size_t i = 0; i < NUM_COMPUTER_STEPS; ++i) {
+    const auto &s = statistics[i];
+    const auto &last = last_computer_statistics[i];
+    const auto &names = computer_step_names[i];
+
+    /* record the CPU time of this tick as one sample */
+    if (s.runs != last.runs && s.time != last.time)
+      Profiler::Record("Computer", names.name, s.time - last.time);
+
+    Profiler::SetCounter("Computer", names.runs, s.runs);
+    Profiler::SetCounter("Computer", names.skips, s.skips);
   }
+
+  last_computer_statistics = statistics;
+
+  Profiler::SetCounter("Calc", "IdleDeferrals", total_idle_deferrals);
+
+  SetSnapshotCounters("BasicReads", "BasicReadRetries",
+                      "BasicWrites", "BasicWrittenBytes", "BasicWriteWaits",
+                      device_blackboard.GetBasicSnapshot());
+  SetSnapshotCounters("CalculatedReads", "CalculatedReadRetries",
+                      "CalculatedWrites", "CalculatedWrittenBytes",
+                      "CalculatedWriteWaits",
+                      device_blackboard.GetCalculatedSnapshot());
 }
 
 void
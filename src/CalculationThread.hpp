@@ -6,6 +6,8 @@
 #include "thread/WorkerThread.hpp"
 #include "thread/Mutex.hxx"
 #include "Computer/Settings.hpp"
+#include "Computer/ComputerStopWatch.hpp"
+#include "Screen/Profiler.hpp"
 
 class DeviceBlackboard;
 class GlideComputer;
@@ -38,6 +40,35 @@ class CalculationThread final : public WorkerThread {
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  /**
+   * Measures the phases of Tick().  Only used by the thread itself.
+   */
+  Profiler::PhaseStopWatch stop_watch{"Calc"};
+
+  /**
+   * Shall GlideComputer::ProcessIdle() be called?  It may be
+   * deferred if a newer GPS fix is already waiting.  Only used by
+   * the thread itself.
+   */
+  bool idle_pending = false;
+
+  /**
+   * How often in a row GlideComputer::ProcessIdle() has been
+   * deferred.  Only used by the thread itself.
+   */
+  unsigned idle_deferrals = 0;
+
+  /**
+   * The total number of deferrals, for the #Profiler.
+   */
+  uint_least64_t total_idle_deferrals = 0;
+
+  /**
+   * The GlideComputer statistics at the time of the previous
+   * UpdateProfilerCounters() call.  Only used by the thread itself.
+   */
+  ComputerStopWatch::Statistics last_computer_statistics;
+
 public:
   CalculationThread(DeviceBlackboard &_device_blackboard,
                     GlideComputer &_glide_computer) noexcept;
@@ -56,6 +87,20 @@ public:
 
   void ForceTrigger() noexcept;
 
+private:
+  /**
+   * Has the #DeviceBlackboard received a GPS fix which the
+   * GlideComputer has not processed yet?
+   */
+  [[gnu::pure]]
+  bool IsNewFixPending() const noexcept;
+
+  /**
+   * Export the GlideComputer and #DeviceBlackboard snapshot
+   * statistics to the #Profiler.
+   */
+  void UpdateProfilerCounters() noexcept;
+
 protected:
   void Tick() noexcept override;
 };
@@ -10,9 +10,8 @@
 #include "net/AddressInfo.hxx"
 #include "net/Resolver.hxx"
 
-#include <boost/geometry/algorithms/distance.hpp>
-#include <boost/geometry/algorithms/intersection.hpp>
-#include <boost/geometry/strategies/strategies.hpp>
+#include <algorithm>
+#include <cassert>
 
 CloudClientContainer::CloudClientContainer()
   :key_set(typename KeySet::bucket_traits(key_buckets, N_KEY_BUCKETS)) {}
@@ -76,10 +75,12 @@ CloudClientContainer::Refresh(CloudClient &client,
   Refresh(client, address);
 
   if (location != client.location) {
-    auto ptr = client.shared_from_this();
-    rtree.remove(ptr);
     client.location = location;
-    rtree.insert(ptr);
+
+    /* usually, the client stays in the same grid cell and nothing
+       needs to be done */
+    if (GetGridCell(location) != client.grid_cell)
+      GridInsert(GridRemove(client));
   }
 
   client.altitude = altitude;
@@ -91,7 +92,7 @@ CloudClientContainer::Insert(CloudClient &client)
   list.push_front(client);
   key_set.insert(client);
   id_set.push_back(client);
-  rtree.insert(client.shared_from_this());
+  GridInsert(client.shared_from_this());
 }
 
 void
@@ -100,7 +101,7 @@ CloudClientContainer::Remove(CloudClient &client)
   list.erase(list.iterator_to(client));
   key_set.erase(key_set.iterator_to(client));
   id_set.erase(id_set.iterator_to(client));
-  rtree.remove(client.shared_from_this());
+  GridRemove(client);
 }
 
 void
@@ -110,11 +111,67 @@ CloudClientContainer::Expire(std::chrono::steady_clock::time_point before)
     Remove(list.back());
 }
 
-CloudClientContainer::query_iterator_range
-CloudClientContainer::QueryWithinRange(GeoPoint location, double range) const
+unsigned
+CloudClientContainer::GetGridRow(Angle latitude) noexcept
+{
+  const int row = (latitude.Degrees() + 90) / GRID_CELL_DEGREES;
+  return std::clamp(row, 0, int(GRID_ROWS) - 1);
+}
+
+unsigned
+CloudClientContainer::GetGridColumn(Angle longitude) noexcept
+{
+  const int column = (longitude.AsDelta().Degrees() + 180) / GRID_CELL_DEGREES;
+  return std::clamp(column, 0, int(GRID_COLUMNS) - 1);
+}
+
+CloudClientContainer::RangeBox
+CloudClientContainer::GetRangeBox(GeoPoint location, double range) noexcept
+{
+  const auto box = BoostRangeBox(location, range);
+
+  RangeBox result;
+  result.south_west = box.min_corner();
+  result.north_east = box.max_corner();
+  result.south_row = GetGridRow(result.south_west.latitude);
+  result.north_row = GetGridRow(result.north_east.latitude);
+  result.west_column = GetGridColumn(result.south_west.longitude);
+  result.east_column = GetGridColumn(result.north_east.longitude);
+  return result;
+}
+
+void
+CloudClientContainer::GridInsert(CloudClientPtr &&client)
 {
-  const auto q = boost::geometry::index::intersects(BoostRangeBox(location, range));
-  return {rtree.qbegin(q), rtree.qend()};
+  client->grid_cell = GetGridCell(client->location);
+
+  auto &cell = grid[client->grid_cell];
+  client->grid_index = cell.size();
+  cell.emplace_back(std::move(client));
+}
+
+CloudClientPtr
+CloudClientContainer::GridRemove(CloudClient &client) noexcept
+{
+  const auto i = grid.find(client.grid_cell);
+  assert(i != grid.end());
+
+  auto &cell = i->second;
+  assert(client.grid_index < cell.size());
+  assert(cell[client.grid_index].get() == &client);
+
+  /* move the last client of this cell into the gap */
+  CloudClientPtr result = std::move(cell[client.grid_index]);
+  if (client.grid_index + 1 < cell.size()) {
+    cell[client.grid_index] = std::move(cell.back());
+    cell[client.grid_index]->grid_index = client.grid_index;
+  }
+
+  cell.pop_back();
+  if (cell.empty())
+    grid.erase(i);
+
+  return result;
 }
 
 inline Serialiser &
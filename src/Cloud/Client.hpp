@@ -3,16 +3,17 @@
 
 #pragma once
 
-#include "Geo/Boost/GeoPoint.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "net/AllocatedSocketAddress.hxx"
 
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/unordered_set.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/range/iterator_range_core.hpp>
+#include <cstdint>
 #include <memory>
 #include <chrono>
+#include <unordered_map>
+#include <vector>
 
 class Serialiser;
 class Deserialiser;
@@ -74,6 +75,13 @@ struct CloudClient
    */
   int altitude;
 
+  /**
+   * The #CloudClientContainer grid cell which contains this client,
+   * and the position within the cell.
+   */
+  uint32_t grid_cell;
+  uint32_t grid_index;
+
   struct KeyHash {
     constexpr std::size_t operator()(uint64_t key) const {
       return key;
@@ -128,22 +136,7 @@ struct CloudClient
 
 using CloudClientPtr = std::shared_ptr<CloudClient>;
 
-/**
- * Helper for boost::geometry::index::rtree.
- */
-struct CloudClientIndexable {
-  typedef GeoPoint result_type;
-
-  [[gnu::pure]]
-  result_type operator()(const CloudClientPtr &client) const {
-    return client->location;
-  }
-};
-
 class CloudClientContainer {
-  typedef boost::geometry::index::rtree<CloudClientPtr, boost::geometry::index::rstar<16>,
-                                        CloudClientIndexable> Tree;
-
   typedef boost::intrusive::list<CloudClient,
                                  boost::intrusive::constant_time_size<false>> List;
 
@@ -156,11 +149,25 @@ class CloudClientContainer {
                                 boost::intrusive::compare<CloudClient::IdCompare>,
                                 boost::intrusive::constant_time_size<false>> IdSet;
 
+  /**
+   * The size of one #grid cell in degrees.  With the traffic range
+   * of 50 km, a query touches only a handful of cells.
+   */
+  static constexpr double GRID_CELL_DEGREES = 0.5;
+  static constexpr unsigned GRID_ROWS = 180 / GRID_CELL_DEGREES;
+  static constexpr unsigned GRID_COLUMNS = 360 / GRID_CELL_DEGREES;
+
   /**
    * A geospatial container of all clients, for fast geographic
-   * lookups.
+   * lookups: a uniform grid of latitude/longitude cells; only cells
+   * containing clients are allocated.  This container owns the
+   * #CloudClient objects.
+   *
+   * Unlike a tree, it can be updated in place: a new fix moves the
+   * client to another cell only if it has crossed a cell boundary,
+   * which is rare.
    */
-  Tree rtree;
+  std::unordered_map<uint32_t, std::vector<CloudClientPtr>> grid;
 
   /**
    * A linked list of clients, sorted by last fix, with fresh items at
@@ -238,12 +245,72 @@ public:
 
   void Expire(std::chrono::steady_clock::time_point before);
 
-  typedef Tree::const_query_iterator query_iterator;
-  typedef boost::iterator_range<query_iterator> query_iterator_range;
-
-  [[gnu::pure]]
-  query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
+  /**
+   * Invoke the given function for each client within the box
+   * around the given location (see BoostRangeBox()), in unspecified
+   * order.  The function gets a "const CloudClientPtr &" and returns
+   * false to stop the iteration.  It must not modify this container.
+   */
+  template<typename F>
+  void VisitWithinRange(GeoPoint location, double range, F &&f) const {
+    const auto box = GetRangeBox(location, range);
+
+    for (unsigned row = box.south_row; row <= box.north_row; ++row) {
+      for (unsigned column = box.west_column;; column = (column + 1) % GRID_COLUMNS) {
+        const auto i = grid.find(row * GRID_COLUMNS + column);
+        if (i != grid.end())
+          for (const auto &client : i->second)
+            if (box.Contains(client->location) && !f(client))
+              return;
+
+        if (column == box.east_column)
+          break;
+      }
+    }
+  }
 
   void Save(Serialiser &s) const;
   void Load(Deserialiser &s);
+
+private:
+  struct RangeBox {
+    GeoPoint south_west, north_east;
+    unsigned south_row, north_row, west_column, east_column;
+
+    [[gnu::pure]]
+    bool Contains(const GeoPoint &p) const noexcept {
+      if (p.latitude < south_west.latitude ||
+          p.latitude > north_east.latitude)
+        return false;
+
+      /* the box may wrap around the anti-meridian */
+      return south_west.longitude <= north_east.longitude
+        ? (p.longitude >= south_west.longitude &&
+           p.longitude <= north_east.longitude)
+        : (p.longitude >= south_west.longitude ||
+           p.longitude <= north_east.longitude);
+    }
+  };
+
+  [[gnu::const]]
+  static RangeBox GetRangeBox(GeoPoint location, double range) noexcept;
+
+  [[gnu::const]]
+  static unsigned GetGridRow(Angle latitude) noexcept;
+
+  [[gnu::const]]
+  static unsigned GetGridColumn(Angle longitude) noexcept;
+
+  [[gnu::const]]
+  static uint32_t GetGridCell(const GeoPoint &location) noexcept {
+    return GetGridRow(location.latitude) * GRID_COLUMNS
+      + GetGridColumn(location.longitude);
+  }
+
+  void GridInsert(CloudClientPtr &&client);
+
+  /**
+   * Remove the client from the grid, and return the owning pointer.
+   */
+  CloudClientPtr GridRemove(CloudClient &client) noexcept;
 };
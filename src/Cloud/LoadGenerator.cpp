@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * A load generator for xcsoar-cloud-server.  It simulates a number
+ * of SkyLines tracking clients flying around in a small area (like
+ * on a competition day) and submits their fixes at a fixed total
+ * rate.  Each client requests traffic every few fixes (0 disables
+ * requests, and thus the traffic pushed by the server); the requests
+ * are sent from a separate socket, so their responses can be told
+ * apart from the traffic which the server pushes to the clients.
+ *
+ * At the end, it prints the achieved fix rate and the latency of
+ * the traffic responses.
+ */
+
+#include "Tracking/SkyLines/Protocol.hpp"
+#include "Tracking/SkyLines/Assemble.hpp"
+#include "Tracking/SkyLines/Server.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Geo/Math.hpp"
+#include "net/AddressInfo.hxx"
+#include "net/Resolver.hxx"
+#include "net/SocketError.hxx"
+#include "net/StaticSocketAddress.hxx"
+#include "net/UniqueSocketDescriptor.hxx"
+#include "util/ByteOrder.hxx"
+#include "util/PrintException.hxx"
+#include "util/SpanCast.hxx"
+#include "system/Error.hxx"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <poll.h>
+#include <stdlib.h>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * By default, each client requests traffic every this many fixes.
+ */
+static constexpr unsigned DEFAULT_REQUEST_INTERVAL = 10;
+
+/**
+ * How long to wait for outstanding responses at the end.
+ */
+static constexpr Clock::duration DRAIN_TIME = std::chrono::seconds(1);
+
+static constexpr uint64_t KEY_BASE = 0x10ad000000000000ULL;
+
+struct SimulatedClient {
+  uint64_t key;
+  GeoPoint location;
+  Angle track;
+
+  /**
+   * When the pending traffic request was sent;
+   * Clock::time_point::min() if there is none.
+   */
+  Clock::time_point request_sent = Clock::time_point::min();
+
+  unsigned n_fixes = 0;
+};
+
+struct Statistics {
+  unsigned n_fixes = 0, n_requests = 0, n_responses = 0, n_pushes = 0;
+
+  /**
+   * Latency of each traffic response in microseconds.
+   */
+  std::vector<unsigned> latencies;
+
+  void Print(Clock::duration duration, unsigned n_clients);
+};
+
+static UniqueSocketDescriptor
+CreateConnectUDP(SocketAddress address)
+{
+  UniqueSocketDescriptor s;
+  if (!s.Create(address.GetFamily(), SOCK_DGRAM, 0))
+    throw MakeSocketError("Failed to create socket");
+
+  if (!s.Connect(address))
+    throw MakeSocketError("Failed to connect socket");
+
+  return s;
+}
+
+template<typename P>
+static void
+SendPacket(SocketDescriptor s, const P &packet)
+{
+  if (s.Send(ReferenceAsBytes(packet), MSG_DONTWAIT) < 0)
+    throw MakeSocketError("Failed to send");
+}
+
+/**
+ * Receive all pending datagrams and return the number of
+ * #TRAFFIC_RESPONSE packets.
+ *
+ * @param clients if not nullptr, then these are responses to traffic
+ * requests, and their latency is recorded
+ */
+static unsigned
+ReceiveAll(SocketDescriptor s, std::vector<SimulatedClient> *clients,
+           Statistics &statistics)
+{
+  const auto now = Clock::now();
+  unsigned n = 0;
+
+  std::byte buffer[4096];
+  ssize_t nbytes;
+  while ((nbytes = s.ReadNoWait(buffer)) > 0) {
+    if ((std::size_t)nbytes < sizeof(SkyLinesTracking::Header))
+      continue;
+
+    const auto &header = *(const SkyLinesTracking::Header *)buffer;
+    if (FromBE16(header.type) != SkyLinesTracking::Type::TRAFFIC_RESPONSE)
+      continue;
+
+    ++n;
+
+    if (clients == nullptr)
+      continue;
+
+    const uint64_t index = FromBE64(header.key) - KEY_BASE;
+    if (index >= clients->size())
+      continue;
+
+    auto &client = (*clients)[index];
+    if (client.request_sent == Clock::time_point::min())
+      /* the second datagram of a large response */
+      continue;
+
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - client.request_sent);
+    statistics.latencies.push_back(latency.count());
+    client.request_sent = Clock::time_point::min();
+  }
+
+  return n;
+}
+
+void
+Statistics::Print(Clock::duration duration, unsigned n_clients)
+{
+  const double seconds = std::chrono::duration<double>(duration).count();
+
+  cout << n_clients << " clients, " << n_fixes << " fixes in "
+       << seconds << " s: " << n_fixes / seconds << " fixes/s" << endl;
+  cout << n_pushes << " traffic pushes received" << endl;
+  cout << n_requests << " traffic requests, " << n_responses
+       << " responses" << endl;
+
+  if (latencies.empty())
+    return;
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [this](unsigned p){
+    return latencies[(latencies.size() - 1) * p / 100] / 1000.;
+  };
+
+  cout << "latency: p50 " << percentile(50) << " ms, p99 "
+       << percentile(99) << " ms, max " << latencies.back() / 1000.
+       << " ms" << endl;
+}
+
+int
+main(int argc, char **argv)
+try {
+  if (argc != 5 && argc != 6) {
+    cerr << "Usage: " << argv[0]
+         << " HOST[:PORT] N_CLIENTS FIXES_PER_SECOND SECONDS [REQUEST_INTERVAL]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto address_list =
+    Resolve(argv[1], SkyLinesTracking::Server::GetDefaultPort(),
+            0, SOCK_DGRAM);
+  const unsigned n_clients = strtoul(argv[2], nullptr, 10);
+  const unsigned rate = strtoul(argv[3], nullptr, 10);
+  const std::chrono::seconds duration(strtoul(argv[4], nullptr, 10));
+  const unsigned request_interval = argc > 5
+    ? strtoul(argv[5], nullptr, 10)
+    : DEFAULT_REQUEST_INTERVAL;
+
+  if (n_clients == 0 || rate == 0) {
+    cerr << "Invalid parameters" << endl;
+    return EXIT_FAILURE;
+  }
+
+  const SocketAddress address = address_list.front();
+  const auto fix_socket = CreateConnectUDP(address);
+  const auto request_socket = CreateConnectUDP(address);
+
+  /* scatter the clients randomly in a 100 km circle */
+  std::mt19937 random;
+  std::uniform_real_distribution<double> random_angle(0, 360);
+  std::uniform_real_distribution<double> random_distance(0, 50000);
+  std::uniform_real_distribution<double> random_turn(-10, 10);
+
+  const GeoPoint center(Angle::Degrees(10), Angle::Degrees(47));
+
+  std::vector<SimulatedClient> clients(n_clients);
+  for (unsigned i = 0; i < n_clients; ++i) {
+    auto &client = clients[i];
+    client.key = KEY_BASE + i;
+    client.location = FindLatitudeLongitude(center,
+                                            Angle::Degrees(random_angle(random)),
+                                            random_distance(random));
+    client.track = Angle::Degrees(random_angle(random));
+  }
+
+  Statistics statistics;
+
+  const auto interval =
+    std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / rate;
+  const auto start = Clock::now();
+  const auto end = start + duration;
+  auto next_fix = start;
+  unsigned next_client = 0;
+
+  std::array<struct pollfd, 2> pfds{{
+    {fix_socket.Get(), POLLIN, 0},
+    {request_socket.Get(), POLLIN, 0},
+  }};
+
+  while (true) {
+    auto now = Clock::now();
+    const bool sending = now < end;
+    if (!sending && now >= end + DRAIN_TIME)
+      break;
+
+    for (; sending && next_fix <= now; next_fix += interval) {
+      auto &client = clients[next_client];
+      next_client = (next_client + 1) % n_clients;
+
+      /* fly at 30 m/s, one fix per second */
+      client.track = (client.track + Angle::Degrees(random_turn(random))).AsBearing();
+      client.location = FindLatitudeLongitude(client.location, client.track, 30);
+
+      const auto time_of_day = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+      SendPacket(fix_socket,
+                 SkyLinesTracking::MakeFix(client.key,
+                                           SkyLinesTracking::FixPacket::FLAG_LOCATION |
+                                           SkyLinesTracking::FixPacket::FLAG_ALTITUDE,
+                                           time_of_day.count(),
+                                           client.location, client.track,
+                                           30, 30, 1500, 0, 0));
+      ++statistics.n_fixes;
+
+      if (request_interval > 0 &&
+          client.n_fixes++ % request_interval == 0 &&
+          client.request_sent == Clock::time_point::min()) {
+        SendPacket(request_socket,
+                   SkyLinesTracking::MakeTrafficRequest(client.key,
+                                                        false, false, true));
+        client.request_sent = Clock::now();
+        ++statistics.n_requests;
+      }
+    }
+
+    statistics.n_pushes += ReceiveAll(fix_socket, nullptr, statistics);
+    statistics.n_responses += ReceiveAll(request_socket, &clients, statistics);
+
+    now = Clock::now();
+    int timeout = 0;
+    if (!sending)
+      timeout = 10;
+    else if (next_fix > now)
+      timeout = std::chrono::ceil<std::chrono::milliseconds>(next_fix - now).count();
+
+    if (poll(pfds.data(), pfds.size(), timeout) < 0)
+      throw MakeErrno("poll() failed");
+  }
+
+  statistics.Print(duration, n_clients);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
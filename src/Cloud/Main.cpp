@@ -168,26 +168,30 @@ CloudServer::OnFix(const Client &c,
     client = clients.Find(c.key);
     if (client != nullptr)
       clients.Refresh(*client, c.address);
+
+    /* no new location, nothing to send */
+    return;
   }
 
   /* send this new traffic location to all interested clients
      immediately */
   const auto now = std::chrono::steady_clock::now();
-  for (const auto &i : clients.QueryWithinRange(location, TRAFFIC_RANGE)) {
+  clients.VisitWithinRange(location, TRAFFIC_RANGE, [&](const CloudClientPtr &i){
     if (i->key == c.key)
       /* ignore this client's own submissions - he knows them
          already */
-      continue;
+      return true;
 
     if (now > i->wants_traffic)
       /* not interested (anymore) */
-      continue;
+      return true;
 
     TrafficResponseSender s(*this, i->address, i->key);
     s.Add(client->id, 0, //TODO: time?
           client->location, client->altitude);
     s.Flush();
-  }
+    return true;
+  });
 }
 
 void
@@ -212,21 +216,20 @@ CloudServer::OnTrafficRequest(const Client &c, bool near)
   TrafficResponseSender s(*this, c.address, c.key);
 
   unsigned n = 0;
-  for (const auto &traffic : clients.QueryWithinRange(client->location,
-                                                      TRAFFIC_RANGE)) {
+  clients.VisitWithinRange(client->location, TRAFFIC_RANGE,
+                           [&](const CloudClientPtr &traffic){
     if (traffic.get() == client)
-      continue;
+      return true;
 
     if (traffic->stamp < min_stamp)
       /* don't send stale traffic, it's probably not there anymore */
-      continue;
+      return true;
 
     s.Add(traffic->id, 0, //TODO: time?
           traffic->location, traffic->altitude);
 
-    if (++n > 64)
-      break;
-  }
+    return ++n <= 64;
+  });
 
   s.Flush();
 }
@@ -288,21 +291,22 @@ CloudServer::OnThermalSubmit(const Client &c,
 
   /* send this new thermal to all interested clients immediately */
   const auto now = std::chrono::steady_clock::now();
-  for (const auto &i : clients.QueryWithinRange(bottom_location,
-                                                THERMAL_RANGE)) {
+  clients.VisitWithinRange(bottom_location, THERMAL_RANGE,
+                           [&](const CloudClientPtr &i){
     if (i->key == c.key)
       /* ignore this client's own submissions - he knows them
          already */
-      continue;
+      return true;
 
     if (now > i->wants_thermals)
       /* not interested (anymore) */
-      continue;
+      return true;
 
     ThermalResponseSender s(*this, i->address, i->key);
     s.Add(thermal.Pack());
     s.Flush();
-  }
+    return true;
+  });
 }
 
 void
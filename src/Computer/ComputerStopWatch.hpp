@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * The steps of GlideComputer::ProcessGPS() and
+ * GlideComputer::ProcessIdle() which are accounted separately by
+ * #ComputerStopWatch.
+ */
+enum class ComputerStep : uint8_t {
+  BASIC,
+  TASK,
+  FLIGHT,
+  AUTO_QNH,
+  CIRCLING,
+  WAVE,
+  WIND,
+  THERMAL_LOCATOR,
+  CLIMB,
+  CLIMB_EVENTS,
+  CU,
+  TEAM_CODE,
+  TRACE,
+
+  /* waiting for the route and reach thread */
+  ROUTE,
+
+  CONDITION_MONITORS,
+
+  /* slow computers, run by ProcessIdle() */
+  LOGGING,
+  CONTEST,
+  WARNINGS,
+  IDLE_CONDITION_MONITORS,
+  RETROSPECTIVE,
+
+  COUNT
+};
+
+static constexpr std::size_t NUM_COMPUTER_STEPS =
+  static_cast<std::size_t>(ComputerStep::COUNT);
+
+/**
+ * Counts how often each #ComputerStep was run or skipped (because
+ * none of its inputs has changed), and optionally measures how much
+ * time each step took.
+ *
+ * This object is not thread-safe; it is owned by the
+ * #CalculationThread.
+ */
+class ComputerStopWatch {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct StepStatistics {
+    uint_least64_t runs = 0, skips = 0;
+
+    /**
+     * The accumulated duration of all runs (only while time
+     * measurement is enabled).
+     */
+    Clock::duration time{};
+  };
+
+  using Statistics = std::array<StepStatistics, NUM_COMPUTER_STEPS>;
+
+private:
+  Statistics statistics;
+
+  /**
+   * Measure the duration of each step?  This is disabled by default,
+   * because it requires two clock reads per step.
+   */
+  bool measure_time = false;
+
+  /**
+   * The step which is currently being measured; #ComputerStep::COUNT
+   * if none.
+   */
+  ComputerStep current = ComputerStep::COUNT;
+
+  Clock::time_point start_time;
+
+public:
+  void SetMeasureTime(bool value) noexcept {
+    measure_time = value;
+  }
+
+  const Statistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
+  /**
+   * Finish the current step (if any) and begin the given one.
+   */
+  void Mark(ComputerStep step) noexcept {
+    ++statistics[static_cast<std::size_t>(step)].runs;
+
+    if (!measure_time) {
+      current = ComputerStep::COUNT;
+      return;
+    }
+
+    const auto now = Clock::now();
+    Account(now);
+    current = step;
+    start_time = now;
+  }
+
+  /**
+   * Finish the current step (if any) and record that the given step
+   * was skipped.
+   */
+  void Skip(ComputerStep step) noexcept {
+    Stop();
+    ++statistics[static_cast<std::size_t>(step)].skips;
+  }
+
+  /**
+   * Finish the current step (if any).
+   */
+  void Stop() noexcept {
+    if (current == ComputerStep::COUNT)
+      return;
+
+    Account(Clock::now());
+    current = ComputerStep::COUNT;
+  }
+
+private:
+  void Account(Clock::time_point now) noexcept {
+    if (current != ComputerStep::COUNT)
+      statistics[static_cast<std::size_t>(current)].time += now - start_time;
+  }
+};
@@ -3,6 +3,9 @@
 
 #include "ContestComputer.hpp"
 #include "Engine/Contest/Settings.hpp"
+#include "LogFile.hpp"
+
+#include <cassert>
 
 ContestComputer::ContestComputer(const Trace &trace_full,
                                  const Trace &trace_triangle,
@@ -10,6 +13,7 @@ ContestComputer::ContestComputer(const Trace &trace_full,
   :contest_manager(Contest::OLC_SPRINT, trace_full, trace_triangle, trace_sprint, true)
 {
   contest_manager.SetIncremental(true);
+  contest_manager.SetExecutor(this);
 }
 
 void
@@ -41,5 +45,48 @@ ContestComputer::SolveExhaustive(const ContestSettings &settings,
 
   contest_stats = contest_manager.GetStats();
 
+  LogTimings();
+
   return result;
 }
+
+void
+ContestComputer::LogTimings() const noexcept
+{
+  contest_manager.VisitTimings([](const char *name,
+                                  std::chrono::steady_clock::duration d,
+                                  unsigned n_calls){
+    LogFmt("Contest {}: {} ms in {} calls", name,
+           std::chrono::duration_cast<std::chrono::milliseconds>(d).count(),
+           n_calls);
+  });
+}
+
+void
+ContestComputer::Run(std::span<const std::function<void()>> jobs) noexcept
+{
+  assert(!jobs.empty());
+
+  for (std::size_t i = 1; i < jobs.size(); ++i) {
+    const auto &job = jobs[i];
+
+    if (i > std::size(helpers)) {
+      /* not enough threads */
+      job();
+      continue;
+    }
+
+    try {
+      helpers[i - 1].Start(job);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to start contest thread");
+      job();
+    }
+  }
+
+  /* the calling thread runs the first one */
+  jobs.front()();
+
+  for (auto &i : helpers)
+    i.Wait();
+}
@@ -4,14 +4,23 @@
 #pragma once
 
 #include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Contest/ContestExecutor.hpp"
+#include "thread/JobThread.hpp"
 
 struct ContestSettings;
 struct ContestStatistics;
 class Trace;
 
-class ContestComputer {
+class ContestComputer final : ContestExecutor {
   ContestManager contest_manager;
 
+  /**
+   * Threads which run independent contest solvers in parallel; the
+   * calling thread runs one of them itself.  Declared last, so they
+   * get stopped before the #ContestManager is destroyed.
+   */
+  JobThread helpers[2]{JobThread{"Contest1"}, JobThread{"Contest2"}};
+
 public:
   ContestComputer(const Trace &trace_full,
                   const Trace &trace_triangle,
@@ -21,6 +30,14 @@ public:
     contest_manager.SetIncremental(incremental);
   }
 
+  /**
+   * Run independent contest solvers in parallel threads?  This is
+   * enabled by default.
+   */
+  void SetParallel(bool parallel) noexcept {
+    contest_manager.SetExecutor(parallel ? this : nullptr);
+  }
+
   void Reset() {
     contest_manager.Reset();
   }
@@ -37,4 +54,13 @@ public:
 
   bool SolveExhaustive(const ContestSettings &settings_computer,
                        ContestStatistics &contest_stats);
+
+private:
+  /**
+   * Write the time spent in each contest solver to the log file.
+   */
+  void LogTimings() const noexcept;
+
+  /* virtual methods from class ContestExecutor */
+  void Run(std::span<const std::function<void()>> jobs) noexcept override;
 };
@@ -42,6 +42,10 @@ GlideComputer::ResetFlight(const bool full)
   cu_computer.Reset();
   warning_computer.Reset();
 
+  cu_inputs.Reset();
+  warning_inputs.Reset();
+  retrospective_inputs.Reset();
+
   trace_history_time.Reset();
 }
 
@@ -60,6 +64,8 @@ GlideComputer::ProcessGPS(bool force)
 
   const bool last_flying = calculated.flight.flying;
 
+  stop_watch.Mark(ComputerStep::BASIC);
+
   if (basic.time_available) {
     /* use UTC offset to calculate local time */
     const auto utc_offset = settings.utc_offset.ToDuration();
@@ -82,6 +88,7 @@ GlideComputer::ProcessGPS(bool force)
                                  settings);
 
   // Process basic task information
+  stop_watch.Mark(ComputerStep::TASK);
   const bool last_finished = calculated.ordered_task_stats.task_finished;
 
   task_computer.ProcessBasicTask(basic,
@@ -97,6 +104,7 @@ GlideComputer::ProcessGPS(bool force)
     OnFinishTask();
 
   // Check if everything is okay with the gps time and process it
+  stop_watch.Mark(ComputerStep::FLIGHT);
   air_data_computer.FlightTimes(Basic(), SetCalculated(),
                                 settings);
 
@@ -110,19 +118,31 @@ GlideComputer::ProcessGPS(bool force)
   // Process extended information
   air_data_computer.ProcessVertical(Basic(),
                                     SetCalculated(),
-                                    settings);
+                                    settings, stop_watch);
 
+  stop_watch.Mark(ComputerStep::CLIMB_EVENTS);
   stats_computer.ProcessClimbEvents(calculated);
 
-  cu_computer.Compute(basic, calculated, settings);
+  if (cu_inputs.Update(settings.forecast_temperature,
+                       basic.temperature_available,
+                       basic.baro_altitude_available,
+                       basic.pressure_altitude_available,
+                       basic.gps_altitude_available,
+                       calculated.flight.flying)) {
+    stop_watch.Mark(ComputerStep::CU);
+    cu_computer.Compute(basic, calculated, settings);
+  } else
+    stop_watch.Skip(ComputerStep::CU);
 
   // Calculate the team code
+  stop_watch.Mark(ComputerStep::TEAM_CODE);
   CalculateOwnTeamCode();
 
   // Calculate the bearing and range of the teammate
   CalculateTeammateBearingRange();
 
   // update basic trace history
+  stop_watch.Mark(ComputerStep::TRACE);
   if (basic.time_available) {
     const auto dt = trace_history_time.Update(basic.time,
                                               milliseconds{500}, seconds{30});
@@ -135,9 +155,17 @@ GlideComputer::ProcessGPS(bool force)
 
   CalculateVarioScale();
 
+  /* the route and the reach were solved in background while doing
+     the above */
+  stop_watch.Mark(ComputerStep::ROUTE);
+  task_computer.FinishMoreTask(calculated);
+
   // Update the ConditionMonitors
+  stop_watch.Mark(ComputerStep::CONDITION_MONITORS);
   condition_monitors.Update(Basic(), Calculated(), settings);
 
+  stop_watch.Stop();
+
   return idle_clock.CheckUpdate(milliseconds(500));
 }
 
@@ -149,20 +177,33 @@ GlideComputer::ProcessIdle(bool exhaustive)
 
   // Log GPS fixes for internal usage
   // (snail trail, stats, contest, ...)
+  stop_watch.Mark(ComputerStep::LOGGING);
   stats_computer.DoLogging(basic, calculated);
   log_computer.Run(basic, calculated, GetComputerSettings().logger);
 
+  stop_watch.Mark(ComputerStep::CONTEST);
   task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
                             exhaustive);
 
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  if (warning_inputs.Update(basic.time_available)) {
+    stop_watch.Mark(ComputerStep::WARNINGS);
+    warning_computer.Update(GetComputerSettings(), basic,
+                            calculated, calculated.airspace_warnings);
+  } else
+    stop_watch.Skip(ComputerStep::WARNINGS);
 
+  stop_watch.Mark(ComputerStep::IDLE_CONDITION_MONITORS);
   idle_condition_monitors.Update(basic, calculated, GetComputerSettings());
 
   // Calculate summary of flight
-  if (basic.location_available)
+  if (basic.location_available &&
+      retrospective_inputs.Update(basic.location_available)) {
+    stop_watch.Mark(ComputerStep::RETROSPECTIVE);
     retrospective.UpdateSample(basic.location);
+  } else
+    stop_watch.Skip(ComputerStep::RETROSPECTIVE);
+
+  stop_watch.Stop();
 }
 
 bool
@@ -7,6 +7,8 @@
 #include "time/PeriodClock.hpp"
 #include "time/DeltaTime.hpp"
 #include "GlideComputerAirData.hpp"
+#include "ComputerStopWatch.hpp"
+#include "InputTracker.hpp"
 #include "StatsComputer.hpp"
 #include "TaskComputer.hpp"
 #include "LogComputer.hpp"
@@ -46,6 +48,26 @@ class GlideComputer : public GlideComputerBlackboard
 
   PeriodClock idle_clock;
 
+  ComputerStopWatch stop_watch;
+
+  /**
+   * The inputs of CuComputer::Compute(): the forecast temperature,
+   * the measured temperature, altitude and the "flying" flag.
+   */
+  InputTracker<Temperature, Validity, Validity, Validity, Validity,
+               bool> cu_inputs;
+
+  /**
+   * The input of WarningComputer::Update(), which does nothing
+   * unless the time has advanced.
+   */
+  InputTracker<Validity> warning_inputs;
+
+  /**
+   * The input of Retrospective::UpdateSample(): the location.
+   */
+  InputTracker<Validity> retrospective_inputs;
+
   /**
    * This object is used to check whether to update
    * DerivedInfo::trace_history.
@@ -97,6 +119,23 @@ public:
     ProcessIdle(true);
   }
 
+  /**
+   * Enable or disable measuring the duration of each computer (see
+   * GetStatistics()).
+   */
+  void SetMeasureTime(bool value) noexcept {
+    stop_watch.SetMeasureTime(value);
+  }
+
+  /**
+   * Returns how often each computer was run or skipped and how much
+   * time it took.  Must be called from the thread which calls
+   * ProcessGPS() and ProcessIdle().
+   */
+  const ComputerStopWatch::Statistics &GetStatistics() const noexcept {
+    return stop_watch.GetStatistics();
+  }
+
   void OnStartTask();
   void OnFinishTask();
   void OnTransitionEnter();
@@ -145,6 +184,15 @@ public:
     task_computer.SetContestIncremental(incremental);
   }
 
+  /**
+   * Solve route and reach in background threads?  This is enabled by
+   * default; replay tools may want to disable it to get the results
+   * in the same tick.
+   */
+  void SetRouteParallel(bool parallel) {
+    task_computer.SetRouteParallel(parallel);
+  }
+
 protected:
   void OnTakeoff();
   void OnLanding();
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "GlideComputerAirData.hpp"
+#include "ComputerStopWatch.hpp"
 #include "Settings.hpp"
 #include "Math/LowPassFilter.hpp"
 #include "Terrain/RasterTerrain.hpp"
@@ -70,34 +71,43 @@ GlideComputerAirData::ProcessBasic(const MoreData &basic,
 void
 GlideComputerAirData::ProcessVertical(const MoreData &basic,
                                       DerivedInfo &calculated,
-                                      const ComputerSettings &settings)
+                                      const ComputerSettings &settings,
+                                      ComputerStopWatch &stop_watch)
 {
   /* the "circling" flag may be modified by
      CirclingComputer::Turning(); remember the old state so this
      method can check for modifications */
   const bool last_circling = calculated.circling;
 
+  stop_watch.Mark(ComputerStep::AUTO_QNH);
   auto_qnh.Process(basic, calculated, settings, waypoints);
 
+  stop_watch.Mark(ComputerStep::CIRCLING);
   circling_computer.TurnRate(calculated, basic,
                              calculated.flight);
   Turning(basic, calculated, settings);
 
+  stop_watch.Mark(ComputerStep::WAVE);
   wave_computer.Compute(basic, calculated.flight,
                         calculated.wave, settings.wave);
 
+  stop_watch.Mark(ComputerStep::WIND);
   wind_computer.Compute(settings.wind, settings.polar.glide_polar_task,
                         basic, calculated);
   wind_computer.Select(settings.wind, basic, calculated);
   wind_computer.ComputeHeadWind(basic, calculated);
 
-  if (basic.location_available)
+  if (basic.location_available) {
+    stop_watch.Mark(ComputerStep::THERMAL_LOCATOR);
     thermallocator.Process(calculated.circling && calculated.turning,
                            basic.time, basic.location,
                            basic.netto_vario,
                            calculated.GetWindOrZero(),
                            calculated.thermal_locator);
+  } else
+    stop_watch.Skip(ComputerStep::THERMAL_LOCATOR);
 
+  stop_watch.Mark(ComputerStep::CLIMB);
   LastThermalStats(basic, calculated, last_circling);
 
   gr_computer.Compute(basic, calculated,
@@ -21,6 +21,7 @@ struct ThermalLocatorInfo;
 class Waypoints;
 class RasterTerrain;
 class GlidePolar;
+class ComputerStopWatch;
 
 // TODO: replace copy constructors so copies of these structures
 // do not replicate the large items or items that should be singletons
@@ -75,10 +76,13 @@ public:
 
   /**
    * Calculates some other values
+   *
+   * @param stop_watch accounts the individual computers
    */
   void ProcessVertical(const MoreData &basic,
                        DerivedInfo &calculated,
-                       const ComputerSettings &settings);
+                       const ComputerSettings &settings,
+                       ComputerStopWatch &stop_watch);
 
   /**
    * 1. Detects time retreat and calls ResetFlight if GPS lost
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <tuple>
+
+/**
+ * Remembers the inputs (usually #Validity objects) a computer has
+ * seen when it was last run, to be able to skip it if none of them
+ * has changed since.
+ *
+ * This is only correct for computers which produce the same result
+ * (and the same internal state) when they are called again with
+ * unmodified inputs.
+ */
+template<typename... T>
+class InputTracker {
+  std::tuple<T...> last;
+
+  bool valid = false;
+
+public:
+  /**
+   * Forget the remembered inputs, i.e. the next Update() call will
+   * return true.  Call this when the computer itself is reset.
+   */
+  void Reset() noexcept {
+    valid = false;
+  }
+
+  /**
+   * Remember the given inputs.
+   *
+   * @return true if the computer needs to be run, i.e. if at least
+   * one input differs from the previous call
+   */
+  bool Update(const T &... inputs) noexcept {
+    const std::tuple<T...> current{inputs...};
+    if (valid && current == last)
+      return false;
+
+    last = current;
+    valid = true;
+    return true;
+  }
+};
@@ -7,6 +7,7 @@
 #include "NMEA/Derived.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "LogFile.hpp"
 
 #include <algorithm>
 
@@ -19,6 +20,9 @@ RouteComputer::RouteComputer(const Airspaces &airspace_database,
 void
 RouteComputer::ResetFlight()
 {
+  worker.Wait();
+  job_pending = false;
+
   route_clock.Reset();
   reach_clock.Reset();
   protected_route_planner.Reset();
@@ -34,79 +38,98 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                             const GlidePolar &glide_polar,
                             const GlidePolar &safety_polar)
 {
+  /* usually a no-op, because the caller has already called
+     Finish() in the last tick */
+  Finish(calculated);
+
   if (!basic.location_available || !basic.NavAltitudeAvailable())
     return;
 
-  protected_route_planner.SetPolars(settings, config,
-                                    glide_polar, safety_polar,
-                                    calculated.GetWindOrZero(),
-                                    calculated.common_stats.height_min_working);
+  const AircraftState state = ToAircraftState(basic, calculated);
+
+  Job job{
+    settings, config, glide_polar, safety_polar,
+    calculated.GetWindOrZero(),
+    (int)calculated.common_stats.height_min_working,
+    AGeoPoint(state.location, state.altitude),
+    /* allow at least 500m of climb above current altitude as
+       ceiling, in case there are no actual working band stats */
+    std::max((int)basic.nav_altitude + 500,
+             (int)calculated.common_stats.height_max_working),
+  };
+
+  Reach(basic, calculated, config, job);
+  TerrainWarning(basic, calculated, job);
+
+  if (!job.reach && !job.route)
+    return;
+
+  if (parallel) {
+    try {
+      worker.Start([this, job]{ result = Solve(job); });
+      job_pending = true;
+      return;
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to start route thread");
+    }
+  }
+
+  Publish(Solve(job), calculated);
+}
+
+void
+RouteComputer::Finish(DerivedInfo &calculated) noexcept
+{
+  if (!job_pending)
+    return;
 
-  Reach(basic, calculated, config);
-  TerrainWarning(basic, calculated, config);
+  worker.Wait();
+  job_pending = false;
+  Publish(result, calculated);
 }
 
 inline void
 RouteComputer::TerrainWarning(const MoreData &basic,
                               DerivedInfo &calculated,
-                              const RoutePlannerConfig &config)
+                              Job &job)
 {
-  const AircraftState as = ToAircraftState(basic, calculated);
-
   const GlideResult& sol = calculated.task_stats.current_leg.solution_remaining;
-  if (!sol.IsDefined()) {
+  if (!sol.IsDefined() || !terrain) {
     calculated.terrain_warning_location.SetInvalid();
     return;
   }
 
-  const AGeoPoint start (as.location, as.altitude);
-  const RoughAltitude h_ceiling(std::max((int)basic.nav_altitude+500,
-                                         (int)calculated.common_stats.height_max_working));
-  // allow at least 500m of climb above current altitude as ceiling, in case
-  // there are no actual working band stats.
   GeoVector v = sol.vector;
   if (v.distance > 200000)
     /* limit to reasonable distances (200km max.) to avoid overflow in
        GeoVector::EndPoint() */
     v.distance = 200000;
 
-  if (terrain) {
-    if (sol.IsDefined()) {
-      const AGeoPoint dest(v.EndPoint(start), sol.min_arrival_altitude);
-      bool dirty = route_clock.CheckAdvance(basic.time, PERIOD);
-
-      if (!dirty) {
-        dirty =
-          calculated.task_stats.active_index != last_active_tp ||
-          calculated.common_stats.task_type != last_task_type;
-        if (dirty) {
-          // restart clock
-          route_clock.Reset();
-        }
-      }
-
-      last_task_type = calculated.common_stats.task_type;
-      last_active_tp = calculated.task_stats.active_index;
-
-      if (dirty) {
-        protected_route_planner.SolveRoute(dest, start, config, h_ceiling);
-        calculated.planned_route = route_planner.GetSolution();
-
-        calculated.terrain_warning_location =
-          route_planner.Intersection(start, dest);
-      }
-      return;
-    } else {
-      protected_route_planner.SolveRoute(start, start, config, h_ceiling);
-      calculated.planned_route = route_planner.GetSolution();
+  bool dirty = route_clock.CheckAdvance(basic.time, PERIOD);
+
+  if (!dirty) {
+    dirty =
+      calculated.task_stats.active_index != last_active_tp ||
+      calculated.common_stats.task_type != last_task_type;
+    if (dirty) {
+      // restart clock
+      route_clock.Reset();
     }
   }
-  calculated.terrain_warning_location.SetInvalid();
+
+  last_task_type = calculated.common_stats.task_type;
+  last_active_tp = calculated.task_stats.active_index;
+
+  if (dirty) {
+    job.route = true;
+    job.route_dest = AGeoPoint(v.EndPoint(job.start),
+                               sol.min_arrival_altitude);
+  }
 }
 
 inline void
 RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
-                     const RoutePlannerConfig &config)
+                     const RoutePlannerConfig &config, Job &job)
 {
   if (!calculated.terrain_valid) {
     /* without valid terrain information, we cannot calculate
@@ -116,25 +139,62 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
     return;
   }
 
-  const bool do_solve = config.IsReachEnabled() && terrain != NULL;
+  if (reach_clock.CheckAdvance(basic.time, PERIOD)) {
+    job.reach = true;
+    job.reach_do_solve = config.IsReachEnabled() && terrain != NULL;
+  }
+}
 
-  const AircraftState state = ToAircraftState(basic, calculated);
-  const AGeoPoint start (state.location, state.altitude);
-  const int h_ceiling(std::max((int)basic.nav_altitude + 500,
-                               (int)calculated.common_stats.height_max_working));
+RouteComputer::Result
+RouteComputer::Solve(const Job &job) noexcept
+{
+  protected_route_planner.SetPolars(job.settings, job.config,
+                                    job.glide_polar, job.safety_polar,
+                                    job.wind, job.height_min_working);
 
-  if (reach_clock.CheckAdvance(basic.time, PERIOD)) {
-    protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
+  Result r;
 
-    if (do_solve) {
-      calculated.terrain_base = protected_route_planner.GetTerrainBase();
-      calculated.terrain_base_valid = true;
-    }
+  if (job.reach) {
+    protected_route_planner.SolveReach(job.start, job.config, job.h_ceiling,
+                                       job.reach_do_solve,
+                                       parallel ? &reach_helper : nullptr);
+
+    r.reach = true;
+    r.terrain_base_valid = job.reach_do_solve;
+    if (r.terrain_base_valid)
+      r.terrain_base = protected_route_planner.GetTerrainBase();
+  }
+
+  if (job.route) {
+    protected_route_planner.SolveRoute(job.route_dest, job.start,
+                                       job.config, job.h_ceiling);
+
+    r.route = true;
+    r.planned_route = route_planner.GetSolution();
+    r.terrain_warning_location =
+      route_planner.Intersection(job.start, job.route_dest);
+  }
+
+  return r;
+}
+
+void
+RouteComputer::Publish(const Result &r, DerivedInfo &calculated) noexcept
+{
+  if (r.reach && r.terrain_base_valid) {
+    calculated.terrain_base = r.terrain_base;
+    calculated.terrain_base_valid = true;
+  }
+
+  if (r.route) {
+    calculated.planned_route = r.planned_route;
+    calculated.terrain_warning_location = r.terrain_warning_location;
   }
 }
 
 void
 RouteComputer::set_terrain(const RasterTerrain* _terrain) {
+  worker.Wait();
   terrain = _terrain;
   protected_route_planner.SetTerrain(terrain);
 }
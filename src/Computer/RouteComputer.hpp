@@ -6,15 +6,17 @@
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "Engine/Task/TaskType.hpp"
 #include "Engine/Route/RoutePlanner.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "thread/JobThread.hpp"
 #include "time/GPSClock.hpp"
 
 struct MoreData;
 struct DerivedInfo;
-struct GlideSettings;
-struct RoutePlannerConfig;
 class ProtectedAirspaceWarningManager;
 class RasterTerrain;
-class GlidePolar;
 
 class RouteComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::seconds(5);
@@ -30,10 +32,85 @@ class RouteComputer {
   TaskType last_task_type;
   unsigned last_active_tp;
 
+  /**
+   * The parameters of one Solve() call, collected by ProcessRoute().
+   */
+  struct Job {
+    GlideSettings settings;
+    RoutePlannerConfig config;
+    GlidePolar glide_polar, safety_polar;
+    SpeedVector wind;
+    int height_min_working;
+
+    AGeoPoint start;
+    int h_ceiling;
+
+    /**
+     * Solve the reach?
+     */
+    bool reach = false;
+    bool reach_do_solve;
+
+    /**
+     * Solve the route to #route_dest?
+     */
+    bool route = false;
+    AGeoPoint route_dest;
+  };
+
+  /**
+   * The results of one Solve() call, to be copied to #DerivedInfo by
+   * Publish().
+   */
+  struct Result {
+    bool reach = false, route = false;
+
+    bool terrain_base_valid;
+    int terrain_base;
+
+    StaticRoute planned_route;
+    GeoPoint terrain_warning_location;
+  };
+
+  /**
+   * Solve the route and the reach in background threads?  If false,
+   * everything is calculated synchronously in ProcessRoute().
+   */
+  bool parallel = true;
+
+  /**
+   * Has a job been started in #worker whose #result has not yet
+   * been published?
+   */
+  bool job_pending = false;
+
+  /**
+   * The result of the last job started in #worker.  It may only be
+   * accessed after JobThread::Wait().
+   */
+  Result result;
+
+  /**
+   * This thread solves the terrain reach while #worker solves the
+   * working reach.
+   */
+  JobThread reach_helper{"Reach"};
+
+  /**
+   * This thread runs Solve() while the calculation thread does the
+   * rest of its work; Finish() waits for it.  It is declared last so
+   * it is stopped before everything its job uses is destroyed.
+   */
+  JobThread worker{"Route"};
+
 public:
   RouteComputer(const Airspaces &airspace_database,
                 const ProtectedAirspaceWarningManager *warnings);
 
+  ~RouteComputer() noexcept {
+    worker.Wait();
+  }
+
   const ProtectedRoutePlanner &GetProtectedRoutePlanner() const {
     return protected_route_planner;
   }
@@ -43,9 +120,19 @@ public:
    * container.  Call this before modifying the container.
    */
   void ClearAirspaces() {
+    worker.Wait();
     route_planner.Reset();
   }
 
+  /**
+   * Enable or disable background solving.  With it, ProcessRoute()
+   * only starts the calculation, and Finish() publishes the results.
+   */
+  void SetParallel(bool _parallel) noexcept {
+    worker.Wait();
+    parallel = _parallel;
+  }
+
   void ResetFlight();
   void ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                     const GlideSettings &settings,
@@ -53,13 +140,27 @@ public:
                     const GlidePolar &glide_polar,
                     const GlidePolar &safety_polar);
 
+  /**
+   * Wait for the calculation started by ProcessRoute() (if any) and
+   * copy its results to #DerivedInfo.  Call this in the same tick,
+   * after doing other work, to solve the route in parallel to it.
+   */
+  void Finish(DerivedInfo &calculated) noexcept;
+
   void set_terrain(const RasterTerrain* _terrain);
 
 private:
   void TerrainWarning(const MoreData &basic,
                       DerivedInfo &calculated,
-                      const RoutePlannerConfig &config);
+                      Job &job);
 
   void Reach(const MoreData &basic, DerivedInfo &calculated,
-             const RoutePlannerConfig &config);
+             const RoutePlannerConfig &config, Job &job);
+
+  /**
+   * Do the expensive part of the job.  This may run in #worker.
+   */
+  Result Solve(const Job &job) noexcept;
+
+  static void Publish(const Result &result, DerivedInfo &calculated) noexcept;
 };
@@ -69,6 +69,14 @@ public:
   void ProcessMoreTask(const MoreData &basic, DerivedInfo &calculated,
                        const ComputerSettings &settings_computer);
 
+  /**
+   * Publish the results of the route calculation started by
+   * ProcessMoreTask(); see RouteComputer::Finish().
+   */
+  void FinishMoreTask(DerivedInfo &calculated) noexcept {
+    route.Finish(calculated);
+  }
+
   void ResetFlight(const bool full=true);
 
   void SetTerrain(const RasterTerrain* _terrain);
@@ -77,6 +85,10 @@ public:
     contest.SetIncremental(incremental);
   }
 
+  void SetRouteParallel(bool parallel) {
+    route.SetParallel(parallel);
+  }
+
   /**
    * Auto-create a task on takeoff that leads back home.
    */
@@ -763,9 +763,9 @@ DeviceDescriptor::ForwardLine(const char *line)
     s += "\r\n";
     p->Write(s.c_str());
     if (monitor != nullptr) {
-      monitor->DataReceived( {
+      monitor->DataReceived({
         reinterpret_cast<const std::byte *>(s.c_str()),
-        s.length() });
+        s.length() }, false);
     }
   }
 }
@@ -1538,10 +1538,10 @@ DeviceDescriptor::PortError(const char *msg) noexcept
 }
 
 bool
-DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
+DeviceDescriptor::RawDataReceived(std::span<const std::byte> s) noexcept
 {
   if (monitor != nullptr)
-    monitor->DataReceived(s);
+    monitor->DataReceived(s, false);
 
   // Pass data directly to drivers that use binary data protocols
   if (driver != nullptr && device != nullptr && driver->UsesRawData()) {
@@ -1561,8 +1561,17 @@ DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
     return true;
   }
 
-  if (!IsNMEAOut())
-    PortLineSplitter::DataReceived(s);
+  return IsNMEAOut();
+}
+
+bool
+DeviceDescriptor::DataReceived(std::span<const std::byte> s,
+                               bool writable) noexcept
+{
+  /* the monitor and raw drivers see the data before the line
+     splitter may modify it in place */
+  if (!RawDataReceived(s))
+    PortLineSplitter::DataReceived(s, writable);
 
   return true;
 }
@@ -621,8 +621,18 @@ private:
   void PortStateChanged() noexcept override;
   void PortError(const char *msg) noexcept override;
 
+  /**
+   * Pass the data to the port monitor and to drivers which parse raw
+   * data.
+   *
+   * @return true if the data has been consumed (or shall be
+   * ignored), false if it shall be split into lines
+   */
+  bool RawDataReceived(std::span<const std::byte> s) noexcept;
+
   /* virtual methods from DataHandler  */
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
 
   /* virtual methods from PortLineHandler */
   bool LineReceived(const char *line) noexcept override;
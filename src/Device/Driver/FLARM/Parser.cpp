@@ -31,10 +31,11 @@ FlarmDevice::ParsePFLAC(NMEAInputLine &line)
 bool
 FlarmDevice::ParseNMEA(const char *_line, [[maybe_unused]] NMEAInfo &info)
 {
-  if (!VerifyNMEAChecksum(_line))
+  const auto data = VerifyNMEAChecksumData(_line);
+  if (!data)
     return false;
 
-  NMEAInputLine line(_line);
+  NMEAInputLine line(*data);
 
   const auto type = line.ReadView();
   if (type == "$PFLAC"sv)
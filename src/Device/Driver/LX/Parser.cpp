@@ -5,6 +5,7 @@
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Info.hpp"
+#include "NMEA/SentenceType.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "RadioFrequency.hpp"
 #include "TransponderCode.hpp"
@@ -685,16 +686,17 @@ LXDevice::UpdateDeviceFlags(const DeviceInfo &device_info,
 bool
 LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
-  if (!VerifyNMEAChecksum(String))
+  const auto data = VerifyNMEAChecksumData(String);
+  if (!data)
     return false;
 
-  NMEAInputLine line(String);
+  NMEAInputLine line(*data);
 
-  const auto type = line.ReadView();
-  if (type == "$LXWP0"sv)
+  switch (MakeNMEASentenceType(line.ReadView())) {
+  case MakeNMEASentenceType("$LXWP0"):
     return LXWP0(line, info);
 
-  if (type == "$LXWP1"sv) {
+  case MakeNMEASentenceType("$LXWP1"): {
     DeviceInfo &device_info = mode == Mode::PASS_THROUGH
       ? info.secondary_device
       : info.device;
@@ -703,18 +705,17 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (type == "$LXWP2"sv)
+  case MakeNMEASentenceType("$LXWP2"):
     return LXWP2(line, info);
 
-  if (type == "$LXWP3"sv)
+  case MakeNMEASentenceType("$LXWP3"):
     return LXWP3(line, info);
 
-  if (type == "$PLXV0"sv) {
+  case MakeNMEASentenceType("$PLXV0"):
     is_colibri = false;
     return PLXV0(line, lxnav_vario_settings, info);
-  }
 
-  if (type == "$PLXVC"sv) {
+  case MakeNMEASentenceType("$PLXVC"):
     is_colibri = false;
     PLXVC(line, info, nano_settings, device_declaration, mutex);
 
@@ -728,17 +729,16 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
         vario_just_detected = true;
     }
     return true;
-  }
 
-  if (type == "$PLXVF"sv) {
+  case MakeNMEASentenceType("$PLXVF"):
     is_colibri = false;
     return PLXVF(line, info);
-  }
 
-  if (type == "$PLXVS"sv) {
+  case MakeNMEASentenceType("$PLXVS"):
     is_colibri = false;
     return PLXVS(line, info);
-  }
 
-  return false;
+  default:
+    return false;
+  }
 }
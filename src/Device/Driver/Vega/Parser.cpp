@@ -5,6 +5,7 @@
 #include "Message.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceType.hpp"
 
 #include <algorithm>
 
@@ -201,26 +202,37 @@ VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
   if (type.starts_with("$PD"sv))
     detected = true;
 
-  if (type == "$PDSWC"sv)
+  switch (MakeNMEASentenceType(type)) {
+  case MakeNMEASentenceType("$PDSWC"):
     return PDSWC(line, info, volatile_data);
-  else if (type == "$PDAAV"sv)
+
+  case MakeNMEASentenceType("$PDAAV"):
     return PDAAV(line, info);
-  else if (type == "$PDVSC"sv)
+
+  case MakeNMEASentenceType("$PDVSC"):
     return PDVSC(line, info);
-  else if (type == "$PDVDV"sv)
+
+  case MakeNMEASentenceType("$PDVDV"):
     return PDVDV(line, info);
-  else if (type == "$PDVDS"sv)
+
+  case MakeNMEASentenceType("$PDVDS"):
     return PDVDS(line, info);
-  else if (type == "$PDVVT"sv)
+
+  case MakeNMEASentenceType("$PDVVT"):
     return PDVVT(line, info);
-  else if (type == "$PDVSD"sv) {
+
+  case MakeNMEASentenceType("$PDVSD"): {
     const auto message = line.Rest();
     StaticString<256> buffer;
     buffer.SetASCII(message);
     Message::AddMessage(buffer);
     return true;
-  } else if (type == "$PDTSM"sv)
+  }
+
+  case MakeNMEASentenceType("$PDTSM"):
     return PDTSM(line, info);
-  else
+
+  default:
     return false;
+  }
 }
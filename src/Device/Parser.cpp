@@ -6,6 +6,7 @@
 #include "NMEA/Info.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceType.hpp"
 #include "Units/System.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
 #include "util/CharUtil.hxx"
@@ -35,57 +36,58 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
   if (string[0] != '$')
     return false;
 
-  if (!NMEAChecksum(string))
+  const auto data = VerifyNMEAChecksumData(string);
+  if (!data)
     return false;
 
-  NMEAInputLine line(string);
+  NMEAInputLine line(*data);
 
   const auto type = line.ReadView();
   if (type.size() < 6)
     return false;
 
   if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    const auto type2 = type.substr(3);
-
-    if (type2 == "GSA")
+    switch (MakeNMEASentenceType(type.substr(3))) {
+    case MakeNMEASentenceType("GSA"):
       return GSA(line, info);
 
-    if (type2 == "GLL")
+    case MakeNMEASentenceType("GLL"):
       return GLL(line, info);
 
-    if (type2 == "RMC")
+    case MakeNMEASentenceType("RMC"):
       return RMC(line, info);
 
-    if (type2 == "GGA")
+    case MakeNMEASentenceType("GGA"):
       return GGA(line, info);
 
-    if (type2 == "HDM")
+    case MakeNMEASentenceType("HDM"):
       return HDM(line, info);
 
-    if (type2 == "MWV")
+    case MakeNMEASentenceType("MWV"):
       return MWV(line, info);
+
+    default:
+      break;
+    }
   }
 
   // if (proprietary sentence) ...
   if (type[1] == 'P') {
-    const auto type2 = type.substr(1);
-
+    switch (MakeNMEASentenceType(type.substr(1))) {
     // Airspeed and vario sentence
-    if (type2 == "PTAS1")
+    case MakeNMEASentenceType("PTAS1"):
       return PTAS1(line, info);
 
     // FLARM sentences
-    if (type2 == "PFLAE") {
+    case MakeNMEASentenceType("PFLAE"):
       ParsePFLAE(line, info.flarm.error, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAV") {
+    case MakeNMEASentenceType("PFLAV"):
       ParsePFLAV(line, info.flarm.version, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAA") {
+    case MakeNMEASentenceType("PFLAA"): {
       RangeFilter range;
       range.horizontal=0;
       range.vertical=0;
@@ -93,31 +95,29 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
       return true;
     }
 
-    if (type2 == "PFLAU") {
+    case MakeNMEASentenceType("PFLAU"):
       ParsePFLAU(line, info.flarm.status, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAJ") {
+    case MakeNMEASentenceType("PFLAJ"):
       ParsePFLAJ(line, info.flarm.state, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAQ") {
+    case MakeNMEASentenceType("PFLAQ"):
       ParsePFLAQ(line, info.flarm.progress, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAM") {
+    case MakeNMEASentenceType("PFLAM"):
       ParsePFLAM(line);
       return true;
-    }
 
     // Garmin altitude sentence
-    if (type2 == "PGRMZ")
+    case MakeNMEASentenceType("PGRMZ"):
       return RMZ(line, info);
 
-    return false;
+    default:
+      return false;
+    }
   }
 
   return false;
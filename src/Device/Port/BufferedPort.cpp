@@ -74,10 +74,11 @@ BufferedPort::WaitRead(std::chrono::steady_clock::duration _timeout)
 }
 
 bool
-BufferedPort::DataReceived(std::span<const std::byte> s) noexcept
+BufferedPort::DataReceived(std::span<const std::byte> s,
+                           bool writable) noexcept
 {
   if (running) {
-    return handler.DataReceived(s);
+    return handler.DataReceived(s, writable);
   } else {
     const std::lock_guard lock{mutex};
 
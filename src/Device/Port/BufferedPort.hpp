@@ -46,5 +46,6 @@ public:
 
 protected:
   /* virtual methods from class DataHandler */
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
 };
@@ -76,7 +76,7 @@ NullPort::WaitRead([[maybe_unused]] std::chrono::steady_clock::duration timeout)
 }
 
 bool
-NullPort::DataReceived(std::span<const std::byte>) noexcept
+NullPort::DataReceived(std::span<const std::byte>, bool) noexcept
 {
   return true;
 }
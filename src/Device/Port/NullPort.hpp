@@ -30,5 +30,6 @@ public:
 
 private:
   /* virtual methods from class DataHandler */
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
 };
@@ -286,7 +286,7 @@ SerialPort::Run() noexcept
         continue;
     }
 
-    DataReceived({inbuf, dwBytesTransferred});
+    DataReceived({inbuf, dwBytesTransferred}, true);
   }
 
   Flush();
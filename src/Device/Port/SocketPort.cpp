@@ -81,7 +81,7 @@ try {
     return;
   }
 
-  DataReceived({input, std::size_t(nbytes)});
+  DataReceived({input, std::size_t(nbytes)}, true);
 } catch (...) {
   socket.Close();
   OnConnectionError();
@@ -462,5 +462,5 @@ TTYPort::OnSocketReady(unsigned) noexcept
     return;
   }
 
-  DataReceived({input, std::size_t(nbytes)});
+  DataReceived({input, std::size_t(nbytes)}, true);
 }
@@ -25,8 +25,27 @@ SanitiseLine(char *const begin, char *const end)
   std::replace_if(begin, end, IsInsaneChar, ' ');
 }
 
+inline bool
+PortLineSplitter::HandleLine(char *line, char *end) noexcept
+{
+  /* remove trailing whitespace, such as '\r' */
+  end = StripRight(line, end);
+  *end = 0;
+
+  SanitiseLine(line, end);
+
+  /* if there are NUL bytes in the line, skip to after the last
+     one, to avoid conflicts with NUL terminated C strings due to
+     binary garbage */
+  void *nul;
+  while ((nul = memchr(line, 0, end - line)) != nullptr)
+    line = (char *)nul + 1;
+
+  return LineReceived(line);
+}
+
 bool
-PortLineSplitter::DataReceived(std::span<const std::byte> s) noexcept
+PortLineSplitter::BufferData(std::span<const std::byte> s) noexcept
 {
   assert(!s.empty());
 
@@ -54,24 +73,63 @@ PortLineSplitter::DataReceived(std::span<const std::byte> s) noexcept
         /* no newline here: wait for more data */
         break;
 
-      char *end = line + strlen(line);
+      if (!HandleLine(line, line + strlen(line)))
+        return false;
+    }
+  } while (data < end);
+
+  return true;
+}
+
+bool
+PortLineSplitter::SplitInPlace(std::span<std::byte> s) noexcept
+{
+  assert(!s.empty());
+
+  char *data = (char *)s.data(), *const end = data + s.size();
 
-      /* remove trailing whitespace, such as '\r' */
-      end = StripRight(line, end);
+  if (!buffer.empty()) {
+    /* complete the partial line from the previous call in the
+       internal buffer */
+    char *newline = (char *)memchr(data, '\n', end - data);
+    if (newline == nullptr)
+      return BufferData(s);
 
-      SanitiseLine(line, end);
+    ++newline;
+    if (!BufferData({(const std::byte *)data, std::size_t(newline - data)}))
+      return false;
 
-      /* if there are NUL bytes in the line, skip to after the last
-         one, to avoid conflicts with NUL terminated C strings due to
-         binary garbage */
-      void *nul;
-      while ((nul = memchr(line, 0, end - line)) != nullptr)
-        line = (char *)nul + 1;
+    data = newline;
+  }
 
-      if (!LineReceived(line))
+  while (data < end) {
+    char *newline = (char *)memchr(data, '\n', end - data);
+    if (newline == nullptr)
+      /* keep the partial line for the next call */
+      return BufferData({(const std::byte *)data, std::size_t(end - data)});
+
+    char *next = newline + 1;
+
+    if (std::size_t(newline - data) >= buffer.GetCapacity()) {
+      /* this line would overflow the internal buffer; let
+         BufferData() apply its overflow handling */
+      if (!BufferData({(const std::byte *)data, std::size_t(next - data)}))
         return false;
-    }
-  } while (data < end);
+    } else if (!HandleLine(data, newline))
+      return false;
+
+    data = next;
+  }
 
   return true;
 }
+
+bool
+PortLineSplitter::DataReceived(std::span<const std::byte> s,
+                               bool writable) noexcept
+{
+  if (writable)
+    return SplitInPlace({const_cast<std::byte *>(s.data()), s.size()});
+  else
+    return BufferData(s);
+}
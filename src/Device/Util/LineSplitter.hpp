@@ -13,6 +13,31 @@ class PortLineSplitter : public DataHandler, protected PortLineHandler {
   Buffer buffer;
 
 public:
-  /* virtual methods from class DataHandler */
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  /**
+   * If the buffer is writable, complete lines are parsed in place,
+   * without copying them to the internal buffer; only a partial line
+   * at the end is copied.
+   */
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
+
+private:
+  /**
+   * Copy the data to the internal buffer and pass each complete line
+   * to HandleLine().
+   */
+  bool BufferData(std::span<const std::byte> s) noexcept;
+
+  /**
+   * Parse complete lines in place.
+   */
+  bool SplitInPlace(std::span<std::byte> s) noexcept;
+
+  /**
+   * Clean up a line and pass it to LineReceived().
+   *
+   * @param end the end of the line; will be overwritten with a null
+   * terminator
+   */
+  bool HandleLine(char *line, char *end) noexcept;
 };
@@ -39,7 +39,7 @@ public:
     :terminal(_terminal) {}
   virtual ~PortTerminalBridge() {}
 
-  bool DataReceived(std::span<const std::byte> s) noexcept {
+  bool DataReceived(std::span<const std::byte> s, bool) noexcept override {
     {
       const std::lock_guard lock{mutex};
       buffer.Shift();
@@ -18,6 +18,7 @@ enum ControlIndex {
   GliderScreenPosition,
   MaxAutoZoomDistance,
   PAGES_DISTINCT_ZOOM,
+  StaticLayerCache,
 };
 
 static constexpr StaticEnumChoice orientation_list[] = {
@@ -129,6 +130,13 @@ MapDisplayConfigPanel::Prepare(ContainerWindow &parent,
              page_settings.distinct_zoom);
   SetExpertRow(PAGES_DISTINCT_ZOOM);
 
+#ifdef ENABLE_OPENGL
+  AddBoolean(_("Cache terrain and topography"),
+             _("Render terrain and topography into an off-screen buffer and reuse it while the map moves and rotates. This makes drawing faster (e.g. while circling) at the cost of a slightly blurred map when it is rotated."),
+             settings_map.static_layer_cache_enabled);
+  SetExpertRow(StaticLayerCache);
+#endif
+
   UpdateVisibilities();
 }
 
@@ -163,6 +171,11 @@ MapDisplayConfigPanel::Save(bool &_changed) noexcept
   changed |= SaveValue(PAGES_DISTINCT_ZOOM, ProfileKeys::PagesDistinctZoom,
                        page_settings.distinct_zoom);
 
+#ifdef ENABLE_OPENGL
+  changed |= SaveValue(StaticLayerCache, ProfileKeys::StaticLayerCache,
+                       settings_map.static_layer_cache_enabled);
+#endif
+
   _changed |= changed;
 
   return true;
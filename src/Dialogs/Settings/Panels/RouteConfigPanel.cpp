@@ -18,6 +18,7 @@ enum ControlIndex {
   empty_spacer,
   TurningReach,
   ReachPolarMode,
+  ReachIncremental,
   FinalGlideTerrain,
 };
 
@@ -52,6 +53,7 @@ RouteConfigPanel::ShowReachControls(bool show)
 {
   SetRowVisible(FinalGlideTerrain, show);
   SetRowVisible(ReachPolarMode, show);
+  SetRowVisible(ReachIncremental, show);
 }
 
 void
@@ -137,6 +139,13 @@ RouteConfigPanel::Prepare(ContainerWindow &parent,
           reach_polar_list, (unsigned)route_planner.reach_polar_mode);
   SetExpertRow(ReachPolarMode);
 
+  AddBoolean(_("Incremental reach"),
+             _("When enabled, the reach is updated from the previous calculation while the glider "
+                 "moves, instead of being calculated from scratch each time.  This uses less CPU, "
+                 "but close to terrain obstacles the reach may differ slightly."),
+             route_planner.reach_incremental);
+  SetExpertRow(ReachIncremental);
+
   static constexpr StaticEnumChoice final_glide_terrain_list[] = {
     { FeaturesSettings::FinalGlideTerrain::OFF, N_("Off"),
       N_("Disables the reach display.") },
@@ -173,6 +182,9 @@ RouteConfigPanel::Save(bool &_changed) noexcept
   changed |= SaveValueEnum(ReachPolarMode, ProfileKeys::ReachPolarMode,
                            route_planner.reach_polar_mode);
 
+  changed |= SaveValue(ReachIncremental, ProfileKeys::ReachIncremental,
+                       route_planner.reach_incremental);
+
   changed |= SaveValueEnum(FinalGlideTerrain, ProfileKeys::FinalGlideTerrain,
                            settings_computer.features.final_glide_terrain);
 
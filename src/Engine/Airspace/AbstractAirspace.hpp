@@ -247,6 +247,10 @@ public:
     days_of_operation = mask;
   }
 
+  AirspaceActivity GetDays() const noexcept {
+    return days_of_operation;
+  }
+
   /**
    * Get asclass of airspace
    *
@@ -414,7 +418,7 @@ public:
 
 protected:
   /** Project border */
-  void Project(const FlatProjection &tp) noexcept;
+  virtual void Project(const FlatProjection &tp) noexcept;
 
 private:
   /**
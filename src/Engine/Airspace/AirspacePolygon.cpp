@@ -24,6 +24,26 @@ AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts) noexcept
     m_border.emplace_back(p_start);
 
   is_convex = TriState::UNKNOWN;
+
+  UpdateIndex();
+}
+
+void
+AirspacePolygon::UpdateIndex() noexcept
+{
+  if (m_border.size() >= PolygonIndex::MIN_SIZE)
+    index = std::make_unique<PolygonIndex>(m_border);
+  else
+    index.reset();
+}
+
+void
+AirspacePolygon::Project(const FlatProjection &projection) noexcept
+{
+  AbstractAirspace::Project(projection);
+
+  if (index)
+    index->Project(m_border);
 }
 
 const GeoPoint
@@ -55,6 +75,9 @@ AirspacePolygon::GetCenter() const noexcept
 bool
 AirspacePolygon::Inside(const GeoPoint &loc) const noexcept
 {
+  if (index)
+    return index->IsInside(loc);
+
   return m_border.IsInside(loc);
 }
 
@@ -67,13 +90,19 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
 
   AirspaceIntersectSort sorter(start, *this);
 
-  for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
-
-    const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
+  const auto check_edge = [&](std::size_t i){
+    const FlatRay r_seg(m_border[i].GetFlatLocation(),
+                        m_border[i + 1].GetFlatLocation());
     auto t = ray.DistinctIntersection(r_seg);
     if (t >= 0)
       sorter.add(t, projection.Unproject(ray.Parametric(t)));
-  }
+  };
+
+  if (index)
+    index->VisitEdgesNear(ray.point, ray.point + ray.vector, check_edge);
+  else
+    for (std::size_t i = 0; i + 1 < m_border.size(); ++i)
+      check_edge(i);
 
   return sorter.all();
 }
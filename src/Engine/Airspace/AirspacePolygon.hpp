@@ -4,6 +4,9 @@
 #pragma once
 
 #include "AbstractAirspace.hpp"
+#include "Geo/PolygonIndex.hpp"
+
+#include <memory>
 #include <vector>
 
 #ifdef DO_PRINT
@@ -12,6 +15,12 @@
 
 /** General polygon form airspace */
 class AirspacePolygon final : public AbstractAirspace {
+  /**
+   * Speeds up Inside() and Intersects() for large polygons; nullptr
+   * if the polygon is small.
+   */
+  std::unique_ptr<PolygonIndex> index;
+
 public:
   /**
    * Constructor.  For testing, pts vector is a cloud of points,
@@ -29,6 +38,7 @@ public:
   void MakeConvex() noexcept {
     m_border.PruneInterior();
     is_convex = TriState::TRUE;
+    UpdateIndex();
   }
 
   /* virtual methods from class AbstractAirspace */
@@ -41,6 +51,12 @@ public:
   GeoPoint ClosestPoint(const GeoPoint &loc,
                         const FlatProjection &projection) const noexcept override;
 
+protected:
+  void Project(const FlatProjection &tp) noexcept override;
+
+private:
+  void UpdateIndex() noexcept;
+
 public:
 #ifdef DO_PRINT
   friend std::ostream &operator<<(std::ostream &f,
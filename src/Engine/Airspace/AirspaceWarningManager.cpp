@@ -9,8 +9,24 @@
 #include "AirspaceAircraftPerformance.hpp"
 #include "Task/Stats/TaskStats.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 static constexpr double CRUISE_FILTER_FACT = 0.5;
 
+/**
+ * The longest time an airspace which did not cause a warning may go
+ * without being checked again.
+ */
+static constexpr FloatDuration MAX_RECHECK_INTERVAL = std::chrono::seconds{5};
+
+/**
+ * If the track or the ground speed [m/s] differs more than this from
+ * the values the schedule was built for, it is discarded.
+ */
+static constexpr Angle MAX_TRACK_CHANGE = Angle::Degrees(10);
+static constexpr double MAX_SPEED_CHANGE = 5;
+
 AirspaceWarningManager::AirspaceWarningManager(const AirspaceWarningConfig &_config,
                                                const Airspaces &_airspaces)
   :airspaces(_airspaces)
@@ -38,6 +54,9 @@ AirspaceWarningManager::SetConfig(const AirspaceWarningConfig &_config)
   if (modified_warning_time) {
     SetPredictionTimeGlide(config.warning_time);
     SetPredictionTimeFilter(config.warning_time);
+
+    /* the slack of all scheduled items is obsolete */
+    schedule.clear();
   }
 }
 
@@ -48,6 +67,10 @@ AirspaceWarningManager::Reset(const AircraftState &state)
   warnings.clear();
   cruise_filter.Reset(state);
   circling_filter.Reset(state);
+
+  schedule.clear();
+  clock = {};
+  statistics.Clear();
 }
 
 void 
@@ -114,6 +137,30 @@ AirspaceWarningManager::Update(const AircraftState& state,
     return false;
   }
 
+  /* without time slicing, there is no schedule and no statistics to
+     maintain */
+  std::chrono::steady_clock::time_point start_time;
+  if (time_slicing) {
+    start_time = std::chrono::steady_clock::now();
+
+    statistics.evaluations = statistics.skipped = statistics.deferred = 0;
+    statistics.max_age = {};
+
+    if (airspaces.GetSerial() != schedule_serial ||
+        !state.track.CompareRoughly(schedule_track, MAX_TRACK_CHANGE) ||
+        fabs(state.ground_speed - schedule_speed) > MAX_SPEED_CHANGE) {
+      /* the airspace objects may have been replaced, or the time to
+         intercept of all scheduled items was calculated for a
+         different course */
+      schedule.clear();
+      schedule_serial = airspaces.GetSerial();
+      schedule_track = state.track;
+      schedule_speed = state.ground_speed;
+    }
+
+    clock += dt;
+  }
+
   // save old state
   for (auto &w : warnings)
     w.SaveState();
@@ -124,6 +171,9 @@ AirspaceWarningManager::Update(const AircraftState& state,
   UpdateFilter(state, circling);
   UpdateTask(state, glide_polar, task_stats);
 
+  if (time_slicing)
+    PruneSchedule();
+
   // action changes
   for (auto it = warnings.begin(), end = warnings.end(); it != end;) {
     if (it->WarningLive(config.acknowledgement_time, dt)) {
@@ -143,9 +193,28 @@ AirspaceWarningManager::Update(const AircraftState& state,
   if (changed)
     ++serial;
 
+  if (time_slicing) {
+    statistics.worst_age = std::max(statistics.worst_age,
+                                    statistics.max_age);
+    statistics.duration = std::chrono::steady_clock::now() - start_time;
+    statistics.worst_duration = std::max(statistics.worst_duration,
+                                         statistics.duration);
+  }
+
   return changed;
 }
 
+void
+AirspaceWarningManager::PruneSchedule() noexcept
+{
+  std::erase_if(schedule, [](const auto &i){
+    return !i.second.seen;
+  });
+
+  for (auto &i : schedule)
+    i.second.seen = false;
+}
+
 /**
  * Class used temporarily to check intersections with warning system
  */
@@ -161,6 +230,12 @@ class AirspaceIntersectionWarningVisitor final
   const double max_alt;
   bool mode_inside = false;
 
+  /**
+   * The result of the last Visit() call.
+   */
+  AirspaceInterceptSolution solution;
+  bool warning_found;
+
 public:
   /**
    * Constructor
@@ -190,42 +265,56 @@ public:
   }
 
   /**
-   * Check whether this intersection should be added to, or updated in, the warning manager
-   *
-   * @param airspace Airspace corresponding to current intersection
+   * Check whether this airspace may be added to, or updated in, the
+   * warning manager at all.  This performs only cheap checks, no
+   * geometry.
    */
-  void Intersection(ConstAirspacePtr &airspace_ptr) noexcept {
-    const auto &airspace = *airspace_ptr;
+  [[gnu::pure]]
+  bool IsRelevant(const AbstractAirspace &airspace) const noexcept {
     if (!airspace.IsActive())
-      return; // ignore inactive airspaces completely
+      return false; // ignore inactive airspaces completely
 
     if (!(warning_manager.GetConfig().IsClassEnabled(airspace.GetClassOrType()) || 
 	      warning_manager.GetConfig().IsClassEnabled(airspace.GetTypeOrClass())) ||
         ExcludeAltitude(airspace))
-      return;
+      return false;
 
-    AirspaceWarning *warning = warning_manager.GetWarningPtr(airspace);
-    if (warning == nullptr || warning->IsStateAccepted(warning_state)) {
+    const AirspaceWarning *warning = warning_manager.GetWarningPtr(airspace);
+    return warning == nullptr || warning->IsStateAccepted(warning_state);
+  }
 
-      AirspaceInterceptSolution solution;
+  /**
+   * Check whether this intersection should be added to, or updated in, the warning manager
+   *
+   * @param airspace Airspace corresponding to current intersection
+   */
+  void Intersection(ConstAirspacePtr &airspace_ptr) noexcept {
+    const auto &airspace = *airspace_ptr;
 
-      if (mode_inside) {
-        solution = airspace.Intercept(state, perf,
-                                      state.location, state.location);
-      } else {
-        solution = Intercept(airspace, state, perf);
-      }
-      if (!solution.IsValid())
-        return;
-      if (solution.elapsed_time > max_time)
-        return;
+    solution = AirspaceInterceptSolution::Invalid();
+    warning_found = false;
 
-      if (warning == nullptr)
-        warning = warning_manager.GetNewWarningPtr(std::move(airspace_ptr));
+    if (!IsRelevant(airspace))
+      return;
 
-      warning->UpdateSolution(warning_state, solution);
-      found = true;
+    if (mode_inside) {
+      solution = airspace.Intercept(state, perf,
+                                    state.location, state.location);
+    } else {
+      solution = Intercept(airspace, state, perf);
     }
+    if (!solution.IsValid())
+      return;
+    if (solution.elapsed_time > max_time)
+      return;
+
+    AirspaceWarning *warning = warning_manager.GetWarningPtr(airspace);
+    if (warning == nullptr)
+      warning = warning_manager.GetNewWarningPtr(std::move(airspace_ptr));
+
+    warning->UpdateSolution(warning_state, solution);
+    found = true;
+    warning_found = true;
   }
 
   void Visit(ConstAirspacePtr as) noexcept override {
@@ -241,12 +330,27 @@ public:
     return found;
   }
 
+  /**
+   * The intercept solution calculated by the last Visit() call
+   * (invalid if the airspace was not relevant).
+   */
+  const AirspaceInterceptSolution &GetSolution() const noexcept {
+    return solution;
+  }
+
+  /**
+   * Did the last Visit() call add or update a warning?
+   */
+  bool IsWarningFound() const noexcept {
+    return warning_found;
+  }
+
   void SetMode(bool m) {
     mode_inside = m;
   }
 
 private:
-  bool ExcludeAltitude(const AbstractAirspace& airspace) {
+  bool ExcludeAltitude(const AbstractAirspace& airspace) const noexcept {
     if (max_alt <= 0)
       return false;
 
@@ -285,11 +389,115 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
                                              warning_state, max_time_limit,
                                              ceiling);
 
-  airspaces.VisitIntersecting(state.location, location_predicted, visitor);
+  const auto &projection = GetProjection();
+
+  if (!time_slicing) {
+    /* check all candidates in every update, without a schedule */
+    for (const auto &i : airspaces.QueryIntersecting(state.location,
+                                                     location_predicted)) {
+      if (!visitor.IsRelevant(i.GetAirspace()))
+        continue;
+
+      if (visitor.SetIntersections(i.GetAirspace().Intersects(state.location,
+                                                              location_predicted,
+                                                              projection)))
+        visitor.Visit(i.GetAirspacePtr());
+    }
+
+    visitor.SetMode(true);
+
+    for (const auto &i : airspaces.QueryInside(state.location))
+      visitor.Visit(i.GetAirspacePtr());
+
+    return visitor.Found();
+  }
+
+  const auto evaluate = [&](ConstAirspacePtr airspace, ScheduleItem &item){
+    ++statistics.evaluations;
+
+    AirspaceInterceptSolution solution = AirspaceInterceptSolution::Invalid();
+    item.warning = false;
+
+    if (visitor.SetIntersections(airspace->Intersects(state.location,
+                                                      location_predicted,
+                                                      projection))) {
+      visitor.Visit(std::move(airspace));
+      solution = visitor.GetSolution();
+      item.warning = visitor.IsWarningFound();
+    }
+
+    item.evaluated = clock;
+
+    if (solution.IsValid()) {
+      /* the time to intercept decreases by at most the time which
+         passes (unless the aircraft changes course), so re-checking
+         after half of the slack catches it before it reaches the
+         warning time */
+      const auto slack = solution.elapsed_time - max_time_limit;
+      item.deadline = clock + slack;
+      item.due = clock + std::clamp(slack / 2, FloatDuration{},
+                                    MAX_RECHECK_INTERVAL);
+    } else {
+      item.deadline = item.due = clock + MAX_RECHECK_INTERVAL;
+    }
+  };
+
+  due.clear();
+
+  for (const auto &i : airspaces.QueryIntersecting(state.location,
+                                                   location_predicted)) {
+    if (!visitor.IsRelevant(i.GetAirspace()))
+      continue;
+
+    auto [it, is_new] =
+      schedule.try_emplace(ScheduleKey{&i.GetAirspace(), warning_state});
+    ScheduleItem &item = it->second;
+    item.seen = true;
+
+    if (is_new || item.warning)
+      /* always check new candidates and current warnings */
+      evaluate(i.GetAirspacePtr(), item);
+    else if (item.due <= clock)
+      due.emplace_back(i.GetAirspacePtr(), &item);
+    else {
+      ++statistics.skipped;
+      statistics.max_age = std::max(statistics.max_age,
+                                    clock - item.evaluated);
+    }
+  }
+
+  /* re-check the most urgent ones first, as long as the budget
+     allows */
+  std::sort(due.begin(), due.end(), [](const auto &a, const auto &b){
+    return a.second->deadline < b.second->deadline;
+  });
+
+  for (auto &[airspace, item] : due) {
+    /* the budget may defer a re-check by at most
+       MAX_RECHECK_INTERVAL */
+    if (statistics.evaluations < evaluation_budget ||
+        clock - item->due >= MAX_RECHECK_INTERVAL) {
+      evaluate(std::move(airspace), *item);
+    } else {
+      ++statistics.deferred;
+      ++statistics.skipped;
+      statistics.max_age = std::max(statistics.max_age,
+                                    clock - item->evaluated);
+    }
+  }
+
+  due.clear();
+
+  /* airspaces the aircraft is inside of are checked in every
+     update */
 
   visitor.SetMode(true);
 
   for (const auto &i : airspaces.QueryInside(state.location)) {
+    if (!visitor.IsRelevant(i.GetAirspace()))
+      continue;
+
+    ++statistics.evaluations;
     visitor.Visit(i.GetAirspacePtr());
   }
 
@@ -393,6 +601,9 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
 
     if (warning == nullptr ||
         warning->IsStateAccepted(AirspaceWarning::WARNING_INSIDE)) {
+      if (time_slicing)
+        ++statistics.evaluations;
+
       GeoPoint c = airspace->ClosestPoint(state.location, GetProjection());
       const AirspaceAircraftPerformance perf_glide(glide_polar);
       const AirspaceInterceptSolution solution =
@@ -9,7 +9,12 @@
 #include "time/FloatDuration.hxx"
 #include "util/Serial.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 class TaskStats;
 class GlidePolar;
@@ -17,6 +22,54 @@ class Airspaces;
 class FlatProjection;
 class AirspaceAircraftPerformance;
 
+/**
+ * Instrumentation of AirspaceWarningManager::Update().  It is only
+ * maintained with time slicing, see
+ * AirspaceWarningManager::SetTimeSlicing().
+ */
+struct AirspaceWarningStatistics {
+  /**
+   * The number of intercept solutions calculated during the last
+   * update.
+   */
+  unsigned evaluations;
+
+  /**
+   * The number of candidates during the last update whose previous
+   * (non-warning) result was still considered valid.
+   */
+  unsigned skipped;
+
+  /**
+   * The number of re-checks during the last update which were due
+   * but were postponed because the budget was exhausted.
+   */
+  unsigned deferred;
+
+  /**
+   * The age of the oldest result which was reused during the last
+   * update, i.e. the worst-case latency of a skipped candidate.
+   */
+  FloatDuration max_age;
+
+  /**
+   * The largest #max_age since the last reset.
+   */
+  FloatDuration worst_age;
+
+  /**
+   * The wall time of the last update, and the largest one since the
+   * last reset.
+   */
+  std::chrono::steady_clock::duration duration, worst_duration;
+
+  void Clear() noexcept {
+    evaluations = skipped = deferred = 0;
+    max_age = worst_age = {};
+    duration = worst_duration = {};
+  }
+};
+
 /**
  * Class to detect and track airspace warnings
  *
@@ -48,9 +101,99 @@ class AirspaceWarningManager {
    */
   Serial serial;
 
+  /**
+   * Identifies one airspace in one of the predicted passes (glide,
+   * filter, task).
+   */
+  struct ScheduleKey {
+    const AbstractAirspace *airspace;
+    AirspaceWarning::State state;
+
+    constexpr bool operator==(const ScheduleKey &) const noexcept = default;
+
+    struct Hash {
+      std::size_t operator()(const ScheduleKey &key) const noexcept {
+        return std::hash<const AbstractAirspace *>{}(key.airspace) ^
+          static_cast<std::size_t>(key.state);
+      }
+    };
+  };
+
+  /**
+   * Scheduling state of a #ScheduleKey.  Airspaces which were found
+   * to be far away (in time) are re-checked less frequently.
+   */
+  struct ScheduleItem {
+    /**
+     * When the intercept solution was last calculated (see #clock).
+     */
+    FloatDuration evaluated;
+
+    /**
+     * When it needs to be calculated again.
+     */
+    FloatDuration due;
+
+    /**
+     * The estimated time when the time to intercept drops below the
+     * maximum warning time; used to prioritise re-checks.
+     */
+    FloatDuration deadline;
+
+    /**
+     * Did the last calculation produce a warning?  Then it is
+     * re-checked in every update.
+     */
+    bool warning;
+
+    /**
+     * Was this a candidate in the current update?  Items which are
+     * not get removed, so an airspace is checked immediately when it
+     * becomes a candidate again.
+     */
+    bool seen;
+  };
+
+  std::unordered_map<ScheduleKey, ScheduleItem, ScheduleKey::Hash> schedule;
+
+  /**
+   * The #Airspaces serial the #schedule was built for.
+   */
+  Serial schedule_serial;
+
+  /**
+   * The sum of all Update() time steps since the last reset; the
+   * time base of the #schedule.
+   */
+  FloatDuration clock{};
+
+  /**
+   * The track and ground speed the #schedule was built for.  The
+   * re-check times assume that the aircraft keeps them.
+   */
+  Angle schedule_track = Angle::Zero();
+  double schedule_speed = 0;
+
+  /**
+   * The maximum number of intercept solutions per update, see
+   * SetTimeSlicing().
+   */
+  unsigned evaluation_budget = DEFAULT_EVALUATION_BUDGET;
+
+  bool time_slicing = false;
+
+  AirspaceWarningStatistics statistics;
+
+  /**
+   * Temporary buffer for UpdatePredicted().
+   */
+  std::vector<std::pair<ConstAirspacePtr, ScheduleItem *>> due;
+
 public:
   using const_iterator = AirspaceWarningList::const_iterator;
 
+  static constexpr unsigned DEFAULT_EVALUATION_BUDGET = 16;
+
   /** 
    * Default constructor
    * 
@@ -104,6 +247,32 @@ public:
               const TaskStats &task_stats,
               bool circling, std::chrono::duration<unsigned> dt) noexcept;
 
+  /**
+   * Configure the time slicing of Update().  If enabled, airspaces
+   * which are far away (in time) are re-checked less frequently, and
+   * the number of intercept solutions per update is limited to the
+   * given budget, prioritised by time to intercept.  Airspaces the
+   * aircraft is inside of, airspaces which caused a warning in the
+   * previous update and new candidates are always checked, even if
+   * that exceeds the budget.  The budget delays a re-check by at most
+   * a few seconds, and all re-check times are discarded when the
+   * track or the ground speed changes significantly.
+   *
+   * If disabled (the default), all candidates are checked in every
+   * update, and neither the schedule nor the statistics are
+   * maintained.
+   */
+  void SetTimeSlicing(bool enabled,
+                      unsigned budget = DEFAULT_EVALUATION_BUDGET) noexcept {
+    time_slicing = enabled;
+    evaluation_budget = budget;
+    schedule.clear();
+  }
+
+  const AirspaceWarningStatistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
   /**
    * Adjust time of glide predictor
    *
@@ -256,4 +425,9 @@ private:
                        const AirspaceAircraftPerformance &perf,
                        const AirspaceWarning::State warning_state,
                        FloatDuration max_time) noexcept;
+
+  /**
+   * Remove #schedule items which were not seen in this update.
+   */
+  void PruneSchedule() noexcept;
 };
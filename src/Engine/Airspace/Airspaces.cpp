@@ -11,6 +11,8 @@
 #include <boost/geometry/strategies/strategies.hpp>
 #include <boost/geometry/geometries/segment.hpp>
 
+#include <vector>
+
 namespace bgi = boost::geometry::index;
 
 Airspaces::~Airspaces() noexcept = default;
@@ -83,9 +85,20 @@ Airspaces::Optimise() noexcept
     airspace_tree.clear();
   }
 
-  for (auto &i : tmp_as) {
-    Airspace as(std::move(i), task_projection);
-    airspace_tree.insert(as);
+  if (airspace_tree.empty()) {
+    /* bulk-load the tree; this is much faster than inserting one
+       by one, and the packed tree is faster to query */
+    std::vector<Airspace> v;
+    v.reserve(tmp_as.size());
+    for (auto &i : tmp_as)
+      v.emplace_back(std::move(i), task_projection);
+
+    airspace_tree = AirspaceTree(v);
+  } else {
+    for (auto &i : tmp_as) {
+      Airspace as(std::move(i), task_projection);
+      airspace_tree.insert(as);
+    }
   }
 
   tmp_as.clear();
@@ -62,6 +62,15 @@ public:
    */
   void Add(AirspacePtr airspace) noexcept;
 
+  /**
+   * Returns the airspaces which were added since the last Optimise()
+   * call, i.e. which are not yet in the tree, in the order they were
+   * added.
+   */
+  const std::deque<AirspacePtr> &GetPending() const noexcept {
+    return tmp_as;
+  }
+
   /**
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <functional>
+#include <span>
+
+/**
+ * Runs a number of independent contest solvers, possibly in parallel
+ * threads.  This interface allows #ContestManager to use threads
+ * without depending on a thread library.
+ */
+class ContestExecutor {
+public:
+  /**
+   * Run all jobs and return after the last one has finished.  The
+   * jobs must not throw.
+   */
+  virtual void Run(std::span<const std::function<void()>> jobs) noexcept = 0;
+};
@@ -2,6 +2,11 @@
 // Copyright The XCSoar Project
 
 #include "ContestManager.hpp"
+#include "ContestExecutor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
 
 ContestManager::ContestManager(const Contest _contest,
                                const Trace &trace_full,
@@ -27,6 +32,9 @@ ContestManager::ContestManager(const Contest _contest,
    charron_small(trace_triangle, false),
    charron_large(trace_triangle, true)
 {
+  for (std::size_t i = 0; i < MAX_JOBS; ++i)
+    functions[i] = [this, i]{ RunJob(i); };
+
   Reset();
 }
 
@@ -137,7 +145,10 @@ RunContest(AbstractContest &_contest,
 {
   // run solver, return immediately if further processing is required
   // by subsequent calls
+  const auto start = std::chrono::steady_clock::now();
   SolverResult r = _contest.Solve(exhaustive);
+  _contest.AddSolveTime(std::chrono::steady_clock::now() - start);
+
   if (r != SolverResult::VALID)
     return false;
 
@@ -153,6 +164,41 @@ RunContest(AbstractContest &_contest,
   return true;
 }
 
+void
+ContestManager::RunJob(std::size_t i) noexcept
+{
+  const ContestJob &job = current_jobs[i];
+  current_valid[i] = RunContest(job.solver, stats.result[job.index],
+                                stats.solution[job.index],
+                                current_exhaustive);
+}
+
+bool
+ContestManager::RunContests(std::span<const ContestJob> jobs,
+                            bool exhaustive) noexcept
+{
+  assert(jobs.size() <= MAX_JOBS);
+
+  /* each job writes only to its own slot, and the return values are
+     combined in a fixed order after all have finished; this makes
+     the result independent of the scheduling */
+  current_jobs = jobs;
+  current_exhaustive = exhaustive;
+  current_valid = {};
+
+  const std::span f{functions.data(), jobs.size()};
+  if (executor != nullptr)
+    executor->Run(f);
+  else
+    for (const auto &i : f)
+      i();
+
+  current_jobs = {};
+
+  return std::find(current_valid.begin(), current_valid.end(), true) !=
+    current_valid.end();
+}
+
 bool
 ContestManager::UpdateIdle(bool exhaustive) noexcept
 {
@@ -188,11 +234,10 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::OLC_PLUS:
-    retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(olc_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunContests(std::array<ContestJob, 2>{{
+        {olc_classic, 0},
+        {olc_fai, 1},
+      }}, exhaustive);
 
     if (retval) {
       olc_plus.Feed(stats.result[0], stats.solution[0],
@@ -205,14 +250,11 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::DMST:
-    retval = RunContest(dmst_quad, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(dmst_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
-
-    retval |= RunContest(dmst_or, stats.result[2],
-                         stats.solution[2], exhaustive);
+    retval = RunContests(std::array<ContestJob, 3>{{
+        {dmst_quad, 0},
+        {dmst_triangle, 1},
+        {dmst_or, 2},
+      }}, exhaustive);
 
     if (retval) {
       dmst_free.Feed(stats.result[0], stats.solution[0],
@@ -225,17 +267,17 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::XCONTEST:
-    retval = RunContest(xcontest_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(xcontest_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunContests(std::array<ContestJob, 2>{{
+        {xcontest_free, 0},
+        {xcontest_triangle, 1},
+      }}, exhaustive);
     break;
 
   case Contest::DHV_XC:
-    retval = RunContest(dhv_xc_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(dhv_xc_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunContests(std::array<ContestJob, 2>{{
+        {dhv_xc_free, 0},
+        {dhv_xc_triangle, 1},
+      }}, exhaustive);
     break;
 
   case Contest::SIS_AT:
@@ -244,14 +286,11 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::WEGLIDE_FREE:
-    retval = RunContest(weglide_distance, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(weglide_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
-
-    retval |= RunContest(weglide_or, stats.result[2],
-                         stats.solution[2], exhaustive);
+    retval = RunContests(std::array<ContestJob, 3>{{
+        {weglide_distance, 0},
+        {weglide_fai, 1},
+        {weglide_or, 2},
+      }}, exhaustive);
 
     if (retval) {
       weglide_free.Feed(stats.result[0], stats.solution[0],
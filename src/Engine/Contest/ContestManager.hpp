@@ -23,7 +23,12 @@
 #include "Solvers/Charron.hpp"
 #include "ContestStatistics.hpp"
 
+#include <array>
+#include <functional>
+#include <span>
+
 class Trace;
+class ContestExecutor;
 
 /**
  * Special task holder for Online Contest calculations
@@ -57,6 +62,12 @@ class ContestManager
   Charron charron_small;
   Charron charron_large;
 
+  /**
+   * Runs independent solvers in parallel.  If nullptr, they are run
+   * one after another in the calling thread.
+   */
+  ContestExecutor *executor = nullptr;
+
 public:
   /**
    * Base constructor.
@@ -78,6 +89,9 @@ public:
                  const Trace &trace_sprint,
                  bool predict_triangle=false) noexcept;
 
+  ContestManager(const ContestManager &) = delete;
+  ContestManager &operator=(const ContestManager &) = delete;
+
   void SetIncremental(bool incremental) noexcept;
 
   /**
@@ -91,6 +105,17 @@ public:
 
   void SetHandicap(unsigned handicap) noexcept;
 
+  /**
+   * Run independent solvers (e.g. the three DMSt rules) with the
+   * given #ContestExecutor.  Pass nullptr to run everything in the
+   * calling thread.  The results do not depend on this.
+   *
+   * The executor must not be destroyed before this object.
+   */
+  void SetExecutor(ContestExecutor *_executor) noexcept {
+    executor = _executor;
+  }
+
   /**
    * Update internal states (non-essential) for housework,
    * or where functions are slow and would cause loss to real-time performance.
@@ -130,4 +155,82 @@ public:
   const ContestStatistics &GetStats() const noexcept {
     return stats;
   }
+
+  /**
+   * Invoke the given function for each solver which has been used,
+   * with its name, the total wall time spent
+   * in it and the number of calls.
+   */
+  template<typename F>
+  void VisitTimings(F &&f) const noexcept {
+    const std::pair<const char *, const AbstractContest &> solvers[] = {
+      {"OLC sprint", olc_sprint},
+      {"OLC FAI", olc_fai},
+      {"OLC classic", olc_classic},
+      {"OLC league", olc_league},
+      {"OLC plus", olc_plus},
+      {"DMSt quadrilateral", dmst_quad},
+      {"DMSt triangle", dmst_triangle},
+      {"DMSt out and return", dmst_or},
+      {"DMSt free", dmst_free},
+      {"XContest free", xcontest_free},
+      {"XContest triangle", xcontest_triangle},
+      {"DHV-XC free", dhv_xc_free},
+      {"DHV-XC triangle", dhv_xc_triangle},
+      {"SIS-AT", sis_at},
+      {"WeGlide free", weglide_free},
+      {"WeGlide distance", weglide_distance},
+      {"WeGlide FAI", weglide_fai},
+      {"WeGlide out and return", weglide_or},
+      {"Charron small", charron_small},
+      {"Charron large", charron_large},
+    };
+
+    for (const auto &[name, solver] : solvers)
+      if (solver.GetSolveCount() > 0)
+        f(name, solver.GetSolveTime(), solver.GetSolveCount());
+  }
+
+private:
+  struct ContestJob {
+    AbstractContest &solver;
+
+    /**
+     * The index in ContestStatistics::result and
+     * ContestStatistics::solution.
+     */
+    unsigned index;
+  };
+
+  static constexpr std::size_t MAX_JOBS = 3;
+
+  /**
+   * The arguments of the RunContests() call in progress, for
+   * #functions.
+   */
+  std::span<const ContestJob> current_jobs;
+  bool current_exhaustive;
+  std::array<bool, MAX_JOBS> current_valid;
+
+  /**
+   * One function per job slot, which runs the corresponding element
+   * of #current_jobs.  They are created once by the constructor, so
+   * RunContests() does not need to allocate.
+   */
+  std::array<std::function<void()>, MAX_JOBS> functions;
+
+  /**
+   * Run the element of #current_jobs with the given index.
+   */
+  void RunJob(std::size_t i) noexcept;
+
+  /**
+   * Run the given solvers with the #ContestExecutor and store their
+   * results in #stats.
+   *
+   * @return true if at least one of them has found an improved
+   * solution
+   */
+  bool RunContests(std::span<const ContestJob> jobs,
+                   bool exhaustive) noexcept;
 };
@@ -9,6 +9,7 @@
 #include "PathSolvers/SolverResult.hpp"
 
 #include <cassert>
+#include <chrono>
 
 class TracePoint;
 
@@ -22,6 +23,14 @@ class AbstractContest {
   ContestResult best_result;
   ContestTraceVector best_solution;
 
+  /**
+   * The total wall time spent in Solve() and the number of calls.
+   * This is measured by #ContestManager to find out which solver
+   * dominates.
+   */
+  std::chrono::steady_clock::duration solve_time{};
+  unsigned n_solves = 0;
+
 public:
   /**
    * Constructor
@@ -52,6 +61,19 @@ public:
     return best_solution;
   }
 
+  void AddSolveTime(std::chrono::steady_clock::duration d) noexcept {
+    solve_time += d;
+    ++n_solves;
+  }
+
+  std::chrono::steady_clock::duration GetSolveTime() const noexcept {
+    return solve_time;
+  }
+
+  unsigned GetSolveCount() const noexcept {
+    return n_solves;
+  }
+
 protected:
   /**
    * Calculate the result.
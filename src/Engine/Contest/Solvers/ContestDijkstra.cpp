@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 // set size of reserved queue elements (may differ from Dijkstra default)
 static constexpr unsigned CONTEST_QUEUE_SIZE = 5000;
@@ -32,10 +33,32 @@ ContestDijkstra::ContestDijkstra(const Trace &_trace,
 void
 ContestDijkstra::UpdateTrace(bool force) noexcept
 {
+  if (force && incremental && continuous) {
+    /* the incremental solver only considers the newest points as
+       finish, and the edge map may be incomplete after the trace was
+       thinned; the exhaustive search starts from scratch instead, so
+       its result is as good as the non-incremental one */
+    UpdateTraceFull();
+
+    trace_dirty = true;
+    finished = false;
+
+    first_finish_candidate = 0;
+    return;
+  }
+
   if (IsMasterAppended()) return; /* unmodified */
 
   if (IsMasterUpdated(continuous)) {
-    UpdateTraceFull();
+    if (incremental && continuous && finished) {
+      /* the master trace has been thinned; try to keep the edge map
+         instead of starting from scratch */
+      std::vector<unsigned> old_to_new;
+      UpdateTraceRemap(old_to_new);
+      if (RemapEdges(old_to_new))
+        return;
+    } else
+      UpdateTraceFull();
 
     trace_dirty = true;
     finished = false;
@@ -189,9 +212,14 @@ ContestDijkstra::AddStartEdges() noexcept
   assert(num_stages <= MAX_STAGES);
   assert(n_points > 0);
 
-  const int max_altitude = incremental
-    ? GetMaximumStartAltitude(TraceManager::GetPoint(n_points - 1))
-    : 0;
+  /* in incremental mode, only starts which are valid for one of the
+     finish candidates are added */
+  int max_altitude = std::numeric_limits<int>::min();
+  if (incremental)
+    for (unsigned i = std::min(first_finish_candidate, n_points - 1);
+         i < n_points; ++i)
+      max_altitude = std::max(max_altitude,
+                              GetMaximumStartAltitude(TraceManager::GetPoint(i)));
 
   for (ScanTaskPoint destination(0, 0), end(0, n_points);
        destination != end; destination.IncrementPointIndex()) {
@@ -309,6 +337,125 @@ ContestDijkstra::AddIncrementalEdges(unsigned first_point) noexcept
   AddStartEdges();
 }
 
+bool
+ContestDijkstra::RemapEdges(const std::vector<unsigned> &old_to_new) noexcept
+{
+  assert(continuous);
+  assert(incremental);
+  assert(finished);
+
+  /* for each old point, the new index of the nearest surviving point
+     at or before it and at or after it; a node whose parent was
+     removed is linked to one of these instead */
+  const unsigned n_old = old_to_new.size();
+  std::vector<unsigned> before(n_old), after(n_old);
+  unsigned last = removed_index;
+  for (unsigned i = 0; i < n_old; ++i) {
+    if (old_to_new[i] != removed_index)
+      last = old_to_new[i];
+    before[i] = last;
+  }
+
+  last = removed_index;
+  for (unsigned i = n_old; i-- > 0;) {
+    if (old_to_new[i] != removed_index)
+      last = old_to_new[i];
+    after[i] = last;
+  }
+
+  const Dijkstra::EdgeMap edges = dijkstra.GetEdgeMap();
+  dijkstra.Clear();
+
+  /* renumber stage by stage, so the parent of each node has already
+     been inserted; the values are recalculated from the (possibly
+     new) parents, which keeps them exact for the paths they
+     describe */
+  const auto &new_edges = dijkstra.GetEdgeMap();
+  /* final nodes are not kept: the finish of an incremental solution
+     is merely the newest point (or the prediction) at that time, and
+     is superseded by the points appended meanwhile */
+  for (unsigned stage = 0; !IsFinal(stage); ++stage) {
+    for (const auto &[node, edge] : edges) {
+      if (node.GetStageNumber() != stage)
+        continue;
+
+      const unsigned old_index = node.GetPointIndex();
+      assert(old_index < n_old);
+
+      const unsigned index = old_to_new[old_index];
+      if (index == removed_index)
+        /* the neighbouring points have nodes of their own */
+        continue;
+
+      const ScanTaskPoint new_node(stage, index);
+      if (stage == 0) {
+        /* start nodes are their own parents */
+        dijkstra.InsertEdge(new_node, new_node, edge.value);
+        continue;
+      }
+
+      const unsigned old_parent = edge.parent.GetPointIndex();
+      assert(old_parent < n_old);
+
+      /* the old parent if it survived, else its neighbours; pick
+         the one which gives the longest path */
+      const unsigned candidates[] = { before[old_parent], after[old_parent] };
+      const unsigned n_candidates =
+        old_to_new[old_parent] != removed_index ? 1 : 2;
+
+      const auto &node_tp = GetPoint(new_node);
+      const unsigned weight = GetStageWeight(stage - 1);
+
+      unsigned best_parent = removed_index;
+      value_type best_value = 0;
+      for (unsigned c = 0; c < n_candidates; ++c) {
+        const unsigned parent_index = candidates[c];
+        if (parent_index == removed_index || parent_index > index)
+          continue;
+
+        const ScanTaskPoint parent(stage - 1, parent_index);
+        const auto i = new_edges.find(parent);
+        if (i == new_edges.end())
+          continue;
+
+        const auto &parent_tp = GetPoint(parent);
+        if (parent_tp.GetFlatLocation() != node_tp.GetFlatLocation() &&
+            !CheckMinDistance(parent_tp.GetLocation(), node_tp.GetLocation()))
+          continue;
+
+        /* the same value as Link() calculates */
+        const value_type value = i->second.value +
+          (DIJKSTRA_MINMAX_OFFSET - weight * CalcEdgeDistance(parent, new_node));
+        if (best_parent == removed_index || value < best_value) {
+          best_parent = parent_index;
+          best_value = value;
+        }
+      }
+
+      if (best_parent != removed_index)
+        dijkstra.InsertEdge(new_node, ScanTaskPoint(stage - 1, best_parent),
+                            best_value);
+    }
+  }
+
+  if (dijkstra.GetEdgeMap().empty())
+    return false;
+
+  /* old_to_new is ascending; everything after the last surviving
+     point has been appended meanwhile */
+  const unsigned first_new = n_old > 0 && before[n_old - 1] != removed_index
+    ? before[n_old - 1] + 1
+    : 0;
+
+  if (first_new < n_points)
+    AddIncrementalEdges(first_new);
+  else
+    /* nothing was appended; the old index may be out of range now */
+    first_finish_candidate = n_points - 1;
+
+  return true;
+}
+
 const ContestTraceVector &
 ContestDijkstra::GetCurrentPath() const noexcept
 {
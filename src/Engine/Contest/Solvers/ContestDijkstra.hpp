@@ -99,6 +99,18 @@ protected:
    */
   void AddIncrementalEdges(unsigned first_point) noexcept;
 
+  /**
+   * Renumber the nodes of the edge map after UpdateTraceRemap(), and
+   * resume the incremental solver with the points that were
+   * appended.  Nodes whose point was removed are dropped, and a node
+   * whose parent was removed is linked to the parent's nearest
+   * surviving neighbour instead.
+   *
+   * @return false if the solver needs to be restarted, because no
+   * node survived
+   */
+  bool RemapEdges(const std::vector<unsigned> &old_to_new) noexcept;
+
   /**
    * Retrieve weighting of specified leg
    * @param index Index of leg
@@ -4,6 +4,7 @@
 #include "TraceManager.hpp"
 #include "Trace/Trace.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 TraceManager::TraceManager(const Trace &_trace) noexcept
@@ -77,6 +78,7 @@ TraceManager::ClearTrace() noexcept
   append_serial = modify_serial = Serial();
   trace_dirty = true;
   trace.clear();
+  keys.clear();
   n_points = 0;
   predicted = TracePoint::Invalid();
 }
@@ -88,6 +90,11 @@ TraceManager::UpdateTraceFull() noexcept
   trace_master.GetPoints(trace);
   n_points = trace.size();
 
+  keys.clear();
+  keys.reserve(trace.capacity());
+  for (const TracePoint *p : trace)
+    keys.emplace_back(*p);
+
   if (n_points > 0 && predicted.IsDefined())
     predicted.Project(trace_master.GetProjection());
 
@@ -108,6 +115,9 @@ TraceManager::UpdateTraceTail() noexcept
     /* no new points */
     return false;
 
+  for (auto i = std::next(trace.begin(), keys.size()); i != trace.end(); ++i)
+    keys.emplace_back(**i);
+
   n_points = trace.size();
 
   if (n_points > 0 && predicted.IsDefined())
@@ -117,6 +127,50 @@ TraceManager::UpdateTraceTail() noexcept
   return true;
 }
 
+void
+TraceManager::UpdateTraceRemap(std::vector<unsigned> &old_to_new) noexcept
+{
+  /* the pointers in the old copy may be dangling now; only the keys
+     are safe to compare */
+  const std::vector<PointKey> old_keys = std::move(keys);
+
+  UpdateTraceFull();
+
+  /* both copies are chronological, and points are only ever removed
+     or appended; walk both in parallel */
+  old_to_new.clear();
+  old_to_new.reserve(old_keys.size());
+
+  unsigned j = 0;
+  for (const auto &key : old_keys) {
+    while (j < n_points && keys[j].time < key.time)
+      ++j;
+
+    if (j < n_points && keys[j] == key)
+      old_to_new.push_back(j++);
+    else
+      old_to_new.push_back(removed_index);
+  }
+}
+
+unsigned
+TraceManager::FindPoint(TracePoint::Time time,
+                        const GeoPoint &location) const noexcept
+{
+  const auto i = std::lower_bound(keys.begin(), keys.end(), time,
+                                  [](const PointKey &key, TracePoint::Time t){
+                                    return key.time < t;
+                                  });
+  if (i == keys.end() || i->time != time)
+    return removed_index;
+
+  const unsigned index = std::distance(keys.begin(), i);
+  if (GetPoint(index).GetLocation() != location)
+    return removed_index;
+
+  return index;
+}
+
 void
 TraceManager::UpdateTrace([[maybe_unused]] bool force) noexcept
 {
@@ -7,6 +7,9 @@
 #include "Trace/Trace.hpp"
 #include "Trace/Vector.hpp"
 #include "Trace/Point.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+
+#include <vector>
 
 class TraceManager {
 protected:
@@ -27,6 +30,26 @@ private:
    */
   Serial modify_serial;
 
+  /**
+   * Identifies a point of #trace.  Unlike the pointers in #trace,
+   * this remains valid after the master Trace has been thinned, and
+   * is used to find the points which have survived.
+   */
+  struct PointKey {
+    TracePoint::Time time;
+    FlatGeoPoint location;
+
+    explicit PointKey(const TracePoint &p) noexcept
+      :time(p.GetTime()), location(p.GetFlatLocation()) {}
+
+    constexpr bool operator==(const PointKey &) const noexcept = default;
+  };
+
+  /**
+   * One #PointKey for each element of #trace.
+   */
+  std::vector<PointKey> keys;
+
 protected:
   /**
    * Working trace for solver.  This contains pointers to trace_master
@@ -42,6 +65,11 @@ protected:
 
   static constexpr unsigned predicted_index = 0xffff;
 
+  /**
+   * Returned by UpdateTraceRemap() for points that were removed.
+   */
+  static constexpr unsigned removed_index = -1;
+
   bool trace_dirty;
 
 public:
@@ -77,6 +105,25 @@ protected:
    */
   bool UpdateTraceTail() noexcept;
 
+  /**
+   * Obtain a new #Trace copy like UpdateTraceFull(), and determine
+   * the new index of each point of the old copy.
+   *
+   * @param old_to_new receives one element per point of the old copy:
+   * its index in the new copy or #removed_index if the point is gone
+   * (e.g. after the master Trace has been thinned)
+   */
+  void UpdateTraceRemap(std::vector<unsigned> &old_to_new) noexcept;
+
+  /**
+   * Find a point in the working trace.
+   *
+   * @return the index or #removed_index if the point is not there
+   */
+  [[gnu::pure]]
+  unsigned FindPoint(TracePoint::Time time,
+                     const GeoPoint &location) const noexcept;
+
   [[gnu::pure]]
   const TracePoint &GetPoint(unsigned i) const noexcept {
     assert(i < n_points);
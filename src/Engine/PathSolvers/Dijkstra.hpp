@@ -106,6 +106,24 @@ public:
     return edges;
   }
 
+  /**
+   * Does the edge map contain the specified node?
+   */
+  [[gnu::pure]]
+  bool HasEdge(const Node node) const noexcept {
+    return edges.find(node) != edges.end();
+  }
+
+  /**
+   * Insert an edge into the edge map without adding it to the queue.
+   * This hack is used to rebuild the edge map with renumbered nodes,
+   * see ContestDijkstra::RemapEdges().
+   */
+  void InsertEdge(const Node node, const Node parent,
+                  value_type value) noexcept {
+    edges.try_emplace(node, parent, value);
+  }
+
   /**
    * Test whether queue is empty
    *
@@ -175,7 +175,7 @@ AirspaceRoute::~AirspaceRoute() noexcept
 void
 AirspaceRoute::Reset() noexcept
 {
-  RoutePlanner::Reset();
+  TerrainRoute::Reset();
   m_airspaces.ClearClearances();
   m_airspaces.Clear();
 }
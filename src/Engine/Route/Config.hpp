@@ -40,8 +40,15 @@ struct RoutePlannerConfig
   /** Whether reach/abort calculations will use the task or safety polar */
   Polar reach_polar_mode;
 
+  /** Whether the reach is updated incrementally between full solves
+      (faster, but close to terrain obstacles the reachability of a
+      few points may differ from a full solve) */
+  bool reach_incremental;
+
   void SetDefaults();
 
+  bool operator==(const RoutePlannerConfig &) const noexcept = default;
+
   bool IsTerrainEnabled() const {
     return mode == Mode::TERRAIN || mode == Mode::BOTH;
   }
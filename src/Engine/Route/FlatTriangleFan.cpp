@@ -4,6 +4,7 @@
 #include "FlatTriangleFan.hpp"
 #include "FlatTriangleFanVisitor.hpp"
 #include "Math/Line2D.hpp"
+#include "Math/Util.hpp"
 
 #include <cassert>
 
@@ -33,6 +34,16 @@ FlatTriangleFan::AddOrigin(const AFlatGeoPoint &origin,
   vs.push_back(origin);
 }
 
+void
+FlatTriangleFan::Transform(FlatGeoPoint from, FlatGeoPoint to,
+                           double scale, int base) noexcept
+{
+  for (auto &v : vs)
+    v = to + FlatGeoPoint(v - from) * scale;
+
+  height = base + iround((height - base) * scale);
+}
+
 void
 FlatTriangleFan::AddPoint(FlatGeoPoint p) noexcept
 {
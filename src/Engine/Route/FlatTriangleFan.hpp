@@ -92,6 +92,14 @@ public:
     height = _height;
   }
 
+  /**
+   * Move all vertices so that #from ends up at #to, scaling their
+   * distance to it by the given factor.  The height above #base is
+   * scaled by the same factor.
+   */
+  void Transform(FlatGeoPoint from, FlatGeoPoint to, double scale,
+                 int base) noexcept;
+
   void AcceptInRange(const FlatBoundingBox &bb,
                      FlatTriangleFanVisitor &visitor,
                      bool closed) const noexcept;
@@ -6,9 +6,11 @@
 #include "RouteLink.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "ReachFanParms.hpp"
-#include "util/GlobalSliceAllocator.hxx"
 #include "Geo/Flat/FlatProjection.hpp"
 
+#include <algorithm>
+#include <array>
+
 #define REACH_SWEEP (ROUTEPOLAR_Q1-BUFFER)
 
 static bool
@@ -155,24 +157,51 @@ FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint o,
     return;
   }
 
-  for (const auto &x : fan.GetVertices()) {
-    const FlatGeoPoint av = (o + x) * 0.5;
-    const GeoPoint p = parms.projection.Unproject(av);
-    const auto h = parms.terrain->GetHeight(p);
-
-    if (h.IsWater())
-      /* water: assume 0m MSL */
-      parms.terrain_counter++;
-    else if (!h.IsInvalid()) {
-      parms.terrain_counter++;
-      parms.terrain_base += h.GetValue();
+  /* sample the terrain in chunks, to be able to use the batched
+     (faster) RasterMap method */
+  std::array<GeoPoint, 64> points;
+  std::array<TerrainHeight, points.size()> heights;
+
+  auto vertices = fan.GetVertices();
+  while (!vertices.empty()) {
+    const std::size_t n = std::min(vertices.size(), points.size());
+
+    for (std::size_t i = 0; i < n; ++i)
+      points[i] = parms.projection.Unproject((o + vertices[i]) * 0.5);
+
+    parms.terrain->GetInterpolatedHeights(std::span{points}.first(n),
+                                          heights.data());
+
+    for (const auto h : std::span{heights}.first(n)) {
+      if (h.IsWater())
+        /* water: assume 0m MSL */
+        parms.terrain_counter++;
+      else if (!h.IsInvalid()) {
+        parms.terrain_counter++;
+        parms.terrain_base += h.GetValue();
+      }
     }
+
+    vertices = vertices.subspan(n);
   }
 
   if (parms.terrain_counter)
     parms.terrain_base /= parms.terrain_counter;
 }
 
+void
+FlatTriangleFanTree::Transform(FlatGeoPoint from, FlatGeoPoint to,
+                               double scale, int base) noexcept
+{
+  fan.Transform(from, to, scale, base);
+
+  for (auto &child : children)
+    child.Transform(from, to, scale, base);
+
+  if (IsRoot())
+    CalcBoundingBox();
+}
+
 bool
 FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
                               const RouteLink &e_2,
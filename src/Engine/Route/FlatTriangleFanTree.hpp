@@ -4,7 +4,6 @@
 #pragma once
 
 #include "Geo/Flat/FlatBoundingBox.hpp"
-#include "util/SliceAllocator.hxx"
 #include "FlatTriangleFan.hpp"
 
 #include <cstdint>
@@ -31,9 +30,10 @@ public:
 private:
   FlatTriangleFan fan;
 
-  using LeafVector =
-    std::forward_list<FlatTriangleFanTree,
-                      GlobalSliceAllocator<FlatTriangleFanTree, 128u>>;
+  /* this uses the standard allocator (and not a global
+     SliceAllocator) because several trees may be built in parallel
+     threads */
+  using LeafVector = std::forward_list<FlatTriangleFanTree>;
 
   FlatBoundingBox bb_children;
   LeafVector children;
@@ -61,6 +61,11 @@ public:
     return fan.GetHeight();
   }
 
+  [[gnu::pure]]
+  AFlatGeoPoint GetOrigin() const noexcept {
+    return fan.GetOrigin();
+  }
+
   void FillReach(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
   void DummyReach(const AFlatGeoPoint &origin) noexcept;
 
@@ -88,6 +93,13 @@ public:
 
   void UpdateTerrainBase(FlatGeoPoint origin, ReachFanParms &parms) noexcept;
 
+  /**
+   * Apply FlatTriangleFan::Transform() to all fans of this tree,
+   * e.g. to move it to a new origin without solving it again.
+   */
+  void Transform(FlatGeoPoint from, FlatGeoPoint to, double scale,
+                 int base) noexcept;
+
   [[gnu::pure]]
   int DirectArrival(FlatGeoPoint dest,
                     const ReachFanParms &parms) const noexcept;
@@ -6,8 +6,21 @@
 #include "ReachFanParms.hpp"
 #include "ReachResult.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
+/**
+ * Limits for ReachFan::Update(): the maximum distance [m] and height
+ * difference [m] to the origin of the last full Solve(), and the
+ * maximum number of Update() calls in a row.
+ */
+static constexpr double MAX_UPDATE_DISTANCE = 500;
+static constexpr double MAX_UPDATE_HEIGHT = 25;
+static constexpr unsigned MAX_UPDATES = 3;
+
 void
 ReachFan::Reset() noexcept
 {
@@ -21,6 +34,9 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
 {
   Reset();
 
+  solve_origin = origin;
+  n_updates = 0;
+
   // initialise projection
   projection = FlatProjection(origin);
 
@@ -62,6 +78,55 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
   return true;
 }
 
+/**
+ * The height above which the glide range is calculated: the terrain
+ * base, or the floor if that is higher.
+ */
+[[gnu::pure]]
+static int
+GetRangeBase(int terrain_base, const RoutePolars &rpolars) noexcept
+{
+  return std::max(terrain_base, rpolars.GetFloor()) +
+    rpolars.GetSafetyHeight();
+}
+
+bool
+ReachFan::CanUpdate(const AGeoPoint origin,
+                    const RoutePolars &rpolars) const noexcept
+{
+  if (root.IsEmpty() || root.IsDummy() || n_updates >= MAX_UPDATES)
+    return false;
+
+  if (std::abs(origin.altitude - solve_origin.altitude) > MAX_UPDATE_HEIGHT ||
+      origin.DistanceS(solve_origin) > MAX_UPDATE_DISTANCE)
+    return false;
+
+  /* scaling makes no sense close to the terrain base; Solve() may
+     need to fall back to DummyReach() there */
+  const int base = GetRangeBase(terrain_base, rpolars);
+  return origin.altitude > base + MIN_FLOOR_CLEARANCE &&
+    root.GetHeight() > base + MIN_FLOOR_CLEARANCE;
+}
+
+void
+ReachFan::Update(const AGeoPoint origin, const RoutePolars &rpolars) noexcept
+{
+  assert(CanUpdate(origin, rpolars));
+
+  const AFlatGeoPoint old_origin = root.GetOrigin();
+
+  projection = FlatProjection(origin);
+  const FlatGeoPoint new_origin = projection.ProjectInteger(origin);
+
+  const int base = GetRangeBase(terrain_base, rpolars);
+  const double scale = (origin.altitude - base) /
+    (old_origin.altitude - base);
+
+  root.Transform(old_origin, new_origin, scale, base);
+
+  ++n_updates;
+}
+
 std::optional<ReachResult>
 ReachFan::FindPositiveArrival(const AGeoPoint dest,
                               const RoutePolars &rpolars) const noexcept
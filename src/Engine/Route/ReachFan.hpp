@@ -5,6 +5,7 @@
 
 #include "Geo/Flat/FlatProjection.hpp"
 #include "FlatTriangleFanTree.hpp"
+#include "Geo/GeoPoint.hpp"
 
 #include <optional>
 
@@ -19,6 +20,16 @@ class ReachFan
   FlatTriangleFanTree root;
   int terrain_base = 0;
 
+  /**
+   * The origin of the last full Solve().
+   */
+  AGeoPoint solve_origin;
+
+  /**
+   * The number of Update() calls since the last full Solve().
+   */
+  unsigned n_updates = 0;
+
 public:
   friend class PrintHelper;
 
@@ -35,6 +46,26 @@ public:
   bool Solve(const AGeoPoint origin, const RoutePolars &rpolars,
              const RasterMap *terrain, const bool do_solve = true) noexcept;
 
+  /**
+   * Can Update() move this reach to the given origin, or is a full
+   * Solve() needed?  This is only the case if the origin is close to
+   * the one of the last Solve() and Update() has not been called too
+   * often since.  The caller is responsible for checking that the
+   * #RoutePolars and the terrain have not changed.
+   */
+  [[gnu::pure]]
+  bool CanUpdate(const AGeoPoint origin,
+                 const RoutePolars &rpolars) const noexcept;
+
+  /**
+   * Move the reach to a new origin without solving it again.  All
+   * fans are translated to the new origin and scaled by the change
+   * of the glide height above the terrain base.  This is a cheap
+   * approximation which is only good for small changes; see
+   * CanUpdate().
+   */
+  void Update(const AGeoPoint origin, const RoutePolars &rpolars) noexcept;
+
   /**
    * Find arrival height at destination.
    *
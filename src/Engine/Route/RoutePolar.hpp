@@ -48,6 +48,8 @@ class RoutePolar
       else
         inv_gradient = 0;
     };
+
+    bool operator==(const RoutePolarPoint &) const noexcept = default;
   };
 
   RoutePolarPoint points[ROUTEPOLAR_POINTS];
@@ -65,6 +67,8 @@ public:
                   const SpeedVector& wind,
                   const bool glide);
 
+  bool operator==(const RoutePolar &) const noexcept = default;
+
   /**
    * Retrieve data corresponding to a particular (backwards-time) direction.
    *
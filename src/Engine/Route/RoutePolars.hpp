@@ -235,6 +235,20 @@ public:
     return height_min_working;
   }
 
+  /**
+   * Do both objects describe the same aircraft performance?  Unlike
+   * operator==, this ignores #cruise_altitude and #climb_ceiling,
+   * which are derived from the aircraft altitude by SetConfig().
+   */
+  [[gnu::pure]]
+  bool HasSamePerformance(const RoutePolars &other) const noexcept {
+    return polar_glide == other.polar_glide &&
+      polar_cruise == other.polar_cruise &&
+      inv_mc == other.inv_mc &&
+      height_min_working == other.height_min_working &&
+      config == other.config;
+  }
+
   [[gnu::pure]]
   FlatGeoPoint ReachIntercept(int index, const AFlatGeoPoint &flat_origin,
                               const GeoPoint &origin,
@@ -42,9 +42,42 @@ TerrainRoute::SolveReach(const AGeoPoint &origin,
   auto &rpolars = working ? rpolars_reach_working : rpolars_reach;
   rpolars.SetConfig(config, origin.altitude, h_ceiling);
 
-  ReachFan reach;
-  reach.Solve(origin, rpolars, terrain, do_solve);
-  return reach;
+  auto &cache = working ? reach_cache_working : reach_cache;
+
+  if (config.reach_incremental && do_solve && cache.valid &&
+      cache.terrain == terrain &&
+      (terrain == nullptr || cache.terrain_serial == terrain->GetSerial()) &&
+      cache.rpolars.HasSamePerformance(rpolars) &&
+      cache.reach.CanUpdate(origin, rpolars)) {
+    cache.reach.Update(origin, rpolars);
+    return cache.reach;
+  }
+
+  if (!config.reach_incremental || !do_solve) {
+    cache.valid = false;
+
+    ReachFan reach;
+    reach.Solve(origin, rpolars, terrain, do_solve);
+    return reach;
+  }
+
+  /* solve right into the cache; the caller gets the only copy */
+  cache.reach.Solve(origin, rpolars, terrain, do_solve);
+  cache.rpolars = rpolars;
+  cache.terrain = terrain;
+  if (terrain != nullptr)
+    cache.terrain_serial = terrain->GetSerial();
+  cache.valid = true;
+
+  return cache.reach;
+}
+
+void
+TerrainRoute::Reset() noexcept
+{
+  RoutePlanner::Reset();
+
+  reach_cache.valid = reach_cache_working.valid = false;
 }
 
 /*
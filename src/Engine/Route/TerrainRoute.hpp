@@ -4,8 +4,8 @@
 #pragma once
 
 #include "RoutePlanner.hpp"
-
-class ReachFan;
+#include "ReachFan.hpp"
+#include "util/Serial.hpp"
 
 /**
  * Specialization of #RoutePlanner which implements terrain avoidance.
@@ -27,6 +27,29 @@ class TerrainRoute: public RoutePlanner
 
   mutable RoutePoint m_inx_terrain;
 
+  /**
+   * The result of the last SolveReach() call, to be reused by the
+   * next one if the aircraft has not moved much (see
+   * ReachFan::CanUpdate()).  Only used if
+   * RoutePlannerConfig::reach_incremental is enabled.
+   */
+  struct ReachCache {
+    ReachFan reach;
+
+    /**
+     * The #RoutePolars which were used to solve #reach.
+     */
+    RoutePolars rpolars;
+
+    const RasterMap *terrain;
+    Serial terrain_serial;
+
+    bool valid = false;
+  };
+
+  /** Cached reach to terrain and to working floor */
+  ReachCache reach_cache, reach_cache_working;
+
 public:
   friend class PrintHelper;
 
@@ -55,7 +78,6 @@ public:
    * @param origin The start of the search (current aircraft location)
    * @param do_solve actually solve or just perform minimal calculations
    */
-  [[gnu::pure]]
   ReachFan SolveReach(const AGeoPoint &origin,
                       const RoutePlannerConfig &config,
                       int h_ceiling, bool do_solve,
@@ -76,6 +98,8 @@ public:
   GeoPoint Intersection(const AGeoPoint &origin,
                         const AGeoPoint &destination) const noexcept;
 
+  void Reset() noexcept override;
+
 protected:
   bool IsClear(const RouteLink &e) const noexcept override;
   void AddNearby(const RouteLink &e) noexcept override;
@@ -0,0 +1,518 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ArrayTrace.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+
+#include <stdlib.h>
+
+/**
+ * Marks the end of a linked list in EraseDelta(), and points which
+ * are not in the heap.
+ */
+static constexpr unsigned NONE = -1;
+
+/**
+ * Marks points which were erased by EraseDelta().
+ */
+static constexpr unsigned ERASED = -2;
+
+/**
+ * @see Trace::TraceDelta::DistanceMetric()
+ */
+[[gnu::pure]]
+static unsigned
+DistanceMetric(const TracePoint &last, const TracePoint &node,
+               const TracePoint &next) noexcept
+{
+  const int d_this = last.FlatDistanceTo(node) + node.FlatDistanceTo(next);
+  const int d_rem = last.FlatDistanceTo(next);
+  return abs(d_this - d_rem);
+}
+
+/**
+ * @see Trace::TraceDelta::TimeMetric()
+ */
+static constexpr TracePoint::Time
+TimeMetric(const TracePoint &last, const TracePoint &node,
+           const TracePoint &next) noexcept
+{
+  return next.DeltaTime(last)
+    - std::min(next.DeltaTime(node), node.DeltaTime(last));
+}
+
+ArrayTrace::ArrayTrace(const Time _no_thin_time, const Time _max_time,
+                       const unsigned _max_size) noexcept
+  :max_time(_max_time),
+   no_thin_time(_no_thin_time),
+   max_size(_max_size),
+   opt_size((3 * _max_size) / 4),
+   average_delta_time(), average_delta_distance(0)
+{
+  assert(max_size >= 4);
+
+  /* appending must not reallocate, because that would invalidate
+     pointers to the points */
+  points.reserve(max_size);
+  elim_distance.reserve(max_size);
+  elim_time.reserve(max_size);
+  delta_distance.reserve(max_size);
+}
+
+void
+ArrayTrace::clear() noexcept
+{
+  average_delta_distance = 0;
+  average_delta_time = {};
+
+  points.clear();
+  elim_distance.clear();
+  elim_time.clear();
+  delta_distance.clear();
+
+  ++modify_serial;
+  ++append_serial;
+}
+
+ArrayTrace::Time
+ArrayTrace::GetRecentTime(const Time t) const noexcept
+{
+  if (empty())
+    return {};
+
+  const TracePoint &last = back();
+  if (last.GetTime() > t)
+    return last.GetTime() - t;
+
+  return {};
+}
+
+void
+ArrayTrace::UpdateDelta(unsigned i) noexcept
+{
+  if (i == 0 || i + 1 >= size())
+    return;
+
+  const TracePoint &previous = points[i - 1], &point = points[i],
+    &next = points[i + 1];
+
+  elim_time[i] = TimeMetric(previous, point, next);
+  elim_distance[i] = DistanceMetric(previous, point, next);
+  delta_distance[i] = point.FlatDistanceTo(previous);
+}
+
+void
+ArrayTrace::EraseStart(unsigned i) noexcept
+{
+  elim_distance[i] = null_delta;
+  elim_time[i] = null_time;
+}
+
+void
+ArrayTrace::EraseEarlierThan(const Time p_time) noexcept
+{
+  if (p_time == Time{} || empty() || front().GetTime() >= p_time)
+    // there will be nothing to remove
+    return;
+
+  const auto n = std::distance(points.begin(),
+                               std::find_if(points.begin(), points.end(),
+                                            [p_time](const TracePoint &p){
+                                              return p.GetTime() >= p_time;
+                                            }));
+
+  points.erase(points.begin(), std::next(points.begin(), n));
+  elim_distance.erase(elim_distance.begin(),
+                      std::next(elim_distance.begin(), n));
+  elim_time.erase(elim_time.begin(), std::next(elim_time.begin(), n));
+  delta_distance.erase(delta_distance.begin(),
+                       std::next(delta_distance.begin(), n));
+
+  if (!empty())
+    EraseStart(0);
+
+  ++modify_serial;
+  ++append_serial;
+}
+
+void
+ArrayTrace::EraseLaterThan(const Time min_time) noexcept
+{
+  assert(min_time.count() > 0);
+  assert(!empty());
+
+  while (!empty() && back().GetTime() > min_time) {
+    points.pop_back();
+    elim_distance.pop_back();
+    elim_time.pop_back();
+    delta_distance.pop_back();
+  }
+
+  if (!empty())
+    EraseStart(size() - 1);
+}
+
+void
+ArrayTrace::push_back(const TracePoint &point) noexcept
+{
+  const Time min_delta = std::chrono::seconds{2};
+
+  if (empty()) {
+    // first point determines origin for flat projection
+    task_projection.Reset(point.GetLocation());
+    task_projection.Update();
+  } else if (point.GetTime() < back().GetTime()) {
+    // gone back in time
+
+    const Time clear_threshold = std::chrono::minutes{3};
+    const Time fix_threshold = std::chrono::seconds{10};
+
+    if (point.GetTime() + clear_threshold < back().GetTime()) {
+      /* not fixable, clear the trace and restart from scratch */
+      clear();
+      return;
+    }
+
+    /* not much, try to fix it */
+    EraseLaterThan(point.GetTime() - fix_threshold);
+    ++modify_serial;
+  } else if (point.GetTime() - back().GetTime() < min_delta)
+    // only add one item per two seconds
+    return;
+
+  EnforceTimeWindow(point.GetTime());
+
+  if (size() >= max_size)
+    Thin();
+
+  assert(size() < max_size);
+
+  points.push_back(point);
+  points.back().Project(task_projection);
+  elim_distance.push_back(null_delta);
+  elim_time.push_back(null_time);
+  delta_distance.push_back(0);
+
+  if (size() > 1)
+    UpdateDelta(size() - 2);
+
+  ++append_serial;
+}
+
+unsigned
+ArrayTrace::CalcAverageDeltaDistance(const Time no_thin) const noexcept
+{
+  const Time r = GetRecentTime(no_thin);
+  unsigned acc = 0;
+  unsigned counter = 0;
+
+  for (unsigned i = 0, n = size(); i < n && points[i].GetTime() < r;
+       ++i, ++counter)
+    acc += delta_distance[i];
+
+  if (counter)
+    return acc / counter;
+
+  return 0;
+}
+
+ArrayTrace::Time
+ArrayTrace::CalcAverageDeltaTime(const Time no_thin) const noexcept
+{
+  const Time r = GetRecentTime(no_thin);
+
+  /* find the last item before the "r" timestamp */
+  unsigned counter = 0;
+  while (counter < size() && points[counter].GetTime() < r)
+    ++counter;
+
+  if (counter < 2)
+    return {};
+
+  --counter;
+
+  Time start_time = front().GetTime();
+  Time end_time = points[counter].GetTime();
+  return (end_time - start_time) / counter;
+}
+
+void
+ArrayTrace::EnforceTimeWindow(const Time latest_time) noexcept
+{
+  if (max_time == null_time)
+    /* no time window configured */
+    return;
+
+  if (latest_time <= max_time)
+    /* see Trace::EnforceTimeWindow() */
+    return;
+
+  EraseEarlierThan(latest_time - max_time);
+}
+
+inline bool
+ArrayTrace::DeltaRank(unsigned a, unsigned b) const noexcept
+{
+  // distance is king
+  if (elim_distance[a] != elim_distance[b])
+    return elim_distance[a] < elim_distance[b];
+
+  // distance is equal, so go by time error
+  if (elim_time[a] != elim_time[b])
+    return elim_time[a] < elim_time[b];
+
+  // all else fails, go by age
+  return points[a].IsOlderThan(points[b]);
+}
+
+void
+ArrayTrace::HeapSiftUp(std::size_t position) noexcept
+{
+  const unsigned i = heap[position];
+
+  while (position > 0) {
+    const std::size_t parent = (position - 1) / 2;
+    if (!DeltaRank(i, heap[parent]))
+      break;
+
+    heap[position] = heap[parent];
+    heap_position[heap[position]] = position;
+    position = parent;
+  }
+
+  heap[position] = i;
+  heap_position[i] = position;
+}
+
+void
+ArrayTrace::HeapSiftDown(std::size_t position) noexcept
+{
+  const unsigned i = heap[position];
+  const std::size_t n = heap.size();
+
+  while (true) {
+    std::size_t child = 2 * position + 1;
+    if (child >= n)
+      break;
+
+    if (child + 1 < n && DeltaRank(heap[child + 1], heap[child]))
+      ++child;
+
+    if (!DeltaRank(heap[child], i))
+      break;
+
+    heap[position] = heap[child];
+    heap_position[heap[position]] = position;
+    position = child;
+  }
+
+  heap[position] = i;
+  heap_position[i] = position;
+}
+
+void
+ArrayTrace::HeapUpdate(unsigned i) noexcept
+{
+  HeapSiftUp(heap_position[i]);
+  HeapSiftDown(heap_position[i]);
+}
+
+unsigned
+ArrayTrace::HeapPop() noexcept
+{
+  assert(!heap.empty());
+
+  const unsigned top = heap.front();
+  const unsigned last = heap.back();
+  heap.pop_back();
+  heap_position[top] = NONE;
+
+  if (!heap.empty()) {
+    heap.front() = last;
+    HeapSiftDown(0);
+  }
+
+  return top;
+}
+
+bool
+ArrayTrace::EraseDelta(const unsigned target_size, const Time recent) noexcept
+{
+  if (size() <= 2)
+    return false;
+
+  const Time recent_time = GetRecentTime(recent);
+  const unsigned n = size();
+
+  /* while erasing, the surviving points are linked to their
+     neighbours; the arrays are compacted at the end */
+  link_previous.resize(n);
+  link_next.resize(n);
+  for (unsigned i = 0; i < n; ++i) {
+    link_previous[i] = i > 0 ? i - 1 : NONE;
+    link_next[i] = i + 1 < n ? i + 1 : NONE;
+  }
+
+  /* edges and recent points are never erased, so they are not added
+     to the heap at all */
+  heap.clear();
+  heap_position.assign(n, NONE);
+  for (unsigned i = 0; i < n; ++i) {
+    if (!IsEdge(i) && points[i].GetTime() < recent_time) {
+      heap_position[i] = heap.size();
+      heap.push_back(i);
+    }
+  }
+
+  for (std::size_t i = heap.size() / 2; i-- > 0;)
+    HeapSiftDown(i);
+
+  const auto update = [this](unsigned i){
+    const unsigned previous = link_previous[i], next = link_next[i];
+    if (previous == NONE || next == NONE)
+      /* first or last point */
+      return;
+
+    const TracePoint &point = points[i];
+    elim_time[i] = TimeMetric(points[previous], point, points[next]);
+    elim_distance[i] = DistanceMetric(points[previous], point, points[next]);
+    delta_distance[i] = point.FlatDistanceTo(points[previous]);
+
+    if (heap_position[i] != NONE)
+      HeapUpdate(i);
+  };
+
+  unsigned remaining = n;
+  while (remaining > target_size && !heap.empty()) {
+    const unsigned i = HeapPop();
+    const unsigned previous = link_previous[i], next = link_next[i];
+    assert(previous != NONE && next != NONE);
+
+    link_next[previous] = next;
+    link_previous[next] = previous;
+    heap_position[i] = ERASED;
+    --remaining;
+
+    update(previous);
+    update(next);
+  }
+
+  if (remaining == n)
+    return false;
+
+  unsigned dest = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    if (heap_position[i] == ERASED)
+      continue;
+
+    if (dest != i) {
+      points[dest] = points[i];
+      elim_distance[dest] = elim_distance[i];
+      elim_time[dest] = elim_time[i];
+      delta_distance[dest] = delta_distance[i];
+    }
+
+    ++dest;
+  }
+
+  assert(dest == remaining);
+
+  points.resize(dest);
+  elim_distance.resize(dest);
+  elim_time.resize(dest);
+  delta_distance.resize(dest);
+  return true;
+}
+
+inline void
+ArrayTrace::Thin2() noexcept
+{
+  const unsigned target_size = opt_size;
+  assert(size() > target_size);
+
+  // if still too big, remove points based on line simplification
+  EraseDelta(target_size, no_thin_time);
+  if (size() <= target_size)
+    return;
+
+  // if still too big, thin again, ignoring recency
+  if (no_thin_time.count() > 0)
+    EraseDelta(target_size, {});
+
+  assert(size() <= target_size);
+}
+
+void
+ArrayTrace::Thin() noexcept
+{
+  assert(size() == max_size);
+
+  Thin2();
+
+  assert(size() < max_size);
+
+  average_delta_distance = CalcAverageDeltaDistance(no_thin_time);
+  average_delta_time = CalcAverageDeltaTime(no_thin_time);
+
+  ++modify_serial;
+  ++append_serial;
+}
+
+void
+ArrayTrace::GetPoints(TracePointVector &v) const noexcept
+{
+  v.assign(points.begin(), points.end());
+}
+
+void
+ArrayTrace::GetPoints(TracePointerVector &v) const noexcept
+{
+  v.clear();
+  v.reserve(size());
+  for (const auto &i : points)
+    v.push_back(&i);
+}
+
+bool
+ArrayTrace::SyncPoints(TracePointerVector &v) const noexcept
+{
+  assert(v.size() <= size());
+
+  if (v.size() == size())
+    /* no news */
+    return false;
+
+  v.reserve(size());
+  for (unsigned i = v.size(), n = size(); i < n; ++i)
+    v.push_back(&points[i]);
+
+  return true;
+}
+
+void
+ArrayTrace::GetPoints(TracePointVector &v, const Time min_time,
+                      const GeoPoint &location,
+                      double min_distance) const noexcept
+{
+  /* skip the trace points that are before min_time */
+  const auto first = std::find_if(points.begin(), points.end(),
+                                  [min_time](const TracePoint &p){
+                                    return p.GetTime() >= min_time;
+                                  });
+  if (first == points.end())
+    /* nothing left */
+    return;
+
+  v.reserve(std::distance(first, points.end()));
+
+  const unsigned range = ProjectRange(location, min_distance);
+  const unsigned sq_range = range * range;
+
+  const_iterator i{&*first}, end = this->end();
+  do {
+    v.push_back(*i);
+    i.NextSquareRange(sq_range, end);
+  } while (i != end);
+}
@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Point.hpp"
+#include "util/NonCopyable.hpp"
+#include "util/Serial.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "time/Stamp.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+class TracePointVector;
+class TracePointerVector;
+
+/**
+ * An alternative implementation of #Trace with the same public API
+ * and the same thinning algorithm (i.e. it keeps exactly the same
+ * points), but with a different memory layout:
+ *
+ * - the points are stored in chronological order in one contiguous
+ *   array, which makes iterating them cheap
+ * - the thinning metrics are stored in separate arrays (structure of
+ *   arrays), because they are only needed while appending and
+ *   thinning
+ * - the thinning order is only established during Thin() with an
+ *   index-based binary heap, instead of keeping all points sorted in
+ *   a tree all the time
+ *
+ * The points are compacted after thinning; like with #Trace, all
+ * pointers and iterators get invalidated when GetModifySerial()
+ * changes.  Appending does not invalidate them, because capacity for
+ * the maximum number of points is allocated by the constructor.
+ */
+class ArrayTrace : private NonCopyable
+{
+  using Time = TracePoint::Time;
+
+  /**
+   * All points in chronological order.
+   */
+  std::vector<TracePoint> points;
+
+  /* the thinning metrics of each point; see Trace::TraceDelta */
+  std::vector<unsigned> elim_distance;
+  std::vector<Time> elim_time;
+  std::vector<unsigned> delta_distance;
+
+  /* temporary buffers for EraseDelta(); stored here to avoid
+     allocating them each time */
+  std::vector<unsigned> link_previous, link_next;
+  std::vector<unsigned> heap, heap_position;
+
+  TaskProjection task_projection;
+
+  const Time max_time;
+  const Time no_thin_time;
+  const unsigned max_size;
+  const unsigned opt_size;
+
+  Time average_delta_time;
+  unsigned average_delta_distance;
+
+  Serial append_serial, modify_serial;
+
+public:
+  /**
+   * @see Trace::Trace()
+   */
+  explicit ArrayTrace(Time no_thin_time = {},
+                      Time max_time = null_time,
+                      unsigned max_size = 1000) noexcept;
+
+  /**
+   * Add trace to internal store.
+   *
+   * @param a new point; its "flat" (projected) location is ignored
+   */
+  void push_back(const TracePoint &point) noexcept;
+
+  /**
+   * Clear the trace store
+   */
+  void clear() noexcept;
+
+  void EraseEarlierThan(TimeStamp time) noexcept {
+    EraseEarlierThan(time.Cast<Time>());
+  }
+
+  void EraseLaterThan(TimeStamp time) noexcept {
+    EraseLaterThan(time.Cast<Time>());
+  }
+
+  unsigned GetMaxSize() const noexcept {
+    return max_size;
+  }
+
+  unsigned size() const noexcept {
+    return points.size();
+  }
+
+  bool empty() const noexcept {
+    return points.empty();
+  }
+
+  /**
+   * @see Trace::GetAppendSerial()
+   */
+  const Serial &GetAppendSerial() const noexcept {
+    return append_serial;
+  }
+
+  /**
+   * @see Trace::GetModifySerial()
+   */
+  const Serial &GetModifySerial() const noexcept {
+    return modify_serial;
+  }
+
+  /**
+   * Retrieve a vector of trace points sorted by time
+   */
+  void GetPoints(TracePointVector &v) const noexcept;
+
+  /**
+   * Retrieve a vector of trace points sorted by time
+   */
+  void GetPoints(TracePointerVector &v) const noexcept;
+
+  /**
+   * @see Trace::SyncPoints()
+   */
+  bool SyncPoints(TracePointerVector &v) const noexcept;
+
+  /**
+   * Fill the vector with trace points, not before #min_time, minimum
+   * resolution #min_distance.
+   */
+  void GetPoints(TracePointVector &v, Time min_time,
+                 const GeoPoint &location, double resolution) const noexcept;
+
+  const TracePoint &front() const noexcept {
+    assert(!empty());
+
+    return points.front();
+  }
+
+  const TracePoint &back() const noexcept {
+    assert(!empty());
+
+    return points.back();
+  }
+
+  static constexpr auto null_time = TracePoint::INVALID_TIME;
+
+  unsigned GetAverageDeltaDistance() const noexcept {
+    return average_delta_distance;
+  }
+
+  Time GetAverageDeltaTime() const noexcept {
+    return average_delta_time;
+  }
+
+  class const_iterator {
+    const TracePoint *p;
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = const TracePoint;
+    using pointer = const TracePoint *;
+    using reference = const TracePoint &;
+
+    const_iterator() = default;
+
+    explicit constexpr const_iterator(const TracePoint *_p) noexcept
+      :p(_p) {}
+
+    constexpr const TracePoint &operator*() const noexcept {
+      return *p;
+    }
+
+    constexpr const TracePoint *operator->() const noexcept {
+      return p;
+    }
+
+    constexpr const_iterator &operator++() noexcept {
+      ++p;
+      return *this;
+    }
+
+    constexpr const_iterator &operator--() noexcept {
+      --p;
+      return *this;
+    }
+
+    constexpr bool operator==(const const_iterator &) const noexcept = default;
+
+    const_iterator &NextSquareRange(unsigned sq_resolution,
+                                    const const_iterator &end) noexcept {
+      const TracePoint &previous = **this;
+      while (true) {
+        ++*this;
+
+        if (*this == end)
+          return *this;
+
+        if (p->FlatSquareDistanceTo(previous) >= sq_resolution)
+          return *this;
+      }
+    }
+  };
+
+  const_iterator begin() const noexcept {
+    return const_iterator{points.data()};
+  }
+
+  const_iterator end() const noexcept {
+    return const_iterator{points.data() + points.size()};
+  }
+
+  const TaskProjection &GetProjection() const noexcept {
+    return task_projection;
+  }
+
+  [[gnu::pure]]
+  unsigned ProjectRange(const GeoPoint &location, double distance) const noexcept {
+    return task_projection.ProjectRangeInteger(location, distance);
+  }
+
+private:
+  static constexpr unsigned null_delta = 0 - 1;
+
+  [[gnu::pure]]
+  Time GetRecentTime(Time t) const noexcept;
+
+  bool IsEdge(unsigned i) const noexcept {
+    return elim_time[i] == null_time;
+  }
+
+  /**
+   * Recalculate the thinning metrics of a point from its neighbours.
+   * Does nothing for the first and the last point.
+   */
+  void UpdateDelta(unsigned i) noexcept;
+
+  /**
+   * Mark the point as the new first or last point after the ones
+   * before or after it have been erased.
+   */
+  void EraseStart(unsigned i) noexcept;
+
+  void EraseEarlierThan(Time p_time) noexcept;
+  void EraseLaterThan(Time min_time) noexcept;
+
+  void EnforceTimeWindow(Time latest_time) noexcept;
+
+  /**
+   * @see Trace::EraseDelta()
+   */
+  bool EraseDelta(unsigned target_size, Time recent = {}) noexcept;
+
+  void Thin2() noexcept;
+  void Thin() noexcept;
+
+  [[gnu::pure]]
+  unsigned CalcAverageDeltaDistance(Time no_thin) const noexcept;
+
+  [[gnu::pure]]
+  Time CalcAverageDeltaTime(Time no_thin) const noexcept;
+
+  /* binary heap of point indices, ordered like Trace::DeltaList */
+
+  [[gnu::pure]]
+  bool DeltaRank(unsigned a, unsigned b) const noexcept;
+
+  void HeapSiftUp(std::size_t position) noexcept;
+  void HeapSiftDown(std::size_t position) noexcept;
+  void HeapUpdate(unsigned i) noexcept;
+  unsigned HeapPop() noexcept;
+};
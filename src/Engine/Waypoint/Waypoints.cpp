@@ -79,19 +79,24 @@ Waypoints::Waypoints() noexcept = default;
 void
 Waypoints::Optimise() noexcept
 {
-  if (waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds())
-    /* empty or already optimised */
+  if (waypoint_tree.IsEmpty())
     return;
 
-  task_projection.Update();
+  if (!projected) {
+    task_projection.Update();
 
-  for (auto &i : waypoint_tree) {
-    // TODO: eliminate this const_cast hack
-    Waypoint &w = const_cast<Waypoint &>(*i);
-    w.Project(task_projection);
-  }
+    for (auto &i : waypoint_tree) {
+      // TODO: eliminate this const_cast hack
+      Waypoint &w = const_cast<Waypoint &>(*i);
+      w.Project(task_projection);
+    }
+
+    projected = true;
 
-  waypoint_tree.Optimise();
+    /* the positions have changed */
+    waypoint_tree.Build();
+  } else
+    waypoint_tree.Optimise();
 }
 
 void
@@ -100,16 +105,19 @@ Waypoints::Append(WaypointPtr wp) noexcept
   // TODO: eliminate this const_cast hack
   Waypoint &w = const_cast<Waypoint &>(*wp);
 
-  if (waypoint_tree.HaveBounds()) {
-    w.Project(task_projection);
-    if (!waypoint_tree.IsWithinBounds(wp))
-      ScheduleOptimise();
-  } else if (IsEmpty())
+  if (IsEmpty()) {
     task_projection.Reset(w.location);
+    ScheduleOptimise();
+  }
 
   w.flags.watched = w.origin == WaypointOrigin::WATCHED;
 
-  task_projection.Scan(w.location);
+  if (task_projection.Scan(w.location))
+    /* outside of the projection bounds */
+    ScheduleOptimise();
+  else if (projected)
+    w.Project(task_projection);
+
   w.id = next_id++;
 
   waypoint_tree.Add(wp);
@@ -118,6 +126,15 @@ Waypoints::Append(WaypointPtr wp) noexcept
   ++serial;
 }
 
+void
+Waypoints::Append(std::vector<WaypointPtr> &&list) noexcept
+{
+  for (auto &wp : list)
+    Append(std::move(wp));
+
+  list.clear();
+}
+
 WaypointPtr
 Waypoints::GetNearest(const GeoPoint &loc, double range) const noexcept
 {
@@ -129,10 +146,10 @@ Waypoints::GetNearest(const GeoPoint &loc, double range) const noexcept
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
   const auto found = waypoint_tree.FindNearest(point, mrange);
 
-  if (found.first == waypoint_tree.end())
+  if (found == waypoint_tree.end())
     return nullptr;
 
-  return *found.first;
+  return *found;
 }
 
 static constexpr bool
@@ -162,10 +179,10 @@ Waypoints::GetNearestIf(const GeoPoint &loc, double range,
                                                    return predicate(*ptr);
                                                  });
 
-  if (found.first == waypoint_tree.end())
+  if (found == waypoint_tree.end())
     return nullptr;
 
-  return *found.first;
+  return *found;
 }
 
 WaypointPtr
@@ -253,6 +270,7 @@ Waypoints::Clear() noexcept
   home = nullptr;
   name_tree.Clear();
   waypoint_tree.clear();
+  projected = false;
   next_id = 1;
 }
 
@@ -266,10 +284,10 @@ Waypoints::Erase(WaypointPtr &&wp) noexcept
                                        [&wp](const WaypointPtr &ptr){
                                          return ptr == wp;
                                        });
-  assert(f.first != waypoint_tree.end());
+  assert(f != waypoint_tree.end());
 
   name_tree.Remove(std::move(wp));
-  waypoint_tree.erase(f.first);
+  waypoint_tree.erase(f);
   ++serial;
 }
 
@@ -288,6 +306,11 @@ Waypoints::EraseUserMarkers() noexcept
       } else
         return false;
     });
+
+  /* erasing an indexed marker drops the whole index; rebuild it, or
+     all queries would scan the waypoints linearly */
+  if (projected)
+    waypoint_tree.Optimise();
 }
 
 void
@@ -299,15 +322,12 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement) noexcept
 
   replacement.id = orig->id;
 
-  if (waypoint_tree.HaveBounds()) {
+  if (task_projection.Scan(replacement.location))
+    /* outside of the projection bounds */
+    ScheduleOptimise();
+  else if (projected)
     replacement.Project(task_projection);
 
-    const WaypointTree::Point point(replacement.flat_location.x,
-                                    replacement.flat_location.y);
-    if (!waypoint_tree.IsWithinBounds(point))
-      ScheduleOptimise();
-  }
-
   WaypointPtr new_ptr(new Waypoint(std::move(replacement)));
   name_tree.Add(new_ptr);
 
@@ -315,9 +335,9 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement) noexcept
                                        [&orig](const WaypointPtr &ptr){
                                          return ptr == orig;
                                        });
-  assert(f.first != waypoint_tree.end());
+  assert(f != waypoint_tree.end());
 
-  waypoint_tree.Replace(f.first, std::move(new_ptr));
+  waypoint_tree.Replace(f, std::move(new_ptr));
 
   ++serial;
 }
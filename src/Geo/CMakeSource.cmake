@@ -19,6 +19,7 @@ set(_SOURCES
         Geo/Math.cpp # aug: von mir umgenannt
         Geo/Memento/DistanceMemento.cpp
         Geo/Memento/GeoVectorMemento.cpp
+        Geo/PolygonIndex.cpp
         Geo/Quadrilateral.cpp
         Geo/SearchPoint.cpp
         Geo/SearchPointVector.cpp
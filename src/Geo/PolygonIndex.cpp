@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "PolygonIndex.hpp"
+#include "SearchPointVector.hpp"
+#include "util/Compiler.h"
+
+#include <cassert>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* NEON supports double precision only on AArch64 */
+#if defined(__aarch64__) || defined(__SSE2__)
+#define HAVE_SIMD_DOUBLE
+#endif
+
+/**
+ * Aim for this many edges per latitude band.
+ */
+static constexpr std::size_t EDGES_PER_BAND = 8;
+
+static constexpr std::size_t MAX_BANDS = 1024;
+
+PolygonIndex::PolygonIndex(const SearchPointVector &border) noexcept
+{
+  assert(border.size() >= 2);
+
+  const std::size_t n_edges = border.size() - 1;
+
+  min_y = max_y = border.front().GetLocation().latitude.Native();
+  for (const auto &i : border) {
+    const double y = i.GetLocation().latitude.Native();
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+  }
+
+  const std::size_t n_bands =
+    std::clamp<std::size_t>(n_edges / EDGES_PER_BAND, 1, MAX_BANDS);
+  band_scale = max_y > min_y ? n_bands / (max_y - min_y) : 0;
+
+  /* counting sort: an edge goes into each band its latitude range
+     overlaps; since GetBand() is monotonic, the band of any latitude
+     within an edge's range is within the edge's band range */
+
+  band_offsets.assign(n_bands + 1, 0);
+
+  const auto BandRange = [this](const SearchPoint &a, const SearchPoint &b){
+    const double ya = a.GetLocation().latitude.Native();
+    const double yb = b.GetLocation().latitude.Native();
+    return std::make_pair(GetBand(std::min(ya, yb)),
+                          GetBand(std::max(ya, yb)));
+  };
+
+  for (auto i = border.begin(), next = std::next(i); next != border.end();
+       i = next, next = std::next(i)) {
+    if (i->GetLocation().latitude == next->GetLocation().latitude)
+      continue;
+
+    const auto [first, last] = BandRange(*i, *next);
+    for (unsigned b = first; b <= last; ++b)
+      ++band_offsets[b + 1];
+  }
+
+  for (std::size_t b = 0; b < n_bands; ++b)
+    band_offsets[b + 1] += band_offsets[b];
+
+  const std::size_t n = band_offsets.back();
+  x0.resize(n);
+  y0.resize(n);
+  x1.resize(n);
+  y1.resize(n);
+
+  std::vector<uint32_t> fill(band_offsets.begin(), band_offsets.end() - 1);
+
+  for (auto i = border.begin(), next = std::next(i); next != border.end();
+       i = next, next = std::next(i)) {
+    if (i->GetLocation().latitude == next->GetLocation().latitude)
+      continue;
+
+    const auto [first, last] = BandRange(*i, *next);
+    for (unsigned b = first; b <= last; ++b) {
+      const uint32_t j = fill[b]++;
+      x0[j] = i->GetLocation().longitude.Native();
+      y0[j] = i->GetLocation().latitude.Native();
+      x1[j] = next->GetLocation().longitude.Native();
+      y1[j] = next->GetLocation().latitude.Native();
+    }
+  }
+}
+
+void
+PolygonIndex::Project(const SearchPointVector &border) noexcept
+{
+  flat_x.resize(border.size());
+  flat_y.resize(border.size());
+
+  for (std::size_t i = 0; i < border.size(); ++i) {
+    flat_x[i] = border[i].GetFlatLocation().x;
+    flat_y[i] = border[i].GetFlatLocation().y;
+  }
+}
+
+inline unsigned
+PolygonIndex::GetBand(double y) const noexcept
+{
+  const std::size_t n_bands = band_offsets.size() - 1;
+  const double b = (y - min_y) * band_scale;
+  if (!(b > 0))
+    return 0;
+  if (b >= n_bands)
+    return n_bands - 1;
+  return unsigned(b);
+}
+
+/*
+ * The winding number kernels.  Each one evaluates, for the edges
+ * [i, end):
+ *
+ *   left = (x1 - x0) * (py - y0) - (px - x0) * (y1 - y0)
+ *   wn += y0 <= py && y1 > py && left > 0   (upward crossing)
+ *   wn -= y0 > py && y1 <= py && left < 0   (downward crossing)
+ *
+ * which is the same calculation as PolygonInterior().
+ */
+
+static inline int
+WindingNumberPortable(const double *gcc_restrict x0,
+                      const double *gcc_restrict y0,
+                      const double *gcc_restrict x1,
+                      const double *gcc_restrict y1,
+                      std::size_t i, std::size_t end,
+                      double px, double py) noexcept
+{
+  int wn = 0;
+
+  for (; i < end; ++i) {
+    const double left = (x1[i] - x0[i]) * (py - y0[i]) -
+      (px - x0[i]) * (y1[i] - y0[i]);
+
+    if (y0[i] <= py) {
+      if (y1[i] > py && left > 0)
+        ++wn;
+    } else {
+      if (y1[i] <= py && left < 0)
+        --wn;
+    }
+  }
+
+  return wn;
+}
+
+#if defined(__aarch64__)
+
+[[gnu::always_inline]]
+static inline int
+WindingNumberSIMD(const double *gcc_restrict x0,
+                  const double *gcc_restrict y0,
+                  const double *gcc_restrict x1,
+                  const double *gcc_restrict y1,
+                  std::size_t &i, std::size_t end,
+                  double px, double py) noexcept
+{
+  const float64x2_t vpx = vdupq_n_f64(px), vpy = vdupq_n_f64(py);
+  const float64x2_t zero = vdupq_n_f64(0);
+
+  /* each comparison yields all bits set (-1) in lanes where it is
+     true */
+  int64x2_t wn = vdupq_n_s64(0);
+
+  for (; i + 2 <= end; i += 2) {
+    const float64x2_t ax = vld1q_f64(x0 + i), ay = vld1q_f64(y0 + i);
+    const float64x2_t bx = vld1q_f64(x1 + i), by = vld1q_f64(y1 + i);
+
+    const float64x2_t left =
+      vsubq_f64(vmulq_f64(vsubq_f64(bx, ax), vsubq_f64(vpy, ay)),
+                vmulq_f64(vsubq_f64(vpx, ax), vsubq_f64(by, ay)));
+
+    const uint64x2_t up = vandq_u64(vandq_u64(vcleq_f64(ay, vpy),
+                                              vcgtq_f64(by, vpy)),
+                                    vcgtq_f64(left, zero));
+    const uint64x2_t down = vandq_u64(vandq_u64(vcgtq_f64(ay, vpy),
+                                                vcleq_f64(by, vpy)),
+                                      vcltq_f64(left, zero));
+
+    wn = vsubq_s64(wn, vreinterpretq_s64_u64(up));
+    wn = vaddq_s64(wn, vreinterpretq_s64_u64(down));
+  }
+
+  return vaddvq_s64(wn);
+}
+
+#elif defined(__SSE2__)
+
+[[gnu::always_inline]]
+static inline int
+WindingNumberSIMD(const double *gcc_restrict x0,
+                  const double *gcc_restrict y0,
+                  const double *gcc_restrict x1,
+                  const double *gcc_restrict y1,
+                  std::size_t &i, std::size_t end,
+                  double px, double py) noexcept
+{
+  const __m128d vpx = _mm_set1_pd(px), vpy = _mm_set1_pd(py);
+  const __m128d zero = _mm_setzero_pd();
+
+  /* each comparison yields all bits set (-1) in lanes where it is
+     true */
+  __m128i wn = _mm_setzero_si128();
+
+  for (; i + 2 <= end; i += 2) {
+    const __m128d ax = _mm_loadu_pd(x0 + i), ay = _mm_loadu_pd(y0 + i);
+    const __m128d bx = _mm_loadu_pd(x1 + i), by = _mm_loadu_pd(y1 + i);
+
+    const __m128d left =
+      _mm_sub_pd(_mm_mul_pd(_mm_sub_pd(bx, ax), _mm_sub_pd(vpy, ay)),
+                 _mm_mul_pd(_mm_sub_pd(vpx, ax), _mm_sub_pd(by, ay)));
+
+    const __m128d up = _mm_and_pd(_mm_and_pd(_mm_cmple_pd(ay, vpy),
+                                             _mm_cmpgt_pd(by, vpy)),
+                                  _mm_cmpgt_pd(left, zero));
+    const __m128d down = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(ay, vpy),
+                                               _mm_cmple_pd(by, vpy)),
+                                    _mm_cmplt_pd(left, zero));
+
+    wn = _mm_sub_epi64(wn, _mm_castpd_si128(up));
+    wn = _mm_add_epi64(wn, _mm_castpd_si128(down));
+  }
+
+  alignas(16) int64_t result[2];
+  _mm_store_si128((__m128i *)result, wn);
+  return result[0] + result[1];
+}
+
+#endif
+
+[[gnu::hot]]
+bool
+PolygonIndex::IsInside(const GeoPoint &p) const noexcept
+{
+  const double px = p.longitude.Native(), py = p.latitude.Native();
+
+  /* no edge can cross a latitude outside of this range */
+  if (!(py >= min_y && py < max_y))
+    return false;
+
+  const unsigned band = GetBand(py);
+  std::size_t i = band_offsets[band];
+  const std::size_t end = band_offsets[band + 1];
+
+  int wn = 0;
+
+#ifdef HAVE_SIMD_DOUBLE
+  wn += WindingNumberSIMD(x0.data(), y0.data(), x1.data(), y1.data(),
+                          i, end, px, py);
+#endif
+
+  /* the remainder (or everything on other CPUs) */
+  wn += WindingNumberPortable(x0.data(), y0.data(), x1.data(), y1.data(),
+                              i, end, px, py);
+
+  return wn != 0;
+}
+
+/*
+ * The bounding box kernels: edge k (from vertex k to vertex k+1) is
+ * skipped if both of its vertices are on the outer side of the same
+ * box border.
+ */
+
+static inline bool
+IsEdgeNearPortable(const int32_t *x, const int32_t *y, std::size_t k,
+                   FlatGeoPoint lower, FlatGeoPoint upper) noexcept
+{
+  return !((x[k] > upper.x && x[k + 1] > upper.x) ||
+           (x[k] < lower.x && x[k + 1] < lower.x) ||
+           (y[k] > upper.y && y[k + 1] > upper.y) ||
+           (y[k] < lower.y && y[k + 1] < lower.y));
+}
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+/**
+ * Returns a 4 bit mask of the lanes which are not set.
+ */
+[[gnu::always_inline]]
+static inline unsigned
+NotMask4(uint32x4_t m) noexcept
+{
+  static constexpr uint32_t bits[4] = {1, 2, 4, 8};
+  const uint32x4_t x = vbicq_u32(vld1q_u32(bits), m);
+  uint32x2_t s = vpadd_u32(vget_low_u32(x), vget_high_u32(x));
+  s = vpadd_u32(s, s);
+  return vget_lane_u32(s, 0);
+}
+
+[[gnu::always_inline]]
+static inline unsigned
+FindEdgesNear4(const int32_t *x, const int32_t *y, std::size_t k,
+               int32x4_t lower_x, int32x4_t lower_y,
+               int32x4_t upper_x, int32x4_t upper_y) noexcept
+{
+  const int32x4_t ax = vld1q_s32(x + k), bx = vld1q_s32(x + k + 1);
+  const int32x4_t ay = vld1q_s32(y + k), by = vld1q_s32(y + k + 1);
+
+  uint32x4_t far = vandq_u32(vcgtq_s32(ax, upper_x), vcgtq_s32(bx, upper_x));
+  far = vorrq_u32(far, vandq_u32(vcltq_s32(ax, lower_x),
+                                 vcltq_s32(bx, lower_x)));
+  far = vorrq_u32(far, vandq_u32(vcgtq_s32(ay, upper_y),
+                                 vcgtq_s32(by, upper_y)));
+  far = vorrq_u32(far, vandq_u32(vcltq_s32(ay, lower_y),
+                                 vcltq_s32(by, lower_y)));
+
+  return NotMask4(far);
+}
+
+#elif defined(__SSE2__)
+
+[[gnu::always_inline]]
+static inline unsigned
+FindEdgesNear4(const int32_t *x, const int32_t *y, std::size_t k,
+               __m128i lower_x, __m128i lower_y,
+               __m128i upper_x, __m128i upper_y) noexcept
+{
+  const __m128i ax = _mm_loadu_si128((const __m128i *)(x + k));
+  const __m128i bx = _mm_loadu_si128((const __m128i *)(x + k + 1));
+  const __m128i ay = _mm_loadu_si128((const __m128i *)(y + k));
+  const __m128i by = _mm_loadu_si128((const __m128i *)(y + k + 1));
+
+  __m128i far = _mm_and_si128(_mm_cmpgt_epi32(ax, upper_x),
+                              _mm_cmpgt_epi32(bx, upper_x));
+  far = _mm_or_si128(far, _mm_and_si128(_mm_cmplt_epi32(ax, lower_x),
+                                        _mm_cmplt_epi32(bx, lower_x)));
+  far = _mm_or_si128(far, _mm_and_si128(_mm_cmpgt_epi32(ay, upper_y),
+                                        _mm_cmpgt_epi32(by, upper_y)));
+  far = _mm_or_si128(far, _mm_and_si128(_mm_cmplt_epi32(ay, lower_y),
+                                        _mm_cmplt_epi32(by, lower_y)));
+
+  return ~_mm_movemask_ps(_mm_castsi128_ps(far)) & 0xf;
+}
+
+#endif
+
+[[gnu::hot]]
+uint32_t
+PolygonIndex::FindEdgesNear(std::size_t first,
+                            FlatGeoPoint lower,
+                            FlatGeoPoint upper) const noexcept
+{
+  const std::size_t end = std::min(first + 32, GetEdgeCount());
+  const int32_t *x = flat_x.data(), *y = flat_y.data();
+
+  uint32_t mask = 0;
+  std::size_t k = first;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+  const int32x4_t lower_x = vdupq_n_s32(lower.x);
+  const int32x4_t lower_y = vdupq_n_s32(lower.y);
+  const int32x4_t upper_x = vdupq_n_s32(upper.x);
+  const int32x4_t upper_y = vdupq_n_s32(upper.y);
+#elif defined(__SSE2__)
+  const __m128i lower_x = _mm_set1_epi32(lower.x);
+  const __m128i lower_y = _mm_set1_epi32(lower.y);
+  const __m128i upper_x = _mm_set1_epi32(upper.x);
+  const __m128i upper_y = _mm_set1_epi32(upper.y);
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__SSE2__)
+  /* each step reads the vertices [k, k+5) */
+  for (; k + 4 <= end; k += 4)
+    mask |= FindEdgesNear4(x, y, k, lower_x, lower_y, upper_x, upper_y)
+      << (k - first);
+#endif
+
+  /* the remainder (or everything on other CPUs) */
+  for (; k < end; ++k)
+    if (IsEdgeNearPortable(x, y, k, lower, upper))
+      mask |= uint32_t(1) << (k - first);
+
+  return mask;
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Flat/FlatGeoPoint.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct GeoPoint;
+class SearchPointVector;
+
+/**
+ * Acceleration structure for point-in-polygon and segment
+ * intersection tests on a large closed #SearchPointVector (e.g. the
+ * border of an airspace with thousands of vertices).
+ *
+ * For the point-in-polygon test, the geographic edges are copied
+ * into structure-of-arrays form and sorted into latitude bands; a
+ * query only evaluates the edges overlapping the band of the query
+ * point, several at a time with SSE2/NEON.  The result is exactly
+ * the same as PolygonInterior().
+ *
+ * For segment intersections, a structure-of-arrays copy of the flat
+ * (projected) vertices allows skipping all edges whose bounding box
+ * does not overlap the segment's, again with SSE2/NEON.
+ */
+class PolygonIndex {
+  /**
+   * The geographic edges (longitude/latitude in radians), sorted by
+   * band.  Horizontal edges are omitted, because they never cross a
+   * latitude.
+   */
+  std::vector<double> x0, y0, x1, y1;
+
+  /**
+   * The edges of band b are [band_offsets[b], band_offsets[b+1]).
+   */
+  std::vector<uint32_t> band_offsets;
+
+  double min_y, max_y, band_scale;
+
+  /**
+   * The flat vertices, copied by Project().
+   */
+  std::vector<int32_t> flat_x, flat_y;
+
+public:
+  /**
+   * Polygons with fewer vertices are fast enough without an index.
+   */
+  static constexpr std::size_t MIN_SIZE = 64;
+
+  /**
+   * @param border a closed polygon (the first and the last point are
+   * the same)
+   */
+  explicit PolygonIndex(const SearchPointVector &border) noexcept;
+
+  /**
+   * Copy the flat locations of the border; must be called after each
+   * SearchPointVector::Project() call.
+   */
+  void Project(const SearchPointVector &border) noexcept;
+
+  /**
+   * Like PolygonInterior(), but faster.
+   */
+  [[gnu::pure]]
+  bool IsInside(const GeoPoint &p) const noexcept;
+
+  /**
+   * Invoke f(i) for each edge (border[i], border[i+1]) which may
+   * intersect the segment between the two given flat points, in
+   * increasing order.  All edges which are skipped are guaranteed
+   * not to intersect it.
+   */
+  template<typename F>
+  void VisitEdgesNear(FlatGeoPoint a, FlatGeoPoint b, F &&f) const {
+    const FlatGeoPoint lower{std::min(a.x, b.x), std::min(a.y, b.y)};
+    const FlatGeoPoint upper{std::max(a.x, b.x), std::max(a.y, b.y)};
+
+    const std::size_t n = GetEdgeCount();
+    for (std::size_t first = 0; first < n; first += 32)
+      for (uint32_t mask = FindEdgesNear(first, lower, upper);
+           mask != 0; mask &= mask - 1)
+        f(first + std::countr_zero(mask));
+  }
+
+private:
+  std::size_t GetEdgeCount() const noexcept {
+    return flat_x.empty() ? 0 : flat_x.size() - 1;
+  }
+
+  [[gnu::pure]]
+  unsigned GetBand(double y) const noexcept;
+
+  /**
+   * Returns a bit mask of the edges [first, first+32) whose bounding
+   * box overlaps the given box.
+   */
+  [[gnu::pure]]
+  uint32_t FindEdgesNear(std::size_t first,
+                         FlatGeoPoint lower,
+                         FlatGeoPoint upper) const noexcept;
+};
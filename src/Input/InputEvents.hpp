@@ -195,6 +195,7 @@ void eventRunLuaFile(const char *misc);
 void eventResetTask(const char *misc);
 void eventLockScreen(const char *misc);
 void eventExchangeFrequencies(const char *misc);
+void eventProfiler(const char *misc);
 #if  1 // def IS_OPENVARIO
 void eventShutdown(const char *misc);
 #endif
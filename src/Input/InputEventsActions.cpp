@@ -80,6 +80,9 @@ https://xcsoar.readthedocs.io/en/latest/input_events.html
 #include "Interface.hpp"
 #include "InfoBoxes/Content/Thermal.hpp"
 #include "Terrain/RasterTerrain.hpp"
+#include "Screen/Profiler.hpp"
+#include "LocalPath.hpp"
+#include "system/Path.hpp"
 
 #include <cassert>
 #include <algorithm>
@@ -856,6 +859,42 @@ InputEvents::eventExchangeFrequencies([[maybe_unused]] const char *misc)
   XCSoarInterface::ExchangeRadioFrequencies(true);
 }
 
+// Profiler
+// Controls the built-in profiler which records the duration of the
+// map rendering and calculation phases
+//  on: start recording
+//  off: stop recording
+//  toggle: toggle recording
+//  reset: forget all samples
+//  save: write a summary to profiler.csv in the data directory
+void
+InputEvents::eventProfiler(const char *misc)
+{
+  if (StringIsEqual(misc, "on"))
+    Profiler::SetEnabled(true);
+  else if (StringIsEqual(misc, "off"))
+    Profiler::SetEnabled(false);
+  else if (StringIsEqual(misc, "toggle"))
+    Profiler::SetEnabled(!Profiler::IsEnabled());
+  else if (StringIsEqual(misc, "reset")) {
+    Profiler::Clear();
+    return;
+  } else if (StringIsEqual(misc, "save")) {
+    try {
+      Profiler::SaveCSV(LocalPath("profiler.csv"));
+      Message::AddMessage(_("Profiler data saved"));
+    } catch (...) {
+      ShowError(std::current_exception(), _("Failed to save file."));
+    }
+    return;
+  } else
+    return;
+
+  Message::AddMessage(Profiler::IsEnabled()
+                      ? _("Profiler on")
+                      : _("Profiler off"));
+}
+
 void
 InputEvents::eventUploadIGCFile([[maybe_unused]] const char *misc) {
   FileDataField df;
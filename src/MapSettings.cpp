@@ -25,6 +25,7 @@ MapSettings::SetDefaults() noexcept
   circle_zoom_enabled = true;
   max_auto_zoom_distance = 100000; /* 100 km */
   topography_enabled = true;
+  static_layer_cache_enabled = false;
   terrain.SetDefaults();
   aircraft_symbol = AircraftSymbol::SIMPLE;
   detour_cost_markers_enabled = false;
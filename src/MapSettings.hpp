@@ -115,6 +115,12 @@ struct MapSettings {
   /** Map will show topography */
   bool topography_enabled;
 
+  /**
+   * Render terrain and topography into an off-screen texture and
+   * reuse it while the map moves (OpenGL only)
+   */
+  bool static_layer_cache_enabled;
+
   TerrainRendererSettings terrain;
 
   AircraftSymbol aircraft_symbol;
@@ -24,6 +24,7 @@ set(_SOURCES
         MapWindow/MapWindowTraffic.cpp
         MapWindow/MapWindowTrail.cpp
         MapWindow/MapWindowWaypoints.cpp
+        MapWindow/StaticLayerCache.cpp
         MapWindow/StencilMapCanvas.cpp
         MapWindow/TargetMapWindow.cpp
         MapWindow/TargetMapWindowDrag.cpp
@@ -104,10 +104,9 @@ GlueMapWindow::ExchangeBlackboard() noexcept
   /* copy device_blackboard to MapWindow */
 
   {
-    auto &device_blackboard = *backend_components->device_blackboard;
-    const std::lock_guard lock{device_blackboard.mutex};
-    ReadBlackboard(device_blackboard.Basic(),
-                   device_blackboard.Calculated());
+    const auto &device_blackboard = *backend_components->device_blackboard;
+    ReadBlackboard(device_blackboard.LeaseBasic(),
+                   device_blackboard.LeaseCalculated());
   }
 
 #ifndef ENABLE_OPENGL
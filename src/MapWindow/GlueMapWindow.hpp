@@ -239,6 +239,12 @@ protected:
   bool OnMouseGesture(const char* gesture) noexcept;
 
 private:
+  /**
+   * Copy the cache statistics of terrain and topography to the
+   * #Profiler.
+   */
+  void UpdateProfilerCounters() const noexcept;
+
   void DrawGesture(Canvas &canvas) const noexcept;
   void DrawMapScale(Canvas &canvas, const PixelRect &rc,
                     const MapWindowProjection &projection) const noexcept;
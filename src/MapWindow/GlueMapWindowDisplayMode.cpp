@@ -108,8 +108,24 @@ GlueMapWindow::UpdateScreenBounds() noexcept
      it's used by other calculations, therefore don't check if terrain
      display is enabled */
   if (terrain_thread != nullptr &&
-      visible_projection.IsValid())
+      visible_projection.IsValid()) {
     terrain_thread->Trigger(visible_projection);
+
+    /* while cruising, load the tiles ahead of the aircraft before
+       they scroll into view */
+    const NMEAInfo &basic = CommonInterface::Basic();
+    const DerivedInfo &calculated = CommonInterface::Calculated();
+    if (basic.location_available && basic.track_available &&
+        basic.MovementDetected() && !calculated.circling) {
+      const auto &stats = calculated.task_stats;
+      terrain_thread->SetPrefetchHint(basic.location, basic.track,
+                                      basic.ground_speed,
+                                      stats.task_valid
+                                      ? stats.current_leg.location_remaining
+                                      : GeoPoint::Invalid());
+    } else
+      terrain_thread->ClearPrefetchHint();
+  }
 }
 
 void
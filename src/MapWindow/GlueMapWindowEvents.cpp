@@ -11,6 +11,8 @@
 #include "Interface.hpp"
 #include "Pan.hpp"
 #include "Topography/Thread.hpp"
+#include "Terrain/TerrainRenderer.hpp"
+#include "Screen/Profiler.hpp"
 #include "Asset.hpp"
 #include "Components.hpp"
 #include "BackendComponents.hpp"
@@ -410,6 +412,9 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas) noexcept
 
   MapWindow::OnPaintBuffer(canvas);
 
+  if (Profiler::IsEnabled())
+    UpdateProfilerCounters();
+
   DrawMapScale(canvas, GetClientRect(), render_projection);
   if (IsPanning())
     DrawPanInfo(canvas);
@@ -419,6 +424,28 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas) noexcept
 #endif
 }
 
+void
+GlueMapWindow::UpdateProfilerCounters() const noexcept
+{
+  if (const auto *terrain_renderer = background.GetTerrainRenderer()) {
+    const auto s = terrain_renderer->GetStatistics();
+    Profiler::SetCounter("Terrain", "ImageHits", s.hits);
+    Profiler::SetCounter("Terrain", "ImageMisses", s.misses);
+#ifdef ENABLE_OPENGL
+    Profiler::SetCounter("Terrain", "ReusedCells", s.reused_cells);
+    Profiler::SetCounter("Terrain", "ScannedCells", s.scanned_cells);
+#endif
+  }
+
+  if (topography_thread != nullptr) {
+    const auto s = topography_thread->GetStatistics();
+    Profiler::SetCounter("Topography", "ShapeHits", s.hits);
+    Profiler::SetCounter("Topography", "ShapeMisses", s.misses);
+    Profiler::SetCounter("Topography", "ShapeEvictions", s.evictions);
+    Profiler::SetCounter("Topography", "ResidentShapes", s.resident);
+  }
+}
+
 void
 GlueMapWindow::OnMapItemTimer() noexcept
 {
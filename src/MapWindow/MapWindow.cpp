@@ -67,6 +67,9 @@ void
 MapWindow::FlushCaches() noexcept
 {
   background.Flush();
+#ifdef ENABLE_OPENGL
+  static_layer_cache.Invalidate();
+#endif
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
@@ -6,7 +6,10 @@
 #include "Projection/MapWindowProjection.hpp"
 #include "Renderer/AirspaceRenderer.hpp"
 #include "ui/window/DoubleBufferWindow.hpp"
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+#include "StaticLayerCache.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#else
 #include "ui/canvas/BufferCanvas.hpp"
 #endif
 #include "Renderer/LabelBlock.hpp"
@@ -130,6 +133,24 @@ protected:
   const TrafficLook &traffic_look;
 
   BackgroundRenderer background;
+
+#ifdef ENABLE_OPENGL
+  /**
+   * Caches terrain and topography; see RenderStaticLayers().
+   */
+  StaticLayerCache static_layer_cache;
+
+  /**
+   * The inputs which #static_layer_cache was rendered with (apart
+   * from the projection).
+   */
+  struct {
+    TerrainRendererSettings terrain;
+    unsigned topography_serial;
+    bool topography_enabled;
+  } static_layer_state{};
+#endif
+
   WaypointRenderer waypoint_renderer;
 
   AirspaceRenderer airspace_renderer;
@@ -371,6 +392,20 @@ private:
    */
   void RenderTerrain(Canvas &canvas) noexcept;
 
+#ifdef ENABLE_OPENGL
+  [[gnu::pure]]
+  bool IsStaticLayerCacheUsable() const noexcept;
+
+  /**
+   * Draws terrain and topography from the #StaticLayerCache, after
+   * rendering them into it if necessary.
+   *
+   * @return false if the cache cannot be used; the caller must then
+   * draw these layers directly
+   */
+  bool RenderStaticLayers() noexcept;
+#endif
+
   void RenderRasp(Canvas &canvas) noexcept;
 
 #ifdef HAVE_SKYSIGHT
@@ -15,6 +15,7 @@
 # include "Weather/Skysight/Skysight.hpp"
 #endif
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
 #include "Operation/Operation.hpp"
@@ -26,6 +27,10 @@
 #include "Weather/NOAAStore.hpp"
 #endif
 
+#ifdef ENABLE_OPENGL
+#include "ui/opengl/System.hpp"
+#endif
+
 void
 MapWindow::RenderTrackBearing(Canvas &canvas,
                               const PixelPoint aircraft_pos) noexcept
@@ -42,6 +47,86 @@ MapWindow::RenderTerrain(Canvas &canvas) noexcept
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
 }
 
+#ifdef ENABLE_OPENGL
+
+bool
+MapWindow::IsStaticLayerCacheUsable() const noexcept
+{
+  if (!GetMapSettings().static_layer_cache_enabled ||
+      !StaticLayerCache::IsSupported(render_projection.GetScreenSize()))
+    return false;
+
+  /* RASP and SkySight are drawn between terrain and topography */
+  if (rasp_store != nullptr && GetUIState().weather.map >= 0)
+    return false;
+
+#ifdef HAVE_SKYSIGHT
+  if (skysight != nullptr && skysight->GetActiveLayer() != nullptr)
+    return false;
+#endif
+
+  return true;
+}
+
+bool
+MapWindow::RenderStaticLayers() noexcept
+{
+  if (!IsStaticLayerCacheUsable()) {
+    static_layer_cache.Invalidate();
+    return false;
+  }
+
+  const auto &settings = GetMapSettings();
+  const bool topography_enabled = topography_renderer != nullptr &&
+    settings.topography_enabled;
+  const unsigned topography_serial = topography_enabled
+    ? topography->GetSerial()
+    : 0;
+
+  background.SetShadingAngle(render_projection, settings.terrain,
+                             Calculated());
+
+  bool dirty = !static_layer_cache.Check(render_projection) ||
+    settings.terrain != static_layer_state.terrain ||
+    topography_enabled != static_layer_state.topography_enabled ||
+    topography_serial != static_layer_state.topography_serial;
+
+  /* the terrain renderer may have loaded more tiles or changed the
+     sun azimuth; in that case, it has a new image for us */
+  if (!dirty)
+    dirty = background.Update(static_layer_cache.GetProjection(),
+                              settings.terrain);
+
+  if (dirty) {
+    /* the buffer is larger than the screen; don't let the map
+       window's clipping rectangle cut it */
+    const bool scissor = glIsEnabled(GL_SCISSOR_TEST);
+    if (scissor)
+      glDisable(GL_SCISSOR_TEST);
+
+    Canvas &buffer = static_layer_cache.Begin(render_projection);
+    const WindowProjection &projection = static_layer_cache.GetProjection();
+
+    background.Draw(buffer, projection, settings.terrain);
+    if (topography_enabled)
+      topography_renderer->Draw(buffer, projection);
+
+    static_layer_cache.Commit();
+
+    if (scissor)
+      glEnable(GL_SCISSOR_TEST);
+
+    static_layer_state.terrain = settings.terrain;
+    static_layer_state.topography_enabled = topography_enabled;
+    static_layer_state.topography_serial = topography_serial;
+  }
+
+  static_layer_cache.Draw(render_projection);
+  return true;
+}
+
+#endif
+
 inline void
 MapWindow::RenderRasp(Canvas &canvas) noexcept
 {
@@ -217,7 +302,13 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
 
   // Render terrain, groundline and topography
   draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
+#ifdef ENABLE_OPENGL
+  const bool static_layers_cached = RenderStaticLayers();
+#else
+  constexpr bool static_layers_cached = false;
+#endif
+  if (!static_layers_cached)
+    RenderTerrain(canvas);
 
 #ifdef HAVE_SKYSIGHT
   if (skysight != nullptr && skysight->GetActiveLayer() != nullptr) {
@@ -234,7 +325,8 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   }
 
   draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
+  if (!static_layers_cached)
+    RenderTopography(canvas);
 
   draw_sw.Mark("RenderOverlays");
   RenderOverlays(canvas);
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "StaticLayerCache.hpp"
+
+#ifdef ENABLE_OPENGL
+
+#include "ui/dim/BulkPoint.hpp"
+
+#include <cassert>
+#include <cmath>
+
+/**
+ * The buffer is this much larger than the screen diagonal, so the
+ * map can move by a few hundred pixels before the cache has to be
+ * rendered again.
+ */
+static constexpr double MARGIN_FACTOR = 1.5;
+
+static unsigned
+GetMaxTextureSize() noexcept
+{
+  static GLint max_texture_size = 0;
+  if (max_texture_size == 0)
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+
+  return max_texture_size;
+}
+
+[[gnu::const]]
+static unsigned
+GetScreenDiagonal(PixelSize size) noexcept
+{
+  return (unsigned)std::ceil(std::hypot(size.width, size.height));
+}
+
+/**
+ * @return the width and height of the (square) buffer
+ */
+static unsigned
+GetBufferSize(PixelSize screen_size) noexcept
+{
+  return std::min((unsigned)(GetScreenDiagonal(screen_size) * MARGIN_FACTOR),
+                  GetMaxTextureSize());
+}
+
+bool
+StaticLayerCache::IsSupported(PixelSize screen_size) noexcept
+{
+  /* the margin must be large enough to be worth the effort */
+  return GetScreenDiagonal(screen_size) * 5 / 4 <= GetMaxTextureSize();
+}
+
+bool
+StaticLayerCache::Check(const WindowProjection &screen) const noexcept
+{
+  assert(screen.IsValid());
+
+  if (!valid || screen.GetScreenSize() != screen_size ||
+      screen.GetScale() != projection.GetScale())
+    return false;
+
+  const PixelRect rc = screen.GetScreenRect();
+  const PixelRect cache_rc = projection.GetScreenRect();
+  for (const PixelPoint p : {rc.GetTopLeft(), rc.GetTopRight(),
+                             rc.GetBottomLeft(), rc.GetBottomRight()})
+    if (!cache_rc.Contains(projection.GeoToScreen(screen.ScreenToGeo(p))))
+      return false;
+
+  return true;
+}
+
+Canvas &
+StaticLayerCache::Begin(const WindowProjection &screen) noexcept
+{
+  assert(screen.IsValid());
+
+  screen_size = screen.GetScreenSize();
+  const unsigned size = GetBufferSize(screen_size);
+
+  /* same scale and rotation as the screen, centered on the screen's
+     center */
+  projection = screen;
+  projection.SetScreenSize({size, size});
+  projection.SetScreenOrigin(size / 2, size / 2);
+  projection.SetGeoLocation(screen.GetGeoScreenCenter());
+  projection.UpdateScreenBounds();
+
+  if (buffer.IsDefined())
+    buffer.Resize({size, size});
+  else
+    buffer.Create({size, size});
+
+  valid = false;
+  buffer.Begin();
+  return buffer;
+}
+
+void
+StaticLayerCache::Commit() noexcept
+{
+  buffer.Commit();
+  valid = true;
+}
+
+void
+StaticLayerCache::Draw(const WindowProjection &screen) noexcept
+{
+  assert(Check(screen));
+
+  const PixelRect rc = projection.GetScreenRect();
+  const BulkPixelPoint corners[] = {
+    screen.GeoToScreen(projection.ScreenToGeo(rc.GetTopLeft())),
+    screen.GeoToScreen(projection.ScreenToGeo(rc.GetTopRight())),
+    screen.GeoToScreen(projection.ScreenToGeo(rc.GetBottomLeft())),
+    screen.GeoToScreen(projection.ScreenToGeo(rc.GetBottomRight())),
+  };
+
+  buffer.CopyTo(corners);
+}
+
+#endif
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#ifdef ENABLE_OPENGL
+
+#include "Projection/WindowProjection.hpp"
+#include "ui/canvas/BufferCanvas.hpp"
+
+/**
+ * Caches the bottom layers of the map (terrain and topography) in
+ * an off-screen texture.  The texture is larger than the screen and
+ * covers it at all rotations, so it can be reused while the map
+ * moves and rotates at the same scale (e.g. while circling); each
+ * frame then only needs to draw one textured quad.
+ *
+ * This is only implemented on OpenGL; on the other platforms, these
+ * layers are drawn by the #DrawThread and cached by
+ * #TransparentRendererCache and #TerrainRenderer.
+ */
+class StaticLayerCache {
+  BufferCanvas buffer;
+
+  /**
+   * The projection of the #buffer.
+   */
+  WindowProjection projection;
+
+  /**
+   * The screen size the #buffer was rendered for.
+   */
+  PixelSize screen_size{0, 0};
+
+  bool valid = false;
+
+public:
+  /**
+   * Can a cache for a screen of this size be allocated?
+   */
+  static bool IsSupported(PixelSize screen_size) noexcept;
+
+  void Invalidate() noexcept {
+    valid = false;
+  }
+
+  /**
+   * Can the cache be drawn with the given projection, i.e. does it
+   * cover the whole screen at the same scale?
+   */
+  [[gnu::pure]]
+  bool Check(const WindowProjection &screen) const noexcept;
+
+  /**
+   * The projection for rendering into the cache.  Only valid after
+   * Begin() or if Check() has returned true.
+   */
+  const WindowProjection &GetProjection() const noexcept {
+    return projection;
+  }
+
+  /**
+   * Begin rendering the cache for the given screen projection.
+   * Render to the returned #Canvas with GetProjection(), then call
+   * Commit().
+   */
+  Canvas &Begin(const WindowProjection &screen) noexcept;
+
+  void Commit() noexcept;
+
+  /**
+   * Draw the cache to the current frame buffer.  Check() must have
+   * returned true.
+   */
+  void Draw(const WindowProjection &screen) noexcept;
+};
+
+#endif
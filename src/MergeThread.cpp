@@ -41,12 +41,21 @@ MergeThread::Process() noexcept
 
   computer.Fill(device_blackboard.SetMoreData(), settings_computer);
   computer.Compute(device_blackboard.SetMoreData(), last_any, last_fix,
-                   device_blackboard.Calculated());
+                   device_blackboard.LeaseCalculated());
 
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
 }
 
+void
+MergeThread::FirstRun() noexcept
+{
+  assert(!IsDefined());
+
+  Process();
+  device_blackboard.PublishBasic();
+}
+
 void
 MergeThread::Tick() noexcept
 {
@@ -92,6 +101,10 @@ MergeThread::Tick() noexcept
       last_fix = basic;
   }
 
+  /* this is the only thread which modifies Basic(), so it can be
+     copied to the snapshot without holding the lock */
+  device_blackboard.PublishBasic();
+
 #ifdef HAVE_PCM_PLAYER
   if (vario_available)
     AudioVarioGlue::SetValue(vario);
@@ -43,11 +43,7 @@ public:
    * This method is called during XCSoar startup, for the initial run
    * of the MergeThread.
    */
-  void FirstRun() noexcept {
-    assert(!IsDefined());
-
-    Process();
-  }
+  void FirstRun() noexcept;
 
   /**
    * Throws on error.
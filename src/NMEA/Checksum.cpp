@@ -11,23 +11,52 @@
 
 bool
 VerifyNMEAChecksum(const char *p) noexcept
+{
+  return VerifyNMEAChecksumData(p).has_value();
+}
+
+std::optional<std::string_view>
+VerifyNMEAChecksumData(const char *const p) noexcept
 {
   assert(p != nullptr);
 
-  const char *asterisk = strrchr(p, '*');
-  if (asterisk == nullptr)
-    return false;
+  const char *i = p;
+
+  /* skip the dollar sign at the beginning (the exclamation mark is
+     used by CAI302 */
+  if (*i == '$' || *i == '!')
+    ++i;
+
+  /* the checksum covers everything up to the last asterisk, but the
+     data ends at the first one */
+  const char *first_asterisk = nullptr, *last_asterisk = nullptr;
+  uint8_t checksum = 0, CalcCheckSum = 0;
+
+  for (; *i != 0; ++i) {
+    if (*i == '*') {
+      if (first_asterisk == nullptr)
+        first_asterisk = i;
+      last_asterisk = i;
+      CalcCheckSum = checksum;
+    }
+
+    checksum ^= static_cast<uint8_t>(*i);
+  }
+
+  if (last_asterisk == nullptr)
+    return std::nullopt;
 
-  const char *checksum_string = asterisk + 1;
+  const char *checksum_string = last_asterisk + 1;
   char *endptr;
   unsigned long ReadCheckSum2 = strtoul(checksum_string, &endptr, 16);
   if (endptr == checksum_string || *endptr != 0 || ReadCheckSum2 >= 0x100)
-    return false;
+    return std::nullopt;
 
   uint8_t ReadCheckSum = (unsigned char)ReadCheckSum2;
-  uint8_t CalcCheckSum = NMEAChecksum({p, asterisk});
+  if (CalcCheckSum != ReadCheckSum)
+    return std::nullopt;
 
-  return CalcCheckSum == ReadCheckSum;
+  return std::string_view{p, std::size_t(first_asterisk - p)};
 }
 
 void
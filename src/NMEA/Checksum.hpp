@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <string_view>
 
 /**
@@ -63,6 +64,18 @@ NMEAChecksum(std::string_view src) noexcept
 bool
 VerifyNMEAChecksum(const char *p) noexcept;
 
+/**
+ * Like VerifyNMEAChecksum(), but in the same pass, determine the
+ * data portion of the line (everything before the first asterisk),
+ * which can be passed to #NMEAInputLine.
+ *
+ * @return the data portion or std::nullopt if the checksum is
+ * missing or wrong
+ */
+[[nodiscard]] [[gnu::pure]]
+std::optional<std::string_view>
+VerifyNMEAChecksumData(const char *p) noexcept;
+
 /**
  * Caclulates the checksum of the specified string, and appends it at
  * the end, preceded by an asterisk ('*').
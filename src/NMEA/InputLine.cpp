@@ -8,13 +8,10 @@
 
 #include <string.h>
 
+/* the checksum is not part of the data; find the end of the line
+   and the asterisk in one pass */
 NMEAInputLine::NMEAInputLine(const char* line) noexcept
-  :CSVLine(line)
-{
-  const char* asterisk = strchr(line, '*');
-  if (asterisk != NULL)
-    end = asterisk;
-}
+  :CSVLine(std::string_view{line, strcspn(line, "*")}) {}
 
 bool
 NMEAInputLine::ReadBearing(Angle &value_r) noexcept
@@ -15,6 +15,13 @@ class NMEAInputLine: public CSVLine {
 public:
   explicit NMEAInputLine(const char* line) noexcept;
 
+  /**
+   * Construct from the data portion of a line, i.e. without the
+   * asterisk and the checksum (see VerifyNMEAChecksumData()).
+   */
+  explicit NMEAInputLine(std::string_view data) noexcept
+    :CSVLine(data) {}
+
   /**
    * Parses non-negative floating-point angle value in degrees.
    */
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * A NMEA sentence identifier (e.g. "$GPRMC", "$PFLAA" or just "RMC")
+ * packed into an integer.  Packing is injective for identifiers of
+ * up to 8 characters, which makes it a perfect hash that can be used
+ * as a case label:
+ *
+ *   switch (MakeNMEASentenceType(line.ReadView())) {
+ *   case MakeNMEASentenceType("$PFLAU"):
+ *     ...
+ *   }
+ *
+ * This way, the compiler generates the lookup table (or binary
+ * search) instead of a chain of string comparisons.
+ */
+using NMEASentenceType = uint_least64_t;
+
+/**
+ * Returned by MakeNMEASentenceType() for identifiers which are empty
+ * or longer than 8 characters; never matches a known sentence.
+ */
+static constexpr NMEASentenceType INVALID_NMEA_SENTENCE_TYPE = 0;
+
+[[gnu::pure]]
+constexpr NMEASentenceType
+MakeNMEASentenceType(std::string_view type) noexcept
+{
+  if (type.empty() || type.size() > sizeof(NMEASentenceType))
+    return INVALID_NMEA_SENTENCE_TYPE;
+
+  NMEASentenceType value = 0;
+  for (char ch : type)
+    value = (value << 8) | static_cast<unsigned char>(ch);
+
+  return value;
+}
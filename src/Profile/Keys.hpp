@@ -40,6 +40,7 @@ constexpr std::string_view SlopeShading = "SlopeShading";
 constexpr std::string_view SlopeShadingType = "SlopeShadingType";
 constexpr std::string_view TerrainContours = "TerrainContours";
 constexpr std::string_view DrawTopography = "DrawTopology";
+constexpr std::string_view StaticLayerCache = "StaticLayerCache";
 constexpr std::string_view FinalGlideTerrain = "FinalGlideTerrain";
 constexpr std::string_view AutoWind = "AutoWind";
 constexpr std::string_view ExternalWind = "ExternalWind";
@@ -245,6 +246,7 @@ constexpr std::string_view RoutePlannerAllowClimb = "RoutePlannerAllowClimb";
 constexpr std::string_view RoutePlannerUseCeiling = "RoutePlannerUseCeiling";
 constexpr std::string_view TurningReach = "TurningReach";
 constexpr std::string_view ReachPolarMode = "ReachPolarMode";
+constexpr std::string_view ReachIncremental = "ReachIncremental";
 
 constexpr std::string_view AircraftSymbol = "AircraftSymbol";
 
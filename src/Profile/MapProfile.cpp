@@ -41,6 +41,7 @@ Profile::Load(const ProfileMap &map, MapSettings &settings)
   map.Get(ProfileKeys::CircleZoom, settings.circle_zoom_enabled);
   map.Get(ProfileKeys::MaxAutoZoomDistance, settings.max_auto_zoom_distance);
   map.Get(ProfileKeys::DrawTopography, settings.topography_enabled);
+  map.Get(ProfileKeys::StaticLayerCache, settings.static_layer_cache_enabled);
 
   LoadTerrainRendererSettings(map, settings.terrain);
 
@@ -7,6 +7,8 @@
 #include "ui/canvas/Canvas.hpp"
 #include "NMEA/Derived.hpp"
 
+#include <cassert>
+
 BackgroundRenderer::BackgroundRenderer() noexcept = default;
 BackgroundRenderer::~BackgroundRenderer() noexcept = default;
 
@@ -24,6 +26,40 @@ BackgroundRenderer::SetTerrain(const RasterTerrain *_terrain) noexcept
   renderer.reset();
 }
 
+inline TerrainRenderer &
+BackgroundRenderer::PrepareRenderer(const TerrainRendererSettings &terrain_settings) noexcept
+{
+  assert(terrain != nullptr);
+
+  if (!renderer) {
+    // defer creation until first draw because
+    // the buffer size, smoothing etc is set by the
+    // loaded terrain properties
+    renderer.reset(new TerrainRenderer(*terrain));
+
+#ifdef ENABLE_OPENGL
+    if (full_resolution)
+      renderer->SetQuantisationPixels(1);
+#endif
+  }
+
+  renderer->SetSettings(terrain_settings);
+  return *renderer;
+}
+
+bool
+BackgroundRenderer::Update(const WindowProjection &proj,
+                           const TerrainRendererSettings &terrain_settings) noexcept
+{
+  if (!terrain_settings.enable || terrain == nullptr)
+    return false;
+
+  auto &r = PrepareRenderer(terrain_settings);
+  const auto misses = r.GetStatistics().misses;
+  r.Generate(proj, shading_angle);
+  return r.GetStatistics().misses != misses;
+}
+
 void
 BackgroundRenderer::Draw(Canvas& canvas,
                          const WindowProjection& proj,
@@ -32,21 +68,9 @@ BackgroundRenderer::Draw(Canvas& canvas,
   canvas.ClearWhite();
 
   if (terrain_settings.enable && terrain != nullptr) {
-    if (!renderer) {
-      // defer creation until first draw because
-      // the buffer size, smoothing etc is set by the
-      // loaded terrain properties
-      renderer.reset(new TerrainRenderer(*terrain));
-
-#ifdef ENABLE_OPENGL
-      if (full_resolution)
-        renderer->SetQuantisationPixels(1);
-#endif
-    }
-
-    renderer->SetSettings(terrain_settings);
-    if (renderer->Generate(proj, shading_angle))
-      renderer->Draw(canvas, proj);
+    auto &r = PrepareRenderer(terrain_settings);
+    if (r.Generate(proj, shading_angle))
+      r.Draw(canvas, proj);
   }
 }
 
@@ -49,6 +49,25 @@ public:
    */
   void Flush() noexcept;
 
+  /**
+   * @return the #TerrainRenderer or nullptr if no terrain has been
+   * drawn yet
+   */
+  const TerrainRenderer *GetTerrainRenderer() const noexcept {
+    return renderer.get();
+  }
+
+  /**
+   * Generate the terrain image for the given projection (if
+   * necessary), but don't draw it.
+   *
+   * @return true if a new image was generated, i.e. the next Draw()
+   * call with this projection will look different than the previous
+   * one
+   */
+  bool Update(const WindowProjection &proj,
+              const TerrainRendererSettings &terrain_settings) noexcept;
+
   void Draw(Canvas& canvas,
             const WindowProjection& proj,
             const TerrainRendererSettings &terrain_settings) noexcept;
@@ -59,5 +78,7 @@ public:
   void SetTerrain(const RasterTerrain *terrain) noexcept;
 
 private:
+  TerrainRenderer &PrepareRenderer(const TerrainRendererSettings &terrain_settings) noexcept;
+
   void SetShadingAngle(const WindowProjection& proj, Angle angle) noexcept;
 };
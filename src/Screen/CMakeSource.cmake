@@ -3,6 +3,7 @@
 set(_SOURCES
   Debug.cpp
   Layout.cpp
+  Profiler.cpp
 )
 
 set(SCRIPT_FILES CMakeSource.cmake)
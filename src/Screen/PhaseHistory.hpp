@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/OverwritingRingBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Remembers the durations of the most recent executions of one
+ * phase (e.g. one step of rendering the map), and calculates
+ * percentiles over this rolling window.
+ */
+class PhaseHistory {
+  /**
+   * The ring buffer keeps one slot free, so this holds 255
+   * samples.
+   */
+  static constexpr unsigned BUFFER_SIZE = 256;
+
+public:
+  using Duration = std::chrono::microseconds;
+
+  struct Summary {
+    /**
+     * The number of samples added since the last Clear(), including
+     * the ones which have dropped out of the window.
+     */
+    uint_least64_t count;
+
+    /**
+     * The number of samples in the window; the following values
+     * were calculated from these.
+     */
+    unsigned window;
+
+    Duration p50, p95, max;
+  };
+
+private:
+  /**
+   * The durations in microseconds.
+   */
+  OverwritingRingBuffer<uint32_t, BUFFER_SIZE> samples;
+
+  uint_least64_t count = 0;
+
+public:
+  static constexpr unsigned GetWindowSize() noexcept {
+    return BUFFER_SIZE - 1;
+  }
+
+  void Add(std::chrono::steady_clock::duration d) noexcept {
+    const auto us = std::chrono::duration_cast<Duration>(d).count();
+    samples.push(us <= 0
+                 ? 0
+                 : (uint32_t)std::min<decltype(us)>(us, UINT32_MAX));
+    ++count;
+  }
+
+  void Clear() noexcept {
+    samples.clear();
+    count = 0;
+  }
+
+  /**
+   * Calculate the percentiles (nearest-rank method) of the samples
+   * in the window.
+   */
+  [[gnu::pure]]
+  Summary GetSummary() const noexcept {
+    std::array<uint32_t, BUFFER_SIZE> sorted;
+    unsigned n = 0;
+    for (const uint32_t i : samples)
+      sorted[n++] = i;
+
+    std::sort(sorted.begin(), std::next(sorted.begin(), n));
+
+    Summary summary{count, n, {}, {}, {}};
+    if (n > 0) {
+      summary.p50 = Duration{sorted[Rank(n, 50)]};
+      summary.p95 = Duration{sorted[Rank(n, 95)]};
+      summary.max = Duration{sorted[n - 1]};
+    }
+
+    return summary;
+  }
+
+private:
+  /**
+   * @return the index of the given percentile in a sorted array
+   * with n > 0 elements
+   */
+  static constexpr unsigned Rank(unsigned n, unsigned percent) noexcept {
+    return (n * percent + 99) / 100 - 1;
+  }
+};
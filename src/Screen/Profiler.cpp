@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler.hpp"
+#include "PhaseHistory.hpp"
+#include "thread/Mutex.hxx"
+#include "util/StaticArray.hxx"
+#include "util/StringAPI.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/Path.hpp"
+
+#include <fmt/format.h>
+
+namespace Profiler {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+struct Phase {
+  const char *group, *name;
+  PhaseHistory history;
+};
+
+struct Counter {
+  const char *group, *name;
+  uint_least64_t value;
+};
+
+/* these are only modified while holding the mutex; samples for
+   phases or counters which don't fit are dropped */
+Mutex mutex;
+StaticArray<Phase, 64> phases;
+StaticArray<Counter, 32> counters;
+
+template<typename T, std::size_t max>
+[[gnu::pure]]
+T *
+Find(StaticArray<T, max> &array,
+     const char *group, const char *name) noexcept
+{
+  for (auto &i : array)
+    if (StringIsEqual(i.group, group) && StringIsEqual(i.name, name))
+      return &i;
+
+  return nullptr;
+}
+
+} // anonymous namespace
+
+void
+SetEnabled(bool value) noexcept
+{
+  enabled.store(value, std::memory_order_relaxed);
+}
+
+void
+Record(const char *group, const char *phase, Clock::duration d) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  Phase *p = Find(phases, group, phase);
+  if (p == nullptr) {
+    if (phases.full())
+      return;
+
+    p = &phases.append();
+    p->group = group;
+    p->name = phase;
+    p->history.Clear();
+  }
+
+  p->history.Add(d);
+}
+
+void
+SetCounter(const char *group, const char *name, uint_least64_t value) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  Counter *c = Find(counters, group, name);
+  if (c == nullptr) {
+    if (counters.full())
+      return;
+
+    c = &counters.append();
+    c->group = group;
+    c->name = name;
+  }
+
+  c->value = value;
+}
+
+void
+Clear() noexcept
+{
+  const std::lock_guard lock{mutex};
+  phases.clear();
+  counters.clear();
+}
+
+void
+WriteCSV(BufferedOutputStream &os)
+{
+  os.Write("kind,group,name,count,window,p50_us,p95_us,max_us\n");
+
+  const std::lock_guard lock{mutex};
+
+  for (const auto &i : phases) {
+    const auto s = i.history.GetSummary();
+    os.Fmt("phase,{},{},{},{},{},{},{}\n", i.group, i.name,
+           s.count, s.window,
+           s.p50.count(), s.p95.count(), s.max.count());
+  }
+
+  for (const auto &i : counters)
+    os.Fmt("counter,{},{},{},,,,\n", i.group, i.name, i.value);
+}
+
+void
+SaveCSV(Path path)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+  WriteCSV(os);
+  os.Flush();
+  file.Commit();
+}
+
+} // namespace Profiler
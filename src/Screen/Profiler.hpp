@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class Path;
+class BufferedOutputStream;
+
+/**
+ * A lightweight profiler which is compiled into all builds, but
+ * records nothing until it is enabled at runtime (see the
+ * "Profiler" input event).  It keeps a rolling window of durations
+ * for each phase (see #PhaseHistory) and a number of counters, and
+ * exports them as CSV.
+ *
+ * All group, phase and counter names must be string literals (or
+ * other strings which live forever); only the pointers are stored.
+ *
+ * All functions are thread-safe.
+ */
+namespace Profiler {
+
+using Clock = std::chrono::steady_clock;
+
+extern std::atomic<bool> enabled;
+
+inline bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+void
+SetEnabled(bool value) noexcept;
+
+/**
+ * Add one sample to the history of the given phase.
+ */
+void
+Record(const char *group, const char *phase, Clock::duration d) noexcept;
+
+/**
+ * Update the current value of a counter (e.g. the number of cache
+ * hits so far).  The value is absolute, not a delta; the owner of
+ * the counter keeps track of it.
+ */
+void
+SetCounter(const char *group, const char *name, uint_least64_t value) noexcept;
+
+/**
+ * Forget all samples and counters.
+ */
+void
+Clear() noexcept;
+
+/**
+ * Write all phase summaries and counters as CSV.
+ *
+ * Throws on error.
+ */
+void
+WriteCSV(BufferedOutputStream &os);
+
+/**
+ * Write the CSV export (see WriteCSV()) to a new file.
+ *
+ * Throws on error.
+ */
+void
+SaveCSV(Path path);
+
+/**
+ * Measures a sequence of consecutive phases of one operation (e.g.
+ * rendering one frame) and records each of them, plus the total
+ * duration as phase "Total".  It is a no-op while the profiler is
+ * disabled.
+ *
+ * Note that on OpenGL, this measures only the CPU time needed to
+ * submit the drawing commands, because it does not wait for the GPU
+ * to finish (unlike #ScreenStopWatch in STOP_WATCH builds).
+ */
+class PhaseStopWatch {
+  const char *const group;
+
+  /**
+   * The current phase; nullptr if no operation is being measured.
+   */
+  const char *phase = nullptr;
+
+  Clock::time_point start_time, phase_time;
+
+public:
+  explicit constexpr PhaseStopWatch(const char *_group) noexcept
+    :group(_group) {}
+
+  /**
+   * Finish the current phase (if any) and begin a new one.
+   */
+  void Mark(const char *_phase) noexcept {
+    if (!IsEnabled()) {
+      phase = nullptr;
+      return;
+    }
+
+    const auto now = Clock::now();
+    if (phase != nullptr)
+      Record(group, phase, now - phase_time);
+    else
+      start_time = now;
+
+    phase = _phase;
+    phase_time = now;
+  }
+
+  /**
+   * Finish the current phase and the operation.
+   */
+  void Finish() noexcept {
+    if (phase == nullptr)
+      return;
+
+    const auto now = Clock::now();
+    Record(group, phase, now - phase_time);
+    Record(group, "Total", now - start_time);
+    phase = nullptr;
+  }
+};
+
+} // namespace Profiler
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Profiler.hpp"
+
 #ifdef STOP_WATCH
 
 #include "util/StaticArray.hxx"
@@ -24,10 +26,14 @@
 
 /**
  * A stop watch which measures the time needed to perform an
- * operation, and writes it to the log file.  It is a no-op if the
- * macro STOP_WATCH is not defined.
+ * operation.  The phases are recorded by the #Profiler (if enabled
+ * at runtime); if the macro STOP_WATCH is defined, they are also
+ * measured precisely (waiting for the GPU) and written to the log
+ * file.
  */
 class ScreenStopWatch {
+  Profiler::PhaseStopWatch profiler{"Draw"};
+
 #ifdef STOP_WATCH
   typedef uint64_t clock_stamp_t;
   typedef uint64_t cpu_stamp_t;
@@ -106,6 +112,7 @@ public:
   void Mark(const char *text) {
     FlushScreen();
     markers.append().Set(text);
+    profiler.Mark(text);
   }
 
   void Finish() {
@@ -113,6 +120,7 @@ public:
       return;
 
     FlushScreen();
+    profiler.Finish();
     markers.append().Set(nullptr);
 
     for (unsigned i = 0; markers[i + 1].text != nullptr; ++i) {
@@ -135,7 +143,12 @@ public:
 
 #else /* !STOP_WATCH */
 public:
-  void Mark([[maybe_unused]] const char *text) {}
-  void Finish() {}
+  void Mark(const char *text) noexcept {
+    profiler.Mark(text);
+  }
+
+  void Finish() noexcept {
+    profiler.Finish();
+  }
 #endif /* !STOP_WATCH */
 };
@@ -555,7 +555,7 @@ Startup(UI::Display &display)
   {
     LogFormat("Loading topography");
     operation.SetText(_("Loading Topography File..."));
-    LoadConfiguredTopography(*data_components->topography);
+    LoadConfiguredTopography(*data_components->topography, file_cache);
     operation.SetProgressPosition(256);
   }
 
@@ -606,6 +606,7 @@ Startup(UI::Display &display)
     SubOperationEnvironment sub_env(operation, 768, 1024);
     ReadAirspace(*data_components->airspaces,
                  computer_settings.pressure,
+                 file_cache,
                  sub_env);
   }
 
@@ -616,7 +617,7 @@ Startup(UI::Display &display)
   {
     const AircraftState aircraft_state =
       ToAircraftState(backend_components->device_blackboard->Basic(),
-                      backend_components->device_blackboard->Calculated());
+                      backend_components->device_blackboard->LeaseCalculated());
     ProtectedAirspaceWarningManager::ExclusiveLease lease(backend_components->glide_computer->GetAirspaceWarnings());
     lease->Reset(aircraft_state);
   }
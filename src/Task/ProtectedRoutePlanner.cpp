@@ -3,6 +3,8 @@
 
 #include "ProtectedRoutePlanner.hpp"
 #include "Engine/Route/ReachResult.hpp"
+#include "thread/JobThread.hpp"
+#include "LogFile.hpp"
 
 void
 ProtectedRoutePlanner::SetTerrain(const RasterTerrain *terrain) noexcept
@@ -39,7 +41,8 @@ void
 ProtectedRoutePlanner::SolveReach(const AGeoPoint &origin,
                                   const RoutePlannerConfig &config,
                                   const int h_ceiling,
-                                  const bool do_solve) noexcept
+                                  const bool do_solve,
+                                  JobThread *helper) noexcept
 {
   /* these local variables help avoid locking both mutexes at the same
      time */
@@ -47,8 +50,30 @@ ProtectedRoutePlanner::SolveReach(const AGeoPoint &origin,
 
   {
     const std::scoped_lock lock{route_mutex};
-    rt = route_planner.SolveReach(origin, config, h_ceiling, do_solve, false);
+
+    /* the two reaches use separate state in the TerrainRoute, so
+       they can be solved in parallel */
+    bool parallel = false;
+    if (helper != nullptr) {
+      try {
+        helper->Start([&]{
+          rt = route_planner.SolveReach(origin, config, h_ceiling, do_solve,
+                                        false);
+        });
+        parallel = true;
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to start reach thread");
+      }
+    }
+
+    if (!parallel)
+      rt = route_planner.SolveReach(origin, config, h_ceiling, do_solve, false);
+
     rw = route_planner.SolveReach(origin, config, h_ceiling, do_solve, true);
+
+    if (parallel)
+      helper->Wait();
+
     rpolars_reach = route_planner.GetReachPolar();
   }
 
@@ -13,6 +13,7 @@ struct RoutePlannerConfig;
 class GlidePolar;
 class RasterTerrain;
 class Airspaces;
+class JobThread;
 
 /**
  * Facade to task/airspace/waypoints as used by threads,
@@ -74,8 +75,15 @@ public:
                   const RoutePlannerConfig &config,
                   int h_ceiling) noexcept;
 
+  /**
+   * Solve the reach to terrain and the reach to working floor.
+   *
+   * @param helper if not nullptr, then the terrain reach is solved in
+   * this thread while the calling thread solves the working reach
+   */
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
-                  int h_ceiling, bool do_solve) noexcept;
+                  int h_ceiling, bool do_solve,
+                  JobThread *helper=nullptr) noexcept;
 
   [[gnu::pure]]
   const FlatProjection GetTerrainReachProjection() const noexcept;
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Bilinear.hpp"
+#include "util/Compiler.h"
+
+#include <cassert>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * All variants calculate
+ *
+ *   ((a * kx + b * ix) * ky + (c * kx + d * ix) * iy) >> 16
+ *
+ * with kx = 256 - ix and ky = 256 - iy.  This fits into 32 bit
+ * signed integers for all 16 bit heights, and it equals the formula
+ * used by RasterBuffer::GetInterpolated().
+ */
+
+static inline int32_t
+InterpolatePortable(int32_t a, int32_t b, int32_t c, int32_t d,
+                    int32_t ix, int32_t iy) noexcept
+{
+  const int32_t kx = 0x100 - ix, ky = 0x100 - iy;
+  return ((a * kx + b * ix) * ky + (c * kx + d * ix) * iy) >> 16;
+}
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+[[gnu::always_inline]]
+static inline void
+Interpolate4(const int32_t *gcc_restrict a, const int32_t *gcc_restrict b,
+             const int32_t *gcc_restrict c, const int32_t *gcc_restrict d,
+             const int32_t *gcc_restrict ix, const int32_t *gcc_restrict iy,
+             int32_t *gcc_restrict result) noexcept
+{
+  const int32x4_t k256 = vdupq_n_s32(0x100);
+
+  const int32x4_t vix = vld1q_s32(ix), viy = vld1q_s32(iy);
+  const int32x4_t vkx = vsubq_s32(k256, vix), vky = vsubq_s32(k256, viy);
+
+  int32x4_t top = vmulq_s32(vld1q_s32(a), vkx);
+  top = vmlaq_s32(top, vld1q_s32(b), vix);
+
+  int32x4_t bottom = vmulq_s32(vld1q_s32(c), vkx);
+  bottom = vmlaq_s32(bottom, vld1q_s32(d), vix);
+
+  int32x4_t sum = vmulq_s32(top, vky);
+  sum = vmlaq_s32(sum, bottom, viy);
+
+  vst1q_s32(result, vshrq_n_s32(sum, 16));
+}
+
+#elif defined(__SSE2__)
+
+/**
+ * Multiply packed 32 bit integers, keeping the low 32 bits.  SSE2
+ * lacks _mm_mullo_epi32() (that is SSE4.1).
+ */
+[[gnu::always_inline]]
+static inline __m128i
+MulLo32(__m128i x, __m128i y) noexcept
+{
+  const __m128i even = _mm_mul_epu32(x, y);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_si128(x, 4),
+                                    _mm_srli_si128(y, 4));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+[[gnu::always_inline]]
+static inline void
+Interpolate4(const int32_t *gcc_restrict a, const int32_t *gcc_restrict b,
+             const int32_t *gcc_restrict c, const int32_t *gcc_restrict d,
+             const int32_t *gcc_restrict ix, const int32_t *gcc_restrict iy,
+             int32_t *gcc_restrict result) noexcept
+{
+  const __m128i k256 = _mm_set1_epi32(0x100);
+
+  const __m128i vix = _mm_load_si128((const __m128i *)ix);
+  const __m128i viy = _mm_load_si128((const __m128i *)iy);
+  const __m128i vkx = _mm_sub_epi32(k256, vix);
+  const __m128i vky = _mm_sub_epi32(k256, viy);
+
+  const __m128i top =
+    _mm_add_epi32(MulLo32(_mm_load_si128((const __m128i *)a), vkx),
+                  MulLo32(_mm_load_si128((const __m128i *)b), vix));
+  const __m128i bottom =
+    _mm_add_epi32(MulLo32(_mm_load_si128((const __m128i *)c), vkx),
+                  MulLo32(_mm_load_si128((const __m128i *)d), vix));
+
+  const __m128i sum = _mm_add_epi32(MulLo32(top, vky),
+                                    MulLo32(bottom, viy));
+
+  _mm_store_si128((__m128i *)result, _mm_srai_epi32(sum, 16));
+}
+
+#endif
+
+[[gnu::hot]]
+void
+BilinearBatch::Interpolate(unsigned n) noexcept
+{
+  assert(n <= CAPACITY);
+
+  unsigned i = 0;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__SSE2__)
+  /* all arrays are aligned to 16 bytes, so we can process 4 elements
+     at a time */
+  for (; i + 4 <= n; i += 4)
+    Interpolate4(a + i, b + i, c + i, d + i, ix + i, iy + i, result + i);
+#endif
+
+  /* the remainder (or everything on other CPUs) */
+  for (; i < n; ++i)
+    result[i] = InterpolatePortable(a[i], b[i], c[i], d[i], ix[i], iy[i]);
+}
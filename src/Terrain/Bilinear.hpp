@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Height.hpp"
+
+#include <cstdint>
+
+/**
+ * A batch of bilinear interpolations in structure-of-arrays layout.
+ * The caller collects the four corner heights and the sub-pixel
+ * offsets of many samples (which is memory bound and scalar), and
+ * then Interpolate() does the arithmetic for all of them at once,
+ * using SSE2 or NEON if available.
+ *
+ * The results are exactly the same as RasterBuffer::GetInterpolated().
+ */
+struct BilinearBatch {
+  static constexpr unsigned CAPACITY = 64;
+
+  /**
+   * The heights of the four corners: top left, top right, bottom
+   * left, bottom right.
+   */
+  alignas(16) int32_t a[CAPACITY], b[CAPACITY], c[CAPACITY], d[CAPACITY];
+
+  /**
+   * The sub-pixel offsets (0..255).
+   */
+  alignas(16) int32_t ix[CAPACITY], iy[CAPACITY];
+
+  alignas(16) int32_t result[CAPACITY];
+
+  /**
+   * Store a sample which evaluates to the given value, without
+   * interpolation.
+   */
+  void SetConstant(unsigned i, TerrainHeight h) noexcept {
+    a[i] = b[i] = c[i] = d[i] = h.GetValue();
+    ix[i] = iy[i] = 0;
+  }
+
+  /**
+   * Store a sample.
+   *
+   * @param tm pointer to the top left pixel
+   * @param dx the offset of the right neighbour (0 or 1)
+   * @param dy the offset of the bottom neighbour (0 or the pitch)
+   */
+  void Set(unsigned i, const TerrainHeight *tm, unsigned dx, unsigned dy,
+           unsigned _ix, unsigned _iy) noexcept {
+    if (tm->IsSpecial() || tm[dx].IsSpecial() ||
+        tm[dy].IsSpecial() || tm[dx + dy].IsSpecial()) {
+      SetConstant(i, *tm);
+      return;
+    }
+
+    a[i] = tm->GetValue();
+    b[i] = tm[dx].GetValue();
+    c[i] = tm[dy].GetValue();
+    d[i] = tm[dx + dy].GetValue();
+    ix[i] = _ix;
+    iy[i] = _iy;
+  }
+
+  /**
+   * Calculate the first #n results.
+   */
+  void Interpolate(unsigned n) noexcept;
+
+  TerrainHeight Get(unsigned i) const noexcept {
+    return TerrainHeight(int16_t(result[i]));
+  }
+};
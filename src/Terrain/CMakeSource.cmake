@@ -1,5 +1,6 @@
 set(TERRAIN_DIR     ${CMAKE_CURRENT_SOURCE_DIR}) 
 set(_SOURCES
+        ${TERRAIN_DIR}/Bilinear.cpp
         ${TERRAIN_DIR}/HeightMatrix.cpp
         ${TERRAIN_DIR}/Intersection.cpp
         ${TERRAIN_DIR}/Loader.cpp
@@ -10,6 +11,7 @@ set(_SOURCES
         ${TERRAIN_DIR}/RasterTerrain.cpp
         ${TERRAIN_DIR}/RasterTile.cpp
         ${TERRAIN_DIR}/RasterTileCache.cpp
+        ${TERRAIN_DIR}/RasterTileStore.cpp
         ${TERRAIN_DIR}/ScanLine.cpp
         ${TERRAIN_DIR}/TerrainRenderer.cpp
         ${TERRAIN_DIR}/TerrainSettings.cpp
@@ -10,7 +10,9 @@
 #include "Projection/WindowProjection.hpp"
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 void
 HeightMatrix::SetSize(std::size_t _size) noexcept
@@ -58,6 +60,105 @@ HeightMatrix::Fill(const RasterMap &map, const GeoBounds &bounds,
   }
 }
 
+void
+HeightMatrix::ScanGridCells(const RasterMap &map, TerrainHeight *dest,
+                            int y, int x_begin, int x_end,
+                            bool interpolate) const noexcept
+{
+  assert(x_begin < x_end);
+
+  const Angle latitude = cell_height * y;
+
+  if (x_end - x_begin == 1) {
+    /* RasterMap::ScanLine() needs a line with two different end
+       points; scan two cells and use the first one */
+    TerrainHeight buffer[2];
+    map.ScanLine(GeoPoint(cell_width * x_begin, latitude),
+                 GeoPoint(cell_width * (x_begin + 1), latitude),
+                 buffer, 2, interpolate);
+    *dest = buffer[0];
+    return;
+  }
+
+  map.ScanLine(GeoPoint(cell_width * x_begin, latitude),
+               GeoPoint(cell_width * (x_end - 1), latitude),
+               dest, x_end - x_begin, interpolate);
+}
+
+GeoBounds
+HeightMatrix::FillGrid(const RasterMap &map, const GeoBounds &bounds,
+                       Angle _cell_width, Angle _cell_height,
+                       bool interpolate) noexcept
+{
+  assert(bounds.IsValid());
+  assert(_cell_width.Native() > 0);
+  assert(_cell_height.Native() > 0);
+
+  const bool reuse = grid_valid &&
+    _cell_width == cell_width && _cell_height == cell_height &&
+    interpolate == grid_interpolate;
+
+  const IntPoint2D old_origin = grid_origin;
+  const UnsignedPoint2D old_size = size;
+  if (reuse)
+    /* keep the old values for copying */
+    std::swap(data, previous);
+
+  cell_width = _cell_width;
+  cell_height = _cell_height;
+  grid_interpolate = interpolate;
+
+  /* expand the bounds to the grid; at least 2x2 cells */
+  const int west = (int)std::floor(bounds.GetWest() / cell_width);
+  const int east = std::max((int)std::ceil(bounds.GetEast() / cell_width),
+                            west + 1);
+  const int north = (int)std::ceil(bounds.GetNorth() / cell_height);
+  const int south = std::min((int)std::floor(bounds.GetSouth() / cell_height),
+                             north - 1);
+
+  grid_origin = {west, north};
+  SetSize(UnsignedPoint2D(east - west + 1, north - south + 1));
+
+  /* the columns which can be copied from the previous buffer */
+  const int copy_west = reuse ? std::max(west, old_origin.x) : 0;
+  const int copy_east = reuse
+    ? std::min(east + 1, old_origin.x + (int)old_size.x)
+    : 0;
+
+  std::size_t n_copied = 0;
+
+  TerrainHeight *p = data.data();
+  for (int y = north; y >= south; --y, p += size.x) {
+    const int old_row = old_origin.y - y;
+    if (copy_west >= copy_east ||
+        old_row < 0 || old_row >= (int)old_size.y) {
+      /* nothing to reuse in this row */
+      ScanGridCells(map, p, y, west, east + 1, interpolate);
+      continue;
+    }
+
+    std::copy_n(previous.data() + old_row * old_size.x +
+                (copy_west - old_origin.x),
+                copy_east - copy_west,
+                p + (copy_west - west));
+    n_copied += copy_east - copy_west;
+
+    if (copy_west > west)
+      ScanGridCells(map, p, y, west, copy_west, interpolate);
+
+    if (copy_east <= east)
+      ScanGridCells(map, p + (copy_east - west), y,
+                    copy_east, east + 1, interpolate);
+  }
+
+  grid_valid = true;
+  reused_cells += n_copied;
+  scanned_cells += std::size_t(size.x) * size.y - n_copied;
+
+  return GeoBounds(cell_height * north, cell_width * east,
+                   cell_height * south, cell_width * west);
+}
+
 #else
 
 void
@@ -7,6 +7,12 @@
 #include "Math/Point2D.hpp"
 #include "util/AllocatedArray.hxx"
 
+#include <cstddef>
+
+#ifdef ENABLE_OPENGL
+#include "Math/Angle.hpp"
+#endif
+
 class RasterMap;
 
 #ifdef ENABLE_OPENGL
@@ -19,6 +25,35 @@ class HeightMatrix {
   AllocatedArray<TerrainHeight> data;
   UnsignedPoint2D size;
 
+#ifdef ENABLE_OPENGL
+  /**
+   * The values of the previous FillGrid() call; swapped with #data
+   * so the overlapping part can be copied.
+   */
+  AllocatedArray<TerrainHeight> previous;
+
+  /**
+   * The grid of the last FillGrid() call.  Cell (x, y) of the buffer
+   * is the sample at longitude (#grid_origin.x + x) * #cell_width and
+   * latitude (#grid_origin.y - y) * #cell_height.
+   */
+  Angle cell_width = Angle::Zero(), cell_height = Angle::Zero();
+  IntPoint2D grid_origin;
+  bool grid_interpolate;
+
+  /**
+   * Does the buffer contain valid values of the grid described
+   * above?
+   */
+  bool grid_valid = false;
+
+  /**
+   * The number of cells which were copied from the previous buffer
+   * resp. scanned from the #RasterMap by all FillGrid() calls.
+   */
+  std::size_t reused_cells = 0, scanned_cells = 0;
+#endif
+
 public:
   HeightMatrix() noexcept = default;
 
@@ -38,6 +73,55 @@ public:
    */
   void Fill(const RasterMap &map, const GeoBounds &bounds,
             UnsignedPoint2D _size, bool interpolate) noexcept;
+
+  /**
+   * Like Fill(), but the samples are taken on a global grid with the
+   * given cell size.  The values which overlap with the previous
+   * call (with the same cell size) are reused, and only the newly
+   * exposed cells are scanned from the #RasterMap; this makes
+   * redrawing after panning cheap.  Call Discard() when the
+   * #RasterMap has changed.
+   *
+   * @return the bounds of the samples, i.e. the given bounds
+   * expanded to the grid
+   */
+  GeoBounds FillGrid(const RasterMap &map, const GeoBounds &bounds,
+                     Angle _cell_width, Angle _cell_height,
+                     bool interpolate) noexcept;
+
+  /**
+   * Don't reuse any values in the next FillGrid() call.
+   */
+  void Discard() noexcept {
+    grid_valid = false;
+  }
+
+  Angle GetCellWidth() const noexcept {
+    return cell_width;
+  }
+
+  Angle GetCellHeight() const noexcept {
+    return cell_height;
+  }
+
+  std::size_t GetReusedCells() const noexcept {
+    return reused_cells;
+  }
+
+  std::size_t GetScannedCells() const noexcept {
+    return scanned_cells;
+  }
+
+private:
+  /**
+   * Scan the cells [x_begin, x_end) of row y (grid coordinates) into
+   * the given buffer.
+   */
+  void ScanGridCells(const RasterMap &map, TerrainHeight *dest,
+                     int y, int x_begin, int x_end,
+                     bool interpolate) const noexcept;
+
+public:
 #else
   /**
    * @param interpolate true enables interpolation of sub-pixel values
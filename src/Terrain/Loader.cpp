@@ -3,6 +3,7 @@
 
 #include "Loader.hpp"
 #include "RasterTileCache.hpp"
+#include "RasterTileStore.hpp"
 #include "RasterProjection.hpp"
 #include "ZzipStream.hpp"
 #include "WorldFile.hpp"
@@ -15,6 +16,10 @@ extern "C" {
 #include "jasper/jpc/jpc_t1cod.h"
 }
 
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+
 #include <string.h>
 
 long
@@ -306,12 +311,153 @@ TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
     if (!raster_tile_cache.PollTiles(p, radius))
       /* nothing to do */
       return;
+
+    if (raster_tile_cache.MapRequestedTiles()) {
+      /* all tiles were mapped from the tile store; no need to
+         decode the JPEG2000 file */
+      raster_tile_cache.FinishTileUpdate();
+      return;
+    }
   }
 
   AtScopeExit(this) { raster_tile_cache.FinishTileUpdate(); };
   LoadJPG2000(dir, path);
 }
 
+inline bool
+TerrainLoader::PrefetchTiles(struct zzip_dir *dir, const char *path,
+                             SignedRasterLocation p, unsigned radius)
+{
+  assert(!scan_overview);
+
+  {
+    const std::lock_guard lock{mutex};
+
+    if (!raster_tile_cache.PollPrefetchTiles(p, radius))
+      return false;
+
+    if (raster_tile_cache.MapRequestedTiles()) {
+      raster_tile_cache.FinishTileUpdate();
+      return true;
+    }
+  }
+
+  AtScopeExit(this) { raster_tile_cache.FinishTileUpdate(); };
+  LoadJPG2000(dir, path);
+  return true;
+}
+
+unsigned
+TerrainLoader::ConvertTileBatch(struct zzip_dir *dir, const char *path,
+                                BufferedOutputStream &os, unsigned first)
+{
+  assert(!scan_overview);
+
+  auto &tiles = raster_tile_cache.tiles;
+  const unsigned last = std::min(first + CONVERT_BATCH_SIZE,
+                                 unsigned(tiles.GetSize()));
+
+  /* tiles which are already loaded (e.g. because they are visible)
+     are written as they are and stay loaded; the others are decoded
+     now and unloaded afterwards */
+  std::bitset<CONVERT_BATCH_SIZE> decode;
+
+  {
+    const std::lock_guard lock{mutex};
+
+    for (unsigned i = first; i < last; ++i) {
+      auto &tile = tiles.GetLinear(i);
+      if (tile.IsDefined() && !tile.IsLoaded()) {
+        tile.SetRequest();
+        decode.set(i - first);
+      }
+    }
+  }
+
+  AtScopeExit(this, &tiles, first, last, &decode) {
+    const std::lock_guard lock{mutex};
+
+    for (unsigned i = first; i < last; ++i) {
+      if (!decode.test(i - first))
+        continue;
+
+      auto &tile = tiles.GetLinear(i);
+      tile.ClearRequest();
+      tile.Unload();
+    }
+  };
+
+  if (decode.any())
+    LoadJPG2000(dir, path);
+
+  /* no lock needed for writing: the tiles are only modified by this
+     thread */
+  for (unsigned i = first; i < last; ++i) {
+    const auto &tile = tiles.GetLinear(i);
+    if (!tile.IsDefined())
+      continue;
+
+    if (!tile.IsLoaded())
+      throw std::runtime_error("Failed to decode terrain tile");
+
+    RasterTileStore::WriteTile(os, tile);
+  }
+
+  return last;
+}
+
+inline void
+TerrainLoader::ConvertTiles(struct zzip_dir *dir, const char *path,
+                            BufferedOutputStream &os)
+{
+  const unsigned n_tiles = raster_tile_cache.tiles.GetSize();
+
+  RasterTileStore::WriteHeader(os, raster_tile_cache.GetTiles());
+
+  env.SetProgressRange(n_tiles);
+
+  for (unsigned i = 0; i < n_tiles;) {
+    if (env.IsCancelled())
+      throw std::runtime_error("Cancelled");
+
+    i = ConvertTileBatch(dir, path, os, i);
+
+    /* LoadJPG2000() changes the progress range */
+    env.SetProgressRange(n_tiles);
+    env.SetProgressPosition(i);
+  }
+}
+
+void
+ConvertTerrainTiles(struct zzip_dir *dir, const char *path,
+                    RasterTileCache &raster_tile_cache,
+                    BufferedOutputStream &os,
+                    OperationEnvironment &env)
+{
+  if (!raster_tile_cache.IsValid())
+    throw std::runtime_error("Terrain invalid");
+
+  /* fake a mutex - nobody else may access the tiles meanwhile */
+  SharedMutex mutex;
+
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
+  loader.ConvertTiles(dir, path, os);
+}
+
+unsigned
+ConvertTerrainTileBatch(struct zzip_dir *dir, const char *path,
+                        RasterTileCache &raster_tile_cache,
+                        SharedMutex &mutex,
+                        BufferedOutputStream &os, unsigned first)
+{
+  if (!raster_tile_cache.IsValid())
+    throw std::runtime_error("Terrain invalid");
+
+  NullOperationEnvironment env;
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
+  return loader.ConvertTileBatch(dir, path, os, first);
+}
+
 void
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
@@ -337,3 +483,27 @@ UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                      raster_location,
                      projection.DistancePixelsCoarse(radius));
 }
+
+bool
+PrefetchTerrainTiles(struct zzip_dir *dir, const char *path,
+                     RasterTileCache &raster_tile_cache, SharedMutex &mutex,
+                     SignedRasterLocation p, unsigned radius)
+{
+  if (!raster_tile_cache.IsValid())
+    return false;
+
+  NullOperationEnvironment env;
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
+  return loader.PrefetchTiles(dir, path, p, radius);
+}
+
+bool
+PrefetchTerrainTiles(struct zzip_dir *dir, const char *path,
+                     RasterTileCache &raster_tile_cache, SharedMutex &mutex,
+                     const RasterProjection &projection,
+                     const GeoPoint &location, double radius)
+{
+  return PrefetchTerrainTiles(dir, path, raster_tile_cache, mutex,
+                              projection.ProjectCoarse(location),
+                              projection.DistancePixelsCoarse(radius));
+}
@@ -13,6 +13,7 @@ struct GeoPoint;
 class RasterTileCache;
 class RasterProjection;
 class OperationEnvironment;
+class BufferedOutputStream;
 
 class TerrainLoader {
   SharedMutex &mutex;
@@ -49,6 +50,35 @@ public:
   void UpdateTiles(struct zzip_dir *dir, const char *path,
                    SignedRasterLocation p, unsigned radius);
 
+  /**
+   * Throws on error.
+   *
+   * @return true if tiles were loaded
+   */
+  bool PrefetchTiles(struct zzip_dir *dir, const char *path,
+                     SignedRasterLocation p, unsigned radius);
+
+  /**
+   * The number of tiles decoded in one pass over the JPEG2000 file
+   * by ConvertTileBatch().  This limits the amount of memory needed
+   * for the conversion.
+   */
+  static constexpr unsigned CONVERT_BATCH_SIZE = 64;
+
+  /**
+   * Throws on error.
+   */
+  void ConvertTiles(struct zzip_dir *dir, const char *path,
+                    BufferedOutputStream &os);
+
+  /**
+   * Throws on error.
+   *
+   * @return the index of the next tile to be converted
+   */
+  unsigned ConvertTileBatch(struct zzip_dir *dir, const char *path,
+                            BufferedOutputStream &os, unsigned first);
+
   /* callback methods for libjasper (via jas_rtc.cpp) */
 
   long SkipMarkerSegment(long file_offset) const;
@@ -98,6 +128,58 @@ LoadTerrainOverview(struct zzip_dir *dir,
                       tile_cache, false, env);
 }
 
+/**
+ * Decode all tiles and write them as a #RasterTileStore.  The
+ * #RasterTileCache must have been initialised already (e.g. with
+ * LoadTerrainOverview()).  On large files, this is a very expensive
+ * operation.
+ *
+ * Throws on error.
+ */
+void
+ConvertTerrainTiles(struct zzip_dir *dir, const char *path,
+                    RasterTileCache &raster_tile_cache,
+                    BufferedOutputStream &os,
+                    OperationEnvironment &env);
+
+static inline void
+ConvertTerrainTiles(struct zzip_dir *dir,
+                    RasterTileCache &tile_cache,
+                    BufferedOutputStream &os,
+                    OperationEnvironment &env)
+{
+  ConvertTerrainTiles(dir, "terrain.jp2", tile_cache, os, env);
+}
+
+/**
+ * Decode a batch of tiles starting at the given index and append
+ * them to a #RasterTileStore whose header has already been written
+ * (see RasterTileStore::WriteHeader()).  Unlike
+ * ConvertTerrainTiles(), this may be called while the
+ * #RasterTileCache is in use: tiles which are loaded already are
+ * written as they are, and the others are unloaded again after they
+ * have been written.
+ *
+ * Throws on error.
+ *
+ * @return the index of the next tile to be converted; the store is
+ * complete when this equals the number of tiles
+ */
+unsigned
+ConvertTerrainTileBatch(struct zzip_dir *dir, const char *path,
+                        RasterTileCache &raster_tile_cache,
+                        SharedMutex &mutex,
+                        BufferedOutputStream &os, unsigned first);
+
+static inline unsigned
+ConvertTerrainTileBatch(struct zzip_dir *dir,
+                        RasterTileCache &tile_cache, SharedMutex &mutex,
+                        BufferedOutputStream &os, unsigned first)
+{
+  return ConvertTerrainTileBatch(dir, "terrain.jp2", tile_cache, mutex,
+                                 os, first);
+}
+
 /**
  * Throws on error.
  */
@@ -129,3 +211,43 @@ UpdateTerrainTiles(struct zzip_dir *dir,
   UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
                      projection, location, radius);
 }
+
+/**
+ * Load a few tiles near the given location which are not needed by
+ * the view yet (see RasterTileCache::PollPrefetchTiles()).  Call this
+ * only after UpdateTerrainTiles() has finished.
+ *
+ * Throws on error.
+ *
+ * @return true if tiles were loaded; the function should be called
+ * again to load more
+ */
+bool
+PrefetchTerrainTiles(struct zzip_dir *dir, const char *path,
+                     RasterTileCache &raster_tile_cache, SharedMutex &mutex,
+                     SignedRasterLocation p, unsigned radius);
+
+static inline bool
+PrefetchTerrainTiles(struct zzip_dir *dir,
+                     RasterTileCache &tile_cache, SharedMutex &mutex,
+                     SignedRasterLocation p, unsigned radius)
+{
+  return PrefetchTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
+                              p, radius);
+}
+
+bool
+PrefetchTerrainTiles(struct zzip_dir *dir, const char *path,
+                     RasterTileCache &raster_tile_cache, SharedMutex &mutex,
+                     const RasterProjection &projection,
+                     const GeoPoint &location, double radius);
+
+static inline bool
+PrefetchTerrainTiles(struct zzip_dir *dir,
+                     RasterTileCache &tile_cache, SharedMutex &mutex,
+                     const RasterProjection &projection,
+                     const GeoPoint &location, double radius)
+{
+  return PrefetchTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
+                              projection, location, radius);
+}
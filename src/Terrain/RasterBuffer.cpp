@@ -14,6 +14,20 @@ RasterBuffer::Resize(RasterLocation _size) noexcept
   assert(_size.y > 0);
 
   data.GrowDiscard(_size.x, _size.y);
+  base = data.begin();
+  size = _size;
+}
+
+void
+RasterBuffer::SetView(const TerrainHeight *_base, RasterLocation _size) noexcept
+{
+  assert(_base != nullptr);
+  assert(_size.x > 0);
+  assert(_size.y > 0);
+
+  data.Reset();
+  base = _base;
+  size = _size;
 }
 
 TerrainHeight
@@ -243,7 +257,7 @@ TerrainHeight
 RasterBuffer::GetMaximum() const noexcept
 {
   return IsDefined()
-    ? *std::max_element(data.begin(), data.end(),
+    ? *std::max_element(base, base + size.Area(),
                         [](TerrainHeight a, TerrainHeight b) {
                           return a.GetValue() < b.GetValue();
                         })
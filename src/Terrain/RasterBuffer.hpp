@@ -6,26 +6,44 @@
 #include "RasterTraits.hpp"
 #include "RasterLocation.hpp"
 #include "Height.hpp"
+#include "Bilinear.hpp"
 #include "util/AllocatedGrid.hxx"
 #include "util/Compiler.h"
 
+#include <cassert>
+
 class RasterBuffer {
   AllocatedGrid<TerrainHeight> data;
 
+  /**
+   * Points to the first element.  This is either #data or a
+   * read-only buffer owned by somebody else (see SetView()).
+   */
+  const TerrainHeight *base = nullptr;
+
+  RasterLocation size{0, 0};
+
 public:
   RasterBuffer() noexcept = default;
   RasterBuffer(unsigned _width, unsigned _height) noexcept
-    :data(_width, _height) {}
+    :data(_width, _height), base(data.begin()), size(_width, _height) {}
 
   RasterBuffer(const RasterBuffer &) = delete;
   RasterBuffer &operator=(const RasterBuffer &) = delete;
 
   bool IsDefined() const noexcept {
-    return data.IsDefined();
+    return base != nullptr;
+  }
+
+  /**
+   * Is this buffer a view of memory owned by somebody else?
+   */
+  bool IsView() const noexcept {
+    return base != nullptr && !data.IsDefined();
   }
 
   RasterLocation GetSize() const noexcept {
-    return {data.GetWidth(), data.GetHeight()};
+    return size;
   }
 
   RasterLocation GetFineSize() const noexcept {
@@ -33,23 +51,38 @@ public:
   }
 
   TerrainHeight *GetData() noexcept {
+    assert(!IsView());
+
     return data.begin();
   }
 
   const TerrainHeight *GetData() const noexcept {
-    return data.begin();
+    return base;
   }
 
   const TerrainHeight *GetDataAt(RasterLocation p) const noexcept {
-    return data.GetPointerAt(p.x, p.y);
+    assert(p.x < size.x);
+    assert(p.y < size.y);
+
+    return base + p.y * size.x + p.x;
   }
 
   void Reset() noexcept {
     data.Reset();
+    base = nullptr;
+    size = {0, 0};
   }
 
   void Resize(RasterLocation _size) noexcept;
 
+  /**
+   * Turn this object into a read-only view of the given buffer
+   * (e.g. a #FileMapping) without copying it.  The caller is
+   * responsible for keeping the buffer alive until Reset() is
+   * called.
+   */
+  void SetView(const TerrainHeight *_base, RasterLocation _size) noexcept;
+
   [[gnu::pure]]
   TerrainHeight GetInterpolated(unsigned lx, unsigned ly,
                                 unsigned ix, unsigned iy) const noexcept;
@@ -57,6 +90,34 @@ public:
   [[gnu::pure]]
   TerrainHeight GetInterpolated(RasterLocation p) const noexcept;
 
+  /**
+   * Like GetInterpolated(), but store the sample in a #BilinearBatch
+   * instead of calculating it right away.
+   */
+  void PrepareInterpolated(BilinearBatch &batch, unsigned i,
+                           unsigned lx, unsigned ly,
+                           unsigned ix, unsigned iy) const noexcept {
+    assert(IsDefined());
+    assert(lx < size.x);
+    assert(ly < size.y);
+    assert(ix < 0x100);
+    assert(iy < 0x100);
+
+    const unsigned dx = (lx == size.x - 1) ? 0 : 1;
+    const unsigned dy = (ly == size.y - 1) ? 0 : size.x;
+    batch.Set(i, GetDataAt({lx, ly}), dx, dy, ix, iy);
+  }
+
+  void PrepareInterpolated(BilinearBatch &batch, unsigned i,
+                           RasterLocation p) const noexcept {
+    const auto [px, ix] = RasterTraits::CalcSubpixel(p.x);
+    const auto [py, iy] = RasterTraits::CalcSubpixel(p.y);
+    if (px >= size.x || py >= size.y)
+      batch.SetConstant(i, TerrainHeight::Invalid());
+    else
+      PrepareInterpolated(batch, i, px, py, ix, iy);
+  }
+
   [[gnu::pure]]
   TerrainHeight Get(RasterLocation p) const noexcept {
     return *GetDataAt(p);
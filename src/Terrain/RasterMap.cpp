@@ -6,6 +6,7 @@
 #include "Math/Util.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 
 void
@@ -35,6 +36,28 @@ RasterMap::GetInterpolatedHeight(const GeoPoint &location) const noexcept
   return raster_tile_cache.GetInterpolatedHeight(pt);
 }
 
+void
+RasterMap::GetInterpolatedHeights(std::span<const GeoPoint> locations,
+                                  TerrainHeight *dest) const noexcept
+{
+  std::array<RasterLocation, BilinearBatch::CAPACITY> buffer;
+
+  while (!locations.empty()) {
+    const std::size_t n = std::min(locations.size(), buffer.size());
+
+    std::transform(locations.begin(), std::next(locations.begin(), n),
+                   buffer.begin(), [this](const GeoPoint &location){
+                     return projection.ProjectFine(location);
+                   });
+
+    raster_tile_cache.GetInterpolatedHeights(std::span{buffer}.first(n),
+                                             dest);
+
+    locations = locations.subspan(n);
+    dest += n;
+  }
+}
+
 void
 RasterMap::ScanLine(const GeoPoint &start, const GeoPoint &end,
                     TerrainHeight *buffer, unsigned size,
@@ -7,6 +7,8 @@
 #include "RasterTileCache.hpp"
 #include "Geo/GeoPoint.hpp"
 
+#include <span>
+
 class OperationEnvironment;
 
 class RasterMap {
@@ -23,6 +25,10 @@ public:
     return raster_tile_cache;
   }
 
+  const RasterTileCache &GetTileCache() const noexcept {
+    return raster_tile_cache;
+  }
+
   void UpdateProjection() noexcept;
 
   /**
@@ -95,6 +101,15 @@ public:
   [[gnu::pure]]
   TerrainHeight GetInterpolatedHeight(const GeoPoint &location) const noexcept;
 
+  /**
+   * Determine the interpolated heights at many locations; this is
+   * faster than calling GetInterpolatedHeight() for each of them.
+   *
+   * @param dest an array with one element per location
+   */
+  void GetInterpolatedHeights(std::span<const GeoPoint> locations,
+                              TerrainHeight *dest) const noexcept;
+
   /**
    * Scan a straight line and fill the buffer with the specified
    * number of samples along the line.
@@ -12,10 +12,18 @@
 #include "Projection/WindowProjection.hpp"
 #include "ui/event/Idle.hpp"
 
+#include "util/Compiler.h"
+
 #include <algorithm> // for std::clamp()
 #include <cassert>
 #include <cstdint>
 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /**
  * Constants for terrain rendering thresholds and quantisation limits.
  * These values were introduced in commit df6c73466b to replace magic numbers.
@@ -27,6 +35,13 @@ static constexpr unsigned MAX_QUANTISATION_NEAR = 25;
 static constexpr unsigned MAX_QUANTISATION_LOW_ZOOM = 40;
 static constexpr double BOUNDS_SCALE_FACTOR = 1.5;
 
+/**
+ * The relative deviation from the desired terrain cell size which is
+ * accepted to keep using the previous cell size (so the previous
+ * height matrix can be reused after panning).
+ */
+static constexpr double CELL_SIZE_TOLERANCE = 0.125;
+
 /**
  * Interpolate between x and y with i/128, i.e. i/(1 << 7).
  *
@@ -128,6 +143,19 @@ RasterRenderer::UpdateQuantisation() noexcept
   return quantisation_pixels < last_quantisation_pixels;
 }
 
+/**
+ * Is the cell size #b close enough to the desired size #a to be used
+ * instead?
+ */
+[[gnu::const]]
+static bool
+IsCloseCellSize(Angle a, Angle b) noexcept
+{
+  return b.Native() > 0 &&
+    a.Native() > b.Native() * (1 - CELL_SIZE_TOLERANCE) &&
+    a.Native() < b.Native() * (1 + CELL_SIZE_TOLERANCE);
+}
+
 const GLTexture &
 RasterRenderer::BindAndGetTexture() const noexcept
 {
@@ -195,12 +223,27 @@ RasterRenderer::ScanMap(const RasterMap &map,
   }
 
 #ifdef ENABLE_OPENGL
-  bounds = projection.GetScreenBounds().Scale(BOUNDS_SCALE_FACTOR);
-  bounds.IntersectWith(map.GetBounds());
+  const GeoBounds scan_bounds =
+    projection.GetScreenBounds().Scale(BOUNDS_SCALE_FACTOR);
+
+  /* the cell size of a matrix with one cell per quantisation_pixels
+     for the whole (unclipped) area */
+  const UnsignedPoint2D matrix_size =
+    (UnsignedPoint2D)projection.GetScreenSize() / quantisation_pixels;
+  Angle cell_width = scan_bounds.GetWidth() / std::max(matrix_size.x, 1u);
+  Angle cell_height = scan_bounds.GetHeight() / std::max(matrix_size.y, 1u);
+
+  /* keep the previous cell size if it is close enough, so the
+     values of the previous scan can be reused after panning */
+  if (IsCloseCellSize(cell_width, height_matrix.GetCellWidth()) &&
+      IsCloseCellSize(cell_height, height_matrix.GetCellHeight())) {
+    cell_width = height_matrix.GetCellWidth();
+    cell_height = height_matrix.GetCellHeight();
+  }
 
-  height_matrix.Fill(map, bounds,
-                     (UnsignedPoint2D)projection.GetScreenSize() / quantisation_pixels,
-                     true);
+  bounds = scan_bounds;
+  bounds.IntersectWith(map.GetBounds());
+  bounds = height_matrix.FillGrid(map, bounds, cell_width, cell_height, true);
 
   last_quantisation_pixels = quantisation_pixels;
 #else
@@ -305,6 +348,87 @@ ClipHeightDelta(TerrainHeight a, TerrainHeight b) noexcept
   return ClipHeightDelta(a.GetValue() - b.GetValue());
 }
 
+[[gnu::always_inline]]
+static inline void
+SlopeValuesPortable(const double *gcc_restrict num,
+                    const double *gcc_restrict square_mag,
+                    int *gcc_restrict value,
+                    std::size_t i, std::size_t n) noexcept
+{
+  for (; i < n; ++i) {
+    const double mag = sqrt(square_mag[i]);
+    /* this is a workaround for a SIGFPE (division by zero)
+       observed by our users on some Android devices (e.g. Nexus
+       7), even though we did our best to make sure that the
+       integer arithmetics above can't overflow */
+    /* TODO: debug this problem and replace this workaround */
+    value[i] = int(num[i] / std::max(mag, 1.0));
+  }
+}
+
+#if defined(__aarch64__)
+
+[[gnu::always_inline]]
+static inline std::size_t
+SlopeValuesSIMD(const double *gcc_restrict num,
+                const double *gcc_restrict square_mag,
+                int *gcc_restrict value, std::size_t n) noexcept
+{
+  const float64x2_t one = vdupq_n_f64(1);
+
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const float64x2_t mag = vmaxq_f64(vsqrtq_f64(vld1q_f64(square_mag + i)),
+                                      one);
+    const float64x2_t quotient = vdivq_f64(vld1q_f64(num + i), mag);
+    vst1_s32(value + i, vmovn_s64(vcvtq_s64_f64(quotient)));
+  }
+
+  return i;
+}
+
+#elif defined(__SSE2__)
+
+[[gnu::always_inline]]
+static inline std::size_t
+SlopeValuesSIMD(const double *gcc_restrict num,
+                const double *gcc_restrict square_mag,
+                int *gcc_restrict value, std::size_t n) noexcept
+{
+  const __m128d one = _mm_set1_pd(1);
+
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d mag = _mm_max_pd(_mm_sqrt_pd(_mm_loadu_pd(square_mag + i)),
+                                   one);
+    const __m128d quotient = _mm_div_pd(_mm_loadu_pd(num + i), mag);
+    _mm_storel_epi64((__m128i *)(value + i), _mm_cvttpd_epi32(quotient));
+  }
+
+  return i;
+}
+
+#endif
+
+/**
+ * Evaluate the expensive part of the slope shading formula (a square
+ * root and a division per pixel) for a whole row, two pixels at a
+ * time where the CPU supports it.
+ */
+static void
+SlopeValues(const double *num, const double *square_mag,
+            int *value, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+
+#if defined(__aarch64__) || defined(__SSE2__)
+  i = SlopeValuesSIMD(num, square_mag, value, n);
+#endif
+
+  /* the remainder (or everything on other CPUs) */
+  SlopeValuesPortable(num, square_mag, value, i, n);
+}
+
 // JMW: if zoomed right in (e.g. one unit is larger than terrain
 // grid), then increase the step size to be equal to the terrain
 // grid for purposes of calculating slope, to avoid shading problems
@@ -333,6 +457,20 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
   RawColor *dest = image->GetTopRow();
 
+  /* the slope of each row is calculated in two passes: the first
+     one collects the operands of the shading formula, the second
+     one (SlopeValues()) evaluates the expensive part of it for the
+     whole row at once */
+  const unsigned width = height_matrix.GetSize().x;
+  slope_num.GrowDiscard(width);
+  slope_square_mag.GrowDiscard(width);
+  slope_value.GrowDiscard(width);
+  slope_color_index.GrowDiscard(width);
+  double *const num = slope_num.data();
+  double *const square_mag = slope_square_mag.data();
+  int *const value = slope_value.data();
+  int *const color_index = slope_color_index.data();
+
   for (unsigned y = 0; y < height_matrix.GetSize().y; ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
@@ -345,13 +483,19 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
-    RawColor *p = dest;
+    RawColor *const row = dest, *p = row;
     dest = image->GetNextRow(dest);
 
     unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
     unsigned char *contour_this_column_base = contour_column_base;
 
-    for (unsigned x = 0; x < height_matrix.GetSize().x; ++x, ++src) {
+    /* no slope shading unless the first pass says otherwise; zero
+       operands are harmless for SlopeValues() */
+    std::fill_n(num, width, 0.);
+    std::fill_n(square_mag, width, 0.);
+    std::fill_n(color_index, width, -1);
+
+    for (unsigned x = 0; x < width; ++x, ++src) {
       const auto e = *src;
       if (!e.IsSpecial()) [[likely]] {
         unsigned h = std::max(0, (int)e.GetValue());
@@ -413,22 +557,18 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
         const int dd1 = int(p20) * p32;
         const double dd2 = double(p20) * double(p31) *
           double(height_slope_factor);
-        const double num =
+        num[x] =
           dd2 * double(sz) + double(dd0) * double(sx) +
           double(dd1) * double(sy);
-        const double square_mag =
+        square_mag[x] =
           double(dd0) * double(dd0) +
           double(dd1) * double(dd1) +
           dd2 * dd2;
-        const double mag = sqrt(square_mag);
-        /* this is a workaround for a SIGFPE (division by zero)
-           observed by our users on some Android devices (e.g. Nexus
-           7), even though we did our best to make sure that the
-           integer arithmetics above can't overflow */
-        /* TODO: debug this problem and replace this workaround */
-        const int sval = int(num / std::max(mag, 1.0));
-        const int sindex = (sval - sz) * contrast / 128;
-        *p++ = oColorBuf[int(h) + 256 * std::clamp(sindex, -63, 63)];
+
+        /* the color is determined below, after the slope values of
+           the whole row have been calculated */
+        color_index[x] = h;
+        ++p;
       } else if (e.IsWater()) {
         // we're in the water, so look up the color for water
         *p++ = oColorBuf[255];
@@ -439,6 +579,16 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
       contour_this_column_base++;
 
     }
+
+    SlopeValues(num, square_mag, value, width);
+
+    for (unsigned x = 0; x < width; ++x) {
+      if (color_index[x] < 0)
+        continue;
+
+      const int sindex = (value[x] - sz) * contrast / 128;
+      row[x] = oColorBuf[color_index[x] + 256 * std::clamp(sindex, -63, 63)];
+    }
   }
 }
 
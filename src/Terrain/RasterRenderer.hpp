@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Terrain/HeightMatrix.hpp"
+#include "util/AllocatedArray.hxx"
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
@@ -63,6 +64,12 @@ class RasterRenderer {
 
   RawColor *color_table = nullptr;
 
+  /**
+   * Per-row scratch buffers for GenerateSlopeImage().
+   */
+  AllocatedArray<double> slope_num, slope_square_mag;
+  AllocatedArray<int> slope_value, slope_color_index;
+
 public:
   RasterRenderer() noexcept;
   ~RasterRenderer() noexcept;
@@ -79,8 +86,13 @@ public:
   }
 
 #ifdef ENABLE_OPENGL
+  /**
+   * Force a redraw, and discard the cached height matrix.  Call this
+   * after the #RasterMap has changed.
+   */
   void Invalidate() noexcept {
     bounds.SetInvalid();
+    height_matrix.Discard();
   }
 
   /**
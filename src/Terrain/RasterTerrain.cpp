@@ -3,18 +3,50 @@
 
 #include "RasterTerrain.hpp"
 #include "Loader.hpp"
+#include "RasterTileStore.hpp"
 #include "Profile/Profile.hpp"
 #include "io/ZipArchive.hpp"
 #include "io/FileCache.hpp"
+#include "io/FileMapping.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
 #include "io/Reader.hxx"
 #include "io/BufferedReader.hxx"
+#include "system/Path.hpp"
 #include "Operation/Operation.hpp"
 #include "LogFile.hpp"
 
+#include <optional>
+
 static const char *const terrain_cache_name = "terrain";
 
+struct RasterTerrain::TileStoreBuilder {
+  FileCache &cache;
+
+  const AllocatedPath path;
+
+  /**
+   * The store being written; nullptr if GenerateTileStore() has not
+   * been called yet.
+   */
+  std::unique_ptr<FileOutputStream> os;
+
+  std::optional<BufferedOutputStream> bos;
+
+  /**
+   * The index of the next tile to be converted.
+   */
+  unsigned next_tile = 0;
+
+  TileStoreBuilder(FileCache &_cache, Path _path) noexcept
+    :cache(_cache), path(_path) {}
+};
+
+RasterTerrain::RasterTerrain(ZipArchive &&_archive) noexcept
+  :Guard<RasterMap>(map), archive(std::move(_archive)) {}
+
+RasterTerrain::~RasterTerrain() noexcept = default;
+
 inline bool
 RasterTerrain::LoadCache(FileCache &cache, Path path)
 {
@@ -43,28 +75,75 @@ RasterTerrain::SaveCache(FileCache &cache, Path path) const
   os->Commit();
 }
 
+inline bool
+RasterTerrain::LoadTileStore(FileCache &cache, Path path)
+{
+  std::span<const std::byte> payload;
+  auto mapping = cache.Map(RasterTileStore::CACHE_NAME, path, payload);
+  if (!mapping)
+    return false;
+
+  auto &tile_cache = map.GetTileCache();
+
+  auto store = std::make_unique<RasterTileStore>(std::move(mapping), payload);
+  if (!store->IsCompatible(tile_cache.GetTiles())) {
+    cache.Flush(RasterTileStore::CACHE_NAME);
+    return false;
+  }
+
+  tile_cache.SetTileStore(store.get());
+  tile_store = std::move(store);
+  return true;
+}
+
+inline void
+RasterTerrain::InitTileStore(FileCache &cache, Path path) noexcept
+{
+  try {
+    if (LoadTileStore(cache, path))
+      return;
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to load terrain tile store");
+    cache.Flush(RasterTileStore::CACHE_NAME);
+  }
+
+  if (RasterTileStore::CalcSize(map.GetTileCache().GetTiles()) >
+      RasterTileStore::MAX_SIZE)
+    /* too large; keep decoding tiles on demand */
+    return;
+
+  /* decoding all tiles takes too long for the startup; the
+     TerrainThread does it in the background */
+  tile_store_builder = std::make_unique<TileStoreBuilder>(cache, path);
+}
+
 inline void
 RasterTerrain::Load(Path path, FileCache *cache,
                     OperationEnvironment &operation)
 {
+  bool cached = false;
   try {
-    if (LoadCache(cache, path))
-      return;
+    cached = LoadCache(cache, path);
   } catch (...) {
     LogError(std::current_exception(), "Failed to load terrain cache");
   }
 
-  LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  if (!cached) {
+    LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
 
-  map.UpdateProjection();
+    map.UpdateProjection();
 
-  if (cache != nullptr) {
-    try {
-      SaveCache(*cache, path);
-    } catch (...) {
-      LogError(std::current_exception(), "Failed to save terrain cache");
+    if (cache != nullptr) {
+      try {
+        SaveCache(*cache, path);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save terrain cache");
+      }
     }
   }
+
+  if (cache != nullptr)
+    InitTileStore(*cache, path);
 }
 
 std::unique_ptr<RasterTerrain>
@@ -105,3 +184,58 @@ RasterTerrain::UpdateTiles(const GeoPoint &location, double radius) noexcept
 
   return map.IsDirty();
 }
+
+bool
+RasterTerrain::PrefetchTiles(const GeoPoint &location, double radius) noexcept
+{
+  auto &tile_cache = map.GetTileCache();
+  if (!tile_cache.IsValid())
+    return false;
+
+  try {
+    return PrefetchTerrainTiles(archive.get(), tile_cache, mutex,
+                                map.GetProjection(), location, radius);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to prefetch terrain tiles");
+    return false;
+  }
+}
+
+bool
+RasterTerrain::GenerateTileStore() noexcept
+{
+  if (!tile_store_builder)
+    return false;
+
+  auto &builder = *tile_store_builder;
+  auto &tile_cache = map.GetTileCache();
+  const unsigned n_tiles = tile_cache.GetTiles().size();
+
+  try {
+    if (!builder.os) {
+      builder.os = builder.cache.Save(RasterTileStore::CACHE_NAME,
+                                      builder.path);
+      builder.bos.emplace(*builder.os);
+      RasterTileStore::WriteHeader(*builder.bos, tile_cache.GetTiles());
+    }
+
+    builder.next_tile = ConvertTerrainTileBatch(archive.get(), tile_cache,
+                                                mutex, *builder.bos,
+                                                builder.next_tile);
+    if (builder.next_tile < n_tiles)
+      return true;
+
+    builder.bos->Flush();
+    builder.os->Commit();
+
+    const std::lock_guard lock{mutex};
+    LoadTileStore(builder.cache, builder.path);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to save terrain tile store");
+    builder.cache.Flush(RasterTileStore::CACHE_NAME);
+  }
+
+  /* finished or failed; don't try again */
+  tile_store_builder.reset();
+  return false;
+}
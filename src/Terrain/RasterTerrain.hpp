@@ -13,6 +13,7 @@
 class Path;
 class FileCache;
 class OperationEnvironment;
+class RasterTileStore;
 
 /**
  * Class to manage raster terrain database, potentially with caching
@@ -29,12 +30,27 @@ private:
 
   RasterMap map;
 
+  /**
+   * Pre-decoded tiles mapped from the #FileCache; nullptr if not
+   * available.
+   */
+  std::unique_ptr<RasterTileStore> tile_store;
+
+  struct TileStoreBuilder;
+
+  /**
+   * Generates the #RasterTileStore in the background (see
+   * GenerateTileStore()); nullptr if there is nothing to generate.
+   */
+  std::unique_ptr<TileStoreBuilder> tile_store_builder;
+
 public:
   /**
    * Constructor.  Returns uninitialised object.
    */
-  explicit RasterTerrain(ZipArchive &&_archive) noexcept
-    :Guard<RasterMap>(map), archive(std::move(_archive)) {}
+  explicit RasterTerrain(ZipArchive &&_archive) noexcept;
+
+  ~RasterTerrain() noexcept;
 
   const Serial &GetSerial() const noexcept {
     return map.GetSerial();
@@ -68,6 +84,29 @@ public:
    */
   bool UpdateTiles(const GeoPoint &location, double radius) noexcept;
 
+  /**
+   * Load a few tiles near the given location, after all tiles needed
+   * by UpdateTiles() have been loaded.
+   *
+   * @return true if the method shall be called again
+   */
+  bool PrefetchTiles(const GeoPoint &location, double radius) noexcept;
+
+  /**
+   * Decode the next batch of tiles into the #RasterTileStore which
+   * was missing in the #FileCache when the terrain was loaded.  Once
+   * it is complete, it gets mapped and used for loading tiles.  This
+   * must be called in the thread which calls UpdateTiles().
+   *
+   * @return true if the method shall be called again
+   */
+  bool GenerateTileStore() noexcept;
+
+  RasterTileCache::TileStatistics GetTileStatistics() const noexcept {
+    Lease lease(*this);
+    return lease->GetTileCache().GetStatistics();
+  }
+
 private:
   /**
    * Throws on error.
@@ -84,6 +123,21 @@ private:
    */
   void SaveCache(FileCache &cache, Path path) const;
 
+  /**
+   * Map the #RasterTileStore from the cache.
+   *
+   * Throws on error.
+   *
+   * @return false if there is no (valid) store
+   */
+  bool LoadTileStore(FileCache &cache, Path path);
+
+  /**
+   * Map the #RasterTileStore.  If it does not exist yet, prepare
+   * generating it with GenerateTileStore().  Errors are logged.
+   */
+  void InitTileStore(FileCache &cache, Path path) noexcept;
+
   /**
    * Throws on error.
    */
@@ -113,3 +113,15 @@ RasterTile::VisibilityChanged(IntPoint2D view,
   request = false;
   return CheckTileVisibility(view, view_radius);
 }
+
+bool
+RasterTile::CheckPrefetch(IntPoint2D p, unsigned radius) noexcept
+{
+  request = false;
+
+  if (!IsDefined() || IsLoaded())
+    return false;
+
+  distance = CalcDistanceTo(p);
+  return distance <= radius;
+}
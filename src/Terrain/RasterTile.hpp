@@ -7,6 +7,8 @@
 #include "RasterLocation.hpp"
 #include "RasterBuffer.hpp"
 
+#include <cassert>
+
 struct jas_matrix;
 class BufferedOutputStream;
 class BufferedReader;
@@ -27,6 +29,12 @@ public:
 
   bool request;
 
+  /**
+   * Was this tile loaded by RasterTileCache::PollPrefetchTiles() and
+   * not yet needed by the view?  Used for the statistics.
+   */
+  bool prefetched = false;
+
   RasterBuffer buffer;
 
 public:
@@ -47,6 +55,7 @@ public:
   void Clear() noexcept {
     size = {0, 0};
     request = false;
+    prefetched = false;
   }
 
   bool IsDefined() const noexcept {
@@ -79,6 +88,7 @@ public:
 
   void Unload() noexcept {
     buffer.Reset();
+    prefetched = false;
   }
 
   bool IsLoaded() const noexcept {
@@ -87,6 +97,15 @@ public:
 
   void CopyFrom(const struct jas_matrix &m) noexcept;
 
+  /**
+   * "Load" this tile by pointing the buffer to already decoded
+   * heights (e.g. a #RasterTileStore mapping) without copying them.
+   */
+  void MapFrom(const TerrainHeight *data) noexcept {
+    if (IsDefined())
+      buffer.SetView(data, size);
+  }
+
   /**
    * Determine the non-interpolated height at the specified pixel
    * location.
@@ -110,8 +129,35 @@ public:
   TerrainHeight GetInterpolatedHeight(unsigned x, unsigned y,
                                       unsigned ix, unsigned iy) const noexcept;
 
+  /**
+   * Is the specified pixel location within this tile?
+   */
+  constexpr bool IsInside(unsigned x, unsigned y) const noexcept {
+    return x - start.x < size.x && y - start.y < size.y;
+  }
+
+  /**
+   * Like GetInterpolatedHeight(), but store the sample in a
+   * #BilinearBatch.  The location must be inside this tile.
+   */
+  void PrepareInterpolatedHeight(BilinearBatch &batch, unsigned i,
+                                 unsigned x, unsigned y,
+                                 unsigned ix, unsigned iy) const noexcept {
+    assert(IsLoaded());
+    assert(IsInside(x, y));
+
+    buffer.PrepareInterpolated(batch, i, x - start.x, y - start.y, ix, iy);
+  }
+
   bool VisibilityChanged(IntPoint2D view, unsigned view_radius) noexcept;
 
+  /**
+   * Clear the request flag and check whether this tile is a
+   * candidate for prefetching, i.e. it is not loaded yet and it is
+   * within the given radius.  Updates #distance.
+   */
+  bool CheckPrefetch(IntPoint2D p, unsigned radius) noexcept;
+
   void ScanLine(RasterLocation a, RasterLocation b,
                 TerrainHeight *dest, unsigned dest_size,
                 bool interpolate) const noexcept {
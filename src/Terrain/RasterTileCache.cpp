@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "RasterTileCache.hpp"
+#include "RasterTileStore.hpp"
 #include "Math/Angle.hpp"
 #include "io/BufferedOutputStream.hxx"
 #include "io/BufferedReader.hxx"
@@ -25,31 +26,32 @@ CopyOverviewRow(TerrainHeight *gcc_restrict dest, const jas_seqent_t *gcc_restri
     *dest++ = TerrainHeight(*src);
 }
 
-void
-RasterTileCache::PutOverviewTile(unsigned index,
-                                 RasterLocation start, RasterLocation end,
-                                 const struct jas_matrix &m) noexcept
+/**
+ * Copy a tile into a scaled-down buffer (the overview or a pyramid
+ * level), picking every (2^bits)th pixel.
+ */
+static void
+PutScaledTile(RasterBuffer &buffer, unsigned bits,
+              RasterLocation start, const struct jas_matrix &m) noexcept
 {
-  tiles.GetLinear(index).Set(start, end);
-
-  const unsigned dest_pitch = overview.GetSize().x;
+  const unsigned dest_pitch = buffer.GetSize().x;
 
-  start.x = RasterTraits::ToOverview(start.x);
-  start.y = RasterTraits::ToOverview(start.y);
+  start.x >>= bits;
+  start.y >>= bits;
 
-  if (start.x >= overview.GetSize().x || start.y >= overview.GetSize().y)
+  if (start.x >= buffer.GetSize().x || start.y >= buffer.GetSize().y)
     return;
 
-  unsigned width = RasterTraits::ToOverviewCeil(m.numcols_);
-  if (start.x + width > overview.GetSize().x)
-    width = overview.GetSize().x - start.x;
-  unsigned height = RasterTraits::ToOverviewCeil(m.numrows_);
-  if (start.y + height > overview.GetSize().y)
-    height = overview.GetSize().y - start.y;
+  unsigned width = RasterTraits::ScaleDownCeil(m.numcols_, bits);
+  if (start.x + width > buffer.GetSize().x)
+    width = buffer.GetSize().x - start.x;
+  unsigned height = RasterTraits::ScaleDownCeil(m.numrows_, bits);
+  if (start.y + height > buffer.GetSize().y)
+    height = buffer.GetSize().y - start.y;
 
-  const unsigned skip = 1 << RasterTraits::OVERVIEW_BITS;
+  const unsigned skip = 1 << bits;
 
-  auto *gcc_restrict dest = overview.GetData()
+  auto *gcc_restrict dest = buffer.GetData()
     + start.y * dest_pitch + start.x;
 
   /* note: this loop rounds up */
@@ -57,6 +59,20 @@ RasterTileCache::PutOverviewTile(unsigned index,
     CopyOverviewRow(dest, m.rows_[y], width, skip);
 }
 
+void
+RasterTileCache::PutOverviewTile(unsigned index,
+                                 RasterLocation start, RasterLocation end,
+                                 const struct jas_matrix &m) noexcept
+{
+  tiles.GetLinear(index).Set(start, end);
+
+  PutScaledTile(overview, RasterTraits::OVERVIEW_BITS, start, m);
+
+  for (unsigned i = 0; i < pyramid.size(); ++i)
+    if (pyramid[i].IsDefined())
+      PutScaledTile(pyramid[i], i + 1, start, m);
+}
+
 void
 RasterTileCache::PutTileData(unsigned index,
                              const struct jas_matrix &m) noexcept
@@ -117,6 +133,13 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
     /* dispose all tiles which are out of range */
     for (unsigned i = MAX_ACTIVE_TILES; i < request_tiles.size(); ++i) {
       RasterTile &tile = tiles.GetLinear(request_tiles[i]);
+      if (!tile.IsLoaded())
+        continue;
+
+      ++statistics.evictions;
+      if (tile.prefetched)
+        ++statistics.wasted;
+
       tile.Unload();
     }
 
@@ -130,13 +153,21 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
   unsigned num_activate = 0;
   for (unsigned i = 0; i < request_tiles.size(); ++i) {
     RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-    if (tile.IsLoaded())
+    if (tile.IsLoaded()) {
+      if (tile.prefetched && tile.GetDistance() <= (int)radius) {
+        /* the view needs a tile which was prefetched */
+        tile.prefetched = false;
+        ++statistics.hits;
+      }
+
       continue;
+    }
 
-    if (++num_activate <= MAX_ACTIVATE)
+    if (++num_activate <= MAX_ACTIVATE) {
       /* request the tile in the current iteration */
       tile.SetRequest();
-    else
+      ++statistics.misses;
+    } else
       /* this tile will be loaded in the next iteration */
       dirty = true;
   }
@@ -144,6 +175,131 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
   return num_activate > 0;
 }
 
+bool
+RasterTileCache::PollPrefetchTiles(SignedRasterLocation p,
+                                   unsigned radius) noexcept
+{
+  /**
+   * Maximum number of tiles prefetched at a time.  This is small, to
+   * allow cancelling the prefetch quickly when the view or the hint
+   * changes.
+   */
+  constexpr unsigned MAX_PREFETCH = 4;
+
+  /**
+   * Don't prefetch when this many tiles are loaded already.
+   */
+  constexpr unsigned MAX_LOADED = MAX_ACTIVE_TILES * 3 / 4;
+
+  /* see PollTiles() */
+  radius += 256;
+
+  unsigned num_loaded = 0;
+
+  request_tiles.clear();
+  for (unsigned i = 0; i < tiles.GetSize(); ++i) {
+    RasterTile &tile = tiles.GetLinear(i);
+    if (tile.IsLoaded())
+      ++num_loaded;
+    else if (tile.CheckPrefetch(p, radius) && !request_tiles.full())
+      request_tiles.append(i);
+  }
+
+  if (num_loaded >= MAX_LOADED)
+    request_tiles.clear();
+
+  const unsigned n = std::min({
+      MAX_PREFETCH,
+      (unsigned)request_tiles.size(),
+      MAX_LOADED - std::min(num_loaded, MAX_LOADED),
+    });
+
+  if (n == 0)
+    return false;
+
+  const RTDistanceSort sort(*this);
+  std::partial_sort(request_tiles.begin(), request_tiles.begin() + n,
+                    request_tiles.end(), sort);
+  request_tiles.shrink(n);
+
+  for (std::size_t i : request_tiles) {
+    RasterTile &tile = tiles.GetLinear(i);
+    tile.SetRequest();
+    tile.prefetched = true;
+    ++statistics.prefetched;
+  }
+
+  return true;
+}
+
+bool
+RasterTileCache::MapRequestedTiles() noexcept
+{
+  if (store == nullptr)
+    return false;
+
+  bool complete = true;
+  for (std::size_t i : request_tiles) {
+    RasterTile &tile = tiles.GetLinear(i);
+    if (!tile.IsRequested())
+      continue;
+
+    const auto *data = store->GetTileData(i);
+    if (data == nullptr) {
+      complete = false;
+      continue;
+    }
+
+    tile.MapFrom(data);
+    tile.ClearRequest();
+  }
+
+  return complete;
+}
+
+std::pair<const RasterBuffer *, unsigned>
+RasterTileCache::FindLevel(unsigned bits) const noexcept
+{
+  if (bits >= RasterTraits::OVERVIEW_BITS)
+    return {&overview, RasterTraits::OVERVIEW_BITS};
+
+  for (unsigned i = bits; i > 0; --i)
+    if (pyramid[i - 1].IsDefined())
+      return {&pyramid[i - 1], i};
+
+  return {nullptr, 0};
+}
+
+std::pair<const RasterBuffer *, unsigned>
+RasterTileCache::GetCoarseBuffer() const noexcept
+{
+  for (unsigned i = 0; i < pyramid.size(); ++i)
+    if (pyramid[i].IsDefined())
+      return {&pyramid[i], i + 1};
+
+  return {&overview, RasterTraits::OVERVIEW_BITS};
+}
+
+unsigned
+RasterTileCache::GetPyramidMask() const noexcept
+{
+  unsigned mask = 0;
+  for (unsigned i = 0; i < pyramid.size(); ++i)
+    if (pyramid[i].IsDefined())
+      mask |= 1u << i;
+  return mask;
+}
+
+std::size_t
+RasterTileCache::GetPyramidBytes() const noexcept
+{
+  std::size_t bytes = 0;
+  for (const auto &level : pyramid)
+    if (level.IsDefined())
+      bytes += std::size_t(level.GetSize().Area()) * sizeof(TerrainHeight);
+  return bytes;
+}
+
 TerrainHeight
 RasterTileCache::GetHeight(RasterLocation p) const noexcept
 {
@@ -155,8 +311,9 @@ RasterTileCache::GetHeight(RasterLocation p) const noexcept
   if (tile.IsLoaded())
     return tile.GetHeight(p);
 
-  // still not found, so go to overview
-  return overview.GetInterpolated(p << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS));
+  // still not found, so go to the pyramid or the overview
+  const auto [buffer, bits] = GetCoarseBuffer();
+  return buffer->GetInterpolated(p << (RasterTraits::SUBPIXEL_BITS - bits));
 }
 
 TerrainHeight
@@ -173,8 +330,53 @@ RasterTileCache::GetInterpolatedHeight(RasterLocation l) const noexcept
   if (tile.IsLoaded())
     return tile.GetInterpolatedHeight(px, py, ix, iy);
 
-  // still not found, so go to overview
-  return overview.GetInterpolated({RasterTraits::ToOverview(l.x), RasterTraits::ToOverview(l.y)});
+  // still not found, so go to the pyramid or the overview
+  const auto [buffer, bits] = GetCoarseBuffer();
+  return buffer->GetInterpolated(l >> bits);
+}
+
+void
+RasterTileCache::GetInterpolatedHeights(std::span<const RasterLocation> locations,
+                                        TerrainHeight *dest) const noexcept
+{
+  const auto [coarse, coarse_bits] = GetCoarseBuffer();
+
+  /* consecutive locations are usually in the same tile; remember it
+     to avoid looking it up again */
+  const RasterTile *tile = nullptr;
+
+  BilinearBatch batch;
+
+  while (!locations.empty()) {
+    const std::size_t n = std::min<std::size_t>(locations.size(),
+                                                BilinearBatch::CAPACITY);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const RasterLocation l = locations[i];
+      if (l.x >= overview_size_fine.x || l.y >= overview_size_fine.y) {
+        // outside overall bounds
+        batch.SetConstant(i, TerrainHeight::Invalid());
+        continue;
+      }
+
+      const auto [px, ix] = RasterTraits::CalcSubpixel(l.x);
+      const auto [py, iy] = RasterTraits::CalcSubpixel(l.y);
+
+      if (tile == nullptr || !tile->IsInside(px, py))
+        tile = &tiles.Get(px / tile_size.x, py / tile_size.y);
+
+      if (tile->IsLoaded() && tile->IsInside(px, py))
+        tile->PrepareInterpolatedHeight(batch, i, px, py, ix, iy);
+      else
+        coarse->PrepareInterpolated(batch, i, l >> coarse_bits);
+    }
+
+    batch.Interpolate(n);
+    for (std::size_t i = 0; i < n; ++i)
+      *dest++ = batch.Get(i);
+
+    locations = locations.subspan(n);
+  }
 }
 
 void
@@ -190,6 +392,22 @@ RasterTileCache::SetSize(UnsignedPoint2D _size,
   overview.Resize({RasterTraits::ToOverviewCeil(size.x), RasterTraits::ToOverviewCeil(size.y)});
   overview_size_fine = size << RasterTraits::SUBPIXEL_BITS;
 
+  /* allocate the coarse levels first, they are the cheapest and the
+     most useful ones */
+  std::size_t pyramid_bytes = 0;
+  for (unsigned i = pyramid.size(); i-- > 0;) {
+    const RasterLocation level_size{
+      RasterTraits::ScaleDownCeil(size.x, i + 1),
+      RasterTraits::ScaleDownCeil(size.y, i + 1),
+    };
+
+    pyramid_bytes += std::size_t(level_size.Area()) * sizeof(TerrainHeight);
+    if (pyramid_bytes <= MAX_PYRAMID_BYTES)
+      pyramid[i].Resize(level_size);
+    else
+      pyramid[i].Reset();
+  }
+
   tiles.GrowDiscard(_n_tiles.x, _n_tiles.y);
 }
 
@@ -208,15 +426,31 @@ RasterTileCache::SetLatLonBounds(double _lon_min, double _lon_max,
                               std::min(lat_min, lat_max)));
 }
 
+void
+RasterTileCache::SetTileStore(const RasterTileStore *_store) noexcept
+{
+  /* drop all views into the old store */
+  if (store != nullptr)
+    for (auto &i : tiles)
+      if (i.buffer.IsView())
+        i.Unload();
+
+  store = _store;
+}
+
 void
 RasterTileCache::Reset() noexcept
 {
   size = {0, 0};
   bounds.SetInvalid();
   segments.clear();
+  store = nullptr;
 
   overview.Reset();
 
+  for (auto &i : pyramid)
+    i.Reset();
+
   for (auto &i : tiles)
     i.Unload();
 }
@@ -265,6 +499,7 @@ RasterTileCache::SaveCache(BufferedOutputStream &os) const
   header.tile_size = tile_size;
   header.n_tiles = {tiles.GetWidth(), tiles.GetHeight()};
   header.num_marker_segments = segments.size();
+  header.pyramid_mask = GetPyramidMask();
   header.bounds = bounds;
 
 #ifdef TEST_AUGUST
@@ -295,6 +530,12 @@ RasterTileCache::SaveCache(BufferedOutputStream &os) const
   /* save overview */
   size_t overview_size = overview.GetSize().Area();
   os.Write(std::as_bytes(std::span{overview.GetData(), overview_size}));
+
+  /* save pyramid */
+  for (const auto &level : pyramid)
+    if (level.IsDefined())
+      os.Write(std::as_bytes(std::span{level.GetData(),
+                                       std::size_t(level.GetSize().Area())}));
 }
 
 void
@@ -318,6 +559,9 @@ RasterTileCache::LoadCache(BufferedReader &r)
     throw std::runtime_error("Malformed terrain cache header");
 
   SetSize(header.size, header.tile_size, header.n_tiles);
+  if (header.pyramid_mask != GetPyramidMask())
+    throw std::runtime_error("Malformed terrain cache pyramid");
+
   bounds = header.bounds;
   if (!bounds.IsValid())
     throw std::runtime_error("Malformed terrain cache bounds");
@@ -346,4 +590,12 @@ RasterTileCache::LoadCache(BufferedReader &r)
         overview.GetData(),
         overview_size,
       }));
+
+  /* load pyramid */
+  for (auto &level : pyramid)
+    if (level.IsDefined())
+      r.ReadFull(std::as_writable_bytes(std::span{
+            level.GetData(),
+            std::size_t(level.GetSize().Area()),
+          }));
 }
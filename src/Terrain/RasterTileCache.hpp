@@ -10,9 +10,11 @@
 #include "util/StaticArray.hxx"
 #include "util/Serial.hpp"
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <optional>
+#include <span>
 
 static constexpr unsigned  RASTER_SLOPE_FACT = 12;
 
@@ -20,8 +22,43 @@ struct jas_matrix;
 struct GridLocation;
 class BufferedOutputStream;
 class BufferedReader;
+class RasterTileStore;
 
 class RasterTileCache {
+public:
+  /**
+   * Counters which help tuning #MAX_ACTIVE_TILES and the prefetch
+   * parameters.
+   */
+  struct TileStatistics {
+    /**
+     * Tiles needed by the view which had already been prefetched.
+     */
+    unsigned hits = 0;
+
+    /**
+     * Tiles needed by the view which had to be loaded on demand.
+     */
+    unsigned misses = 0;
+
+    /**
+     * Tiles which were unloaded to stay within #MAX_ACTIVE_TILES.
+     */
+    unsigned evictions = 0;
+
+    /**
+     * Tiles requested by PollPrefetchTiles().
+     */
+    unsigned prefetched = 0;
+
+    /**
+     * Prefetched tiles which were evicted before the view needed
+     * them.
+     */
+    unsigned wasted = 0;
+  };
+
+private:
   static constexpr unsigned MAX_RTC_TILES = 4096;
 
   /**
@@ -41,6 +78,20 @@ class RasterTileCache {
    */
   static constexpr unsigned INTERSECT_BITS = 7;
 
+  /**
+   * The memory budget (in bytes) for all pyramid levels.  Levels are
+   * allocated from the coarsest to the finest one; a level which
+   * would exceed the budget is not allocated, and neither are the
+   * finer ones.  Build with TERRAIN_PYRAMID=n to disable the pyramid.
+   */
+#ifdef NO_TERRAIN_PYRAMID
+  static constexpr std::size_t MAX_PYRAMID_BYTES = 0;
+#elif defined(ANDROID) || defined(KOBO)
+  static constexpr std::size_t MAX_PYRAMID_BYTES = 2 * 1024 * 1024;
+#else
+  static constexpr std::size_t MAX_PYRAMID_BYTES = 8 * 1024 * 1024;
+#endif
+
 protected:
   friend struct RTDistanceSort;
   friend class TerrainLoader;
@@ -76,13 +127,19 @@ protected:
   };
 
   struct CacheHeader {
-    static constexpr unsigned VERSION = 0xb;
+    static constexpr unsigned VERSION = 0xc;
 
     unsigned version;
     UnsignedPoint2D size;
     Point2D<uint_least16_t> tile_size;
     UnsignedPoint2D n_tiles;
     unsigned num_marker_segments;
+
+    /**
+     * A bit mask of the pyramid levels stored in the cache.
+     */
+    unsigned pyramid_mask;
+
     GeoBounds bounds;
   };
 
@@ -98,6 +155,15 @@ protected:
   Point2D<uint_least16_t> tile_size;
 
   RasterBuffer overview;
+
+  /**
+   * Intermediate resolutions between the fine tiles and #overview,
+   * built while loading the overview; level i is scaled down by
+   * 2^(i+1).  Levels which would use too much memory are not
+   * allocated.
+   */
+  std::array<RasterBuffer, RasterTraits::PYRAMID_LEVELS> pyramid;
+
   RasterLocation size;
   RasterLocation overview_size_fine;
 
@@ -105,6 +171,15 @@ protected:
 
   StaticArray<MarkerSegmentInfo, 8192> segments;
 
+  /**
+   * An optional store of pre-decoded tiles.  If set, requested tiles
+   * are mapped from there instead of being decoded from the JPEG2000
+   * file.
+   */
+  const RasterTileStore *store = nullptr;
+
+  TileStatistics statistics;
+
   /**
    * An array that is used to sort the requested tiles by distance.
    * This is only used by PollTiles() internally, but is stored in the
@@ -150,6 +225,20 @@ public:
   [[gnu::pure]]
   TerrainHeight GetInterpolatedHeight(RasterLocation p) const noexcept;
 
+  /**
+   * Determine the interpolated heights at many sub-pixel locations.
+   * This is faster than calling GetInterpolatedHeight() for each
+   * location, because the tile lookup is skipped while consecutive
+   * locations are in the same tile, and the interpolation arithmetic
+   * is vectorised (see #BilinearBatch).
+   *
+   * @param locations the sub-pixel positions within the map; may be
+   * out of range
+   * @param dest an array with one element per location
+   */
+  void GetInterpolatedHeights(std::span<const RasterLocation> locations,
+                              TerrainHeight *dest) const noexcept;
+
   /**
    * Scan a straight line and fill the buffer with the specified
    * number of samples along the line.
@@ -185,6 +274,30 @@ public:
                      int height_floor) const noexcept;
 
 private:
+  /**
+   * Find the coarsest available pyramid level whose pixels are not
+   * larger than 2^bits fine pixels.  The overview counts as the
+   * coarsest level.
+   *
+   * @return the buffer and its scale (in bits), or nullptr if the
+   * fine tiles should be used
+   */
+  [[gnu::pure]]
+  std::pair<const RasterBuffer *, unsigned>
+  FindLevel(unsigned bits) const noexcept;
+
+  /**
+   * Returns the finest available buffer which covers the whole map
+   * (a pyramid level or the overview) and its scale (in bits).  This
+   * is used when the fine tile is not loaded.
+   */
+  [[gnu::pure]]
+  std::pair<const RasterBuffer *, unsigned>
+  GetCoarseBuffer() const noexcept;
+
+  [[gnu::pure]]
+  unsigned GetPyramidMask() const noexcept;
+
   /**
    * Get field (not interpolated) directly, without bringing tiles to front.
    * @param p position/256
@@ -196,6 +309,12 @@ private:
   std::pair<TerrainHeight, bool> GetFieldDirect(RasterLocation p) const noexcept;
 
 public:
+  /**
+   * Returns the number of bytes allocated by the pyramid levels.
+   */
+  [[gnu::pure]]
+  std::size_t GetPyramidBytes() const noexcept;
+
   /**
    * Throws on error.
    */
@@ -223,6 +342,10 @@ public:
     return serial;
   }
 
+  const TileStatistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
   void Reset() noexcept;
 
   const GeoBounds &GetBounds() const noexcept {
@@ -231,6 +354,21 @@ public:
     return bounds;
   }
 
+  std::span<const RasterTile> GetTiles() const noexcept {
+    return {tiles.begin(), tiles.GetSize()};
+  }
+
+  /**
+   * Attach a #RasterTileStore (or detach it by passing nullptr).
+   * The caller is responsible for keeping it alive until it is
+   * detached or until Reset() is called.
+   */
+  void SetTileStore(const RasterTileStore *_store) noexcept;
+
+  bool HasTileStore() const noexcept {
+    return store != nullptr;
+  }
+
 public:
   /* methods called by class TerrainLoader */
 
@@ -260,6 +398,26 @@ public:
 
   bool PollTiles(SignedRasterLocation p, unsigned radius) noexcept;
 
+  /**
+   * Request a few tiles near the given location (usually ahead of
+   * the aircraft), nearest first.  This is only called when all
+   * tiles needed by the view are loaded.  It never unloads tiles; it
+   * only fills up to 3/4 of #MAX_ACTIVE_TILES, which leaves room for
+   * the view.
+   *
+   * @return true if tiles were requested
+   */
+  bool PollPrefetchTiles(SignedRasterLocation p, unsigned radius) noexcept;
+
+  /**
+   * Load all requested tiles from the #RasterTileStore.  Tiles which
+   * are missing in the store remain requested.
+   *
+   * @return true if all requested tiles have been loaded, false if
+   * the JPEG2000 file needs to be decoded
+   */
+  bool MapRequestedTiles() noexcept;
+
   void PutTileData(unsigned index, const struct jas_matrix &m) noexcept;
 
   void FinishTileUpdate() noexcept;
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "RasterTileStore.hpp"
+#include "RasterTile.hpp"
+#include "io/FileMapping.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "util/SpanCast.hxx"
+
+#include <cassert>
+#include <stdexcept>
+
+#include <string.h>
+
+static constexpr std::size_t
+CalcTileBytes(RasterLocation size) noexcept
+{
+  return std::size_t(size.x) * size.y * sizeof(TerrainHeight);
+}
+
+RasterTileStore::RasterTileStore(std::unique_ptr<FileMapping> &&_mapping,
+                                 std::span<const std::byte> _data)
+  :mapping(std::move(_mapping)), data(_data)
+{
+  if (data.size() < sizeof(Header) ||
+      reinterpret_cast<std::uintptr_t>(data.data()) % alignof(Entry) != 0)
+    throw std::runtime_error("Malformed terrain tile store");
+
+  Header header;
+  memcpy(&header, data.data(), sizeof(header));
+
+  if (header.version != Header::VERSION ||
+      header.n_tiles > (data.size() - sizeof(header)) / sizeof(Entry))
+    throw std::runtime_error("Malformed terrain tile store header");
+
+  entries = {
+    reinterpret_cast<const Entry *>(data.data() + sizeof(header)),
+    header.n_tiles,
+  };
+
+  const std::size_t min_offset = sizeof(header) +
+    entries.size() * sizeof(Entry);
+
+  for (const auto &i : entries)
+    if (i.offset != 0 &&
+        (i.offset < min_offset ||
+         i.offset % alignof(TerrainHeight) != 0 ||
+         i.offset + CalcTileBytes(i.size) > data.size()))
+      throw std::runtime_error("Malformed terrain tile store entry");
+}
+
+RasterTileStore::~RasterTileStore() noexcept = default;
+
+bool
+RasterTileStore::IsCompatible(std::span<const RasterTile> tiles) const noexcept
+{
+  if (tiles.size() != entries.size())
+    return false;
+
+  for (std::size_t i = 0; i < tiles.size(); ++i) {
+    const auto &tile = tiles[i];
+    const auto &entry = entries[i];
+
+    if (tile.IsDefined()
+        ? entry.offset == 0 || entry.size != tile.size
+        : entry.offset != 0)
+      return false;
+  }
+
+  return true;
+}
+
+std::size_t
+RasterTileStore::CalcSize(std::span<const RasterTile> tiles) noexcept
+{
+  std::size_t size = sizeof(Header) + tiles.size() * sizeof(Entry);
+  for (const auto &tile : tiles)
+    if (tile.IsDefined())
+      size += CalcTileBytes(tile.size);
+  return size;
+}
+
+void
+RasterTileStore::WriteHeader(BufferedOutputStream &os,
+                             std::span<const RasterTile> tiles)
+{
+  if (CalcSize(tiles) > MAX_SIZE)
+    throw std::runtime_error("Terrain tile store too large");
+
+  Header header;
+  header.version = Header::VERSION;
+  header.n_tiles = tiles.size();
+  os.Write(ReferenceAsBytes(header));
+
+  std::size_t offset = sizeof(header) + tiles.size() * sizeof(Entry);
+  for (const auto &tile : tiles) {
+    Entry entry;
+
+    if (tile.IsDefined()) {
+      entry.offset = offset;
+      entry.size = tile.size;
+      offset += CalcTileBytes(tile.size);
+    } else {
+      entry.offset = 0;
+      entry.size = {0, 0};
+    }
+
+    os.Write(ReferenceAsBytes(entry));
+  }
+}
+
+void
+RasterTileStore::WriteTile(BufferedOutputStream &os, const RasterTile &tile)
+{
+  assert(tile.IsDefined());
+  assert(tile.IsLoaded());
+  assert(tile.buffer.GetSize() == tile.size);
+
+  os.Write(std::as_bytes(std::span{tile.buffer.GetData(),
+                                   std::size_t(tile.size.Area())}));
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "RasterLocation.hpp"
+#include "Height.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+class FileMapping;
+class BufferedOutputStream;
+class RasterTile;
+
+/**
+ * A file containing all terrain tiles in decoded form, which gets
+ * mapped into memory.  Once this exists, "loading" a tile is just
+ * pointing a #RasterBuffer into the mapping; the kernel pages the
+ * data in on demand, and no JPEG2000 decoding is needed.
+ *
+ * The file is generated once from the JPEG2000 file (see
+ * ConvertTerrainTiles()) and is stored in the #FileCache next to the
+ * regular terrain cache.
+ *
+ * File layout: a #Header, followed by one #Entry per tile, followed
+ * by the raw #TerrainHeight rows of each tile.
+ */
+class RasterTileStore {
+  struct Header {
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t version;
+    uint32_t n_tiles;
+  };
+
+  struct Entry {
+    /**
+     * The position of the tile data within the store (starting at
+     * the #Header).  0 means this tile is not defined.
+     */
+    uint32_t offset;
+
+    RasterLocation size;
+  };
+
+  std::unique_ptr<FileMapping> mapping;
+
+  std::span<const Entry> entries;
+
+  std::span<const std::byte> data;
+
+public:
+  /**
+   * The name of this store within the #FileCache.
+   */
+  static constexpr const char *CACHE_NAME = "terrain_tiles";
+
+  /**
+   * Don't generate stores larger than this, because they would waste
+   * too much storage space and would exceed the #FileMapping limits.
+   */
+  static constexpr std::size_t MAX_SIZE = 256 * 1024 * 1024;
+
+  /**
+   * Throws on error.
+   *
+   * @param _data the portion of #_mapping which contains the store
+   */
+  RasterTileStore(std::unique_ptr<FileMapping> &&_mapping,
+                  std::span<const std::byte> _data);
+
+  ~RasterTileStore() noexcept;
+
+  RasterTileStore(const RasterTileStore &) = delete;
+  RasterTileStore &operator=(const RasterTileStore &) = delete;
+
+  /**
+   * Does this store match the layout of the given tiles?
+   */
+  [[gnu::pure]]
+  bool IsCompatible(std::span<const RasterTile> tiles) const noexcept;
+
+  /**
+   * Returns a pointer to the decoded heights of the given tile, or
+   * nullptr if the tile is not in this store.
+   */
+  [[gnu::pure]]
+  const TerrainHeight *GetTileData(unsigned index) const noexcept {
+    if (index >= entries.size() || entries[index].offset == 0)
+      return nullptr;
+
+    return reinterpret_cast<const TerrainHeight *>(data.data() +
+                                                   entries[index].offset);
+  }
+
+  /**
+   * Calculate the size of a store containing the given tiles.
+   */
+  [[gnu::pure]]
+  static std::size_t CalcSize(std::span<const RasterTile> tiles) noexcept;
+
+  /**
+   * Write the header and the tile table.  After that, WriteTile()
+   * must be called for each defined tile, in index order.
+   *
+   * Throws on error.
+   */
+  static void WriteHeader(BufferedOutputStream &os,
+                          std::span<const RasterTile> tiles);
+
+  /**
+   * Write the decoded data of one (loaded) tile.
+   *
+   * Throws on error.
+   */
+  static void WriteTile(BufferedOutputStream &os, const RasterTile &tile);
+};
@@ -19,6 +19,21 @@ constexpr unsigned OVERVIEW_BITS = 4;
 
 constexpr unsigned OVERVIEW_MASK = ~((~0u) << OVERVIEW_BITS);
 
+/**
+ * The number of intermediate resolutions ("pyramid levels") between
+ * the terrain bitmap and the overview.  Level i is scaled down by
+ * 2^(i+1).
+ */
+constexpr unsigned PYRAMID_LEVELS = OVERVIEW_BITS - 1;
+
+/**
+ * Convert a pixel size to the size of a scaled-down bitmap, rounding
+ * up.
+ */
+constexpr unsigned ScaleDownCeil(unsigned x, unsigned bits) noexcept {
+  return (x + ~((~0u) << bits)) >> bits;
+}
+
 /**
  * The fixed-point fractional part of sub-pixel coordinates.
  */
@@ -4,6 +4,11 @@
 #include "Terrain/RasterTileCache.hpp"
 #include "Terrain/RasterLocation.hpp"
 
+#include <algorithm>
+#include <bit>
+
+#include <stdlib.h>
+
 /**
  * A #RasterLocation with some cached computations.  The
  * #RasterLocation base holds the linear subpixel coordinates within
@@ -315,6 +320,27 @@ RasterTileCache::ScanLine(const RasterLocation _start,
   assert(_end.y < GetFineSize().y);
   assert(size >= 2);
 
+  /* if the samples are further apart than one pixel, scan a
+     scaled-down level instead of the fine tiles, which works even if
+     the tiles are not loaded; the levels are decimated (not
+     averaged), so this point-samples the terrain like the fine scan
+     does, but each sample snaps to the coarse grid and may be off by
+     up to 2^bits-1 fine pixels, which is less than the sample
+     spacing */
+  const unsigned distance =
+    std::max(abs((int)_end.x - (int)_start.x),
+             abs((int)_end.y - (int)_start.y));
+  const unsigned spacing =
+    (distance / (size - 1)) >> RasterTraits::SUBPIXEL_BITS;
+  if (spacing >= 2) {
+    const auto [level, bits] = FindLevel(std::bit_width(spacing) - 1);
+    if (level != nullptr) {
+      level->ScanLineChecked(_start >> bits, _end >> bits,
+                             buffer, size, interpolate);
+      return;
+    }
+  }
+
   const GridRay ray(GetFineTileSize(), _start, _end, size);
   assert(ray.size == size);
   assert(ray.start.index == 0);
@@ -342,20 +342,32 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
       !IsLargeSizeDifference(old_bounds, new_bounds) &&
       terrain_serial == terrain.GetSerial() &&
       sunazimuth.CompareRoughly(last_sun_azimuth) &&
-      !raster_renderer.UpdateQuantisation())
+      !raster_renderer.UpdateQuantisation()) {
     /* no change since previous frame */
+    ++hits;
     return true;
+  }
 
 #else
   if (compare_projection.Compare(map_projection) &&
       terrain_serial == terrain.GetSerial() &&
-      sunazimuth.CompareRoughly(last_sun_azimuth))
+      sunazimuth.CompareRoughly(last_sun_azimuth)) {
     /* no change since previous frame */
+    ++hits;
     return true;
+  }
 
   compare_projection = CompareProjection(map_projection);
 #endif
 
+#ifdef ENABLE_OPENGL
+  if (terrain_serial != terrain.GetSerial())
+    /* new terrain tiles have been loaded: the cached heights are
+       obsolete */
+    raster_renderer.Invalidate();
+#endif
+
+  ++misses;
   terrain_serial = terrain.GetSerial();
 
   last_sun_azimuth = sunazimuth;
@@ -387,3 +399,17 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
                                 do_contour);
   return true;
 }
+
+TerrainRenderer::Statistics
+TerrainRenderer::GetStatistics() const noexcept
+{
+  Statistics s;
+  s.hits = hits;
+  s.misses = misses;
+#ifdef ENABLE_OPENGL
+  const auto &height_matrix = raster_renderer.GetHeightMatrix();
+  s.reused_cells = height_matrix.GetReusedCells();
+  s.scanned_cells = height_matrix.GetScannedCells();
+#endif
+  return s;
+}
@@ -7,6 +7,8 @@
 #include "util/Serial.hpp"
 #include "Terrain/TerrainSettings.hpp"
 
+#include <cstddef>
+
 #ifndef ENABLE_OPENGL
 #include "Projection/CompareProjection.hpp"
 #endif
@@ -17,6 +19,31 @@ class RasterTerrain;
 struct ColorRamp;
 
 class TerrainRenderer {
+public:
+  struct Statistics {
+    /**
+     * The number of Generate() calls which found the previous image
+     * still up to date.
+     */
+    std::size_t hits = 0;
+
+    /**
+     * The number of Generate() calls which had to generate a new
+     * image.
+     */
+    std::size_t misses = 0;
+
+#ifdef ENABLE_OPENGL
+    /**
+     * The number of terrain samples which were copied from the
+     * previous image resp. scanned from the map (see
+     * HeightMatrix::FillGrid()).
+     */
+    std::size_t reused_cells = 0, scanned_cells = 0;
+#endif
+  };
+
+private:
   const RasterTerrain &terrain;
 
   Serial terrain_serial;
@@ -34,6 +61,8 @@ protected:
 
   RasterRenderer raster_renderer;
 
+  std::size_t hits = 0, misses = 0;
+
 public:
   TerrainRenderer(const RasterTerrain &_terrain);
   ~TerrainRenderer() {}
@@ -82,4 +111,7 @@ public:
   void Draw(Canvas &canvas, const WindowProjection &projection) const {
     raster_renderer.Draw(canvas, projection);
   }
+
+  [[gnu::pure]]
+  Statistics GetStatistics() const noexcept;
 };
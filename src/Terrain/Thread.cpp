@@ -4,12 +4,19 @@
 #include "Thread.hpp"
 #include "RasterTerrain.hpp"
 #include "Projection/WindowProjection.hpp"
+#include "Geo/Math.hpp"
 #include "thread/Util.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
 
 TerrainThread::TerrainThread(RasterTerrain &_terrain,
                              std::function<void()> &&_callback)
   :StandbyThread("Terrain"), terrain(_terrain),
-   callback(std::move(_callback)) {}
+   callback(std::move(_callback))
+{
+  log_clock.Update();
+}
 
 void
 TerrainThread::Trigger(const WindowProjection &projection)
@@ -29,6 +36,44 @@ TerrainThread::Trigger(const WindowProjection &projection)
   StandbyThread::Trigger();
 }
 
+void
+TerrainThread::SetPrefetchHint(const GeoPoint &location, Angle track,
+                               double ground_speed, const GeoPoint &target)
+{
+  assert(location.IsValid());
+
+  const double distance = std::min(ground_speed * PREFETCH_TIME.count(),
+                                   MAX_PREFETCH_DISTANCE);
+
+  GeoPoint ahead;
+  if (target.IsValid())
+    ahead = location.DistanceS(target) <= distance
+      ? target
+      : location.IntermediatePoint(target, distance);
+  else
+    ahead = FindLatitudeLongitude(location, track, distance);
+
+  const std::lock_guard lock{mutex};
+
+  /* ignore small changes, to avoid restarting the prefetch all the
+     time */
+  if (prefetch_location.IsValid() &&
+      prefetch_location.DistanceS(ahead) < PREFETCH_RADIUS / 4)
+    return;
+
+  prefetch_location = ahead;
+
+  if (next_center.IsValid())
+    StandbyThread::Trigger();
+}
+
+void
+TerrainThread::ClearPrefetchHint() noexcept
+{
+  const std::lock_guard lock{mutex};
+  prefetch_location = GeoPoint::Invalid();
+}
+
 void
 TerrainThread::Tick() noexcept
 {
@@ -53,4 +98,33 @@ TerrainThread::Tick() noexcept
     const ScopeUnlock unlock(mutex);
     callback();
   }
+
+  /* now that the view is complete, load tiles ahead of the aircraft,
+     a few at a time; this stops as soon as the view moves, and each
+     round uses the latest hint */
+  while (!again && prefetch_location.IsValid() && !IsStopped() &&
+         next_center == last_center && next_radius <= last_radius) {
+    const GeoPoint location = prefetch_location;
+
+    const ScopeUnlock unlock(mutex);
+    if (!terrain.PrefetchTiles(location, PREFETCH_RADIUS))
+      break;
+  }
+
+  /* when there is nothing else to do, generate the tile store, one
+     batch at a time, so a moving view is not delayed for long */
+  while (!again && !IsStopped() &&
+         next_center == last_center && next_radius <= last_radius) {
+    const ScopeUnlock unlock(mutex);
+    if (!terrain.GenerateTileStore())
+      break;
+  }
+
+  if (log_clock.CheckUpdate(std::chrono::minutes{10})) {
+    const ScopeUnlock unlock(mutex);
+    const auto s = terrain.GetTileStatistics();
+    LogFmt("Terrain tiles: {} hits, {} misses, {} evictions, "
+           "{} prefetched, {} wasted",
+           s.hits, s.misses, s.evictions, s.prefetched, s.wasted);
+  }
 }
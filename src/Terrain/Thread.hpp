@@ -5,11 +5,14 @@
 
 #include "thread/StandbyThread.hpp"
 #include "Geo/GeoPoint.hpp"
+#include "time/FloatDuration.hxx"
+#include "time/PeriodClock.hpp"
 
 #include <functional>
 
 class RasterTerrain;
 class WindowProjection;
+class Angle;
 
 /**
  * A thread that loads topography files asynchronously.
@@ -22,16 +25,53 @@ class TerrainThread final : private StandbyThread {
   GeoPoint last_center = GeoPoint::Invalid();
   double last_radius;
 
-  GeoPoint next_center;
+  GeoPoint next_center = GeoPoint::Invalid();
   double next_radius;
 
+  /**
+   * Where the aircraft is expected to be soon (see
+   * SetPrefetchHint()).  Invalid if there is no hint.
+   */
+  GeoPoint prefetch_location = GeoPoint::Invalid();
+
+  /**
+   * Limits how often the tile statistics are logged.
+   */
+  PeriodClock log_clock;
+
 public:
+  /**
+   * How far ahead of the aircraft tiles are prefetched, in flight
+   * time; the distance is capped at #MAX_PREFETCH_DISTANCE.
+   */
+  static constexpr FloatDuration PREFETCH_TIME = std::chrono::minutes{5};
+  static constexpr double MAX_PREFETCH_DISTANCE = 30000;
+
+  /**
+   * The radius [m] around the prefetch location which gets loaded.
+   */
+  static constexpr double PREFETCH_RADIUS = 10000;
+
   TerrainThread(RasterTerrain &_terrain, std::function<void()> &&_callback);
 
   using StandbyThread::LockStop;
 
   void Trigger(const WindowProjection &projection);
 
+  /**
+   * Load tiles ahead of the aircraft after the visible ones have
+   * been loaded.  The prefetch location is on the current task leg
+   * if there is one, or else along the track.  A new hint which
+   * differs significantly cancels the prefetching of the old one.
+   *
+   * @param target the current task point; invalid if there is no
+   * active task
+   */
+  void SetPrefetchHint(const GeoPoint &location, Angle track,
+                       double ground_speed, const GeoPoint &target);
+
+  void ClearPrefetchHint() noexcept;
+
 private:
   /* virtual methods from class StandbyThread*/
   void Tick() noexcept override;
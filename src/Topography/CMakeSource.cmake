@@ -9,6 +9,7 @@ set(_SOURCES
         Topography/XShape.cpp
         Topography/Index.cpp
         Topography/ShapeFile.cpp
+        Topography/ShapeCache.cpp
 )
 
 list(APPEND _SOURCES
@@ -0,0 +1,344 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ShapeCache.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/Path.hpp"
+
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+#include <string.h>
+
+/**
+ * The alignment of all sections within the cache file.  Since the
+ * mapping starts at a page boundary, this is also the alignment in
+ * memory.
+ */
+static constexpr std::size_t SECTION_ALIGNMENT = 8;
+
+namespace {
+
+struct Header {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+
+  /**
+   * sizeof(ShapeCache::Point), which differs between OpenGL and
+   * other builds.
+   */
+  uint32_t point_size;
+
+  uint32_t pixel_scale;
+
+  uint32_t n_shapes, n_words, n_points, n_chars;
+};
+
+} // anonymous namespace
+
+struct ShapeCache::Record {
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  GeoBounds bounds;
+
+  /**
+   * The first point of this shape in the point array.
+   */
+  uint32_t first_point;
+
+  /**
+   * The line lengths of this shape in the word array.
+   */
+  uint32_t first_line;
+
+  /**
+   * For each thinning level: the index counts followed by the indices
+   * in the word array, or #NONE.
+   */
+  std::array<uint32_t, THINNING_LEVELS> indices;
+
+  /**
+   * The label in the character array, or #NONE.
+   */
+  uint32_t label;
+
+  uint8_t type, num_lines;
+
+  /**
+   * False if the shape failed to load.
+   */
+  bool valid;
+};
+
+static_assert(std::is_trivially_copyable_v<ShapeCache::Record>);
+static_assert(std::is_trivially_copyable_v<ShapeCache::Point>);
+static_assert(alignof(ShapeCache::Record) <= SECTION_ALIGNMENT);
+static_assert(alignof(ShapeCache::Point) <= SECTION_ALIGNMENT);
+
+#ifdef ENABLE_OPENGL
+static_assert(ShapeCache::THINNING_LEVELS == XShape::THINNING_LEVELS);
+#endif
+
+std::string
+ShapeCache::MakeName(Path original_path, const char *filename) noexcept
+{
+  return FileCache::MakeName("topography",
+                             {original_path.c_str(), filename});
+}
+
+/**
+ * Skip the padding before the next section and return the section
+ * with the given number of elements.
+ */
+template<typename T>
+static std::span<const T>
+TakeSection(std::span<const std::byte> &data, std::size_t n)
+{
+  const std::size_t padding =
+    -reinterpret_cast<uintptr_t>(data.data()) % SECTION_ALIGNMENT;
+  if (padding > data.size() ||
+      n > (data.size() - padding) / sizeof(T))
+    throw std::runtime_error("Malformed shape cache");
+
+  data = data.subspan(padding);
+  const T *p = reinterpret_cast<const T *>(data.data());
+  data = data.subspan(n * sizeof(T));
+  return {p, n};
+}
+
+/**
+ * Returns the number of words occupied by the given index array.
+ */
+static std::size_t
+GetIndexSize(std::span<const uint16_t> words, std::size_t offset,
+             uint8_t type, std::size_t num_lines)
+{
+  const std::size_t n_counts = type == MS_SHAPE_LINE ? num_lines : 1;
+  if (offset > words.size() || n_counts > words.size() - offset)
+    throw std::runtime_error("Malformed shape cache indices");
+
+  const auto counts = words.subspan(offset, n_counts);
+  const std::size_t n_indices =
+    std::accumulate(counts.begin(), counts.end(), std::size_t{});
+  if (n_indices > words.size() - offset - n_counts)
+    throw std::runtime_error("Malformed shape cache indices");
+
+  return n_counts + n_indices;
+}
+
+ShapeCache::ShapeCache(std::unique_ptr<FileMapping> &&_mapping,
+                       std::span<const std::byte> data)
+  :mapping(std::move(_mapping))
+{
+  const std::span<const std::byte> raw = *mapping;
+  mapped_size = raw.size();
+
+  const auto &header = TakeSection<Header>(data, 1).front();
+  records = TakeSection<Record>(data, header.n_shapes);
+  words = TakeSection<uint16_t>(data, header.n_words);
+  points = TakeSection<Point>(data, header.n_points);
+  const auto labels = TakeSection<char>(data, header.n_chars);
+  chars = labels.data();
+
+  if (!labels.empty() && labels.back() != 0)
+    throw std::runtime_error("Malformed shape cache labels");
+
+  /* verify all offsets, so Load() does not need to */
+  for (const auto &record : records) {
+    if (!record.valid)
+      continue;
+
+    if (record.num_lines > XShape::MAX_LINES ||
+        record.first_line > words.size() ||
+        record.num_lines > words.size() - record.first_line)
+      throw std::runtime_error("Malformed shape cache record");
+
+    const auto lines = words.subspan(record.first_line, record.num_lines);
+    const std::size_t n_points =
+      std::accumulate(lines.begin(), lines.end(), std::size_t{});
+    if (record.first_point > points.size() ||
+        n_points > points.size() - record.first_point)
+      throw std::runtime_error("Malformed shape cache record");
+
+    if (record.label != Record::NONE && record.label >= labels.size())
+      throw std::runtime_error("Malformed shape cache record");
+
+    for (const uint32_t offset : record.indices)
+      if (offset != Record::NONE)
+        GetIndexSize(words, offset, record.type, record.num_lines);
+  }
+}
+
+ShapeCache::~ShapeCache() noexcept = default;
+
+std::unique_ptr<ShapeCache>
+ShapeCache::Open(FileCache &cache, const char *name, Path original_path,
+                 std::size_t n_shapes, unsigned pixel_scale)
+{
+  std::span<const std::byte> data;
+  auto mapping = cache.Map(name, original_path, data);
+  if (!mapping)
+    return nullptr;
+
+  auto payload = data;
+  const auto &header = TakeSection<Header>(payload, 1).front();
+  if (header.version != Header::VERSION ||
+      header.point_size != sizeof(Point) ||
+      header.pixel_scale != pixel_scale ||
+      header.n_shapes != n_shapes)
+    return nullptr;
+
+  return std::unique_ptr<ShapeCache>(new ShapeCache(std::move(mapping),
+                                                    data));
+}
+
+bool
+ShapeCache::Overlaps(std::size_t i, const GeoBounds &bounds) const noexcept
+{
+  const Record &record = records[i];
+  return record.valid && record.bounds.Overlaps(bounds);
+}
+
+std::unique_ptr<XShape>
+ShapeCache::Load(std::size_t i) const
+{
+  const Record &record = records[i];
+  if (!record.valid)
+    return nullptr;
+
+#ifdef ENABLE_OPENGL
+  std::array<const uint16_t *, THINNING_LEVELS> indices;
+  for (std::size_t level = 0; level < THINNING_LEVELS; ++level)
+    indices[level] = record.indices[level] != Record::NONE
+      ? words.data() + record.indices[level]
+      : nullptr;
+#endif
+
+  return std::make_unique<XShape>(record.bounds,
+                                  (MS_SHAPE_TYPE)record.type,
+                                  words.subspan(record.first_line,
+                                                record.num_lines),
+                                  points.data() + record.first_point,
+#ifdef ENABLE_OPENGL
+                                  indices,
+#endif
+                                  record.label != Record::NONE
+                                  ? chars + record.label
+                                  : nullptr);
+}
+
+ShapeCacheWriter::ShapeCacheWriter() noexcept = default;
+ShapeCacheWriter::~ShapeCacheWriter() noexcept = default;
+
+void
+ShapeCacheWriter::Add(const XShape *shape,
+                      [[maybe_unused]] std::span<const float, ShapeCache::THINNING_LEVELS> min_distances)
+{
+  using Record = ShapeCache::Record;
+
+  Record &record = records.emplace_back();
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(static_cast<void *>(&record), 0, sizeof(record));
+  record.indices.fill(Record::NONE);
+  record.label = Record::NONE;
+
+  if (shape == nullptr)
+    return;
+
+  record.valid = true;
+  record.bounds = shape->get_bounds();
+  record.type = shape->get_type();
+
+  const auto lines = shape->GetLines();
+  record.num_lines = lines.size();
+  record.first_line = words.size();
+  words.insert(words.end(), lines.begin(), lines.end());
+
+  const std::size_t n_points =
+    std::accumulate(lines.begin(), lines.end(), std::size_t{});
+  record.first_point = points.size();
+  points.insert(points.end(), shape->GetPoints(),
+                shape->GetPoints() + n_points);
+
+  if (const char *label = shape->GetLabel(); label != nullptr) {
+    record.label = chars.size();
+    chars.append(label);
+    chars.push_back('\0');
+  }
+
+#ifdef ENABLE_OPENGL
+  if (lines.empty())
+    return;
+
+  switch (shape->get_type()) {
+  case MS_SHAPE_LINE:
+  case MS_SHAPE_POLYGON:
+    for (std::size_t level = 0; level < ShapeCache::THINNING_LEVELS; ++level) {
+      if (level == 0 && shape->get_type() == MS_SHAPE_LINE)
+        /* lines are not thinned at level 0 */
+        continue;
+
+      const auto indices = shape->GetIndices(level, min_distances[level]);
+      if (indices.indices == nullptr)
+        continue;
+
+      const std::size_t n_counts = indices.indices - indices.count;
+      const std::span<const uint16_t> counts{indices.count, n_counts};
+      const std::size_t n_indices =
+        std::accumulate(counts.begin(), counts.end(), std::size_t{});
+
+      record.indices[level] = words.size();
+      words.insert(words.end(), indices.count,
+                   indices.indices + n_indices);
+    }
+    break;
+
+  default:
+    break;
+  }
+#endif
+}
+
+void
+ShapeCacheWriter::Save(FileCache &cache, const char *name,
+                       Path original_path, unsigned pixel_scale) const
+{
+  Header header{};
+  header.version = Header::VERSION;
+  header.point_size = sizeof(ShapeCache::Point);
+  header.pixel_scale = pixel_scale;
+  header.n_shapes = records.size();
+  header.n_words = words.size();
+  header.n_points = points.size();
+  header.n_chars = chars.size();
+
+  const auto os = cache.Save(name, original_path);
+
+  /* track the file position to align each section */
+  uint64_t position = os->Tell();
+
+  BufferedOutputStream bos(*os);
+  const auto WriteSection = [&bos, &position](std::span<const std::byte> src){
+    static constexpr std::byte zero[SECTION_ALIGNMENT]{};
+    const std::size_t padding = -position % SECTION_ALIGNMENT;
+    bos.Write(std::span{zero, padding});
+    bos.Write(src);
+    position += padding + src.size();
+  };
+
+  WriteSection(std::as_bytes(std::span{&header, 1}));
+  WriteSection(std::as_bytes(std::span{records}));
+  WriteSection(std::as_bytes(std::span{words}));
+  WriteSection(std::as_bytes(std::span{points}));
+  WriteSection(std::as_bytes(std::span{chars}));
+  bos.Flush();
+
+  os->Commit();
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "XShape.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+class FileCache;
+class FileMapping;
+class Path;
+
+/**
+ * A preprocessed copy of all shapes of one #TopographyFile: the
+ * points are already converted (to #ShapePoint on OpenGL), the labels
+ * are filtered and the thinned OpenGL indices of all levels are
+ * built.  It is stored in the #FileCache (which invalidates it when
+ * the source file changes) and gets mapped into memory; the #XShape
+ * objects created by Load() point into the mapping, so loading a
+ * shape does not parse or copy anything.
+ *
+ * File layout: a header, followed by one record per shape, a 16 bit
+ * word array (the line lengths and indices), all points and all
+ * labels (null-terminated).  Each section is aligned to 8 bytes
+ * within the file.
+ */
+class ShapeCache {
+public:
+  using Point = XShape::Point;
+
+  /**
+   * The number of index arrays per shape; only used on OpenGL.
+   */
+  static constexpr std::size_t THINNING_LEVELS = 4;
+
+  struct Record;
+
+private:
+  std::unique_ptr<FileMapping> mapping;
+
+  std::span<const Record> records;
+  std::span<const uint16_t> words;
+  std::span<const Point> points;
+  const char *chars;
+
+  std::size_t mapped_size;
+
+  ShapeCache(std::unique_ptr<FileMapping> &&_mapping,
+             std::span<const std::byte> payload);
+
+public:
+  ~ShapeCache() noexcept;
+
+  ShapeCache(const ShapeCache &) = delete;
+  ShapeCache &operator=(const ShapeCache &) = delete;
+
+  /**
+   * Generate the #FileCache name for a shapefile.
+   *
+   * @param original_path the file which contains the shapefile
+   * (i.e. the map file or the shapefile itself)
+   */
+  [[gnu::pure]]
+  static std::string MakeName(Path original_path,
+                              const char *filename) noexcept;
+
+  /**
+   * Map the cache into memory.
+   *
+   * Throws on error.
+   *
+   * @param n_shapes the number of shapes in the shapefile
+   * @param pixel_scale the value of Layout::Scale(1) the thinned
+   * indices were built for
+   * @return nullptr if there is no valid cache for this file
+   */
+  static std::unique_ptr<ShapeCache> Open(FileCache &cache, const char *name,
+                                          Path original_path,
+                                          std::size_t n_shapes,
+                                          unsigned pixel_scale);
+
+  std::size_t size() const noexcept {
+    return records.size();
+  }
+
+  /**
+   * Returns the number of bytes mapped into memory.
+   */
+  std::size_t GetMappedSize() const noexcept {
+    return mapped_size;
+  }
+
+  /**
+   * Does the given shape overlap the given bounds?  Always returns
+   * false for shapes which failed to load while the cache was
+   * created.
+   */
+  [[gnu::pure]]
+  bool Overlaps(std::size_t i, const GeoBounds &bounds) const noexcept;
+
+  /**
+   * Create an #XShape object which refers to the mapping.
+   *
+   * @return nullptr if the shape failed to load while the cache was
+   * created
+   */
+  std::unique_ptr<XShape> Load(std::size_t i) const;
+};
+
+/**
+ * Collects all shapes of a shapefile and saves them as a
+ * #ShapeCache.
+ */
+class ShapeCacheWriter {
+  std::vector<ShapeCache::Record> records;
+  std::vector<uint16_t> words;
+  std::vector<ShapeCache::Point> points;
+  std::string chars;
+
+public:
+  ShapeCacheWriter() noexcept;
+  ~ShapeCacheWriter() noexcept;
+
+  /**
+   * Append a shape.
+   *
+   * @param shape the shape or nullptr if it failed to load
+   * @param min_distances the minimum point distance for each
+   * thinning level (see TopographyFile::GetThinningDistance()); only
+   * used on OpenGL
+   */
+  void Add(const XShape *shape,
+           std::span<const float, ShapeCache::THINNING_LEVELS> min_distances);
+
+  /**
+   * Throws on error.
+   */
+  void Save(FileCache &cache, const char *name, Path original_path,
+            unsigned pixel_scale) const;
+};
@@ -52,13 +52,10 @@ TopographyThread::Tick() noexcept
   while (next_projection.IsValid() && again && !IsStopped()) {
     const WindowProjection projection = next_projection;
 
+    /* the callback notifies the client after each updated file */
     const ScopeUnlock unlock(mutex);
-    again = store.ScanVisibility(projection, 1) > 0;
+    again = store.ScanVisibility(projection, helpers, callback) > 0;
   }
 
-  /* notify the client that we have updated the topography cache */
-  if (callback) {
-    const ScopeUnlock unlock(mutex);
-    callback();
-  }
+  statistics = store.GetStatistics();
 }
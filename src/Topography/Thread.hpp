@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "TopographyFile.hpp"
 #include "thread/StandbyThread.hpp"
+#include "thread/JobThread.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Geo/GeoBounds.hpp"
 
@@ -12,18 +14,29 @@
 class TopographyStore;
 
 /**
- * A thread that loads topography files asynchronously.
+ * A thread that loads topography files asynchronously.  The files
+ * are updated in parallel by this thread and a small number of
+ * helper threads; the callback is invoked after each file, so the
+ * map can be redrawn progressively.
  */
 class TopographyThread final : private StandbyThread {
   TopographyStore &store;
 
   const std::function<void()> callback;
 
+  JobThread helpers[2]{JobThread{"Topography1"}, JobThread{"Topography2"}};
+
   WindowProjection next_projection;
 
   GeoBounds last_bounds;
   double scale_threshold;
 
+  /**
+   * A copy of TopographyStore::GetStatistics() after the last
+   * update.  Protected by #mutex.
+   */
+  TopographyFile::Statistics statistics;
+
 public:
   TopographyThread(TopographyStore &_store, std::function<void()> &&_callback);
   ~TopographyThread();
@@ -32,6 +45,15 @@ public:
 
   void Trigger(const WindowProjection &_projection);
 
+  /**
+   * Obtain the cache statistics of the #TopographyStore.  May be
+   * called from any thread.
+   */
+  TopographyFile::Statistics GetStatistics() noexcept {
+    const std::lock_guard lock{mutex};
+    return statistics;
+  }
+
 private:
   /* virtual methods from class StandbyThread*/
   void Tick() noexcept override;
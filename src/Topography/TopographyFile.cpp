@@ -3,14 +3,21 @@
 
 #include "Topography/TopographyFile.hpp"
 #include "Topography/XShape.hpp"
+#include "ShapeCache.hpp"
 #include "Convert.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "util/ScopeExit.hxx"
 
+#ifdef ENABLE_OPENGL
+#include "Geo/FAISphere.hpp"
+#endif
+
 #include <zzip/lib.h>
 
 #include <algorithm>
+#include <array>
 #include <stdexcept>
+#include <utility>
 
 TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                double _threshold,
@@ -23,6 +30,7 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                unsigned _pen_width)
   :dir(_dir),
    file(dir, filename),
+   name(filename),
    label_field(_label_field),
    icon(_icon), big_icon(_big_icon), ultra_icon(_ultra_icon),
    pen_width(_pen_width),
@@ -60,17 +68,38 @@ TopographyFile::~TopographyFile() noexcept
   }
 }
 
+void
+TopographyFile::EnableShapeCache(FileCache &cache, Path original_path,
+                                 const char *filename, unsigned _pixel_scale)
+{
+  cache_original_path = original_path;
+  cache_name = ShapeCache::MakeName(original_path, filename);
+  pixel_scale = _pixel_scale;
+
+  shape_cache = ShapeCache::Open(cache, cache_name.c_str(),
+                                 original_path, file.size(), pixel_scale);
+  if (shape_cache == nullptr)
+    /* create it in the next Update() call */
+    file_cache = &cache;
+  else
+    statistics.bytes_mapped = shape_cache->GetMappedSize();
+}
+
 void
 TopographyFile::ClearCache() noexcept
 {
+  lru.clear();
+  list.clear();
+
   for (auto &i : shapes)
     i.shape.reset();
 
-  list.clear();
+  statistics.resident = 0;
 }
 
 static std::unique_ptr<XShape>
-LoadShape(ShapeFile &file, GeoPoint &center, std::size_t i, int label_field)
+LoadShape(ShapeFile &file, const GeoPoint &center, std::size_t i,
+          int label_field)
 {
   shapeObj shape;
   msInitShape(&shape);
@@ -84,8 +113,79 @@ LoadShape(ShapeFile &file, GeoPoint &center, std::size_t i, int label_field)
   return std::make_unique<XShape>(shape, center, label);
 }
 
+void
+TopographyFile::BuildShapeCache(Mutex &zip_mutex)
+{
+  /* try only once */
+  FileCache &cache = *std::exchange(file_cache, nullptr);
+
+  std::array<float, ShapeCache::THINNING_LEVELS> min_distances{};
+#ifdef ENABLE_OPENGL
+  for (unsigned level = 0; level < min_distances.size(); ++level)
+    min_distances[level] = GetThinningDistance(level, pixel_scale);
+#endif
+
+  ShapeCacheWriter writer;
+  for (std::size_t i = 0; i < file.size(); ++i) {
+    std::unique_ptr<XShape> shape;
+    try {
+      const auto lock = LockZip(zip_mutex);
+      shape = ::LoadShape(file, center, i, label_field);
+    } catch (...) {
+      /* skip malformed shapes; they will never be visible */
+    }
+
+    writer.Add(shape.get(), min_distances);
+  }
+
+  writer.Save(cache, cache_name.c_str(), cache_original_path, pixel_scale);
+
+  shape_cache = ShapeCache::Open(cache, cache_name.c_str(),
+                                 cache_original_path, file.size(),
+                                 pixel_scale);
+  if (shape_cache == nullptr)
+    throw std::runtime_error{"Failed to open the shape cache"};
+
+  statistics.bytes_mapped = shape_cache->GetMappedSize();
+}
+
+std::unique_ptr<const XShape>
+TopographyFile::LoadShape(std::size_t i, Mutex *zip_mutex)
+{
+  std::unique_ptr<const XShape> shape;
+  if (shape_cache != nullptr) {
+    /* the mapped cache needs no locking */
+    shape = shape_cache->Load(i);
+  } else if (zip_mutex != nullptr) {
+    const auto lock = LockZip(*zip_mutex);
+    shape = ::LoadShape(file, center, i, label_field);
+  } else
+    shape = ::LoadShape(file, center, i, label_field);
+
+  if (shape != nullptr) {
+    ++statistics.misses;
+    ++statistics.resident;
+  }
+
+  return shape;
+}
+
+void
+TopographyFile::Evict() noexcept
+{
+  while (statistics.resident > MAX_RESIDENT_SHAPES && !lru.empty()) {
+    ShapeEnvelope &envelope = lru.back();
+    lru.pop_back();
+    envelope.shape.reset();
+
+    --statistics.resident;
+    ++statistics.evictions;
+  }
+}
+
 bool
-TopographyFile::Update(const WindowProjection &map_projection)
+TopographyFile::Update(const WindowProjection &map_projection,
+                       Mutex &zip_mutex)
 {
   if (map_projection.GetMapScale() > scale_threshold)
     /* not visible, don't update cache now */
@@ -97,34 +197,49 @@ TopographyFile::Update(const WindowProjection &map_projection)
     /* the cache is still fresh */
     return false;
 
-  cache_bounds = screenRect.Scale(2);
+  if (file_cache != nullptr)
+    BuildShapeCache(zip_mutex);
 
-  // Test which shapes are inside the given bounds and save the
-  // status to file.status
-  switch (file.WhichShapes(dir, ConvertRect(cache_bounds))) {
-  case MS_FAILURE:
-    ClearCache();
-    throw std::runtime_error{"Failed to update shapefile"};
+  cache_bounds = screenRect.Scale(2);
 
-  case MS_DONE:
-    /* screen is outside of map bounds */
-    return false;
+  ms_const_bitarray status = nullptr;
+  if (shape_cache != nullptr) {
+    if (!ImportRect(file.GetBounds()).Overlaps(cache_bounds))
+      /* screen is outside of map bounds */
+      return false;
+  } else {
+    // Test which shapes are inside the given bounds and save the
+    // status to file.status
+    const auto lock = LockZip(zip_mutex);
+    switch (file.WhichShapes(dir, ConvertRect(cache_bounds))) {
+    case MS_FAILURE:
+      ClearCache();
+      throw std::runtime_error{"Failed to update shapefile"};
+
+    case MS_DONE:
+      /* screen is outside of map bounds */
+      return false;
+
+    case MS_SUCCESS:
+      break;
+    }
 
-  case MS_SUCCESS:
-    break;
+    status = file.GetStatus();
+    assert(status != nullptr);
   }
 
-  const auto status = file.GetStatus();
-  assert(status != nullptr);
-
   // Iterate through the shapefile entries
   auto prev = list.before_begin();
   auto it = shapes.begin();
   for (std::size_t i = 0; i < file.size(); ++i, ++it) {
-    if (!msGetBit(status, i)) {
-      // If the shape is outside the bounds
-      // delete the shape from the cache
-      if (it->shape != nullptr) {
+    const bool visible = shape_cache != nullptr
+      ? shape_cache->Overlaps(i, cache_bounds)
+      : msGetBit(status, i);
+
+    if (!visible) {
+      // If the shape is outside the bounds, move it from the
+      // visible list to the LRU list
+      if (it->shape != nullptr && !it->lru_hook.is_linked()) {
         assert(&*std::next(prev) == &*it);
 
         /* remove from linked list (protected) */
@@ -134,9 +249,7 @@ TopographyFile::Update(const WindowProjection &map_projection)
           ++serial;
         }
 
-        /* now it's unreachable, and we can delete the XShape without
-           holding a lock */
-        it->shape.reset();
+        lru.push_front(*it);
       }
     } else {
       // is inside the bounds
@@ -144,23 +257,36 @@ TopographyFile::Update(const WindowProjection &map_projection)
         assert(&*std::next(prev) != &*it);
 
         // shape isn't cached yet -> cache the shape
-        it->shape = LoadShape(file, center, i, label_field);
+        it->shape = LoadShape(i, &zip_mutex);
+        if (it->shape == nullptr)
+          continue;
+      } else if (it->lru_hook.is_linked()) {
+        assert(&*std::next(prev) != &*it);
 
-        /* insert into linked list (protected) */
-        {
-          const std::lock_guard lock{mutex};
-          prev = list.insert_after(prev, *it);
-          ++serial;
-        }
+        // shape is still resident -> reuse it
+        lru.erase(lru.iterator_to(*it));
+        ++statistics.hits;
       } else {
         ++prev;
         assert(&*prev == &*it);
+        continue;
+      }
+
+      /* insert into linked list (protected) */
+      {
+        const std::lock_guard lock{mutex};
+        prev = list.insert_after(prev, *it);
+        ++serial;
       }
     }
   }
 
   assert(std::next(prev) == list.end());
 
+  /* now the evicted shapes are unreachable, and we can delete them
+     without holding a lock */
+  Evict();
+
   return true;
 }
 
@@ -171,16 +297,24 @@ TopographyFile::LoadAll()
   auto prev = list.before_begin();
   auto it = shapes.begin();
   for (std::size_t i = 0; i < file.size(); ++i, ++it) {
+    if (it->lru_hook.is_linked())
+      lru.erase(lru.iterator_to(*it));
+    else if (it->shape != nullptr) {
+      ++prev;
+      assert(&*prev == &*it);
+      continue;
+    }
+
     if (it->shape == nullptr) {
       assert(&*std::next(prev) != &*it);
       // shape isn't cached yet -> cache the shape
-      it->shape = LoadShape(file, center, i, label_field);
-      // update list pointer
-      prev = list.insert_after(prev, *it);
-    } else {
-      ++prev;
-      assert(&*prev == &*it);
+      it->shape = LoadShape(i, nullptr);
+      if (it->shape == nullptr)
+        continue;
     }
+
+    // update list pointer
+    prev = list.insert_after(prev, *it);
   }
 
   assert(std::next(prev) == list.end());
@@ -229,4 +363,12 @@ TopographyFile::GetMinimumPointDistance(unsigned level) const noexcept
   return 1;
 }
 
+ShapeScalar
+TopographyFile::GetThinningDistance(unsigned level,
+                                    unsigned _pixel_scale) const noexcept
+{
+  return ShapeScalar(GetMinimumPointDistance(level))
+    / (_pixel_scale * FAISphere::REARTH);
+}
+
 #endif
@@ -7,7 +7,9 @@
 #include "Geo/GeoBounds.hpp"
 #include "util/AllocatedArray.hxx"
 #include "util/IntrusiveForwardList.hxx"
+#include "util/IntrusiveList.hxx"
 #include "util/Serial.hpp"
+#include "system/Path.hpp"
 #include "ui/canvas/PortableColor.hpp"
 #include "ResourceId.hpp"
 #include "thread/Mutex.hxx"
@@ -17,15 +19,73 @@
 #endif
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <string>
 
 class WindowProjection;
 class XShape;
+class ShapeCache;
+class FileCache;
 struct zzip_dir;
 
 class TopographyFile {
+public:
+  struct Statistics {
+    /**
+     * The number of shapes which became visible again while they
+     * were still resident.
+     */
+    std::size_t hits = 0;
+
+    /**
+     * The number of shapes which had to be loaded (from the
+     * #ShapeCache or from the shapefile).
+     */
+    std::size_t misses = 0;
+
+    /**
+     * The number of invisible shapes which were discarded to stay
+     * within #MAX_RESIDENT_SHAPES.
+     */
+    std::size_t evictions = 0;
+
+    /**
+     * The number of shapes currently in memory.
+     */
+    std::size_t resident = 0;
+
+    /**
+     * The size of the #ShapeCache mapping.
+     */
+    std::size_t bytes_mapped = 0;
+
+    Statistics &operator+=(const Statistics &other) noexcept {
+      hits += other.hits;
+      misses += other.misses;
+      evictions += other.evictions;
+      resident += other.resident;
+      bytes_mapped += other.bytes_mapped;
+      return *this;
+    }
+  };
+
+  /**
+   * Shapes which are not visible anymore are kept in memory (in
+   * least-recently-used order) until this number of shapes is
+   * resident.
+   */
+  static constexpr std::size_t MAX_RESIDENT_SHAPES = 4096;
+
+private:
   struct ShapeEnvelope final : IntrusiveForwardListHook {
     std::unique_ptr<const XShape> shape;
+
+    /**
+     * Linked in #lru while the shape is resident but not visible.
+     */
+    SafeLinkIntrusiveListHook lru_hook;
   };
 
   /**
@@ -37,16 +97,47 @@ class TopographyFile {
 
   ShapeFile file;
 
+  /**
+   * The name of the shapefile, for log messages.
+   */
+  const std::string name;
+
   /**
    * The center of shapefileObj::bounds.
    */
   GeoPoint center;
 
+  /**
+   * If this is set, then Update() creates the #ShapeCache before
+   * loading shapes.  It is cleared after the first attempt.
+   */
+  FileCache *file_cache = nullptr;
+
+  AllocatedPath cache_original_path = nullptr;
+  std::string cache_name;
+  unsigned pixel_scale = 1;
+
+  /**
+   * The preprocessed shapes; if this is nullptr, shapes are loaded
+   * from the shapefile.  Must be declared before #shapes because the
+   * #XShape objects may point into it.
+   */
+  std::unique_ptr<ShapeCache> shape_cache;
+
   AllocatedArray<ShapeEnvelope> shapes;
 
   using ShapeList = IntrusiveForwardList<ShapeEnvelope>;
   ShapeList list;
 
+  /**
+   * Resident shapes which are not visible, the most recently used
+   * first.
+   */
+  IntrusiveList<ShapeEnvelope,
+                IntrusiveListMemberHookTraits<&ShapeEnvelope::lru_hook>> lru;
+
+  Statistics statistics;
+
   const int label_field;
 
   const ResourceId icon, big_icon, ultra_icon;
@@ -155,10 +246,37 @@ public:
     return serial;
   }
 
+  /**
+   * Use a preprocessed copy of all shapes in the #FileCache; if it
+   * does not exist yet, it will be created by the next Update() call.
+   *
+   * Throws on error.
+   *
+   * @param original_path the file which contains the shapefile
+   * (i.e. the map file or the shapefile itself); modifying it
+   * invalidates the cache
+   * @param filename the name of the shapefile
+   * @param pixel_scale the value of Layout::Scale(1), which is used
+   * for thinning
+   */
+  void EnableShapeCache(FileCache &cache, Path original_path,
+                        const char *filename, unsigned pixel_scale);
+
+  /**
+   * Must be called from the thread which calls Update().
+   */
+  const Statistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
   const GeoPoint &GetCenter() const noexcept {
     return center;
   }
 
+  const char *GetName() const noexcept {
+    return name.c_str();
+  }
+
   bool IsVisible(double map_scale) const noexcept {
     return map_scale <= scale_threshold;
   }
@@ -242,14 +360,25 @@ public:
    */
   [[gnu::pure]]
   unsigned GetMinimumPointDistance(unsigned level) const noexcept;
+
+  /**
+   * @return the minimum distance between points of the given
+   * thinning level in #ShapePoint units, as used by the renderer
+   * @param pixel_scale the value of Layout::Scale(1)
+   */
+  [[gnu::pure]]
+  ShapeScalar GetThinningDistance(unsigned level,
+                                  unsigned pixel_scale) const noexcept;
 #endif
 
   /**
    * Throws on error.
    *
+   * @param zip_mutex serializes access to the ZIP archive; zzip is
+   * not thread-safe, not even for different files in one archive
    * @return true if new data from the topography file has been loaded
    */
-  bool Update(const WindowProjection &map_projection);
+  bool Update(const WindowProjection &map_projection, Mutex &zip_mutex);
 
   /**
    * Throws on error.
@@ -260,4 +389,35 @@ public:
 
 protected:
   void ClearCache() noexcept;
+
+private:
+  /**
+   * Lock the given mutex if this file is inside a ZIP archive.
+   */
+  std::unique_lock<Mutex> LockZip(Mutex &zip_mutex) const noexcept {
+    return dir != nullptr
+      ? std::unique_lock{zip_mutex}
+      : std::unique_lock<Mutex>{};
+  }
+
+  /**
+   * Throws on error.
+   */
+  void BuildShapeCache(Mutex &zip_mutex);
+
+  /**
+   * Throws on error.
+   *
+   * @param zip_mutex see Update(); nullptr if the caller needs no
+   * locking
+   * @return the shape or nullptr if the #ShapeCache says it is
+   * malformed
+   */
+  std::unique_ptr<const XShape> LoadShape(std::size_t i, Mutex *zip_mutex);
+
+  /**
+   * Discard invisible shapes until there are no more than
+   * #MAX_RESIDENT_SHAPES.
+   */
+  void Evict() noexcept;
 };
@@ -4,6 +4,11 @@
 #pragma once
 
 class TopographyStore;
+class FileCache;
 
+/**
+ * @param cache if not nullptr, then preprocessed shapes are stored in
+ * this #FileCache
+ */
 bool
-LoadConfiguredTopography(TopographyStore &store);
+LoadConfiguredTopography(TopographyStore &store, FileCache *cache);
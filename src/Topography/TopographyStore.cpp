@@ -10,8 +10,12 @@
 #include "Operation/Operation.hpp"
 #include "Compatibility/path.h"
 #include "LogFile.hpp"
+#include "thread/JobThread.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <vector>
 
 #include <windef.h> // for MAX_PATH
 
@@ -31,6 +35,26 @@ TopographyStore::GetNextScaleThreshold(double map_scale) const noexcept
   return result;
 }
 
+bool
+TopographyStore::UpdateFile(TopographyFile &file,
+                            const WindowProjection &projection) noexcept
+try {
+  const auto start = std::chrono::steady_clock::now();
+  if (!file.Update(projection, zip_mutex))
+    return false;
+
+  [[maybe_unused]] const std::chrono::duration<double, std::milli> duration =
+    std::chrono::steady_clock::now() - start;
+  LogDebug("Topography {} updated in {:.1f} ms",
+           file.GetName(), duration.count());
+
+  ++serial;
+  return true;
+} catch (...) {
+  LogError(std::current_exception());
+  return false;
+}
+
 unsigned
 TopographyStore::ScanVisibility(const WindowProjection &m_projection,
                                 unsigned max_update) noexcept
@@ -42,21 +66,72 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
   // to make sure eventually everything gets refreshed
   unsigned num_updated = 0;
   for (auto &file : files) {
-    try {
-      if (file.Update(m_projection)) {
+    if (UpdateFile(file, m_projection)) {
+      ++num_updated;
+      if (num_updated >= max_update)
+        break;
+    }
+  }
+
+  return num_updated;
+}
+
+unsigned
+TopographyStore::ScanVisibility(const WindowProjection &m_projection,
+                                std::span<JobThread> helpers,
+                                const std::function<void()> &callback) noexcept
+{
+  std::vector<TopographyFile *> queue;
+  for (auto &file : files)
+    queue.push_back(&file);
+
+  /* each worker takes the next file from the queue until it is
+     empty */
+  std::atomic<std::size_t> next = 0;
+  std::atomic<unsigned> num_updated = 0;
+
+  const auto job = [&]{
+    for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < queue.size();) {
+      if (UpdateFile(*queue[i], m_projection)) {
         ++num_updated;
-        if (num_updated >= max_update)
-          break;
+        if (callback)
+          callback();
       }
+    }
+  };
+
+  /* the calling thread is a worker, too */
+  const std::size_t n_helpers =
+    std::min(helpers.size(), queue.empty() ? 0 : queue.size() - 1);
+
+  std::size_t n_started = 0;
+  for (; n_started < n_helpers; ++n_started) {
+    try {
+      helpers[n_started].Start([&job]{ job(); });
     } catch (...) {
-      LogError(std::current_exception());
+      /* continue with fewer threads */
+      LogError(std::current_exception(), "Failed to start topography thread");
+      break;
     }
   }
 
-  serial += num_updated;
+  job();
+
+  for (auto &helper : helpers.first(n_started))
+    helper.Wait();
+
   return num_updated;
 }
 
+TopographyFile::Statistics
+TopographyStore::GetStatistics() const noexcept
+{
+  TopographyFile::Statistics result;
+  for (const auto &file : files)
+    result += file.GetStatistics();
+  return result;
+}
+
 void
 TopographyStore::LoadAll() noexcept
 {
@@ -66,7 +141,9 @@ TopographyStore::LoadAll() noexcept
 
 void
 TopographyStore::Load(NLineReader &reader,
-                      Path directory, struct zzip_dir *zdir) noexcept
+                      Path directory, struct zzip_dir *zdir,
+                      FileCache *cache, Path original_path,
+                      unsigned pixel_scale) noexcept
 {
   Reset();
 
@@ -109,6 +186,19 @@ TopographyStore::Load(NLineReader &reader,
                               entry->pen_width);
     } catch (...) {
       LogError(std::current_exception());
+      continue;
+    }
+
+    if (cache != nullptr) {
+      try {
+        i->EnableShapeCache(*cache,
+                            original_path != nullptr
+                            ? original_path
+                            : Path{shape_filename},
+                            shape_filename, pixel_scale);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to load shape cache");
+      }
     }
   }
 }
@@ -5,12 +5,18 @@
 
 #include "TopographyFile.hpp"
 #include "util/NonCopyable.hpp"
+#include "thread/Mutex.hxx"
 
+#include <atomic>
 #include <forward_list>
+#include <functional>
+#include <span>
 
 class Path;
+class FileCache;
 class WindowProjection;
 class NLineReader;
+class JobThread;
 struct zzip_dir;
 
 /**
@@ -22,7 +28,13 @@ class TopographyStore : private NonCopyable {
   /**
    * This number is incremented each time this object is modified.
    */
-  unsigned serial = 0;
+  std::atomic<unsigned> serial = 0;
+
+  /**
+   * Serializes access to the ZIP archive while files are updated in
+   * parallel.  See TopographyFile::Update().
+   */
+  Mutex zip_mutex;
 
 public:
   TopographyStore() noexcept;
@@ -58,13 +70,52 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024) noexcept;
 
+  /**
+   * Update all files, distributing them over the given helper
+   * threads and the calling thread.  Returns after all files have
+   * been updated.
+   *
+   * @param callback invoked after each file which has loaded new
+   * data, in the thread which has updated it
+   * @return the number of files which were updated
+   */
+  unsigned ScanVisibility(const WindowProjection &m_projection,
+                          std::span<JobThread> helpers,
+                          const std::function<void()> &callback) noexcept;
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
    */
   void LoadAll() noexcept;
 
+  /**
+   * Sum up the statistics of all files.  Must be called from the
+   * thread which calls ScanVisibility().
+   */
+  [[gnu::pure]]
+  TopographyFile::Statistics GetStatistics() const noexcept;
+
+  /**
+   * @param cache if not nullptr, then preprocessed shapes are stored
+   * in this #FileCache (see TopographyFile::EnableShapeCache())
+   * @param original_path the map file containing the shapefiles
+   * (if loading from a ZIP file); used to invalidate the cache
+   * @param pixel_scale the value of Layout::Scale(1)
+   */
   void Load(NLineReader &reader,
-            Path directory, struct zzip_dir *zdir = nullptr) noexcept;
+            Path directory, struct zzip_dir *zdir = nullptr,
+            FileCache *cache = nullptr, Path original_path = nullptr,
+            unsigned pixel_scale = 1) noexcept;
   void Reset() noexcept;
+
+private:
+  /**
+   * Update one file, log the time it took and increment the serial.
+   * May be called concurrently for different files.
+   *
+   * @return true if new data was loaded
+   */
+  bool UpdateFile(TopographyFile &file,
+                  const WindowProjection &projection) noexcept;
 };
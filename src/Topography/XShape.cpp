@@ -91,7 +91,8 @@ ImportShapePoint(const pointObj &src, [[maybe_unused]] const GeoPoint &file_cent
 
 XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
                const char *_label)
-  :label(ImportLabel(_label))
+  :label_buffer(ImportLabel(_label)),
+   label(label_buffer.c_str())
 {
   bounds = ImportRect(shape.bounds);
   if (!bounds.Check())
@@ -120,8 +121,9 @@ XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
     ++num_lines;
   }
 
-  points = std::make_unique<Point[]>(num_points);
-  auto *p = points.get();
+  points_buffer = std::make_unique<Point[]>(num_points);
+  points = points_buffer.get();
+  auto *p = points_buffer.get();
   for (std::size_t l = 0; l < num_lines; ++l) {
     const pointObj *src = shape.line[l].point;
     p = std::transform(src, src + lines[l], p,
@@ -131,6 +133,31 @@ XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
   }
 }
 
+XShape::XShape(const GeoBounds &_bounds, MS_SHAPE_TYPE _type,
+               std::span<const uint16_t> _lines, const Point *_points,
+#ifdef ENABLE_OPENGL
+               std::span<const uint16_t *const, THINNING_LEVELS> _indices,
+#endif
+               const char *_label) noexcept
+  :bounds(_bounds), type(_type),
+   num_lines(std::min(_lines.size(), lines.size())),
+   points(_points),
+   label(_label)
+{
+  std::copy_n(_lines.begin(), num_lines, lines.begin());
+
+#ifdef ENABLE_OPENGL
+  for (std::size_t level = 0; level < THINNING_LEVELS; ++level) {
+    const uint16_t *p = _indices[level];
+    if (p == nullptr)
+      continue;
+
+    index_count[level] = p;
+    indices[level] = p + (type == MS_SHAPE_LINE ? num_lines : 1);
+  }
+#endif
+}
+
 XShape::~XShape() noexcept = default;
 
 #ifdef ENABLE_OPENGL
@@ -149,12 +176,12 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
   if (type == MS_SHAPE_LINE) {
     if (num_points <= 2)
       return false;  // line cannot be simplified, so don't create indices
-    index_count[thinning_level] = std::make_unique<GLushort[]>(num_lines + num_points);
-    idx_count = index_count[thinning_level].get();
+    index_buffer[thinning_level] = std::make_unique<GLushort[]>(num_lines + num_points);
+    index_count[thinning_level] = idx_count = index_buffer[thinning_level].get();
     indices[thinning_level] = idx = idx_count + num_lines;
 
     const auto end_l = std::next(lines.begin(), num_lines);
-    const ShapePoint *p = points.get();
+    const ShapePoint *p = points;
     unsigned i = 0;
     for (auto l = lines.begin(); l != end_l; ++l) {
       assert(*l >= 2);
@@ -179,17 +206,17 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
     // TODO: free memory saved by thinning (use malloc/realloc or some class?)
     return true;
   } else if (type == MS_SHAPE_POLYGON) {
-    index_count[thinning_level] = std::make_unique<GLushort[]>(1 + 3 * (num_points - 2) + 2 * (num_lines - 1));
-    idx_count = index_count[thinning_level].get();
+    index_buffer[thinning_level] = std::make_unique<GLushort[]>(1 + 3 * (num_points - 2) + 2 * (num_lines - 1));
+    index_count[thinning_level] = idx_count = index_buffer[thinning_level].get();
     indices[thinning_level] = idx = idx_count + 1;
 
     *idx_count = 0;
-    const ShapePoint *pt = points.get();
+    const ShapePoint *pt = points;
     for (std::size_t i=0; i < num_lines; i++) {
       std::size_t count = PolygonToTriangles(pt, lines[i], idx + *idx_count,
                                              min_distance);
       if (i > 0) {
-        const GLushort offset = pt - points.get();
+        const GLushort offset = pt - points;
         const std::size_t max_idx_count = *idx_count + count;
         for (std::size_t j = *idx_count; j < max_idx_count; j++)
           idx[j] += offset;
@@ -214,7 +241,7 @@ XShape::GetIndices(int thinning_level, ShapeScalar min_distance) const noexcept
       return {};
   }
 
-  return {indices[thinning_level], index_count[thinning_level].get()};
+  return {indices[thinning_level], index_count[thinning_level]};
 }
 
 #endif // ENABLE_OPENGL
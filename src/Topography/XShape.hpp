@@ -21,11 +21,19 @@
 struct GeoPoint;
 
 class XShape {
+public:
   static constexpr std::size_t MAX_LINES = 32;
 #ifdef ENABLE_OPENGL
   static constexpr std::size_t THINNING_LEVELS = 4;
 #endif
 
+#ifdef ENABLE_OPENGL
+  using Point = ShapePoint;
+#else
+  using Point = GeoPoint;
+#endif
+
+private:
   GeoBounds bounds;
 
   uint8_t type;
@@ -42,22 +50,19 @@ class XShape {
    */
   std::array<uint16_t, MAX_LINES> lines;
 
-#ifdef ENABLE_OPENGL
-  using Point = ShapePoint;
-#else
-  using Point = GeoPoint;
-#endif
-
   /**
-   * All points of all lines.
+   * All points of all lines.  They are either owned by
+   * #points_buffer or by a #ShapeCache mapping.
    */
-  std::unique_ptr<Point[]> points;
+  const Point *points = nullptr;
+
+  std::unique_ptr<Point[]> points_buffer;
 
 #ifdef ENABLE_OPENGL
   /**
    * Indices of polygon triangles or lines with reduced number of vertices.
    */
-  std::array<uint16_t *, THINNING_LEVELS> indices{};
+  std::array<const uint16_t *, THINNING_LEVELS> indices{};
 
   /**
    * For polygons this will contain the total number of triangle vertices
@@ -65,7 +70,13 @@ class XShape {
    * For lines there will be an array of size num_lines for each thinning
    * level, which contains the number of points for each line.
    */
-  std::array<std::unique_ptr<uint16_t[]>, THINNING_LEVELS> index_count;
+  std::array<const uint16_t *, THINNING_LEVELS> index_count{};
+
+  /**
+   * The memory allocated by BuildIndices() for #index_count and
+   * #indices.
+   */
+  std::array<std::unique_ptr<uint16_t[]>, THINNING_LEVELS> index_buffer;
 
   /**
    * The start offset in the #GLArrayBuffer (vertex buffer object).
@@ -74,7 +85,13 @@ class XShape {
   mutable unsigned offset;
 #endif
 
-  BasicAllocatedString<char> label;
+  BasicAllocatedString<char> label_buffer;
+
+  /**
+   * Points to #label_buffer or into a #ShapeCache mapping; nullptr if
+   * there is no label.
+   */
+  const char *label;
 
 public:
   /**
@@ -83,6 +100,22 @@ public:
   XShape(const shapeObj &shape, const GeoPoint &file_center,
          const char *label);
 
+  /**
+   * Construct an object from preprocessed data (see #ShapeCache)
+   * without copying it; all pointers must remain valid for the
+   * lifetime of this object.
+   *
+   * @param indices for each thinning level: the index counts
+   * followed by the indices (the layout created by BuildIndices()),
+   * or nullptr if they shall be built on demand
+   */
+  XShape(const GeoBounds &bounds, MS_SHAPE_TYPE type,
+         std::span<const uint16_t> lines, const Point *points,
+#ifdef ENABLE_OPENGL
+         std::span<const uint16_t *const, THINNING_LEVELS> indices,
+#endif
+         const char *label) noexcept;
+
   ~XShape() noexcept;
 
   XShape(const XShape &) = delete;
@@ -125,10 +158,10 @@ public:
   }
 
   const Point *GetPoints() const noexcept {
-    return points.get();
+    return points;
   }
 
   const char *GetLabel() const noexcept {
-    return label.c_str();
+    return label;
   }
 };
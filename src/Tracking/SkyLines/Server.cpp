@@ -10,6 +10,14 @@
 #include "net/UniqueSocketDescriptor.hxx"
 #include "util/CRC16CCITT.hpp"
 
+#ifdef __linux__
+#include "net/MsgHdr.hxx"
+#include "util/ScopeExit.hxx"
+
+#include <algorithm>
+#include <array>
+#endif
+
 static UniqueSocketDescriptor
 CreateBindUDP(SocketAddress address)
 {
@@ -25,10 +33,46 @@ CreateBindUDP(SocketAddress address)
 
 namespace SkyLinesTracking {
 
+#ifdef __linux__
+
+struct Server::Batch {
+  /**
+   * The maximum number of datagrams received with one recvmmsg()
+   * call, and the maximum number of responses sent with one
+   * sendmmsg() call.
+   */
+  static constexpr std::size_t SIZE = 32;
+
+  static constexpr std::size_t MAX_DATAGRAM = 4096;
+
+  struct Datagram {
+    StaticSocketAddress address;
+    std::size_t size;
+    std::array<std::byte, MAX_DATAGRAM> data;
+  };
+
+  std::array<Datagram, SIZE> in, out;
+
+  /**
+   * The number of responses in #out.
+   */
+  std::size_t n_out = 0;
+
+  /**
+   * Queue responses in #out instead of sending them right away?
+   */
+  bool queue = false;
+};
+
+#endif
+
 Server::Server(EventLoop &event_loop,
                SocketAddress server_address)
   :socket(event_loop, BIND_THIS_METHOD(OnSocketReady),
           CreateBindUDP(server_address).Release())
+#ifdef __linux__
+  , batch(std::make_unique<Batch>())
+#endif
 {
   socket.ScheduleRead();
 }
@@ -42,8 +86,21 @@ void
 Server::SendBuffer(SocketAddress address,
                    std::span<const std::byte> buffer) noexcept
 {
+#ifdef __linux__
+  if (batch->queue && buffer.size() <= Batch::MAX_DATAGRAM) {
+    if (batch->n_out == Batch::SIZE)
+      FlushSend();
+
+    auto &d = batch->out[batch->n_out++];
+    d.address = address;
+    d.size = buffer.size();
+    std::copy(buffer.begin(), buffer.end(), d.data.begin());
+    return;
+  }
+#endif
+
   try {
-    ssize_t nbytes = socket.GetSocket().WriteNoWait(buffer);
+    ssize_t nbytes = socket.GetSocket().WriteNoWait(buffer, address);
     if (nbytes < 0)
       throw MakeSocketError("Failed to send");
   } catch (...) {
@@ -162,11 +219,84 @@ Server::OnDatagramReceived(Client &&client,
   }
 }
 
+#ifdef __linux__
+
+inline void
+Server::ReceiveBatch()
+{
+  std::array<struct iovec, Batch::SIZE> iov;
+  std::array<struct mmsghdr, Batch::SIZE> msgs;
+
+  for (std::size_t i = 0; i < Batch::SIZE; ++i) {
+    auto &d = batch->in[i];
+    iov[i] = {d.data.data(), d.data.size()};
+    msgs[i].msg_hdr = MakeMsgHdr(d.address, {&iov[i], 1}, {});
+    msgs[i].msg_len = 0;
+  }
+
+  int n = recvmmsg(socket.GetSocket().Get(), msgs.data(), msgs.size(),
+                   MSG_DONTWAIT, nullptr);
+  if (n < 0)
+    throw MakeSocketError("Failed to receive");
+
+  /* send all responses to this batch at once */
+  batch->queue = true;
+  AtScopeExit(this) {
+    batch->queue = false;
+    FlushSend();
+  };
+
+  for (int i = 0; i < n; ++i) {
+    auto &d = batch->in[i];
+
+    Client client;
+    client.address = d.address;
+    client.address.SetSize(msgs[i].msg_hdr.msg_namelen);
+
+    OnDatagramReceived(std::move(client), d.data.data(), msgs[i].msg_len);
+  }
+}
+
+void
+Server::FlushSend() noexcept
+{
+  const std::size_t n = batch->n_out;
+  batch->n_out = 0;
+
+  std::array<struct iovec, Batch::SIZE> iov;
+  std::array<struct mmsghdr, Batch::SIZE> msgs;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto &d = batch->out[i];
+    iov[i] = {const_cast<std::byte *>(d.data.data()), d.size};
+    msgs[i].msg_hdr = MakeMsgHdr(SocketAddress{d.address}, {&iov[i], 1}, {});
+    msgs[i].msg_len = 0;
+  }
+
+  for (std::size_t i = 0; i < n;) {
+    int result = sendmmsg(socket.GetSocket().Get(), msgs.data() + i, n - i,
+                          MSG_DONTWAIT);
+    if (result > 0) {
+      i += result;
+      continue;
+    }
+
+    /* sendmmsg() fails only if the first datagram could not be sent;
+       report it and continue with the next one */
+    OnSendError(batch->out[i].address,
+                std::make_exception_ptr(MakeSocketError("Failed to send")));
+    ++i;
+  }
+}
+
+#endif
+
 void
 Server::OnSocketReady(unsigned) noexcept
 try {
-  // TODO: use recvmmsg() on Linux
-
+#ifdef __linux__
+  ReceiveBatch();
+#else
   Client client;
   socklen_t address_size = sizeof(client.address);
   char buffer[4096];
@@ -181,6 +311,7 @@ try {
   // TODO: set client.key
 
   OnDatagramReceived(std::move(client), buffer, nbytes);
+#endif
 } catch (...) {
   socket.Close();
   OnError(std::current_exception());
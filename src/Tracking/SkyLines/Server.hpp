@@ -10,6 +10,7 @@
 #include <chrono>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <span>
 
 struct GeoPoint;
@@ -25,6 +26,15 @@ namespace SkyLinesTracking {
 class Server {
   SocketEvent socket;
 
+#ifdef __linux__
+  /**
+   * Buffers for receiving datagrams with recvmmsg() and for queueing
+   * the responses to them, which are then sent with sendmmsg().
+   */
+  struct Batch;
+  const std::unique_ptr<Batch> batch;
+#endif
+
 public:
   struct Client {
     StaticSocketAddress address;
@@ -50,6 +60,11 @@ public:
     return socket.GetEventLoop();
   }
 
+  /**
+   * Send a datagram to the given address.  While datagrams received
+   * in one batch are being handled, responses are queued and sent
+   * together after the last one.
+   */
   void SendBuffer(SocketAddress address,
                   std::span<const std::byte> buffer) noexcept;
 
@@ -62,6 +77,15 @@ private:
   void OnDatagramReceived(Client &&client, void *data, size_t length);
   void OnSocketReady(unsigned events) noexcept;
 
+#ifdef __linux__
+  void ReceiveBatch();
+
+  /**
+   * Send all responses queued by SendBuffer().
+   */
+  void FlushSend() noexcept;
+#endif
+
 protected:
   virtual void OnPing(const Client &client, unsigned id);
 
@@ -158,7 +158,7 @@ SettingsLeave(const UISettings &old_ui_settings)
 
     auto &topography = *data_components->topography;
     topography.Reset();
-    LoadConfiguredTopography(topography);
+    LoadConfiguredTopography(topography, file_cache);
     main_window.SetTopography(&topography);
   }
 
@@ -172,6 +172,7 @@ SettingsLeave(const UISettings &old_ui_settings)
     airspace_database.Clear();
     ReadAirspace(airspace_database,
                  CommonInterface::GetComputerSettings().pressure,
+                 file_cache,
                  operation);
 
     if (data_components->terrain)
@@ -12,24 +12,36 @@
 #include "Waypoint/Waypoints.hpp"
 #include "WaypointFileType.hpp"
 #include "WaypointReader.hpp"
+#include "WaypointReaderSeeYou.hpp"
+#include "io/FileReader.hxx"
 #include "io/MapFile.hpp"
 #include "io/ZipArchive.hpp"
 #include "lib/fmt/PathFormatter.hpp"
 #include "system/Path.hpp"
+#include "thread/JobThread.hpp"
+#include "util/AllocatedArray.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace WaypointGlue {
 
 static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
+LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
                  WaypointFileType file_type,
                  WaypointOrigin origin,
                  uint8_t file_num,
                  const RasterTerrain *terrain,
-                 ProgressListener &progress) noexcept
+                 ProgressListener &progressg) noexcept
 try {
-  ReadWaypointFile(path, file_type, waypoints,
+  ReadWaypointFile(dir, path, file_type, waypoints,
                    WaypointFactory(origin, file_num, terrain),
-                   progress);
+                   progressg);
   return true;
 } catch (...) {
   LogFmt("Failed to read waypoint file: {}", path);
@@ -37,68 +49,277 @@ try {
   return false;
 }
 
+/**
+ * CUP files bigger than this are split into chunks of this size which
+ * are parsed in parallel.
+ */
+static constexpr std::size_t CUP_CHUNK_SIZE = 512 * 1024;
+
+namespace {
+
+class NullProgressListener final : public ProgressListener {
+public:
+  void SetProgressRange(unsigned) noexcept override {}
+  void SetProgressPosition(unsigned) noexcept override {}
+};
+
+/**
+ * A waypoint file which is parsed in one or more #ParseJob
+ * instances.
+ */
+struct WaypointFile {
+  AllocatedPath path;
+  WaypointFactory factory;
+
+  /**
+   * The contents of a big CUP file which is split into #chunks.
+   */
+  AllocatedArray<std::byte> data;
+  std::unique_ptr<SeeYouChunks> chunks;
+
+  WaypointFile(AllocatedPath &&_path, WaypointFactory _factory) noexcept
+    :path(std::move(_path)), factory(_factory) {}
+};
+
+/**
+ * Parse a file (or one chunk of a file) into a private list, to be
+ * merged into the #Waypoints instance later.  The list is not
+ * indexed, so each waypoint is indexed only once, by the merge.
+ */
+struct ParseJob {
+  WaypointFile &file;
+
+  /**
+   * The chunk index, or -1 if this job parses the whole file.
+   */
+  int chunk;
+
+  std::vector<WaypointPtr> waypoints;
+
+  std::exception_ptr error;
+
+  std::chrono::steady_clock::duration duration{};
+
+  /**
+   * Was the "Related Tasks" line found in this chunk?
+   */
+  bool tasks_found = false;
+
+  ParseJob(WaypointFile &_file, int _chunk) noexcept
+    :file(_file), chunk(_chunk) {}
+
+  void Run() noexcept {
+    const auto start = std::chrono::steady_clock::now();
+
+    try {
+      if (chunk >= 0) {
+        tasks_found = file.chunks->Parse(chunk, file.factory, waypoints);
+      } else {
+        NullProgressListener progress;
+        ReadWaypointFile(file.path, waypoints, file.factory, progress);
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    duration = std::chrono::steady_clock::now() - start;
+  }
+};
+
+} // anonymous namespace
+
+/**
+ * Load a big CUP file into memory and split it into chunks.  Returns
+ * false if the file is small (or not a CUP file), and it shall be
+ * parsed as a whole.
+ *
+ * Throws on error.
+ */
 static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
-                 WaypointOrigin origin,
-                 uint8_t file_num,
-                 const RasterTerrain *terrain,
-                 ProgressListener &progress) noexcept
-try {
-  ReadWaypointFile(path, waypoints,
-                   WaypointFactory(origin, file_num, terrain),
-                   progress);
+SplitWaypointFile(WaypointFile &file)
+{
+  if (DetermineWaypointFileType(file.path) != WaypointFileType::SEEYOU)
+    return false;
+
+  FileReader reader{file.path};
+  const auto size = reader.GetSize();
+  if (size <= 2 * CUP_CHUNK_SIZE)
+    return false;
+
+  file.data = AllocatedArray<std::byte>(size);
+  reader.ReadFull(file.data);
+
+  file.chunks = std::make_unique<SeeYouChunks>(file.data, CUP_CHUNK_SIZE);
   return true;
-} catch (...) {
-  LogFmt("Failed to read waypoint file: {}", path);
-  LogError(std::current_exception());
-  return false;
 }
 
+/**
+ * Run all jobs, using the helper threads and the calling thread.
+ *
+ * @return the number of threads which were used
+ */
+static unsigned
+RunParseJobs(std::span<const std::unique_ptr<ParseJob>> jobs,
+             std::span<JobThread> helpers,
+             ProgressListener &progress) noexcept
+{
+  std::atomic<std::size_t> next = 0, done = 0;
+
+  const auto job = [&]{
+    for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < jobs.size();) {
+      jobs[i]->Run();
+      ++done;
+    }
+  };
+
+  const std::size_t n_helpers =
+    std::min(helpers.size(), jobs.empty() ? 0 : jobs.size() - 1);
+
+  std::size_t n_started = 0;
+  for (; n_started < n_helpers; ++n_started) {
+    try {
+      helpers[n_started].Start([&job]{ job(); });
+    } catch (...) {
+      /* continue with fewer threads */
+      LogError(std::current_exception(), "Failed to start waypoint thread");
+      break;
+    }
+  }
+
+  /* the calling thread is a worker, too; it is the only one which
+     reports progress */
+  for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < jobs.size();) {
+    jobs[i]->Run();
+    progress.SetProgressPosition(++done);
+  }
+
+  for (auto &helper : helpers.first(n_started))
+    helper.Wait();
+
+  progress.SetProgressPosition(jobs.size());
+  return n_started + 1;
+}
+
+/**
+ * Merge the lists of all jobs of one file into the #Waypoints
+ * instance, in file order.
+ *
+ * @return true if the file was loaded successfully
+ */
 static bool
-LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
-                 WaypointFileType file_type,
-                 WaypointOrigin origin,
-                 uint8_t file_num,
-                 const RasterTerrain *terrain,
-                 ProgressListener &progressg) noexcept
-try {
-  ReadWaypointFile(dir, path, file_type, waypoints,
-                   WaypointFactory(origin, file_num, terrain),
-                   progressg);
-  return true;
-} catch (...) {
-  LogFmt("Failed to read waypoint file: {}", path);
-  LogError(std::current_exception());
-  return false;
+MergeWaypointFile(Waypoints &way_points, const WaypointFile &file,
+                  std::span<const std::unique_ptr<ParseJob>> jobs) noexcept
+{
+  bool success = true, tasks_found = false;
+  std::size_t n = 0;
+  std::chrono::steady_clock::duration duration{};
+
+  for (const auto &job : jobs) {
+    if (&job->file != &file)
+      continue;
+
+    duration += job->duration;
+
+    /* everything after the "Related Tasks" line is not a waypoint */
+    if (tasks_found)
+      continue;
+
+    if (job->error) {
+      if (success) {
+        LogFmt("Failed to read waypoint file: {}", file.path);
+        LogError(job->error);
+        success = false;
+      }
+
+      /* keep the waypoints which were parsed before the error, but
+         discard the following chunks, just like the serial parser
+         would */
+      tasks_found = true;
+    } else
+      tasks_found = job->tasks_found;
+
+    n += job->waypoints.size();
+    way_points.Append(std::move(job->waypoints));
+  }
+
+  LogFmt("Waypoint file {}: {} waypoints, parsed in {:.1f} ms",
+         file.path, n,
+         std::chrono::duration<double, std::milli>(duration).count());
+
+  return success;
 }
 
 bool
 LoadWaypoints(Waypoints &way_points, const RasterTerrain *terrain,
               ProgressListener &progress)
 {
+  const auto start = std::chrono::steady_clock::now();
+
   bool found = false;
 
   // Delete old waypoints
   way_points.Clear();
 
+  /* collect the files; the primary and watched files and user.cup
+     are parsed in parallel, each into its own staging store, and
+     then merged in the same order as they used to be loaded */
+
+  std::list<WaypointFile> files;
+
   // ### FIRST FILE ###
-  auto paths = Profile::GetMultiplePaths(ProfileKeys::WaypointFileList,
-                                         WAYPOINT_FILE_PATTERNS);
   uint8_t file_num = 0;
-  for (const auto &path : paths) {
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::PRIMARY,
-                              file_num++, terrain, progress);
-  }
+  for (auto &path : Profile::GetMultiplePaths(ProfileKeys::WaypointFileList,
+                                              WAYPOINT_FILE_PATTERNS))
+    files.emplace_back(std::move(path),
+                       WaypointFactory(WaypointOrigin::PRIMARY, file_num++,
+                                       terrain));
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
-  paths = Profile::GetMultiplePaths(ProfileKeys::WatchedWaypointFileList,
-                                    WAYPOINT_FILE_PATTERNS);
   file_num = 0;
-  for (const auto &path : paths) {
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::WATCHED,
-                              file_num++, terrain, progress);
+  for (auto &path : Profile::GetMultiplePaths(ProfileKeys::WatchedWaypointFileList,
+                                              WAYPOINT_FILE_PATTERNS))
+    files.emplace_back(std::move(path),
+                       WaypointFactory(WaypointOrigin::WATCHED, file_num++,
+                                       terrain));
+
+  const std::size_t n_configured = files.size();
+
+  //Load user.cup
+  files.emplace_back(LocalPath("user.cup"),
+                     WaypointFactory(WaypointOrigin::USER, 0, terrain));
+
+  std::vector<std::unique_ptr<ParseJob>> jobs;
+  for (auto &file : files) {
+    bool split = false;
+    try {
+      split = SplitWaypointFile(file);
+    } catch (...) {
+      /* the job will fail again and report the error */
+    }
+
+    if (split) {
+      for (std::size_t i = 0; i < file.chunks->size(); ++i)
+        jobs.emplace_back(std::make_unique<ParseJob>(file, int(i)));
+    } else
+      jobs.emplace_back(std::make_unique<ParseJob>(file, -1));
   }
 
+  progress.SetProgressRange(jobs.size());
+
+  JobThread helpers[3]{
+    JobThread{"Waypoints1"},
+    JobThread{"Waypoints2"},
+    JobThread{"Waypoints3"},
+  };
+
+  const unsigned n_threads = RunParseJobs(jobs, helpers, progress);
+
+  const auto parsed = std::chrono::steady_clock::now();
+
+  auto file = files.begin();
+  for (std::size_t i = 0; i < n_configured; ++i, ++file)
+    found |= MergeWaypointFile(way_points, *file, jobs);
+
   // ### MAP/FOURTH FILE ###
 
   // If no waypoint file found yet
@@ -120,14 +341,20 @@ LoadWaypoints(Waypoints &way_points, const RasterTerrain *terrain,
                "Failed to load waypoints from map file");
     }
   }
-  //Load user.cup
-  LoadWaypointFile(way_points, LocalPath("user.cup"),
-                   WaypointFileType::SEEYOU,
-                   WaypointOrigin::USER, 0, terrain, progress);
+
+  // user.cup
+  MergeWaypointFile(way_points, files.back(), jobs);
+
   // Optimise the waypoint list after attaching new waypoints
   way_points.Optimise();
 
-  LogFmt("LoadWaypoints: loaded {} waypoints", way_points.size());
+  const auto end = std::chrono::steady_clock::now();
+  LogFmt("LoadWaypoints: loaded {} waypoints from {} files in {:.1f} ms "
+         "(parsing {:.1f} ms in {} jobs on {} threads)",
+         way_points.size(), files.size(),
+         std::chrono::duration<double, std::milli>(end - start).count(),
+         std::chrono::duration<double, std::milli>(parsed - start).count(),
+         jobs.size(), n_threads);
 
   // Return whether waypoints have been loaded into the waypoint list
   return found;
@@ -9,6 +9,7 @@
 #include "WaypointReaderOzi.hpp"
 #include "WaypointReaderCompeGPS.hpp"
 #include "WaypointFileType.hpp"
+#include "Waypoint/Waypoints.hpp"
 #include "system/Path.hpp"
 #include "io/FileReader.hxx"
 #include "io/CupxArchive.hpp"
@@ -17,6 +18,7 @@
 #include "io/ProgressReader.hpp"
 #include "io/BufferedReader.hxx"
 #include "util/Compiler.h"
+#include "util/ScopeExit.hxx"
 
 #include <stdexcept>
 #include <memory>
@@ -56,7 +58,7 @@ CreateWaypointReader(WaypointFileType type, WaypointFactory factory)
 static void
 ReadWaypointFile(Reader &file_reader, WaypointFileType file_type,
                  uint_least64_t total_size,
-                 Waypoints &way_points, WaypointFactory factory,
+                 std::vector<WaypointPtr> &way_points, WaypointFactory factory,
                  ProgressListener &progress)
 {
   ProgressReader progress_reader{file_reader, total_size, progress};
@@ -82,7 +84,7 @@ ReadWaypointFile(Reader &file_reader, WaypointFileType file_type,
 
 void
 ReadWaypointFile(Path path, WaypointFileType file_type,
-                 Waypoints &way_points,
+                 std::vector<WaypointPtr> &way_points,
                  WaypointFactory factory, ProgressListener &progress)
 {
   if (file_type == WaypointFileType::CUPX) {
@@ -102,6 +104,25 @@ ReadWaypointFile(Path path, WaypointFileType file_type,
                    way_points, factory, progress);
 }
 
+void
+ReadWaypointFile(Path path, std::vector<WaypointPtr> &way_points,
+                 WaypointFactory factory, ProgressListener &progress)
+{
+  ReadWaypointFile(path, DetermineWaypointFileType(path),
+                   way_points, factory, progress);
+}
+
+void
+ReadWaypointFile(Path path, WaypointFileType file_type,
+                 Waypoints &way_points,
+                 WaypointFactory factory, ProgressListener &progress)
+{
+  std::vector<WaypointPtr> list;
+  AtScopeExit(&way_points, &list) { way_points.Append(std::move(list)); };
+
+  ReadWaypointFile(path, file_type, list, factory, progress);
+}
+
 void
 ReadWaypointFile(Path path, Waypoints &way_points,
                  WaypointFactory factory, ProgressListener &progress)
@@ -115,7 +136,10 @@ ReadWaypointFile(struct zzip_dir *dir, const char *path,
                  WaypointFileType file_type, Waypoints &way_points,
                  WaypointFactory factory, ProgressListener &progress)
 {
+  std::vector<WaypointPtr> list;
+  AtScopeExit(&way_points, &list) { way_points.Append(std::move(list)); };
+
   ZipReader file_reader{dir, path};
   ReadWaypointFile(file_reader, file_type, file_reader.GetSize(),
-                   way_points, factory, progress);
+                   list, factory, progress);
 }
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include "Waypoint/Ptr.hpp"
+
 #include <cstdint>
+#include <vector>
 
 enum class WaypointFileType: uint8_t;
 struct zzip_dir;
@@ -12,6 +15,26 @@ class Waypoints;
 class WaypointFactory;
 class ProgressListener;
 
+/**
+ * Parse a waypoint file into the given list without indexing it;
+ * pass the list to Waypoints::Append() afterwards.  This is cheaper
+ * than parsing into a #Waypoints object when the waypoints are
+ * merged into another store anyway.
+ *
+ * Throws on error.
+ */
+void
+ReadWaypointFile(Path path, WaypointFileType file_type,
+                 std::vector<WaypointPtr> &way_points,
+                 WaypointFactory factory, ProgressListener &progress);
+
+/**
+ * Throws on error.
+ */
+void
+ReadWaypointFile(Path path, std::vector<WaypointPtr> &way_points,
+                 WaypointFactory factory, ProgressListener &progress);
+
 /**
  * Throws on error.
  */
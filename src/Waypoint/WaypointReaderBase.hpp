@@ -4,8 +4,10 @@
 #pragma once
 
 #include "Factory.hpp"
+#include "Waypoint/Ptr.hpp"
+
+#include <vector>
 
-class Waypoints;
 class BufferedReader;
 
 class WaypointReaderBase
@@ -21,11 +23,13 @@ public:
   virtual ~WaypointReaderBase() {}
 
   /**
-   * Parses a waypoint file into the given waypoint list
+   * Parses a waypoint file into the given waypoint list.  The
+   * waypoints are not indexed; pass the list to Waypoints::Append()
+   * afterwards.
    * @param way_points The waypoint list to fill
    * @return True if the waypoint file parsing was okay, False otherwise
    */
-  void Parse(Waypoints &way_points, BufferedReader &reader);
+  void Parse(std::vector<WaypointPtr> &way_points, BufferedReader &reader);
 
 protected:
   /**
@@ -36,5 +40,6 @@ protected:
    * @return True if the line was parsed correctly or ignored, False if
    * parsing error occured
    */
-  virtual bool ParseLine(const char *line, Waypoints &way_points) = 0;
+  virtual bool ParseLine(const char *line,
+                         std::vector<WaypointPtr> &way_points) = 0;
 };
@@ -2,8 +2,9 @@
 // Copyright The XCSoar Project
 
 #include "WaypointReaderCompeGPS.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "Geo/UTM.hpp"
+#include "util/StringCompare.hxx"
 #include "util/StringSplit.hxx"
 
 static bool
@@ -119,7 +120,8 @@ ParseAltitude(const char *&src, double &dest) noexcept
 }
 
 bool
-WaypointReaderCompeGPS::ParseLine(const char *line, Waypoints &waypoints)
+WaypointReaderCompeGPS::ParseLine(const char *line,
+                                  std::vector<WaypointPtr> &waypoints)
 {
   /*
    * G  WGS 84
@@ -208,7 +210,7 @@ WaypointReaderCompeGPS::ParseLine(const char *line, Waypoints &waypoints)
   // Parse waypoint name
   waypoint.comment.assign(string_converter.Convert(line));
 
-  waypoints.Append(std::move(waypoint));
+  waypoints.emplace_back(std::make_shared<Waypoint>(std::move(waypoint)));
   return true;
 }
 
@@ -2,8 +2,9 @@
 // Copyright The XCSoar Project
 
 #include "WaypointReaderFS.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "Geo/UTM.hpp"
+#include "util/StringCompare.hxx"
 #include "util/StringStrip.hxx"
 
 #include <stdlib.h>
@@ -110,7 +111,8 @@ ParseAltitude(const char *src, double &dest) noexcept
 }
 
 bool
-WaypointReaderFS::ParseLine(const char *line, Waypoints &way_points)
+WaypointReaderFS::ParseLine(const char *line,
+                            std::vector<WaypointPtr> &way_points)
 {
   //$FormatGEO
   //ACONCAGU  S 32 39 12.00    W 070 00 42.00  6962  Aconcagua
@@ -160,7 +162,7 @@ WaypointReaderFS::ParseLine(const char *line, Waypoints &way_points)
   if (len > (is_utm ? 38 : 47))
     new_waypoint.comment = std::string{string_converter.Convert(line + (is_utm ? 38 : 47))};
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.emplace_back(std::make_shared<Waypoint>(std::move(new_waypoint)));
   return true;
 }
 
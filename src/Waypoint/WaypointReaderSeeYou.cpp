@@ -9,6 +9,15 @@
 #include "util/NumberParser.hxx"
 #include "io/StringConverter.hpp"
 #include "io/BufferedCsvReader.hpp"
+#include "io/BufferedReader.hxx"
+#include "io/MemoryReader.hxx"
+#include "util/ScopeExit.hxx"
+#include "util/SpanCast.hxx"
+#include "util/UTF8.hpp"
+
+#include <algorithm>
+#include <array>
+#include <optional>
 
 #include <stdlib.h>
 
@@ -175,180 +184,326 @@ ParseStyle(std::string_view src, Waypoint::Type &type)
   return true;
 }
 
-bool ParseSeeYou(WaypointFactory factory, Waypoints &waypoints, BufferedReader &reader) {
-  StringConverter string_converter;
+// 2018: name, code, country, lat, lon, elev, style, rwydir, rwylen, freq, desc
+// 2022: name, code, country, lat, lon, elev, style, rwdir, rwlen, rwwidth, freq, desc, userdata, pics
+enum {
+  iName = 0,
+  iShortname = 1,
+  iLatitude = 3,
+  iLongitude = 4,
+  iElevation = 5,
+  iStyle = 6,
+  iRWDir = 7,
+  iRWLen = 8,
+  iRWWidth = 9,
+  iUserData = 12,
+  iPics = 13
+};
+
+using SeeYouRecord = std::array<std::string_view, 14>;
+
+/**
+ * Check whether this is a header (a line with only field names).
+ */
+static std::optional<SeeYouColumns>
+ParseHeader(const SeeYouRecord &params, size_t params_num) noexcept
+{
+  if (!StringIsEqualIgnoreCase(params[iLatitude],"lat"sv))
+    return std::nullopt;
+
+  SeeYouColumns columns;
+
+  /*
+   * Newer cup/cupx specification adds rwwidth, shifts freq and desc
+   * right, and adds userdata and pics.
+   */
+  if (params_num > iRWWidth &&
+      StringIsEqualIgnoreCase(params[iRWWidth], "rwwidth"sv)) {
+    columns.has_rwwidth = true;
+    columns.frequency = 10;
+    columns.description = 11;
+  }
 
-  // 2018: name, code, country, lat, lon, elev, style, rwydir, rwylen, freq, desc
-  // 2022: name, code, country, lat, lon, elev, style, rwdir, rwlen, rwwidth, freq, desc, userdata, pics
-  enum {
-    iName = 0,
-    iShortname = 1,
-    iLatitude = 3,
-    iLongitude = 4,
-    iElevation = 5,
-    iStyle = 6,
-    iRWDir = 7,
-    iRWLen = 8,
-    iRWWidth = 9,
-    iUserData = 12,
-    iPics = 13
-  };
-  unsigned iFrequency = 9;
-  unsigned iDescription = 10;
-
-  size_t params_num;
-  std::array<std::string_view,14> params;
-
-  bool tasks { false };
-  bool first_line = true;
-  bool has_rwwidth = false;
-
-  while ( true ) {
-    params_num = ReadCsvRecord(reader, params);
-
-    // first line of file
-    if (first_line) {
-      first_line = false;
-
-      // Empty file
-      if (params_num == 0)
-        return false;
-
-      // Check whether this is a header (a line with only field names).
-      if (StringIsEqualIgnoreCase(params[iLatitude],"lat"sv)) {
-
-        /*
-         * Newer cup/cupx specification adds rwwidth, shifts freq and desc
-         * right, and adds userdata and pics.
-         */
-        if (params_num > iRWWidth &&
-            StringIsEqualIgnoreCase(params[iRWWidth], "rwwidth"sv)) {
-          has_rwwidth = true;
-          iFrequency = 10;
-          iDescription = 11;
+  return columns;
+}
+
+static bool
+IsTasksSection(const SeeYouRecord &params, size_t params_num) noexcept
+{
+  return params_num == 1 &&
+    StringIsEqualIgnoreCase(params[0],"-----Related Tasks-----"sv);
+}
+
+static void
+ParseRecord(const SeeYouRecord &params, size_t params_num,
+            const SeeYouColumns &columns, WaypointFactory factory,
+            StringConverter &string_converter,
+            std::vector<WaypointPtr> &waypoints)
+{
+  const unsigned iFrequency = columns.frequency;
+  const unsigned iDescription = columns.description;
+
+  // Skip blank lines and comments (comments are an extension)
+  if ( (params_num == 1 && params[0].empty()) ||
+       params[0].starts_with('*') )
+    return;
+
+  // Latitude (e.g. 5115.900N)
+  GeoPoint location;
+
+  if ( params_num <= iLatitude ||
+       !ParseAngle(params[iLatitude], location.latitude, true))
+    return;
+
+  // Longitude (e.g. 00715.900W)
+  if ( params_num <= iLongitude ||
+       !ParseAngle(params[iLongitude], location.longitude, false))
+    return;
+
+  location.Normalize(); // ensure longitude is within -180:180
+
+  Waypoint new_waypoint = factory.Create(location);
+
+  // Name (e.g. "Some Turnpoint")
+  if ( params_num <= iName ||
+       params[iName].empty() )
+    return;
+  new_waypoint.name.assign(string_converter.Convert(params[iName]));
+
+  // Elevation (e.g. 458.0m)
+  /// @todo configurable behaviour
+  if ( params_num > iElevation &&
+       !params[iElevation].empty() &&
+       ParseAltitude(params[iElevation], new_waypoint.elevation) )
+    new_waypoint.has_elevation = true;
+  else
+    factory.FallbackElevation(new_waypoint);
+
+  // Style (e.g. 5)
+  if ( params_num > iStyle &&
+       !params[iStyle].empty())
+    ParseStyle(params[iStyle], new_waypoint.type);
+
+  new_waypoint.flags.turn_point = true;
+
+  // Short name (code) of waypoint
+  if ( params_num <= iShortname )
+    return;
+  new_waypoint.shortname.assign(string_converter.Convert(params[iShortname]));
+
+  // Frequency & runway direction/length (for airports and landables)
+  // and description (e.g. "Some Description")
+  if ( new_waypoint.IsLandable() ) {
+    if ( params_num > iFrequency &&
+         !params[iFrequency].empty() )
+      new_waypoint.radio_frequency = RadioFrequency::Parse(params[iFrequency]);
+
+    // Runway length (e.g. 546.0m)
+    double rwlen = -1;
+    if ( params_num > iRWLen &&
+         !params[iRWLen].empty() &&
+         ParseDistance(params[iRWLen], rwlen) &&
+         rwlen > 0 && rwlen <= 30000)
+      new_waypoint.runway.SetLength(uround(rwlen));
+
+    // Runway width (e.g. 15.0m; available in newer CUP formats)
+    double rwwidth = -1;
+    if (columns.has_rwwidth &&
+        params_num > iRWWidth &&
+        !params[iRWWidth].empty() &&
+        ParseDistance(params[iRWWidth], rwwidth) &&
+        rwwidth > 0 && rwwidth <= 30000)
+      new_waypoint.runway.SetWidth(uround(rwwidth));
+
+    if ( params_num > iRWDir &&
+         !params[iRWDir].empty()) {
+      if (auto value = ParseInteger<unsigned>(params[iRWDir])) {
+        unsigned direction = *value;
+
+        if (direction <= 360) {
+          if (direction == 360)
+            direction = 0;
+
+          new_waypoint.runway.SetDirectionDegrees(direction);
         }
-        continue;
       }
     }
+  }
+
+  /*
+   * This convention was introduced by the OpenAIP project
+   * (http://www.openaip.net/), since no waypoint type exists for
+   * thermal hotspots.
+   */
+  if ( params_num > iDescription &&
+       params[iDescription].starts_with("Hotspot"sv) )
+    new_waypoint.type = Waypoint::Type::THERMAL_HOTSPOT;
+
+  if ( params_num > iDescription )
+    new_waypoint.comment.assign(string_converter.Convert(params[iDescription]));
+
+  if ( params_num > iUserData )
+    new_waypoint.details.assign(string_converter.Convert(params[iUserData]));
+
+  if ( params_num > iPics &&
+       !params[iPics].empty() ) {
+    for (const auto i : IterableSplitString(params[iPics], ';')) {
+      new_waypoint.files_embed.emplace_front(string_converter.Convert(i));
+    }
+  }
+  waypoints.emplace_back(std::make_shared<Waypoint>(std::move(new_waypoint)));
+}
+
+/**
+ * Parse records until the end of the file or the tasks section.
+ *
+ * @return true if the "Related Tasks" line was found
+ */
+static bool
+ParseRecords(const SeeYouColumns &columns, WaypointFactory factory,
+             StringConverter &string_converter,
+             std::vector<WaypointPtr> &waypoints, BufferedReader &reader)
+{
+  SeeYouRecord params;
+
+  while (true) {
+    const size_t params_num = ReadCsvRecord(reader, params);
+
+    // End of file
+    if (params_num == 0)
+      return false;
 
     // Tasks section
-    tasks = params_num == 1 &&
-      StringIsEqualIgnoreCase(params[0],"-----Related Tasks-----"sv);
-
-    // End of file or start of task section
-    if ( !params_num || tasks )
-      break;
-
-    // Skip blank lines and comments (comments are an extension)
-    if ( (params_num == 1 && params[0].empty()) ||
-         params[0].starts_with('*') )
-      continue;
-
-    // Latitude (e.g. 5115.900N)
-    GeoPoint location;
-
-    if ( params_num <= iLatitude ||
-         !ParseAngle(params[iLatitude], location.latitude, true))
-      continue;
-
-    // Longitude (e.g. 00715.900W)
-    if ( params_num <= iLongitude ||
-         !ParseAngle(params[iLongitude], location.longitude, false))
-      continue;
-
-    location.Normalize(); // ensure longitude is within -180:180
-
-    Waypoint new_waypoint = factory.Create(location);
-
-    // Name (e.g. "Some Turnpoint")
-    if ( params_num <= iName ||
-         params[iName].empty() )
-      continue;
-    new_waypoint.name.assign(string_converter.Convert(params[iName]));
-
-    // Elevation (e.g. 458.0m)
-    /// @todo configurable behaviour
-    if ( params_num > iElevation &&
-         !params[iElevation].empty() &&
-         ParseAltitude(params[iElevation], new_waypoint.elevation) )
-      new_waypoint.has_elevation = true;
-    else
-      factory.FallbackElevation(new_waypoint);
-
-    // Style (e.g. 5)
-    if ( params_num > iStyle &&
-         !params[iStyle].empty())
-      ParseStyle(params[iStyle], new_waypoint.type);
-
-    new_waypoint.flags.turn_point = true;
-
-    // Short name (code) of waypoint
-    if ( params_num <= iShortname )
-      continue;
-    new_waypoint.shortname.assign(string_converter.Convert(params[iShortname]));
-
-    // Frequency & runway direction/length (for airports and landables)
-    // and description (e.g. "Some Description")
-    if ( new_waypoint.IsLandable() ) {
-      if ( params_num > iFrequency &&
-           !params[iFrequency].empty() )
-        new_waypoint.radio_frequency = RadioFrequency::Parse(params[iFrequency]);
-
-      // Runway length (e.g. 546.0m)
-      double rwlen = -1;
-      if ( params_num > iRWLen &&
-           !params[iRWLen].empty() &&
-           ParseDistance(params[iRWLen], rwlen) &&
-           rwlen > 0 && rwlen <= 30000)
-        new_waypoint.runway.SetLength(uround(rwlen));
-
-      // Runway width (e.g. 15.0m; available in newer CUP formats)
-      double rwwidth = -1;
-      if (has_rwwidth &&
-          params_num > iRWWidth &&
-          !params[iRWWidth].empty() &&
-          ParseDistance(params[iRWWidth], rwwidth) &&
-          rwwidth > 0 && rwwidth <= 30000)
-        new_waypoint.runway.SetWidth(uround(rwwidth));
-
-      if ( params_num > iRWDir &&
-           !params[iRWDir].empty()) {
-        if (auto value = ParseInteger<unsigned>(params[iRWDir])) {
-          unsigned direction = *value;
-
-          if (direction <= 360) {
-            if (direction == 360)
-              direction = 0;
-
-            new_waypoint.runway.SetDirectionDegrees(direction);
-          }
-        }
+    if (IsTasksSection(params, params_num))
+      return true;
+
+    ParseRecord(params, params_num, columns, factory,
+                string_converter, waypoints);
+  }
+}
+
+bool
+ParseSeeYou(WaypointFactory factory, std::vector<WaypointPtr> &waypoints,
+            BufferedReader &reader)
+{
+  StringConverter string_converter;
+
+  SeeYouRecord params;
+
+  // first line of file
+  const size_t params_num = ReadCsvRecord(reader, params);
+
+  // Empty file
+  if (params_num == 0)
+    return false;
+
+  if (IsTasksSection(params, params_num))
+    return true;
+
+  SeeYouColumns columns;
+  if (const auto header = ParseHeader(params, params_num))
+    columns = *header;
+  else
+    ParseRecord(params, params_num, columns, factory,
+                string_converter, waypoints);
+
+  return ParseRecords(columns, factory, string_converter, waypoints, reader);
+}
+
+bool
+ParseSeeYou(WaypointFactory factory, Waypoints &waypoints,
+            BufferedReader &reader)
+{
+  std::vector<WaypointPtr> list;
+  AtScopeExit(&waypoints, &list) { waypoints.Append(std::move(list)); };
+
+  return ParseSeeYou(factory, list, reader);
+}
+
+/**
+ * Split the data at record boundaries into chunks of approximately
+ * the given size.  This follows the quoting rules of ReadCsvRecord(),
+ * so newlines in quoted fields are not mistaken for record
+ * boundaries.
+ */
+static std::vector<std::span<const std::byte>>
+SplitRecords(std::span<const std::byte> data, std::size_t chunk_size)
+{
+  std::vector<std::span<const std::byte>> chunks;
+
+  std::size_t begin = 0;
+  bool quoted = false, field_start = true;
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    const char ch = static_cast<char>(data[i]);
+
+    if (quoted) {
+      if (ch == '"') {
+        if (i + 1 < data.size() && static_cast<char>(data[i + 1]) == '"')
+          /* a quoted double quote */
+          ++i;
+        else
+          quoted = false;
       }
-    }
+    } else if (ch == ',' || ch == '\n') {
+      field_start = true;
 
-    /*
-     * This convention was introduced by the OpenAIP project
-     * (http://www.openaip.net/), since no waypoint type exists for
-     * thermal hotspots.
-     */
-    if ( params_num > iDescription &&
-         params[iDescription].starts_with("Hotspot"sv) )
-      new_waypoint.type = Waypoint::Type::THERMAL_HOTSPOT;
-
-    if ( params_num > iDescription )
-      new_waypoint.comment.assign(string_converter.Convert(params[iDescription]));
-
-    if ( params_num > iUserData )
-      new_waypoint.details.assign(string_converter.Convert(params[iUserData]));
-
-    if ( params_num > iPics &&
-         !params[iPics].empty() ) {
-      for (const auto i : IterableSplitString(params[iPics], ';')) {
-        new_waypoint.files_embed.emplace_front(string_converter.Convert(i));
+      if (ch == '\n' && i + 1 - begin >= chunk_size) {
+        chunks.push_back(data.subspan(begin, i + 1 - begin));
+        begin = i + 1;
       }
+    } else if (ch != ' ') {
+      quoted = field_start && ch == '"';
+      field_start = false;
+    }
+  }
+
+  if (begin < data.size())
+    chunks.push_back(data.subspan(begin));
+
+  return chunks;
+}
+
+SeeYouChunks::SeeYouChunks(std::span<const std::byte> data,
+                           std::size_t chunk_size)
+{
+  MemoryReader memory_reader{data};
+  BufferedReader reader{memory_reader};
+
+  SeeYouRecord params;
+  const size_t params_num = ReadCsvRecord(reader, params);
+
+  /* the header is not passed to the chunks */
+  std::size_t header_size = 0;
+  if (params_num > 0) {
+    if (const auto header = ParseHeader(params, params_num)) {
+      columns = *header;
+
+      const auto newline = std::find(data.begin(), data.end(),
+                                     std::byte{'\n'});
+      header_size = newline != data.end()
+        ? std::distance(data.begin(), newline) + 1
+        : data.size();
     }
-    waypoints.Append(std::move(new_waypoint));
   }
 
-  return tasks;
+  /* the charset is detected once for the whole file, because each
+     chunk has its own StringConverter */
+  const auto text = ToStringView(data);
+  if (text.starts_with(utf8_byte_order_mark))
+    charset = Charset::UTF8;
+  else if (!ValidateUTF8(text))
+    charset = Charset::ISO_LATIN_1;
+
+  chunks = SplitRecords(data.subspan(header_size), chunk_size);
+}
+
+bool
+SeeYouChunks::Parse(std::size_t i, WaypointFactory factory,
+                    std::vector<WaypointPtr> &waypoints) const
+{
+  StringConverter string_converter{charset};
+
+  MemoryReader memory_reader{chunks[i]};
+  BufferedReader reader{memory_reader};
+  return ParseRecords(columns, factory, string_converter, waypoints, reader);
 }
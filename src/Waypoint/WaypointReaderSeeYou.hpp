@@ -4,14 +4,83 @@
 #pragma once
 
 #include "Factory.hpp"
+#include "Waypoint/Ptr.hpp"
+#include "io/Charset.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
 
 class Waypoints;
 class BufferedReader;
 
 /**
+ * The positions of the columns which differ between versions of the
+ * CUP format.
+ */
+struct SeeYouColumns {
+  unsigned frequency = 9;
+  unsigned description = 10;
+  bool has_rwwidth = false;
+};
+
+/**
+ * Parse a CUP file into the given list.  The waypoints are not
+ * indexed; pass the list to Waypoints::Append() afterwards.
+ *
  * @return true if the "Related Tasks" line was found, false if the
  * file contains no task
  *
  * Throws on error.
  */
-bool ParseSeeYou(WaypointFactory factory, Waypoints &waypoints, BufferedReader &reader);
+bool
+ParseSeeYou(WaypointFactory factory, std::vector<WaypointPtr> &waypoints,
+            BufferedReader &reader);
+
+/**
+ * Parse a CUP file and append its waypoints to the given store.
+ * The waypoints parsed before an error are appended as well.
+ *
+ * Throws on error.
+ */
+bool
+ParseSeeYou(WaypointFactory factory, Waypoints &waypoints,
+            BufferedReader &reader);
+
+/**
+ * A CUP file in memory, split into chunks at record boundaries.  The
+ * chunks can be parsed in parallel; appending the waypoints of all
+ * chunks in order gives the same result as ParseSeeYou(), except
+ * that the waypoints after the "Related Tasks" line must be discarded
+ * (see Parse()).
+ */
+class SeeYouChunks {
+  SeeYouColumns columns;
+  Charset charset = Charset::AUTO;
+
+  std::vector<std::span<const std::byte>> chunks;
+
+public:
+  /**
+   * @param data the file contents; must remain valid as long as this
+   * object is used
+   * @param chunk_size the approximate size of each chunk
+   */
+  SeeYouChunks(std::span<const std::byte> data, std::size_t chunk_size);
+
+  std::size_t size() const noexcept {
+    return chunks.size();
+  }
+
+  /**
+   * Parse one chunk.  May be called concurrently for different
+   * chunks (with different lists).
+   *
+   * Throws on error.
+   *
+   * @return true if the "Related Tasks" line was found; the
+   * following chunks must then be ignored
+   */
+  bool Parse(std::size_t i, WaypointFactory factory,
+             std::vector<WaypointPtr> &waypoints) const;
+};
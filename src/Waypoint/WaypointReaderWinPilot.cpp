@@ -3,7 +3,7 @@
 
 #include "WaypointReaderWinPilot.hpp"
 #include "Units/System.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "util/NumberParser.hxx"
 #include "util/StringSplit.hxx"
 
@@ -198,7 +198,8 @@ ParseFlags(std::string_view src, Waypoint &dest)
 }
 
 bool
-WaypointReaderWinPilot::ParseLine(const char *line, Waypoints &waypoints)
+WaypointReaderWinPilot::ParseLine(const char *line,
+                                  std::vector<WaypointPtr> &waypoints)
 {
   // If (end-of-file)
   if (line[0] == '\0')
@@ -253,6 +254,6 @@ WaypointReaderWinPilot::ParseLine(const char *line, Waypoints &waypoints)
   new_waypoint.comment = std::string{string_converter.Convert(comment)};
   ParseRunwayDirection(comment, new_waypoint.runway);
 
-  waypoints.Append(std::move(new_waypoint));
+  waypoints.emplace_back(std::make_shared<Waypoint>(std::move(new_waypoint)));
   return true;
 }
@@ -2,7 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "WaypointReaderZander.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "util/StringStrip.hxx"
 
 #include <stdlib.h>
@@ -130,7 +130,8 @@ ParseFlagsFromDescription(const char *src, Waypoint &dest) noexcept
 }
 
 bool
-WaypointReaderZander::ParseLine(const char *line, Waypoints &way_points)
+WaypointReaderZander::ParseLine(const char *line,
+                                std::vector<WaypointPtr> &way_points)
 {
   // If (end-of-file or comment)
   if (line[0] == '\0' || line[0] == '*')
@@ -177,6 +178,6 @@ WaypointReaderZander::ParseLine(const char *line, Waypoints &way_points)
     if (len < 36 || !ParseFlagsFromDescription(line + 35, new_waypoint))
       new_waypoint.flags.turn_point = true;
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.emplace_back(std::make_shared<Waypoint>(std::move(new_waypoint)));
   return true;
 }
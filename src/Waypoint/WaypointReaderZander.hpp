@@ -15,5 +15,6 @@ public:
 
 protected:
   /* virtual methods from class WaypointReaderBase */
-  bool ParseLine(const char *line, Waypoints &way_points) override;
+  bool ParseLine(const char *line,
+                 std::vector<WaypointPtr> &way_points) override;
 };
@@ -23,11 +23,11 @@ CSVLine::CSVLine(const char *line) noexcept
 std::string_view
 CSVLine::ReadView() noexcept
 {
-  const char* _separator = strchr(data, ',');
+  const char *_separator = (const char *)memchr(data, ',', end - data);
 
   const char *s = data;
   std::size_t length;
-  if (_separator != nullptr && _separator < end) {
+  if (_separator != nullptr) {
     length = _separator - data;
     data = _separator + 1;
   } else {
@@ -16,6 +16,14 @@ protected:
 public:
   explicit CSVLine(const char *line) noexcept;
 
+  /**
+   * Construct from a line whose end is already known.  The column
+   * after the last one must still be terminated by a null byte or by
+   * a character which is not part of a number (e.g. '*').
+   */
+  explicit constexpr CSVLine(std::string_view line) noexcept
+    :data(line.data()), end(line.data() + line.size()) {}
+
   std::string_view Rest() const noexcept {
     return {data, std::size_t(end - data)};
   }
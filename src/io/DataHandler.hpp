@@ -12,7 +12,14 @@
 class DataHandler {
 public:
   /**
+   * @param s the received data; the buffer is only valid during
+   * this call
+   * @param writable if true, the buffer is owned by the caller and
+   * the handler may modify it (by casting away the "const"), for
+   * example to split and parse lines in place instead of copying
+   * them
    * @return false if the handler wishes to receive no more data
    */
-  virtual bool DataReceived(std::span<const std::byte> s) noexcept = 0;
+  virtual bool DataReceived(std::span<const std::byte> s,
+                            bool writable) noexcept = 0;
 };
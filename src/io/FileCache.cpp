@@ -4,6 +4,7 @@
 #include "FileCache.hpp"
 #include "FileReader.hxx"
 #include "FileOutputStream.hxx"
+#include "FileMapping.hpp"
 #include "system/FileUtil.hpp"
 #include "util/SpanCast.hxx"
 
@@ -14,6 +15,7 @@
 #include <cstdint>
 #include <stdexcept>
 
+#include <stdio.h>
 #include <string.h>
 
 #ifdef HAVE_POSIX
@@ -74,6 +76,24 @@ GetRegularFileInfo(Path path, FileInfo &info)
 FileCache::FileCache(AllocatedPath &&_cache_path)
   :cache_path(std::move(_cache_path)) {}
 
+std::string
+FileCache::MakeName(const char *prefix,
+                    std::initializer_list<const char *> keys) noexcept
+{
+  /* FNV-1a over all keys, each including its null terminator */
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char *p : keys) {
+    for (; *p != 0; ++p)
+      hash = (hash ^ static_cast<uint64_t>(*p)) * 1099511628211ULL;
+    hash = hash * 1099511628211ULL;
+  }
+
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%s_%016llx",
+           prefix, (unsigned long long)hash);
+  return buffer;
+}
+
 void
 FileCache::Flush(const char *name)
 {
@@ -120,6 +140,50 @@ FileCache::Load(const char *name, Path original_path) noexcept
   return nullptr;
 }
 
+std::unique_ptr<FileMapping>
+FileCache::Map(const char *name, Path original_path,
+               std::span<const std::byte> &payload_r) noexcept
+{
+  FileInfo original_info;
+  if (!GetRegularFileInfo(original_path, original_info))
+    return nullptr;
+
+  const auto path = MakeCachePath(name);
+
+  FileInfo cached_info;
+  if (!GetRegularFileInfo(path, cached_info))
+    return nullptr;
+
+  if (original_info.mtime > cached_info.mtime && !original_info.IsFuture()) {
+    File::Delete(path);
+    return nullptr;
+  }
+
+  constexpr std::size_t header_size = sizeof(FILE_CACHE_MAGIC) +
+    sizeof(FileInfo);
+
+  try {
+    auto mapping = std::make_unique<FileMapping>(path);
+    const std::span<const std::byte> raw = *mapping;
+
+    if (raw.size() > header_size) {
+      unsigned magic;
+      struct FileInfo old_info;
+      memcpy(&magic, raw.data(), sizeof(magic));
+      memcpy(&old_info, raw.data() + sizeof(magic), sizeof(old_info));
+
+      if (magic == FILE_CACHE_MAGIC && old_info == original_info) {
+        payload_r = raw.subspan(header_size);
+        return mapping;
+      }
+    }
+  } catch (...) {
+  }
+
+  File::Delete(path);
+  return nullptr;
+}
+
 std::unique_ptr<FileOutputStream>
 FileCache::Save(const char *name, Path original_path)
 {
@@ -5,10 +5,15 @@
 
 #include "system/Path.hpp"
 
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
+#include <span>
+#include <string>
 #include <stdio.h>
 class Reader;
 class FileOutputStream;
+class FileMapping;
 
 class FileCache {
   AllocatedPath cache_path;
@@ -23,6 +28,15 @@ protected:
   }
 
 public:
+  /**
+   * Build a cache name from the given prefix and a hash of the given
+   * strings (e.g. the path of the original file), for callers which
+   * need one cache per file.
+   */
+  [[gnu::pure]]
+  static std::string MakeName(const char *prefix,
+                              std::initializer_list<const char *> keys) noexcept;
+
   void Flush(const char *name);
 
   /**
@@ -30,6 +44,17 @@ public:
    */
   std::unique_ptr<Reader> Load(const char *name, Path original_path) noexcept;
 
+  /**
+   * Like Load(), but map the file into memory instead of reading it.
+   * Returns nullptr on error.
+   *
+   * @param payload_r on success, receives the portion of the mapping
+   * after the cache header (i.e. what was written to the stream
+   * returned by Save())
+   */
+  std::unique_ptr<FileMapping> Map(const char *name, Path original_path,
+                                   std::span<const std::byte> &payload_r) noexcept;
+
   /**
    * Throws on error.
    */
@@ -7,7 +7,7 @@
 
 class NullDataHandler : public DataHandler {
 public:
-  bool DataReceived(std::span<const std::byte>) noexcept override {
+  bool DataReceived(std::span<const std::byte>, bool) noexcept override {
     return true;
   }
 };
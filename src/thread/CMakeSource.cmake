@@ -1,5 +1,6 @@
 set(_SOURCES
         thread/Debug.cpp
+        thread/JobThread.cpp
         thread/RecursivelySuspensibleThread.cpp
         thread/StandbyThread.cpp
         thread/SuspensibleThread.cpp
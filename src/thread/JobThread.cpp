@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/JobThread.hpp"
+
+void
+JobThread::Start(std::function<void()> &&_job)
+{
+  const std::lock_guard lock{mutex};
+  assert(!StandbyThread::IsBusy());
+
+  owned_job = std::move(_job);
+  job = &owned_job;
+
+  try {
+    Trigger();
+  } catch (...) {
+    job = nullptr;
+    owned_job = nullptr;
+    throw;
+  }
+}
+
+void
+JobThread::Start(const std::function<void()> &_job)
+{
+  const std::lock_guard lock{mutex};
+  assert(!StandbyThread::IsBusy());
+
+  job = &_job;
+
+  try {
+    Trigger();
+  } catch (...) {
+    job = nullptr;
+    throw;
+  }
+}
+
+void
+JobThread::Tick() noexcept
+{
+  const auto &f = *job;
+  job = nullptr;
+
+  {
+    const ScopeUnlock unlock(mutex);
+    f();
+  }
+
+  /* drop the captures of the finished function */
+  owned_job = nullptr;
+}
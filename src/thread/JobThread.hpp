@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/StandbyThread.hpp"
+
+#include <functional>
+
+/**
+ * A thread which runs one function at a time in background.  It can
+ * be used to move a calculation off the calling thread (Start() and
+ * check IsBusy() later), or to split a calculation into two parts
+ * which run in parallel (Start() one part, do the other part in the
+ * calling thread, then Wait()).
+ *
+ * The thread is launched on the first Start() call.
+ */
+class JobThread final : private StandbyThread {
+  /**
+   * The function passed to Start(std::function &&).
+   */
+  std::function<void()> owned_job;
+
+  /**
+   * The function to be run by the thread.
+   */
+  const std::function<void()> *job = nullptr;
+
+public:
+  explicit JobThread(const char *_name) noexcept
+    :StandbyThread(_name) {}
+
+  ~JobThread() noexcept {
+    LockStop();
+  }
+
+  /**
+   * Run the given function in the thread.  It must not throw.  Must
+   * not be called while the previous one is still running; call
+   * Wait() or check IsBusy().
+   *
+   * Throws on error (if the thread could not be launched).
+   */
+  void Start(std::function<void()> &&_job);
+
+  /**
+   * Like Start(std::function &&), but run the given function without
+   * copying it.  The caller must keep it alive until it has returned.
+   * This avoids allocating a new function each time.
+   *
+   * Throws on error (if the thread could not be launched).
+   */
+  void Start(const std::function<void()> &_job);
+
+  /**
+   * Is the last function still running?
+   */
+  bool IsBusy() noexcept {
+    const std::lock_guard lock{mutex};
+    return StandbyThread::IsBusy();
+  }
+
+  /**
+   * Wait until the last function has returned.  Returns immediately
+   * if there is none.  This establishes a "happens before" relation,
+   * i.e. the caller may access all data written by the function
+   * afterwards.
+   */
+  void Wait() noexcept {
+    LockWaitDone();
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Publishes snapshots of a value from one writer thread to any number
+ * of reader threads without a mutex.
+ *
+ * The writer copies each new value into a slot which is neither the
+ * current one nor pinned by a reader, and then makes it current.
+ * Readers pin the current slot with a #Lease and read it while the
+ * writer fills another slot; they never wait for the writer.  The
+ * writer only has to wait if all other slots are pinned at the same
+ * time, which requires more than #N-1 concurrent readers.
+ *
+ * Leases should be short-lived (e.g. for copying the value into a
+ * private blackboard); a reader which keeps a slot pinned keeps the
+ * writer from reusing it.
+ */
+template<typename T, std::size_t N=4>
+class SnapshotBuffer {
+  static_assert(N >= 3);
+
+  struct Slot {
+    T value;
+
+    /**
+     * The number of #Lease instances referring to this slot.
+     */
+    mutable std::atomic<unsigned> readers{0};
+  };
+
+  std::array<Slot, N> slots;
+
+  /**
+   * The index of the slot with the most recently published value.
+   */
+  std::atomic<unsigned> current{0};
+
+  /**
+   * Incremented by each Publish() call.
+   */
+  std::atomic<unsigned> version{0};
+
+public:
+  struct Statistics {
+    /**
+     * The number of Publish() calls.
+     */
+    uint_least64_t writes = 0;
+
+    /**
+     * The number of #Lease instances created.
+     */
+    uint_least64_t reads = 0;
+
+    /**
+     * The number of times a reader had to pin another slot because
+     * the writer published a new value concurrently.
+     */
+    uint_least64_t read_retries = 0;
+
+    /**
+     * The number of times the writer had to wait because all slots
+     * were pinned.
+     */
+    uint_least64_t write_waits = 0;
+
+    /**
+     * The number of bytes copied by Publish().
+     */
+    constexpr uint_least64_t GetWrittenBytes() const noexcept {
+      return writes * sizeof(T);
+    }
+  };
+
+private:
+  mutable struct {
+    std::atomic<uint_least64_t> writes{0}, reads{0};
+    std::atomic<uint_least64_t> read_retries{0}, write_waits{0};
+  } counters;
+
+public:
+  /**
+   * A read-only lease on the most recent snapshot.  The value does
+   * not change while the lease exists, even if the writer publishes
+   * new values.
+   */
+  class Lease {
+    const Slot &slot;
+
+    static const Slot &Pin(const SnapshotBuffer &buffer) noexcept {
+      buffer.counters.reads.fetch_add(1, std::memory_order_relaxed);
+
+      while (true) {
+        const Slot &slot = buffer.slots[buffer.current.load()];
+        slot.readers.fetch_add(1);
+
+        /* if the writer has published another slot meanwhile, it
+           may already be writing to this one */
+        if (&buffer.slots[buffer.current.load()] == &slot)
+          return slot;
+
+        slot.readers.fetch_sub(1, std::memory_order_release);
+        buffer.counters.read_retries.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+  public:
+    explicit Lease(const SnapshotBuffer &buffer) noexcept
+      :slot(Pin(buffer)) {}
+
+    Lease(const Lease &) = delete;
+
+    ~Lease() noexcept {
+      slot.readers.fetch_sub(1, std::memory_order_release);
+    }
+
+    operator const T&() const noexcept {
+      return slot.value;
+    }
+
+    const T *operator->() const noexcept {
+      return &slot.value;
+    }
+  };
+
+  /**
+   * Returns a number which is incremented by each Publish() call.
+   */
+  unsigned GetVersion() const noexcept {
+    return version.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Publish a new value.  Must only be called by one thread at a
+   * time.
+   */
+  void Publish(const T &value) noexcept {
+    const unsigned old = current.load(std::memory_order_relaxed);
+
+    unsigned i = old;
+    while (true) {
+      i = (i + 1) % N;
+      if (i == old) {
+        /* all other slots are pinned by readers */
+        counters.write_waits.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+        continue;
+      }
+
+      if (slots[i].readers.load() == 0)
+        break;
+    }
+
+    slots[i].value = value;
+    current.store(i);
+    version.fetch_add(1, std::memory_order_release);
+    counters.writes.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Statistics GetStatistics() const noexcept {
+    Statistics s;
+    s.writes = counters.writes.load(std::memory_order_relaxed);
+    s.reads = counters.reads.load(std::memory_order_relaxed);
+    s.read_retries = counters.read_retries.load(std::memory_order_relaxed);
+    s.write_waits = counters.write_waits.load(std::memory_order_relaxed);
+    return s;
+  }
+};
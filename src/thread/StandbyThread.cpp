@@ -24,7 +24,14 @@ StandbyThread::Trigger()
     TriggerCommand();
   else {
     /* start it if it's not running currently */
-    Start();
+    try {
+      Start();
+    } catch (...) {
+      /* nothing will ever clear the flag; IsBusy() would be stuck */
+      pending = false;
+      throw;
+    }
+
     alive = true;
   }
 }
@@ -88,6 +88,14 @@ BufferCanvas::Begin(Canvas &other) noexcept
   assert(!active);
 
   Resize(other.GetSize());
+  Begin();
+}
+
+void
+BufferCanvas::Begin() noexcept
+{
+  assert(IsDefined());
+  assert(!active);
 
   /* activate the frame buffer */
   frame_buffer->Bind();
@@ -131,10 +139,20 @@ BufferCanvas::Begin(Canvas &other) noexcept
 void
 BufferCanvas::Commit(Canvas &other) noexcept
 {
-  assert(IsDefined());
-  assert(active);
   assert(GetWidth() == other.GetWidth());
   assert(GetHeight() == other.GetHeight());
+
+  Commit();
+
+  /* copy frame buffer to screen */
+  CopyTo(other);
+}
+
+void
+BufferCanvas::Commit() noexcept
+{
+  assert(IsDefined());
+  assert(active);
   assert(frame_buffer != nullptr);
 
   assert(OpenGL::translate.x == 0);
@@ -161,9 +179,6 @@ BufferCanvas::Commit(Canvas &other) noexcept
   OpenGL::display_orientation = old_orientation;
 #endif
 
-  /* copy frame buffer to screen */
-  CopyTo(other);
-
 #ifndef NDEBUG
   active = false;
 #endif
@@ -180,3 +195,15 @@ BufferCanvas::CopyTo(Canvas &other) noexcept
   texture->Bind();
   texture->Draw(other.GetRect(), GetRect());
 }
+
+void
+BufferCanvas::CopyTo(std::span<const BulkPixelPoint, 4> corners) noexcept
+{
+  assert(IsDefined());
+  assert(frame_buffer != nullptr);
+
+  OpenGL::texture_shader->Use();
+
+  texture->Bind();
+  texture->Draw(corners, GetRect());
+}
@@ -5,10 +5,13 @@
 
 #include "Canvas.hpp"
 #include "Math/Point2D.hpp"
+#include "ui/dim/BulkPoint.hpp"
 #include "ui/opengl/Features.hpp" // for SOFTWARE_ROTATE_DISPLAY
 
 #include <glm/mat4x4.hpp>
 
+#include <span>
+
 #ifdef SOFTWARE_ROTATE_DISPLAY
 #include <cstdint>
 enum class DisplayOrientation : uint8_t;
@@ -96,5 +99,25 @@ public:
    */
   void Commit(Canvas &other) noexcept;
 
+  /**
+   * Begin painting to the buffer only, keeping its size.  Unlike
+   * Begin(Canvas &), the buffer may be larger than the screen.
+   * Call Commit() when done.
+   */
+  void Begin() noexcept;
+
+  /**
+   * Finish painting started with Begin().  Nothing is copied to the
+   * screen; use CopyTo() for that.
+   */
+  void Commit() noexcept;
+
   void CopyTo(Canvas &other) noexcept;
+
+  /**
+   * Draw the whole buffer to the current frame buffer, mapping its
+   * corners to the given (possibly rotated) positions: top left, top
+   * right, bottom left, bottom right.
+   */
+  void CopyTo(std::span<const BulkPixelPoint, 4> corners) noexcept;
 };
@@ -133,7 +133,14 @@ GLTexture::Draw(PixelRect dest, PixelRect src) const noexcept
     dest.GetBottomRight(),
   };
 
-  const ScopeVertexPointer vp(vertices);
+  Draw(vertices, src);
+}
+
+void
+GLTexture::Draw(std::span<const BulkPixelPoint, 4> dest,
+                PixelRect src) const noexcept
+{
+  const ScopeVertexPointer vp(dest.data());
 
   const PixelSize allocated = GetAllocatedSize();
   GLfloat x0 = (GLfloat)src.left / allocated.width;
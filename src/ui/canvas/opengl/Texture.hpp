@@ -5,9 +5,11 @@
 
 #include "ui/opengl/System.hpp"
 #include "ui/dim/Rect.hpp"
+#include "ui/dim/BulkPoint.hpp"
 #include "FBO.hpp"
 
 #include <cassert>
+#include <span>
 
 /**
  * This class represents an OpenGL texture.
@@ -107,6 +109,15 @@ public:
 
   void Draw(PixelRect dest, PixelRect src) const noexcept;
 
+  /**
+   * Draw the #src rectangle to a (possibly rotated) quadrilateral.
+   *
+   * @param dest the destination corners: top left, top right,
+   * bottom left, bottom right
+   */
+  void Draw(std::span<const BulkPixelPoint, 4> dest,
+            PixelRect src) const noexcept;
+
   void Draw(PixelPoint dest) const noexcept {
     Draw(PixelRect(dest, GetSize()), GetRect());
   }
@@ -0,0 +1,495 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+
+/**
+ * An R-tree of points which is built in one pass ("bulk loading")
+ * with the Sort-Tile-Recursive algorithm.  All values are stored in
+ * one array, sorted so that the values of each leaf node are
+ * adjacent, and all nodes are stored in another array.  A copy of
+ * each position is kept in a third array, so searching does not need
+ * to dereference the values.  Building the tree sorts all values,
+ * which costs more than inserting them into a #QuadTree, but
+ * searching it is cache-friendly.
+ *
+ * The tree is not updated incrementally.  New values are appended to
+ * an unindexed tail which is searched linearly; removing or moving an
+ * indexed value drops the whole index.  Optimise() rebuilds the tree
+ * from all values.  This fits data which is loaded in bulk and
+ * modified rarely.
+ *
+ * The #Accessor class provides the methods GetX() and GetY() which
+ * return the position of a value.
+ */
+template<typename T, typename Accessor>
+class PackedRTree {
+	/**
+	 * The maximum number of children of a node.
+	 */
+	static constexpr std::size_t FANOUT = 16;
+
+public:
+	typedef int position_type;
+	typedef unsigned distance_type;
+
+	/**
+	 * 64 bit, because the square of a 32 bit distance may not fit
+	 * in #distance_type.
+	 */
+	typedef std::uint64_t square_distance_type;
+
+	using const_iterator = typename std::vector<T>::const_iterator;
+
+	/**
+	 * A location on the plane.
+	 */
+	struct Point {
+		position_type x, y;
+
+		constexpr
+		Point(position_type _x, position_type _y) noexcept
+			:x(_x), y(_y) {}
+
+		constexpr
+		square_distance_type SquareDistanceTo(const Point &other) const noexcept {
+			return Square(std::int64_t(other.x) - x) +
+				Square(std::int64_t(other.y) - y);
+		}
+	};
+
+private:
+	/**
+	 * A rectangle on the plane that is parallel to the X and Y axes.
+	 */
+	struct Rectangle {
+		position_type left, top, right, bottom;
+
+		constexpr
+		explicit Rectangle(const Point &p) noexcept
+			:left(p.x), top(p.y), right(p.x), bottom(p.y) {}
+
+		constexpr
+		void Extend(const Rectangle &other) noexcept {
+			left = std::min(left, other.left);
+			top = std::min(top, other.top);
+			right = std::max(right, other.right);
+			bottom = std::max(bottom, other.bottom);
+		}
+
+		constexpr
+		Point GetMiddle() const noexcept {
+			return Point(left + (right - left) / 2,
+				     top + (bottom - top) / 2);
+		}
+
+		/**
+		 * Calculate the square distance from the specified point to
+		 * the nearest point of this rectangle; zero if the point is
+		 * inside.
+		 */
+		constexpr
+		square_distance_type SquareDistanceTo(const Point &p) const noexcept {
+			const std::int64_t dx = p.x < left
+				? std::int64_t(left) - p.x
+				: (p.x > right ? std::int64_t(p.x) - right : 0);
+			const std::int64_t dy = p.y < top
+				? std::int64_t(top) - p.y
+				: (p.y > bottom ? std::int64_t(p.y) - bottom : 0);
+			return square_distance_type(dx * dx) + square_distance_type(dy * dy);
+		}
+	};
+
+	struct Node {
+		Rectangle bounds;
+
+		/**
+		 * The index of the first child in #nodes (or in #values for
+		 * leaf nodes) and the number of children.
+		 */
+		std::uint32_t first, count;
+	};
+
+	/**
+	 * All values; the first #n_indexed are sorted in tree order, the
+	 * rest is the unindexed tail.
+	 */
+	std::vector<T> values;
+
+	/**
+	 * The positions of the first #n_indexed values.
+	 */
+	std::vector<Point> positions;
+
+	/**
+	 * All nodes: first the leaf nodes (which refer to #values), then
+	 * each upper level; the last one is the root.  Empty if there is
+	 * no index.
+	 */
+	std::vector<Node> nodes;
+
+	std::size_t n_indexed = 0;
+	std::size_t n_leaf_nodes = 0;
+
+	[[no_unique_address]] Accessor accessor;
+
+public:
+	PackedRTree() = default;
+
+	PackedRTree(const PackedRTree &) = delete;
+	PackedRTree &operator=(const PackedRTree &) = delete;
+
+	static constexpr square_distance_type Square(std::int64_t x) noexcept {
+		return square_distance_type(x * x);
+	}
+
+	constexpr Point GetPosition(const T &value) const noexcept {
+		return Point(accessor.GetX(value), accessor.GetY(value));
+	}
+
+	bool IsEmpty() const noexcept {
+		return values.empty();
+	}
+
+	std::size_t size() const noexcept {
+		return values.size();
+	}
+
+	const_iterator begin() const noexcept {
+		return values.begin();
+	}
+
+	const_iterator end() const noexcept {
+		return values.end();
+	}
+
+	/**
+	 * Are all values indexed, i.e. is there nothing to do for
+	 * Optimise()?
+	 */
+	bool IsOptimised() const noexcept {
+		return n_indexed == values.size();
+	}
+
+	void clear() noexcept {
+		values.clear();
+		DropIndex();
+	}
+
+	/**
+	 * Append a value to the unindexed tail.
+	 */
+	template<typename U>
+	void Add(U &&value) noexcept {
+		values.emplace_back(std::forward<U>(value));
+	}
+
+	void erase(const_iterator it) noexcept {
+		if (IsIndexed(it))
+			DropIndex();
+
+		values.erase(it);
+	}
+
+	/**
+	 * Erase all values that match the specified predicate.  The
+	 * predicate is invoked exactly once for each value.
+	 */
+	template<class P>
+	void EraseIf(const P &predicate) noexcept {
+		auto dest = values.begin();
+		bool drop = false;
+		for (auto i = values.begin(); i != values.end(); ++i) {
+			if (predicate(std::as_const(*i))) {
+				drop |= IsIndexed(i);
+				continue;
+			}
+
+			if (dest != i)
+				*dest = std::move(*i);
+			++dest;
+		}
+
+		values.erase(dest, values.end());
+
+		if (drop)
+			DropIndex();
+	}
+
+	/**
+	 * Replace the value.  If it is indexed and its position has been
+	 * modified, then the index is dropped.
+	 */
+	template<typename U>
+	void Replace(const_iterator it, U &&value) noexcept {
+		auto &dest = values[std::distance(begin(), it)];
+		const Point old_position = GetPosition(dest);
+		dest = std::forward<U>(value);
+
+		if (IsIndexed(it)) {
+			const Point new_position = GetPosition(dest);
+			if (new_position.x != old_position.x ||
+			    new_position.y != old_position.y)
+				DropIndex();
+		}
+	}
+
+	/**
+	 * Build the index for all values (if not already done).  This
+	 * reorders the values and invalidates all iterators.
+	 */
+	void Optimise() noexcept {
+		if (IsOptimised())
+			return;
+
+		Build();
+	}
+
+	/**
+	 * Build the index for all values, even if they are already
+	 * indexed.  This must be called after the position of indexed
+	 * values has been modified.  This reorders the values and
+	 * invalidates all iterators.
+	 */
+	void Build() noexcept {
+		DropIndex();
+
+		if (values.empty())
+			return;
+
+		/* sort (position, index) pairs instead of the values, which
+		   would need to be dereferenced for each comparison */
+		struct Entry {
+			Point position;
+			std::uint32_t index;
+		};
+
+		std::vector<Entry> entries;
+		entries.reserve(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+			entries.push_back({GetPosition(values[i]), std::uint32_t(i)});
+
+		SortTiles(std::span{entries}, [](const Entry &entry){
+			return entry.position;
+		});
+
+		std::vector<T> sorted;
+		sorted.reserve(values.size());
+		positions.reserve(values.size());
+		for (const auto &entry : entries) {
+			sorted.emplace_back(std::move(values[entry.index]));
+			positions.push_back(entry.position);
+		}
+
+		values = std::move(sorted);
+
+		for (std::size_t i = 0; i < values.size(); i += FANOUT) {
+			const std::size_t count = std::min(FANOUT, values.size() - i);
+			Rectangle bounds(positions[i]);
+			for (std::size_t j = 1; j < count; ++j)
+				bounds.Extend(Rectangle(positions[i + j]));
+
+			nodes.push_back({bounds, std::uint32_t(i), std::uint32_t(count)});
+		}
+
+		n_indexed = values.size();
+		n_leaf_nodes = nodes.size();
+
+		/* build the upper levels until there is only the root */
+		for (std::size_t level = 0; nodes.size() - level > 1;) {
+			const std::size_t level_end = nodes.size();
+
+			SortTiles(std::span{nodes}.subspan(level, level_end - level),
+				  [](const Node &node){
+					  return node.bounds.GetMiddle();
+				  });
+
+			for (std::size_t i = level; i < level_end; i += FANOUT) {
+				const std::size_t count = std::min(FANOUT, level_end - i);
+				Rectangle bounds = nodes[i].bounds;
+				for (std::size_t j = 1; j < count; ++j)
+					bounds.Extend(nodes[i + j].bounds);
+
+				nodes.push_back({bounds, std::uint32_t(i), std::uint32_t(count)});
+			}
+
+			level = level_end;
+		}
+	}
+
+	/**
+	 * Find the value nearest to the specified location which
+	 * matches the predicate.
+	 *
+	 * @return end() if there is no such value within the range
+	 */
+	template<class P>
+	[[gnu::pure]]
+	const_iterator FindNearestIf(const Point location, distance_type range,
+				     const P &predicate) const noexcept {
+		const T *nearest = nullptr;
+		square_distance_type nearest_square_distance = Square(range);
+
+		if (!nodes.empty() &&
+		    nodes.back().bounds.SquareDistanceTo(location) <= nearest_square_distance)
+			FindNearestIf(nodes.size() - 1, location, predicate,
+				      nearest, nearest_square_distance);
+
+		for (const auto &value : GetTail())
+			CheckNearest(value, location, predicate,
+				     nearest, nearest_square_distance);
+
+		if (nearest == nullptr)
+			return end();
+
+		return std::next(begin(), nearest - values.data());
+	}
+
+	[[gnu::pure]]
+	const_iterator FindNearest(const Point location,
+				   distance_type range) const noexcept {
+		return FindNearestIf(location, range, [](const T &){ return true; });
+	}
+
+	/**
+	 * Invoke the visitor for each value within the specified range.
+	 */
+	template<class V>
+	void VisitWithinRange(const Point location, distance_type range,
+			      V &visitor) const {
+		const square_distance_type square_range = Square(range);
+
+		if (!nodes.empty() &&
+		    nodes.back().bounds.SquareDistanceTo(location) <= square_range)
+			VisitWithinRange(nodes.size() - 1, location, square_range,
+					 visitor);
+
+		for (const auto &value : GetTail())
+			if (GetPosition(value).SquareDistanceTo(location) <= square_range)
+				visitor(value);
+	}
+
+private:
+	bool IsIndexed(const_iterator it) const noexcept {
+		return std::size_t(std::distance(begin(), it)) < n_indexed;
+	}
+
+	std::span<const T> GetTail() const noexcept {
+		return std::span{values}.subspan(n_indexed);
+	}
+
+	void DropIndex() noexcept {
+		positions.clear();
+		nodes.clear();
+		n_indexed = n_leaf_nodes = 0;
+	}
+
+	/**
+	 * Sort the items in "Sort-Tile-Recursive" order: sort them by X,
+	 * cut them into vertical slices, and sort each slice by Y.  Then
+	 * each run of #FANOUT items is a compact tile.
+	 */
+	template<typename I, typename F>
+	static void SortTiles(std::span<I> items, F get_position) noexcept {
+		const std::size_t n_tiles = (items.size() + FANOUT - 1) / FANOUT;
+		const std::size_t n_slices =
+			std::ceil(std::sqrt(double(n_tiles)));
+		const std::size_t slice_size =
+			(n_tiles + n_slices - 1) / n_slices * FANOUT;
+
+		std::sort(items.begin(), items.end(),
+			  [&get_position](const I &a, const I &b){
+				  return get_position(a).x < get_position(b).x;
+			  });
+
+		for (std::size_t i = 0; i < items.size(); i += slice_size) {
+			const auto slice =
+				items.subspan(i, std::min(slice_size, items.size() - i));
+			std::sort(slice.begin(), slice.end(),
+				  [&get_position](const I &a, const I &b){
+					  return get_position(a).y < get_position(b).y;
+				  });
+		}
+	}
+
+	template<class P>
+	void CheckNearest(const T &value, const Point location,
+			  const P &predicate, const T *&nearest,
+			  square_distance_type &nearest_square_distance) const noexcept {
+		const auto square_distance = GetPosition(value).SquareDistanceTo(location);
+		if (square_distance <= nearest_square_distance && predicate(value)) {
+			nearest_square_distance = square_distance;
+			nearest = &value;
+		}
+	}
+
+	template<class P>
+	void FindNearestIf(std::size_t i, const Point location,
+			   const P &predicate, const T *&nearest,
+			   square_distance_type &nearest_square_distance) const noexcept {
+		const Node &node = nodes[i];
+
+		if (i < n_leaf_nodes) {
+			for (std::size_t j = node.first; j < node.first + node.count; ++j) {
+				const auto square_distance = positions[j].SquareDistanceTo(location);
+				if (square_distance <= nearest_square_distance &&
+				    predicate(values[j])) {
+					nearest_square_distance = square_distance;
+					nearest = &values[j];
+				}
+			}
+
+			return;
+		}
+
+		/* visit the nearest children first, to shrink the search
+		   range quickly */
+		std::array<std::pair<square_distance_type, std::uint32_t>, FANOUT> children;
+		std::size_t n = 0;
+		for (std::uint32_t c = node.first; c < node.first + node.count; ++c) {
+			const auto square_distance = nodes[c].bounds.SquareDistanceTo(location);
+			if (square_distance <= nearest_square_distance)
+				children[n++] = {square_distance, c};
+		}
+
+		std::sort(children.begin(), std::next(children.begin(), n));
+
+		for (const auto &[square_distance, c] : std::span{children}.first(n)) {
+			if (square_distance > nearest_square_distance)
+				break;
+
+			FindNearestIf(c, location, predicate,
+				      nearest, nearest_square_distance);
+		}
+	}
+
+	template<class V>
+	void VisitWithinRange(std::size_t i, const Point location,
+			      square_distance_type square_range,
+			      V &visitor) const {
+		const Node &node = nodes[i];
+
+		if (i < n_leaf_nodes) {
+			for (std::size_t j = node.first; j < node.first + node.count; ++j)
+				if (positions[j].SquareDistanceTo(location) <= square_range)
+					visitor(values[j]);
+			return;
+		}
+
+		for (std::uint32_t c = node.first; c < node.first + node.count; ++c)
+			if (nodes[c].bounds.SquareDistanceTo(location) <= square_range)
+				VisitWithinRange(c, location, square_range, visitor);
+	}
+};
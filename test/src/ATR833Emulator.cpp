@@ -74,7 +74,7 @@ ATR833Emulator::Handle(std::span<const std::byte> src) noexcept
     return 1;
 }
 
-bool ATR833Emulator::DataReceived(std::span<const std::byte> s) noexcept
+bool ATR833Emulator::DataReceived(std::span<const std::byte> s, bool) noexcept
 {
   do {
     const auto nbytes = buffer.MoveFrom(s);
@@ -25,5 +25,6 @@ private:
   std::size_t Handle(std::span<const std::byte> src) noexcept;
 
 protected:
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
 };
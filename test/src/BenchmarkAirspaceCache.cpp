@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program compares the cold start of the airspace database from
+ * an OpenAir/TNP text file with loading it from the binary cache (see
+ * AirspaceCache.hpp).  Both include Airspaces::Optimise(), i.e.
+ * building the search tree.
+ *
+ * It verifies that both ways produce the same airspaces.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr unsigned RUNS = 20;
+
+static void
+LoadText(Airspaces &airspaces, Path path)
+{
+  FileReader file_reader{path};
+  BufferedReader buffered_reader{file_reader};
+  ParseAirspaceFile(airspaces, buffered_reader);
+}
+
+static bool
+Equals(const AirspaceAltitude &a, const AirspaceAltitude &b) noexcept
+{
+  return a.altitude == b.altitude && a.flight_level == b.flight_level &&
+    a.altitude_above_terrain == b.altitude_above_terrain &&
+    a.reference == b.reference;
+}
+
+static bool
+Equals(TransponderCode a, TransponderCode b) noexcept
+{
+  return a.IsDefined()
+    ? b.IsDefined() && a.GetCode() == b.GetCode()
+    : !b.IsDefined();
+}
+
+static bool
+Equals(const AbstractAirspace &a, const AbstractAirspace &b) noexcept
+{
+  if (a.GetShape() != b.GetShape() ||
+      !StringIsEqual(a.GetName(), b.GetName()) ||
+      !StringIsEqual(a.GetStationName(), b.GetStationName()) ||
+      a.GetClass() != b.GetClass() || a.GetType() != b.GetType() ||
+      !Equals(a.GetBase(), b.GetBase()) || !Equals(a.GetTop(), b.GetTop()) ||
+      a.GetRadioFrequency() != b.GetRadioFrequency() ||
+      !Equals(a.GetTransponderCode(), b.GetTransponderCode()) ||
+      !a.GetDays().equals(b.GetDays()))
+    return false;
+
+  const auto &pa = a.GetPoints(), &pb = b.GetPoints();
+  if (pa.size() != pb.size())
+    return false;
+
+  for (std::size_t i = 0; i < pa.size(); ++i)
+    if (pa[i].GetLocation() != pb[i].GetLocation())
+      return false;
+
+  return true;
+}
+
+static bool
+Compare(const Airspaces &a, const Airspaces &b) noexcept
+{
+  if (a.GetSize() != b.GetSize())
+    return false;
+
+  /* both trees were bulk-loaded from the same airspaces in the same
+     order, so they have the same layout */
+  const auto range = b.QueryAll();
+  auto j = range.begin();
+  for (const auto &i : a.QueryAll()) {
+    if (!Equals(i.GetAirspace(), j->GetAirspace()))
+      return false;
+
+    ++j;
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.txt");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  char cache_dir[] = "/tmp/BenchmarkAirspaceCache.XXXXXX";
+  if (mkdtemp(cache_dir) == nullptr) {
+    perror("mkdtemp() failed");
+    return EXIT_FAILURE;
+  }
+
+  FileCache cache{AllocatedPath{cache_dir}};
+
+  Duration text{}, save{}, load{};
+
+  Airspaces text_airspaces;
+  for (unsigned run = 0; run < RUNS; ++run) {
+    text_airspaces.Clear();
+
+    const auto start = std::chrono::steady_clock::now();
+    LoadText(text_airspaces, path);
+    text_airspaces.Optimise();
+    text += std::chrono::steady_clock::now() - start;
+  }
+
+  {
+    Airspaces airspaces;
+    LoadText(airspaces, path);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto &pending = airspaces.GetPending();
+    SaveAirspaceCache(cache, path, pending.begin(), pending.end());
+    save = std::chrono::steady_clock::now() - start;
+  }
+
+  Airspaces cache_airspaces;
+  for (unsigned run = 0; run < RUNS; ++run) {
+    cache_airspaces.Clear();
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!LoadAirspaceCache(cache, path, cache_airspaces)) {
+      fprintf(stderr, "Cache not found\n");
+      return EXIT_FAILURE;
+    }
+    cache_airspaces.Optimise();
+    load += std::chrono::steady_clock::now() - start;
+  }
+
+  const bool equal = Compare(text_airspaces, cache_airspaces);
+
+  printf("%u airspaces %s\n", unsigned(text_airspaces.GetSize()),
+         equal ? "identical" : "DIFFERENT");
+  printf("  text  %8.3f ms\n", text.count() * 1000 / RUNS);
+  printf("  cache %8.3f ms (saving took %.3f ms)\n",
+         load.count() * 1000 / RUNS, save.count() * 1000);
+
+  struct DeleteVisitor final : File::Visitor {
+    void Visit(Path p, Path) override {
+      File::Delete(p);
+    }
+  } delete_visitor;
+  Directory::VisitFiles(Path{cache_dir}, delete_visitor);
+  rmdir(cache_dir);
+
+  return equal ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program loads an airspace file and measures the
+ * point-in-polygon and segment intersection tests of all polygons
+ * which are large enough to get a #PolygonIndex, comparing them with
+ * the plain scalar code:
+ *
+ * - "inside": AbstractAirspace::Inside() for random points within
+ *   the polygon's bounds
+ * - "intersects": AbstractAirspace::Intersects() for random segments
+ *   of up to 20 km starting within the polygon's bounds
+ *
+ * It verifies that both produce exactly the same results.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Airspace/AirspaceIntersectSort.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVector.hpp"
+#include "Geo/PolygonIndex.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/Flat/FlatRay.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr unsigned N_QUERIES = 2000;
+
+/**
+ * The scalar version of AirspacePolygon::Intersects(), without the
+ * #PolygonIndex.
+ */
+static AirspaceIntersectionVector
+ScalarIntersects(const AbstractAirspace &airspace,
+                 const GeoPoint &start, const GeoPoint &end,
+                 const FlatProjection &projection) noexcept
+{
+  const FlatRay ray(projection.ProjectInteger(start),
+                    projection.ProjectInteger(end));
+
+  AirspaceIntersectSort sorter(start, airspace);
+
+  const auto &border = airspace.GetPoints();
+  for (auto it = border.begin(); it + 1 != border.end(); ++it) {
+    const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
+    auto t = ray.DistinctIntersection(r_seg);
+    if (t >= 0)
+      sorter.add(t, projection.Unproject(ray.Parametric(t)));
+  }
+
+  return sorter.all();
+}
+
+struct Result {
+  Duration scalar{}, indexed{};
+  unsigned n = 0, mismatches = 0;
+
+  void Print(const char *name, const char *unit_name,
+             double unit) const noexcept {
+    printf("  %-10s scalar %8.3f %s  indexed %8.3f %s  (%u queries, %u mismatches)\n",
+           name, scalar.count() * unit / n, unit_name,
+           indexed.count() * unit / n, unit_name, n, mismatches);
+  }
+};
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.txt");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  Airspaces airspaces;
+
+  {
+    FileReader file_reader{path};
+    BufferedReader buffered_reader{file_reader};
+    ParseAirspaceFile(airspaces, buffered_reader);
+  }
+
+  airspaces.Optimise();
+
+  const auto &projection = airspaces.GetProjection();
+
+  std::mt19937 random;
+  std::uniform_real_distribution<double> random_ratio(0, 1);
+  std::uniform_real_distribution<double> random_distance(0, 20000);
+
+  Result inside, intersects;
+  unsigned n_polygons = 0, n_vertices = 0;
+  unsigned checksum = 0;
+
+  for (const auto &i : airspaces.QueryAll()) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    if (airspace.GetShape() != AbstractAirspace::Shape::POLYGON ||
+        airspace.GetPoints().size() < PolygonIndex::MIN_SIZE)
+      continue;
+
+    ++n_polygons;
+    n_vertices += airspace.GetPoints().size();
+
+    const GeoBounds bounds = airspace.GetGeoBounds();
+    const auto RandomPoint = [&](){
+      return GeoPoint(bounds.GetWest() +
+                      (bounds.GetEast() - bounds.GetWest()) * random_ratio(random),
+                      bounds.GetSouth() +
+                      (bounds.GetNorth() - bounds.GetSouth()) * random_ratio(random));
+    };
+
+    std::vector<GeoPoint> points, ends;
+    for (unsigned j = 0; j < N_QUERIES; ++j) {
+      points.push_back(RandomPoint());
+      ends.push_back(GeoVector(random_distance(random),
+                               Angle::FullCircle() * random_ratio(random))
+                     .EndPoint(points.back()));
+    }
+
+    /* point-in-polygon */
+
+    std::vector<bool> expected_inside;
+    expected_inside.reserve(N_QUERIES);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &p : points)
+      expected_inside.push_back(airspace.GetPoints().IsInside(p));
+    inside.scalar += std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned j = 0; j < N_QUERIES; ++j) {
+      const bool result = airspace.Inside(points[j]);
+      checksum += result;
+      if (result != expected_inside[j])
+        ++inside.mismatches;
+    }
+    inside.indexed += std::chrono::steady_clock::now() - start;
+    inside.n += N_QUERIES;
+
+    /* segment intersection */
+
+    std::vector<AirspaceIntersectionVector> expected_intersects;
+    expected_intersects.reserve(N_QUERIES);
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned j = 0; j < N_QUERIES; ++j)
+      expected_intersects.push_back(ScalarIntersects(airspace,
+                                                     points[j], ends[j],
+                                                     projection));
+    intersects.scalar += std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned j = 0; j < N_QUERIES; ++j) {
+      const auto result = airspace.Intersects(points[j], ends[j], projection);
+      checksum += result.size();
+      if (result != expected_intersects[j])
+        ++intersects.mismatches;
+    }
+    intersects.indexed += std::chrono::steady_clock::now() - start;
+    intersects.n += N_QUERIES;
+  }
+
+  if (n_polygons == 0) {
+    fprintf(stderr, "No polygon with at least %u vertices\n",
+            unsigned(PolygonIndex::MIN_SIZE));
+    return EXIT_FAILURE;
+  }
+
+  printf("%u polygons with %u vertices (checksum %u)\n",
+         n_polygons, n_vertices, checksum);
+  inside.Print("inside", "us", 1e6);
+  intersects.Print("intersects", "us", 1e6);
+
+  return inside.mismatches == 0 && intersects.mismatches == 0
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program replays an IGC file through two
+ * #AirspaceWarningManager instances, one checking all candidates in
+ * every update, the other one with time slicing (with the given
+ * evaluation budget), and compares their performance and warnings.
+ *
+ * "delayed" counts the updates in which a warning reported by the
+ * reference manager was missing in the time-sliced one; "extra"
+ * counts the opposite.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Task/Stats/TaskStats.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Atmosphere/Pressure.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "Geo/GeoVector.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/FileLineReader.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Duration = std::chrono::duration<double>;
+
+struct Fix {
+  AircraftState state;
+  bool circling;
+};
+
+static std::vector<Fix>
+LoadFixes(Path path)
+{
+  FileLineReaderA reader(path);
+  IGCExtensions extensions;
+  extensions.clear();
+
+  std::vector<Fix> fixes;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix)) {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    if (!fix.gps_valid)
+      continue;
+
+    Fix f{};
+    AircraftState &state = f.state;
+    state.time = TimeStamp{fix.time.DurationSinceMidnight()};
+    state.location = fix.location;
+    state.altitude = fix.gps_altitude;
+    state.flying = true;
+
+    if (!fixes.empty()) {
+      const AircraftState &last = fixes.back().state;
+      const auto dt = (state.time - last.time).count();
+      if (dt <= 0)
+        continue;
+
+      const GeoVector vector(last.location, state.location);
+      state.ground_speed = state.true_airspeed = vector.distance / dt;
+      state.track = vector.distance > 1 ? vector.bearing : last.track;
+      state.vario = state.netto_vario = (state.altitude - last.altitude) / dt;
+
+      /* a rough circling detection: turning faster than 6 degrees
+         per second */
+      f.circling = (state.track - last.track).AsDelta().Absolute() >
+        Angle::Degrees(6 * dt);
+    }
+
+    fixes.push_back(f);
+  }
+
+  return fixes;
+}
+
+struct Run {
+  AirspaceWarningManager manager;
+  const bool time_slicing;
+  Duration duration{}, worst_duration{};
+  unsigned n_evaluations = 0, max_evaluations = 0;
+
+  Run(const AirspaceWarningConfig &config, const Airspaces &airspaces,
+      bool _time_slicing, unsigned budget) noexcept
+    :manager(config, airspaces), time_slicing(_time_slicing) {
+    manager.SetTimeSlicing(time_slicing, budget);
+  }
+
+  void Update(const Fix &fix, const GlidePolar &glide_polar,
+              const TaskStats &task_stats,
+              std::chrono::duration<unsigned> dt) noexcept {
+    const auto start = std::chrono::steady_clock::now();
+    manager.Update(fix.state, glide_polar, task_stats, fix.circling, dt);
+    const Duration d = std::chrono::steady_clock::now() - start;
+    duration += d;
+    worst_duration = std::max(worst_duration, d);
+
+    /* the statistics are only maintained with time slicing */
+    if (time_slicing) {
+      const unsigned n = manager.GetStatistics().evaluations;
+      n_evaluations += n;
+      max_evaluations = std::max(max_evaluations, n);
+    }
+  }
+
+  /**
+   * Returns the current warnings, sorted.
+   */
+  std::vector<std::pair<const AbstractAirspace *, AirspaceWarning::State>>
+  GetWarnings() const noexcept {
+    std::vector<std::pair<const AbstractAirspace *, AirspaceWarning::State>> v;
+    for (const auto &w : manager)
+      if (w.IsWarning())
+        v.emplace_back(&w.GetAirspace(), w.GetWarningState());
+    std::sort(v.begin(), v.end());
+    return v;
+  }
+
+  void Print(const char *name, unsigned n_updates) const noexcept {
+    printf("  %-10s %8.3f ms total  %6.1f us/update  worst update %.0f us\n",
+           name, duration.count() * 1000,
+           duration.count() * 1e6 / n_updates,
+           worst_duration.count() * 1e6);
+
+    if (time_slicing)
+      printf("             evaluations avg %.1f max %u  worst age %.0f s\n",
+             double(n_evaluations) / n_updates, max_evaluations,
+             manager.GetStatistics().worst_age.count());
+  }
+};
+
+static bool
+Includes(const std::vector<std::pair<const AbstractAirspace *, AirspaceWarning::State>> &a,
+         const std::vector<std::pair<const AbstractAirspace *, AirspaceWarning::State>> &b) noexcept
+{
+  return std::includes(a.begin(), a.end(), b.begin(), b.end());
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "AIRSPACE.txt FILE.igc [BUDGET]");
+  const auto airspace_path = args.ExpectNextPath();
+  const auto igc_path = args.ExpectNextPath();
+  const unsigned budget = args.IsEmpty()
+    ? AirspaceWarningManager::DEFAULT_EVALUATION_BUDGET
+    : strtoul(args.GetNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  Airspaces airspaces;
+
+  {
+    FileReader file_reader{airspace_path};
+    BufferedReader buffered_reader{file_reader};
+    ParseAirspaceFile(airspaces, buffered_reader);
+  }
+
+  airspaces.Optimise();
+  airspaces.SetFlightLevels(AtmosphericPressure::Standard());
+
+  const auto fixes = LoadFixes(igc_path);
+  if (fixes.size() < 2) {
+    fprintf(stderr, "No fixes found\n");
+    return EXIT_FAILURE;
+  }
+
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+
+  const GlidePolar glide_polar(1);
+
+  TaskStats task_stats;
+  task_stats.reset();
+
+  Run reference(config, airspaces, false, 0);
+  Run sliced(config, airspaces, true, budget);
+
+  reference.manager.Reset(fixes.front().state);
+  sliced.manager.Reset(fixes.front().state);
+
+  unsigned n_updates = 0, n_warnings = 0, n_delayed = 0, n_extra = 0;
+
+  for (auto i = std::next(fixes.begin()); i != fixes.end(); ++i) {
+    const auto dt = std::chrono::duration_cast<std::chrono::duration<unsigned>>(i->state.time - std::prev(i)->state.time);
+
+    reference.Update(*i, glide_polar, task_stats, dt);
+    sliced.Update(*i, glide_polar, task_stats, dt);
+    ++n_updates;
+
+    const auto expected = reference.GetWarnings();
+    const auto actual = sliced.GetWarnings();
+    if (!expected.empty())
+      ++n_warnings;
+    if (!Includes(actual, expected))
+      ++n_delayed;
+    if (!Includes(expected, actual))
+      ++n_extra;
+  }
+
+  printf("%u updates, %u with warnings, %u delayed, %u extra (budget %u)\n",
+         n_updates, n_warnings, n_delayed, n_extra, budget);
+  reference.Print("reference", n_updates);
+  sliced.Print("sliced", n_updates);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
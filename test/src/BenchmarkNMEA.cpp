@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program feeds NMEA data through #PortLineSplitter and
+ * #NMEAParser the way a serial port does: in chunks of up to 4096
+ * bytes which are copied into the port's receive buffer first.  It
+ * compares the copying path (read-only buffer) with the in-place
+ * path (writable buffer) and prints the throughput of both in
+ * sentences per second.  Finally, it measures NMEAParser::ParseLine()
+ * alone on the split lines.
+ *
+ * The FILE arguments (e.g. recorded logs of several devices) are
+ * concatenated.  Without them, it uses a synthetic FLARM scenario
+ * (GPS, altitude and FLARM status with 20 traffic targets, mixed with
+ * LX and Vega sentences).
+ */
+
+#include "Device/Util/LineSplitter.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Checksum.hpp"
+#include "system/Args.hpp"
+#include "io/FileLineReader.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr unsigned RUNS = 200;
+static constexpr std::size_t CHUNK_SIZE = 4096;
+
+class ParsingSplitter final : public PortLineSplitter {
+  NMEAParser parser;
+  NMEAInfo info;
+
+public:
+  unsigned lines, parsed;
+
+  void Reset() noexcept {
+    parser.Reset();
+    info.Reset();
+    info.clock = TimeStamp{FloatDuration{1}};
+    info.alive.Update(info.clock);
+    lines = parsed = 0;
+  }
+
+protected:
+  /* virtual methods from class PortLineHandler */
+  bool LineReceived(const char *line) noexcept override {
+    ++lines;
+    if (parser.ParseLine(line, info))
+      ++parsed;
+    return true;
+  }
+};
+
+static void
+AppendSentence(std::string &dest, const char *sentence)
+{
+  char buffer[256];
+  strcpy(buffer, sentence);
+  AppendNMEAChecksum(buffer);
+  dest.append(buffer);
+  dest.append("\r\n");
+}
+
+static std::string
+MakeSyntheticInput()
+{
+  std::string input;
+
+  for (unsigned second = 0; second < 60; ++second) {
+    char buffer[128];
+    sprintf(buffer, "$GPRMC,0823%02u,A,5103.5403,N,00741.5742,E,"
+            "055.3,022.4,230610,000.0,W", second);
+    AppendSentence(input, buffer);
+
+    sprintf(buffer, "$GPGGA,0823%02u,5103.5403,N,00741.5742,E,"
+            "1,08,0.9,420.0,M,47.0,M,,", second);
+    AppendSentence(input, buffer);
+
+    AppendSentence(input, "$PGRMZ,1378,F,2");
+    AppendSentence(input, "$PFLAU,3,1,2,1,1,-30,2,-32,755,1234");
+    AppendSentence(input, "$LXWP0,Y,222.3,1665.5,1.71,,,,,,239,174,10.1");
+    AppendSentence(input, "$PLXVF,,1.00,0.87,-0.12,-0.25,90.2,244.3,0");
+    AppendSentence(input, "$PDVDV,11,95,1062,762,9252,0");
+
+    for (unsigned i = 0; i < 20; ++i) {
+      sprintf(buffer, "$PFLAA,0,%d,%d,%d,2,DD8F%02X,180,,30,-1.4,1",
+              -1234 + int(i) * 100, 1234 - int(i) * 50, 220 + int(i),
+              i);
+      AppendSentence(input, buffer);
+    }
+  }
+
+  return input;
+}
+
+static void
+LoadInput(std::string &input, Path path)
+{
+  FileLineReaderA reader(path);
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    input.append(line);
+    input.append("\r\n");
+  }
+}
+
+static std::vector<std::string>
+SplitLines(const std::string &input)
+{
+  std::vector<std::string> lines;
+
+  std::size_t position = 0;
+  while (true) {
+    const std::size_t end = input.find("\r\n", position);
+    if (end == input.npos)
+      break;
+
+    lines.emplace_back(input, position, end - position);
+    position = end + 2;
+  }
+
+  return lines;
+}
+
+static Duration
+Measure(ParsingSplitter &splitter, const std::string &input,
+        bool in_place) noexcept
+{
+  std::byte buffer[CHUNK_SIZE];
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned run = 0; run < RUNS; ++run) {
+    for (std::size_t position = 0; position < input.size();) {
+      /* this copy is what the port's read() does */
+      const std::size_t nbytes = std::min(CHUNK_SIZE,
+                                          input.size() - position);
+      memcpy(buffer, input.data() + position, nbytes);
+      position += nbytes;
+
+      splitter.DataReceived({buffer, nbytes}, in_place);
+    }
+  }
+
+  return std::chrono::steady_clock::now() - start;
+}
+
+static Duration
+MeasureParse(const std::vector<std::string> &lines,
+             unsigned &parsed) noexcept
+{
+  NMEAParser parser;
+  NMEAInfo info;
+  info.Reset();
+  info.clock = TimeStamp{FloatDuration{1}};
+  info.alive.Update(info.clock);
+
+  parsed = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned run = 0; run < RUNS; ++run)
+    for (const auto &line : lines)
+      if (parser.ParseLine(line.c_str(), info))
+        ++parsed;
+
+  return std::chrono::steady_clock::now() - start;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[FILE.nmea ...]");
+  std::string input;
+  if (args.IsEmpty())
+    input = MakeSyntheticInput();
+  else
+    while (!args.IsEmpty())
+      LoadInput(input, args.ExpectNextPath());
+
+  if (input.empty()) {
+    fprintf(stderr, "No input\n");
+    return EXIT_FAILURE;
+  }
+
+  ParsingSplitter splitter;
+
+  splitter.Reset();
+  const auto copy = Measure(splitter, input, false);
+  const unsigned copy_lines = splitter.lines, copy_parsed = splitter.parsed;
+
+  splitter.Reset();
+  const auto in_place = Measure(splitter, input, true);
+  const unsigned in_place_lines = splitter.lines,
+    in_place_parsed = splitter.parsed;
+
+  const auto lines = SplitLines(input);
+  unsigned parse_parsed;
+  const auto parse = MeasureParse(lines, parse_parsed);
+
+  const bool equal = copy_lines == in_place_lines &&
+    copy_parsed == in_place_parsed;
+
+  printf("%u bytes, %u sentences, %u parsed %s\n",
+         unsigned(input.size()), copy_lines / RUNS, copy_parsed / RUNS,
+         equal ? "identical" : "DIFFERENT");
+  printf("  copy      %8.3f ms  %10.0f sentences/s\n",
+         copy.count() * 1000 / RUNS, copy_lines / copy.count());
+  printf("  in place  %8.3f ms  %10.0f sentences/s\n",
+         in_place.count() * 1000 / RUNS, in_place_lines / in_place.count());
+  printf("  ParseLine %8.3f ms  %10.0f sentences/s  (%u parsed)\n",
+         parse.count() * 1000 / RUNS, lines.size() * RUNS / parse.count(),
+         parse_parsed / RUNS);
+
+  return equal ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program measures how often the #EventLoop thread wakes up and
+ * how much CPU time it uses while receiving NMEA traffic on several
+ * ports at once, like OpenVario with a few serial devices and a FLARM
+ * and a vario over TCP.
+ *
+ * Each link has a device emulator (#FLARMEmulator or #VegaEmulator)
+ * on one end and a #PortLineSplitter counting the lines on the other.
+ * Serial links are pseudo TTYs, TCP links are socket pairs.  The
+ * emulators only answer requests, so a generator thread writes their
+ * periodic traffic to the device end, one sentence per write.
+ */
+
+#include "FLARMEmulator.hpp"
+#include "VegaEmulator.hpp"
+#include "Device/Port/TTYPort.hpp"
+#include "Device/Port/SocketPort.hpp"
+#include "Device/Util/LineSplitter.hpp"
+#include "NMEA/Checksum.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "event/Call.hxx"
+#include "event/Loop.hxx"
+#include "io/async/AsioThread.hpp"
+#include "net/SocketDescriptor.hxx"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned N_SERIAL = 4, N_TCP = 2;
+static constexpr auto TICK = std::chrono::milliseconds(100);
+
+/**
+ * A #SocketPort on one end of a socket pair.
+ */
+class SocketPairPort final : public SocketPort {
+public:
+  using SocketPort::SocketPort;
+  using SocketPort::OpenIndirect;
+};
+
+class CountingHandler final : public PortLineSplitter {
+public:
+  unsigned lines = 0;
+  std::size_t bytes = 0;
+
+  /* virtual methods from class DataHandler */
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override {
+    bytes += s.size();
+    return PortLineSplitter::DataReceived(s, writable);
+  }
+
+protected:
+  /* virtual methods from class PortLineHandler */
+  bool LineReceived([[maybe_unused]] const char *line) noexcept override {
+    ++lines;
+    return true;
+  }
+};
+
+struct Link {
+  std::unique_ptr<DeviceEmulator> emulator;
+  CountingHandler handler;
+
+  /**
+   * The device end, written by the generator thread.
+   */
+  std::unique_ptr<Port> device_port;
+
+  /**
+   * The receiving end, like the port of a #DeviceDescriptor.
+   */
+  std::unique_ptr<Port> port;
+
+  bool flarm;
+
+  Link(bool _flarm, OperationEnvironment &env) noexcept
+    :flarm(_flarm) {
+    if (flarm)
+      emulator = std::make_unique<FLARMEmulator>();
+    else
+      emulator = std::make_unique<VegaEmulator>();
+
+    emulator->env = &env;
+  }
+};
+
+static void
+OpenSerial(EventLoop &event_loop, Link &link)
+{
+  auto device_port = std::make_unique<TTYPort>(event_loop, nullptr,
+                                               *link.emulator->handler);
+  const char *slave = device_port->OpenPseudo();
+
+  auto port = std::make_unique<TTYPort>(event_loop, nullptr, link.handler);
+  port->Open(slave, 115200);
+
+  link.device_port = std::move(device_port);
+  link.port = std::move(port);
+}
+
+static void
+OpenTCP(EventLoop &event_loop, Link &link)
+{
+  SocketDescriptor a, b;
+  if (!SocketDescriptor::CreateSocketPairNonBlock(AF_LOCAL, SOCK_STREAM, 0,
+                                                  a, b))
+    throw std::runtime_error("socketpair() failed");
+
+  auto device_port = std::make_unique<SocketPairPort>(event_loop, nullptr,
+                                                      *link.emulator->handler);
+  device_port->OpenIndirect(a);
+
+  auto port = std::make_unique<SocketPairPort>(event_loop, nullptr,
+                                               link.handler);
+  port->OpenIndirect(b);
+
+  link.device_port = std::move(device_port);
+  link.port = std::move(port);
+}
+
+static void
+WriteSentence(Port &port, OperationEnvironment &env, const char *sentence)
+{
+  char buffer[256];
+  strcpy(buffer, sentence);
+  AppendNMEAChecksum(buffer);
+  strcat(buffer, "\r\n");
+  port.FullWrite(std::as_bytes(std::span{buffer, strlen(buffer)}),
+                 env, std::chrono::seconds(1));
+}
+
+/**
+ * Write the traffic of one tick.  FLARM sends a position, its status
+ * and 10 traffic targets twice per second, the vario sends its
+ * values 10 times per second and a position once per second.
+ */
+static void
+WriteTick(Link &link, unsigned tick)
+{
+  Port &port = *link.device_port;
+  OperationEnvironment &env = *link.emulator->env;
+  char buffer[128];
+
+  const unsigned second = (tick / 10) % 60;
+
+  if (link.flarm) {
+    if (tick % 5 != 0)
+      return;
+
+    sprintf(buffer, "$GPRMC,0823%02u,A,5103.5403,N,00741.5742,E,"
+            "055.3,022.4,230610,000.0,W", second);
+    WriteSentence(port, env, buffer);
+
+    sprintf(buffer, "$GPGGA,0823%02u,5103.5403,N,00741.5742,E,"
+            "1,08,0.9,420.0,M,47.0,M,,", second);
+    WriteSentence(port, env, buffer);
+
+    WriteSentence(port, env, "$PGRMZ,1378,F,2");
+    WriteSentence(port, env, "$PFLAU,3,1,2,1,1,-30,2,-32,755,1234");
+
+    for (unsigned i = 0; i < 10; ++i) {
+      sprintf(buffer, "$PFLAA,0,%d,%d,%d,2,DD8F%02X,180,,30,-1.4,1",
+              -1234 + int(i) * 100, 1234 - int(i) * 50, 220 + int(i),
+              i);
+      WriteSentence(port, env, buffer);
+    }
+  } else {
+    WriteSentence(port, env, "$PDVDV,11,95,1062,762,9252,0");
+
+    if (tick % 10 == 0) {
+      sprintf(buffer, "$GPRMC,0823%02u,A,5103.5403,N,00741.5742,E,"
+              "055.3,022.4,230610,000.0,W", second);
+      WriteSentence(port, env, buffer);
+    }
+  }
+}
+
+static void
+Generate(std::vector<std::unique_ptr<Link>> &links,
+         unsigned seconds) noexcept
+try {
+  auto next = Clock::now();
+  for (unsigned tick = 0; tick < seconds * 10; ++tick) {
+    for (auto &link : links)
+      WriteTick(*link, tick);
+
+    next += TICK;
+    std::this_thread::sleep_until(next);
+  }
+} catch (...) {
+  PrintException(std::current_exception());
+}
+
+static std::chrono::duration<double>
+ToDuration(const struct timeval &tv) noexcept
+{
+  return std::chrono::seconds(tv.tv_sec) +
+    std::chrono::microseconds(tv.tv_usec);
+}
+
+/**
+ * Obtain the resource usage of the #EventLoop thread.
+ */
+static struct rusage
+GetEventLoopUsage(EventLoop &event_loop)
+{
+  struct rusage usage;
+  BlockingCall(event_loop, [&usage](){
+    getrusage(RUSAGE_THREAD, &usage);
+  });
+  return usage;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[SECONDS]");
+  const unsigned seconds = args.IsEmpty()
+    ? 10
+    : strtoul(args.ExpectNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  if (seconds == 0) {
+    fprintf(stderr, "Invalid duration\n");
+    return EXIT_FAILURE;
+  }
+
+  AsioThread thread;
+  thread.Start();
+  EventLoop &event_loop = thread.GetEventLoop();
+
+  ConsoleOperationEnvironment env;
+
+  std::vector<std::unique_ptr<Link>> links;
+  for (unsigned i = 0; i < N_SERIAL + N_TCP; ++i) {
+    auto &link = *links.emplace_back(std::make_unique<Link>(i % 2 == 0,
+                                                            env));
+    if (i < N_SERIAL)
+      OpenSerial(event_loop, link);
+    else
+      OpenTCP(event_loop, link);
+
+    link.emulator->port = link.device_port.get();
+
+    if (!link.device_port->StartRxThread() || !link.port->StartRxThread()) {
+      fprintf(stderr, "Failed to start the port thread\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  const auto before = GetEventLoopUsage(event_loop);
+  const auto start = Clock::now();
+
+  Generate(links, seconds);
+
+  /* give the EventLoop a moment to receive the last tick */
+  std::this_thread::sleep_for(TICK / 2);
+
+  const auto after = GetEventLoopUsage(event_loop);
+  const std::chrono::duration<double> duration = Clock::now() - start;
+
+  unsigned lines = 0;
+  std::size_t bytes = 0;
+  BlockingCall(event_loop, [&links, &lines, &bytes](){
+    for (const auto &link : links) {
+      lines += link->handler.lines;
+      bytes += link->handler.bytes;
+    }
+  });
+
+  links.clear();
+  thread.Stop();
+
+  const double wakeups = after.ru_nvcsw - before.ru_nvcsw;
+  const auto cpu = ToDuration(after.ru_utime) - ToDuration(before.ru_utime)
+    + ToDuration(after.ru_stime) - ToDuration(before.ru_stime);
+
+  printf("%u serial + %u TCP ports, %.1f s\n",
+         N_SERIAL, N_TCP, duration.count());
+  printf("  %10.0f lines/s  %10.0f bytes/s\n",
+         lines / duration.count(), bytes / duration.count());
+  printf("  %10.1f wakeups/s\n", wakeups / duration.count());
+  printf("  %10.3f ms CPU/s\n", cpu.count() * 1000 / duration.count());
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program replays an IGC file over a terrain file and solves the
+ * reach every 5 seconds (like RouteComputer does):
+ *
+ * - "full": from scratch
+ * - "incremental": with incremental updates (see ReachFan::Update())
+ * - "parallel": from scratch, with the terrain and the working reach
+ *   solved in parallel threads
+ * - "async": like "parallel", but in a background thread; this only
+ *   measures how long the calling thread is blocked
+ *
+ * It reports the time per tick, and how much the arrival heights of
+ * the incremental reach deviate from the full solution.
+ */
+
+#include "Engine/Route/TerrainRoute.hpp"
+#include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/ReachResult.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Geo/Math.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Args.hpp"
+#include "thread/JobThread.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/ZipArchive.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <climits>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr std::chrono::seconds TICK{5};
+
+struct ReachTimer {
+  TerrainRoute route;
+  JobThread *const helper;
+  const bool incremental;
+  Duration duration{};
+
+  ReachTimer(const RasterMap &map, bool _incremental,
+             JobThread *_helper=nullptr) noexcept
+    :helper(_helper), incremental(_incremental) {
+    GlideSettings settings;
+    settings.SetDefaults();
+    RoutePlannerConfig config;
+    config.SetDefaults();
+
+    const GlidePolar polar(1);
+    route.UpdatePolar(settings, config, polar, polar, SpeedVector::Zero(),
+                      500);
+    route.SetTerrain(&map);
+  }
+
+  ReachFan Solve(const AGeoPoint &origin,
+                 RoutePlannerConfig config) {
+    config.reach_incremental = incremental;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    ReachFan reach;
+    if (helper != nullptr)
+      helper->Start([&]{
+        reach = route.SolveReach(origin, config, INT_MAX, true, false);
+      });
+    else
+      reach = route.SolveReach(origin, config, INT_MAX, true, false);
+
+    [[maybe_unused]] auto working =
+      route.SolveReach(origin, config, INT_MAX, true, true);
+
+    if (helper != nullptr)
+      helper->Wait();
+
+    duration += std::chrono::steady_clock::now() - start;
+    return reach;
+  }
+};
+
+/**
+ * Runs a #ReachTimer in a background thread, like RouteComputer
+ * does.
+ */
+struct AsyncReachTimer {
+  JobThread worker{"Worker"};
+  ReachTimer timer;
+  Duration duration{};
+
+  AsyncReachTimer(const RasterMap &map, JobThread &helper) noexcept
+    :timer(map, false, &helper) {}
+
+  void Start(const AGeoPoint &origin, const RoutePlannerConfig &config) {
+    /* in flight, the previous job is long done when the next tick
+       starts; don't count the time waiting for it */
+    worker.Wait();
+
+    const auto start = std::chrono::steady_clock::now();
+    worker.Start([this, origin, &config]{ timer.Solve(origin, config); });
+    duration += std::chrono::steady_clock::now() - start;
+  }
+};
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAP.xcm FILE.igc");
+  const auto map_path = args.ExpectNextPath();
+  const auto igc_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  FileLineReaderA reader(igc_path);
+  IGCExtensions extensions;
+  extensions.clear();
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  RoutePlannerConfig config;
+  config.SetDefaults();
+
+  ReachTimer full(map, false), incremental(map, true);
+
+  JobThread helper("Helper"), async_helper("AsyncHelper");
+  ReachTimer parallel(map, false, &helper);
+  AsyncReachTimer async(map, async_helper);
+
+  SharedMutex mutex;
+  unsigned n_ticks = 0, n_samples = 0, n_mismatches = 0;
+  double total_error = 0;
+  int max_error = 0;
+
+  std::chrono::seconds next_tick{};
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix)) {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    const auto time = fix.time.DurationSinceMidnight();
+    if (!fix.gps_valid || time < next_tick)
+      continue;
+
+    next_tick = time + TICK;
+
+    /* load the tiles around the aircraft like TerrainThread does;
+       this invalidates the incremental reach whenever the tiles
+       change */
+    do {
+      UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                         map.GetProjection(), fix.location, 30000);
+    } while (map.IsDirty());
+
+    const AGeoPoint origin(fix.location, fix.gps_altitude);
+
+    const auto full_reach = full.Solve(origin, config);
+    const auto incremental_reach = incremental.Solve(origin, config);
+    parallel.Solve(origin, config);
+    async.Start(origin, config);
+    ++n_ticks;
+
+    /* compare the arrival heights at a few points around the
+       aircraft */
+    const auto &rpolars = full.route.GetReachPolar();
+    for (unsigned i = 0; i < 40; ++i) {
+      const GeoPoint p = FindLatitudeLongitude(fix.location,
+                                               Angle::Degrees(45 * i),
+                                               5000 + 10000 * (i / 8));
+      const AGeoPoint dest(p, map.GetInterpolatedHeight(p).GetValueOr0());
+
+      const auto a = full_reach.FindPositiveArrival(dest, rpolars);
+      const auto b = incremental_reach.FindPositiveArrival(dest, rpolars);
+      if (!a || !b)
+        continue;
+
+      if (a->IsReachableTerrain() != b->IsReachableTerrain()) {
+        ++n_mismatches;
+        continue;
+      }
+
+      if (!a->IsReachableTerrain())
+        continue;
+
+      const int error = abs(a->terrain - b->terrain);
+      total_error += error;
+      if (error > max_error)
+        max_error = error;
+      ++n_samples;
+    }
+  }
+
+  if (n_ticks == 0) {
+    fprintf(stderr, "No fixes found\n");
+    return EXIT_FAILURE;
+  }
+
+  async.worker.Wait();
+
+  printf("%u ticks\n", n_ticks);
+  printf("full        %8.3f ms/tick\n",
+         full.duration.count() * 1000 / n_ticks);
+  printf("incremental %8.3f ms/tick\n",
+         incremental.duration.count() * 1000 / n_ticks);
+  printf("parallel    %8.3f ms/tick\n",
+         parallel.duration.count() * 1000 / n_ticks);
+  printf("async       %8.3f ms/tick (solved in %.3f ms/tick)\n",
+         async.duration.count() * 1000 / n_ticks,
+         async.timer.duration.count() * 1000 / n_ticks);
+
+  if (n_samples > 0)
+    printf("arrival height error: mean %.1f m, max %d m (%u samples)\n",
+           total_error / n_samples, max_error, n_samples);
+
+  printf("reachability differs at %u points\n", n_mismatches);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
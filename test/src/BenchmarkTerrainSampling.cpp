@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program measures how many interpolated terrain samples per
+ * second can be obtained with RasterMap::GetInterpolatedHeight()
+ * (one sample per call) and with RasterMap::GetInterpolatedHeights()
+ * (batched, vectorised), and verifies that both return the same
+ * heights.
+ */
+
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Geo/Math.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Duration = std::chrono::duration<double>;
+
+static void
+PrintRate(const char *name, std::size_t n, Duration duration) noexcept
+{
+  printf("%-10s %8.3f ms  %7.2f Msamples/s\n", name,
+         duration.count() * 1000, n / duration.count() / 1e6);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto map_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  {
+    ConsoleOperationEnvironment operation;
+    LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+
+  /* sample along random 20 km lines near the map center, like a
+     glide path or a route would; most samples are in the loaded
+     tiles, some hit the pyramid or the overview */
+
+  constexpr unsigned n_lines = 1024, line_samples = 1024;
+
+  const GeoPoint center = map.GetMapCenter();
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> random_offset(-0.3, 0.3);
+  std::uniform_real_distribution<double> random_direction(0, 360);
+
+  std::vector<GeoPoint> points;
+  points.reserve(n_lines * line_samples);
+  for (unsigned i = 0; i < n_lines; ++i) {
+    const GeoPoint a(center.longitude + Angle::Degrees(random_offset(rng)),
+                     center.latitude + Angle::Degrees(random_offset(rng)));
+    const GeoPoint b =
+      FindLatitudeLongitude(a, Angle::Degrees(random_direction(rng)), 20000);
+    for (unsigned j = 0; j < line_samples; ++j)
+      points.push_back(a.Interpolate(b, double(j) / (line_samples - 1)));
+  }
+
+  std::vector<TerrainHeight> scalar(points.size()), batched(points.size());
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < points.size(); ++i)
+    scalar[i] = map.GetInterpolatedHeight(points[i]);
+  const Duration scalar_duration = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  map.GetInterpolatedHeights(points, batched.data());
+  const Duration batched_duration = std::chrono::steady_clock::now() - start;
+
+  PrintRate("scalar", points.size(), scalar_duration);
+  PrintRate("batched", points.size(), batched_duration);
+
+  /* for comparison: the same lines with ScanLine() */
+  std::vector<TerrainHeight> line(line_samples);
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < points.size(); i += line_samples)
+    map.ScanLine(points[i], points[i + line_samples - 1],
+                 line.data(), line.size(), true);
+  const Duration scan_duration = std::chrono::steady_clock::now() - start;
+
+  PrintRate("ScanLine", points.size(), scan_duration);
+
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < points.size(); ++i)
+    if (scalar[i].GetValue() != batched[i].GetValue())
+      ++mismatches;
+
+  if (mismatches > 0) {
+    fprintf(stderr, "%zu of %zu samples differ\n",
+            mismatches, points.size());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
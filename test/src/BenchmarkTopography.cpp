@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program pans a map view across the topography of a map file
+ * and measures TopographyStore::ScanVisibility(), once loading shapes
+ * from the shapefiles and once from the preprocessed shape cache (see
+ * ShapeCache.hpp).  The first pass with the cache includes creating
+ * it; then the map file is loaded again, this time mapping the
+ * existing cache.
+ *
+ * Finally, it updates the layers in parallel (like TopographyThread
+ * does) without the cache.
+ *
+ * It verifies that all ways produce the same visible shapes.
+ */
+
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "io/FileCache.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/ZipLineReader.hpp"
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "thread/JobThread.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr unsigned PASSES = 3;
+static constexpr unsigned STEPS = 200;
+
+static constexpr unsigned PIXEL_SCALE = 1;
+
+/**
+ * Generate a zig-zag path of map views around the given center, which
+ * covers most of the map and revisits each area in the second half.
+ */
+static std::vector<WindowProjection>
+MakePath(GeoPoint center)
+{
+  std::vector<WindowProjection> path;
+
+  for (unsigned i = 0; i < STEPS; ++i) {
+    /* back and forth: 0..1..0 */
+    const double t = i < STEPS / 2
+      ? double(i) / (STEPS / 2)
+      : double(STEPS - i) / (STEPS / 2);
+
+    const GeoPoint location(center.longitude +
+                            Angle::Degrees(-0.5 + t),
+                            center.latitude +
+                            Angle::Degrees((i % 20 < 10 ? 0.03 : -0.03) *
+                                           (i % 10)));
+
+    WindowProjection &projection = path.emplace_back();
+    projection.SetScreenSize({640, 480});
+    projection.SetScaleFromRadius(3000);
+    projection.SetGeoLocation(location);
+    projection.SetScreenOrigin(320, 240);
+    projection.UpdateScreenBounds();
+  }
+
+  return path;
+}
+
+static void
+Load(TopographyStore &store, Path path, FileCache *cache)
+{
+  ZipArchive archive(path);
+  ZipLineReaderA reader(archive.get(), "topology.tpl");
+  store.Load(reader, nullptr, archive.get(), cache, path, PIXEL_SCALE);
+}
+
+static bool
+Equals(const GeoBounds &a, const GeoBounds &b) noexcept
+{
+  return a.GetNorthWest() == b.GetNorthWest() &&
+    a.GetSouthEast() == b.GetSouthEast();
+}
+
+static bool
+Equals(const XShape &a, const XShape &b, const TopographyFile &file) noexcept
+{
+  if (!Equals(a.get_bounds(), b.get_bounds()) ||
+      a.get_type() != b.get_type() ||
+      !std::ranges::equal(a.GetLines(), b.GetLines()))
+    return false;
+
+  const char *la = a.GetLabel(), *lb = b.GetLabel();
+  if (la == nullptr ? lb != nullptr : lb == nullptr || !StringIsEqual(la, lb))
+    return false;
+
+  std::size_t n_points = 0;
+  for (const auto n : a.GetLines())
+    n_points += n;
+
+  if (!std::equal(a.GetPoints(), a.GetPoints() + n_points, b.GetPoints()))
+    return false;
+
+#ifdef ENABLE_OPENGL
+  if (a.get_type() == MS_SHAPE_POLYGON && !a.GetLines().empty()) {
+    for (unsigned level = 0; level < 4; ++level) {
+      const auto distance = file.GetThinningDistance(level, PIXEL_SCALE);
+      const auto ia = a.GetIndices(level, distance);
+      const auto ib = b.GetIndices(level, distance);
+      if (*ia.count != *ib.count ||
+          !std::equal(ia.indices, ia.indices + *ia.count, ib.indices))
+        return false;
+    }
+  }
+#else
+  (void)file;
+#endif
+
+  return true;
+}
+
+/**
+ * @return the number of files whose visible shapes differ
+ */
+static unsigned
+Compare(const TopographyStore &a, const TopographyStore &b) noexcept
+{
+  unsigned mismatches = 0;
+
+  auto j = b.begin();
+  for (const auto &fa : a) {
+    const auto &fb = *j++;
+
+    const std::lock_guard la{fa.mutex};
+    const std::lock_guard lb{fb.mutex};
+
+    auto sb = fb.begin();
+    bool equal = true;
+    for (const auto &shape : fa) {
+      if (sb == fb.end() || !Equals(shape, *sb, fa)) {
+        equal = false;
+        break;
+      }
+
+      ++sb;
+    }
+
+    if (!equal || sb != fb.end())
+      ++mismatches;
+  }
+
+  return mismatches;
+}
+
+static Duration
+Pass(TopographyStore &store, const std::vector<WindowProjection> &path,
+     Duration *first_step=nullptr)
+{
+  Duration result{};
+  for (const auto &projection : path) {
+    const auto start = std::chrono::steady_clock::now();
+    store.ScanVisibility(projection);
+    const Duration duration = std::chrono::steady_clock::now() - start;
+    result += duration;
+
+    if (first_step != nullptr) {
+      *first_step = duration;
+      first_step = nullptr;
+    }
+  }
+
+  return result;
+}
+
+static void
+PrintStatistics(const char *name, const TopographyStore &store) noexcept
+{
+  const auto s = store.GetStatistics();
+  printf("  %-8s hits %zu  misses %zu  evictions %zu  resident %zu  mapped %zu bytes\n",
+         name, s.hits, s.misses, s.evictions, s.resident, s.bytes_mapped);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.xcm");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  char cache_dir[] = "/tmp/BenchmarkTopography.XXXXXX";
+  if (mkdtemp(cache_dir) == nullptr) {
+    perror("mkdtemp() failed");
+    return EXIT_FAILURE;
+  }
+
+  FileCache cache{AllocatedPath{cache_dir}};
+
+  TopographyStore plain, building, mapped;
+  Load(plain, path, nullptr);
+  Load(building, path, &cache);
+
+  if (plain.begin() == plain.end()) {
+    fprintf(stderr, "No topography\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto views = MakePath(plain.begin()->GetCenter());
+
+  Duration plain_first{}, plain_rest{};
+  for (unsigned pass = 0; pass < PASSES; ++pass)
+    (pass == 0 ? plain_first : plain_rest) += Pass(plain, views);
+
+  Duration build{};
+  Pass(building, views, &build);
+
+  auto start = std::chrono::steady_clock::now();
+  Load(mapped, path, &cache);
+  const Duration open = std::chrono::steady_clock::now() - start;
+
+  Duration mapped_first{}, mapped_rest{};
+  unsigned mismatches = 0;
+  for (unsigned pass = 0; pass < PASSES; ++pass) {
+    for (const auto &projection : views) {
+      start = std::chrono::steady_clock::now();
+      mapped.ScanVisibility(projection);
+      (pass == 0 ? mapped_first : mapped_rest) +=
+        std::chrono::steady_clock::now() - start;
+
+      if (pass == 0) {
+        /* move the plain store to the same view */
+        plain.ScanVisibility(projection);
+        mismatches += Compare(plain, mapped);
+      }
+    }
+  }
+
+  printf("%u views, %u mismatches\n", STEPS, mismatches);
+  printf("  shapefile first pass %8.3f ms  later passes %8.3f ms\n",
+         plain_first.count() * 1000,
+         plain_rest.count() * 1000 / (PASSES - 1));
+  printf("  cache     first pass %8.3f ms  later passes %8.3f ms  "
+         "(building took %.3f ms, opening %.3f ms)\n",
+         mapped_first.count() * 1000,
+         mapped_rest.count() * 1000 / (PASSES - 1),
+         build.count() * 1000, open.count() * 1000);
+  /* update the layers in parallel; the plain store is at the last
+     view already, so start with the reverse path */
+  TopographyStore parallel;
+  Load(parallel, path, nullptr);
+
+  JobThread helpers[2]{JobThread{"Helper1"}, JobThread{"Helper2"}};
+  Duration parallel_first{};
+  unsigned parallel_mismatches = 0;
+  for (auto i = views.rbegin(); i != views.rend(); ++i) {
+    start = std::chrono::steady_clock::now();
+    parallel.ScanVisibility(*i, helpers, {});
+    parallel_first += std::chrono::steady_clock::now() - start;
+
+    plain.ScanVisibility(*i);
+    parallel_mismatches += Compare(plain, parallel);
+  }
+
+  printf("  parallel  first pass %8.3f ms  (%zu helper threads, %u mismatches)\n",
+         parallel_first.count() * 1000, std::size(helpers),
+         parallel_mismatches);
+  PrintStatistics("shapefile", plain);
+  PrintStatistics("cache", mapped);
+
+  struct DeleteVisitor final : File::Visitor {
+    void Visit(Path p, Path) override {
+      File::Delete(p);
+    }
+  } delete_visitor;
+  Directory::VisitFiles(Path{cache_dir}, delete_visitor);
+  rmdir(cache_dir);
+
+  return mismatches == 0 && parallel_mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
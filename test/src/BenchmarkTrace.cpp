@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program feeds the fixes of an IGC file into #Trace and
+ * #ArrayTrace with various sizes, and measures:
+ *
+ * - "append": appending all fixes, including thinning
+ * - "iterate": iterating over all points of the resulting trace
+ *
+ * It verifies that both implementations keep exactly the same points.
+ */
+
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/ArrayTrace.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "system/Args.hpp"
+#include "io/FileLineReader.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr unsigned APPEND_RUNS = 20;
+static constexpr unsigned ITERATE_RUNS = 20000;
+
+struct TraceConfig {
+  const char *name;
+  std::chrono::duration<unsigned> no_thin_time, max_time;
+  unsigned max_size;
+};
+
+static constexpr TraceConfig configs[] = {
+  /* like TraceComputer::full */
+  { "full", std::chrono::minutes{2}, Trace::null_time, 1024 },
+  /* like TraceComputer::contest */
+  { "contest", {}, Trace::null_time, 256 },
+  /* like TraceComputer::sprint */
+  { "sprint", {}, std::chrono::hours{2}, 128 },
+};
+
+static std::vector<TracePoint>
+LoadFixes(Path path)
+{
+  FileLineReaderA reader(path);
+  IGCExtensions extensions;
+  extensions.clear();
+
+  std::vector<TracePoint> fixes;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix)) {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    if (!fix.gps_valid)
+      continue;
+
+    const auto time = std::chrono::duration_cast<std::chrono::duration<unsigned>>(fix.time.DurationSinceMidnight());
+    fixes.emplace_back(fix.location, time, fix.gps_altitude, 0, 0);
+  }
+
+  return fixes;
+}
+
+template<typename T>
+static Duration
+MeasureAppend(T &trace, const std::vector<TracePoint> &fixes) noexcept
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned run = 0; run < APPEND_RUNS; ++run) {
+    trace.clear();
+    for (const auto &fix : fixes)
+      trace.push_back(fix);
+  }
+
+  return std::chrono::steady_clock::now() - start;
+}
+
+template<typename T>
+static Duration
+MeasureIterate(const T &trace, unsigned &checksum) noexcept
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned run = 0; run < ITERATE_RUNS; ++run)
+    for (const auto &point : trace)
+      checksum += point.GetFlatLocation().x;
+
+  return std::chrono::steady_clock::now() - start;
+}
+
+static bool
+Compare(const Trace &a, const ArrayTrace &b) noexcept
+{
+  if (a.size() != b.size() ||
+      a.GetAverageDeltaDistance() != b.GetAverageDeltaDistance() ||
+      a.GetAverageDeltaTime() != b.GetAverageDeltaTime())
+    return false;
+
+  auto j = b.begin();
+  for (const auto &i : a) {
+    if (i.GetTime() != j->GetTime() ||
+        i.GetFlatLocation() != j->GetFlatLocation())
+      return false;
+
+    ++j;
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc");
+  const auto igc_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  const auto fixes = LoadFixes(igc_path);
+  if (fixes.empty()) {
+    fprintf(stderr, "No fixes found\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("%u fixes\n", unsigned(fixes.size()));
+
+  bool success = true;
+
+  for (const auto &config : configs) {
+    Trace trace(config.no_thin_time, config.max_time, config.max_size);
+    ArrayTrace array_trace(config.no_thin_time, config.max_time,
+                           config.max_size);
+
+    const auto append = MeasureAppend(trace, fixes);
+    const auto array_append = MeasureAppend(array_trace, fixes);
+
+    unsigned checksum = 0, array_checksum = 0;
+    const auto iterate = MeasureIterate(trace, checksum);
+    const auto array_iterate = MeasureIterate(array_trace, array_checksum);
+
+    const bool equal = Compare(trace, array_trace) &&
+      checksum == array_checksum;
+    if (!equal)
+      success = false;
+
+    printf("%-8s size=%-4u points=%-4u %s\n",
+           config.name, config.max_size, trace.size(),
+           equal ? "identical" : "DIFFERENT");
+    printf("  append   Trace %8.3f ms  ArrayTrace %8.3f ms\n",
+           append.count() * 1000 / APPEND_RUNS,
+           array_append.count() * 1000 / APPEND_RUNS);
+    printf("  iterate  Trace %8.3f us  ArrayTrace %8.3f us\n",
+           iterate.count() * 1000000 / ITERATE_RUNS,
+           array_iterate.count() * 1000000 / ITERATE_RUNS);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program loads a waypoint file and compares the spatial index
+ * of class Waypoints (a bulk-loaded PackedRTree) with the QuadTree it
+ * replaced: the time it takes to build the index, and the time of
+ * range and nearest-neighbour queries at random locations.
+ *
+ * It verifies that both return the same results.
+ */
+
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "system/Args.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "util/PackedRTree.hxx"
+#include "util/QuadTree.hxx"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Duration = std::chrono::duration<double>;
+
+static constexpr unsigned BUILD_RUNS = 10;
+static constexpr unsigned QUERIES = 20000;
+
+/**
+ * The query ranges in flat projection units (about 111 m each).
+ */
+static constexpr unsigned RANGES[] = { 50, 200, 1000 };
+
+struct WaypointAccessor {
+  int GetX(const WaypointPtr &wp) const noexcept {
+    return wp->flat_location.x;
+  }
+
+  int GetY(const WaypointPtr &wp) const noexcept {
+    return wp->flat_location.y;
+  }
+};
+
+using Quad = QuadTree<WaypointPtr, WaypointAccessor>;
+using Packed = PackedRTree<WaypointPtr, WaypointAccessor>;
+
+template<typename F>
+static Duration
+Measure(F &&f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::steady_clock::now() - start;
+}
+
+static unsigned
+SquareDistance(const FlatGeoPoint &a, const FlatGeoPoint &b) noexcept
+{
+  const int dx = a.x - b.x, dy = a.y - b.y;
+  return dx * dx + dy * dy;
+}
+
+/**
+ * A summary of the result of a range query which does not depend on
+ * the order of the visited waypoints.
+ */
+struct VisitResult {
+  unsigned count = 0;
+  unsigned long long id_sum = 0;
+
+  void operator()(const WaypointPtr &wp) noexcept {
+    ++count;
+    id_sum += wp->id;
+  }
+
+  bool operator==(const VisitResult &) const noexcept = default;
+};
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  Waypoints waypoints;
+  const Duration load = Measure([&]{
+    ConsoleOperationEnvironment operation;
+    ReadWaypointFile(path, waypoints,
+                     WaypointFactory(WaypointOrigin::NONE),
+                     operation);
+  });
+
+  const Duration optimise = Measure([&]{ waypoints.Optimise(); });
+
+  const std::vector<WaypointPtr> all(waypoints.begin(), waypoints.end());
+  if (all.empty()) {
+    fprintf(stderr, "No waypoints\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("%zu waypoints, reading %.3f ms, Waypoints::Optimise() %.3f ms\n",
+         all.size(), load.count() * 1000, optimise.count() * 1000);
+
+  Quad quad;
+  Packed packed;
+
+  Duration quad_build{}, packed_build{};
+  for (unsigned run = 0; run < BUILD_RUNS; ++run) {
+    quad.clear();
+    quad_build += Measure([&]{
+      for (const auto &wp : all)
+        quad.Add(wp);
+      quad.Optimise();
+    });
+
+    packed.clear();
+    packed_build += Measure([&]{
+      for (const auto &wp : all)
+        packed.Add(wp);
+      packed.Optimise();
+    });
+  }
+
+  printf("  build    QuadTree %8.3f ms  PackedRTree %8.3f ms\n",
+         quad_build.count() * 1000 / BUILD_RUNS,
+         packed_build.count() * 1000 / BUILD_RUNS);
+
+  /* query around random waypoints, up to 10 km off */
+  std::mt19937 random(42);
+  std::uniform_int_distribution<std::size_t> pick(0, all.size() - 1);
+  std::uniform_int_distribution<int> offset(-100, 100);
+
+  std::vector<FlatGeoPoint> locations;
+  locations.reserve(QUERIES);
+  for (unsigned i = 0; i < QUERIES; ++i) {
+    const auto &p = all[pick(random)]->flat_location;
+    locations.emplace_back(p.x + offset(random), p.y + offset(random));
+  }
+
+  unsigned mismatches = 0;
+
+  for (const unsigned range : RANGES) {
+    std::vector<VisitResult> quad_visits(QUERIES), packed_visits(QUERIES);
+    std::vector<const WaypointPtr *> quad_nearest(QUERIES),
+      packed_nearest(QUERIES);
+
+    const Duration quad_visit = Measure([&]{
+      for (unsigned i = 0; i < QUERIES; ++i)
+        quad.VisitWithinRange(Quad::Point(locations[i].x, locations[i].y),
+                              range, quad_visits[i]);
+    });
+
+    const Duration packed_visit = Measure([&]{
+      for (unsigned i = 0; i < QUERIES; ++i)
+        packed.VisitWithinRange(Packed::Point(locations[i].x, locations[i].y),
+                                range, packed_visits[i]);
+    });
+
+    const Duration quad_find = Measure([&]{
+      for (unsigned i = 0; i < QUERIES; ++i) {
+        const auto found =
+          quad.FindNearest(Quad::Point(locations[i].x, locations[i].y),
+                           range).first;
+        quad_nearest[i] = found != quad.end() ? &*found : nullptr;
+      }
+    });
+
+    const Duration packed_find = Measure([&]{
+      for (unsigned i = 0; i < QUERIES; ++i) {
+        const auto found =
+          packed.FindNearest(Packed::Point(locations[i].x, locations[i].y),
+                             range);
+        packed_nearest[i] = found != packed.end() ? &*found : nullptr;
+      }
+    });
+
+    for (unsigned i = 0; i < QUERIES; ++i) {
+      if (quad_visits[i] != packed_visits[i])
+        ++mismatches;
+
+      /* compare distances, because there may be several waypoints
+         with the same distance */
+      const bool quad_found = quad_nearest[i] != nullptr;
+      const bool packed_found = packed_nearest[i] != nullptr;
+      if (quad_found != packed_found ||
+          (quad_found &&
+           SquareDistance((*quad_nearest[i])->flat_location, locations[i]) !=
+           SquareDistance((*packed_nearest[i])->flat_location, locations[i])))
+        ++mismatches;
+    }
+
+    printf("  range %4u  visit    QuadTree %8.3f ms  PackedRTree %8.3f ms\n",
+           range, quad_visit.count() * 1000, packed_visit.count() * 1000);
+    printf("  range %4u  nearest  QuadTree %8.3f ms  PackedRTree %8.3f ms\n",
+           range, quad_find.count() * 1000, packed_find.count() * 1000);
+  }
+
+  printf("%u queries per range, %u mismatches\n", QUERIES, mismatches);
+
+  return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
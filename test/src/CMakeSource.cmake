@@ -5,11 +5,22 @@ set(TEST_LIST
 # ${SRC_DIR}/AnalyseFlight.cpp
 # ${SRC_DIR}/AppendGRecord.cpp
 # ${SRC_DIR}/ArcApprox.cpp
+# ${SRC_DIR}/BenchmarkAirspaceCache.cpp
+# ${SRC_DIR}/BenchmarkAirspacePolygon.cpp
+# ${SRC_DIR}/BenchmarkAirspaceWarnings.cpp
 # ${SRC_DIR}/BenchmarkFAITriangleSector.cpp
+# ${SRC_DIR}/BenchmarkNMEA.cpp
+# ${SRC_DIR}/BenchmarkPorts.cpp
 # ${SRC_DIR}/BenchmarkProjection.cpp
+# ${SRC_DIR}/BenchmarkReach.cpp
+# ${SRC_DIR}/BenchmarkTerrainSampling.cpp
+# ${SRC_DIR}/BenchmarkTopography.cpp
+# ${SRC_DIR}/BenchmarkTrace.cpp
+# ${SRC_DIR}/BenchmarkWaypoints.cpp
 # ${SRC_DIR}/CAI302Tool.cpp
 # ${SRC_DIR}/ConsoleJobRunner.cpp
 # ${SRC_DIR}/ContestPrinting.cpp
+# ${SRC_DIR}/ConvertTerrain.cpp
 # ${SRC_DIR}/DebugDisplay.cpp
 # ${SRC_DIR}/DebugPort.cpp
 # ${SRC_DIR}/DebugReplay.cpp
@@ -123,15 +134,18 @@ set(TEST_LIST
   ${SRC_DIR}/RunWeGlideClient.cpp
   ${SRC_DIR}/TestAATPoint.cpp
   ${SRC_DIR}/TestARange.cpp
+  ${SRC_DIR}/TestAirspaceCache.cpp
   ${SRC_DIR}/TestAirspaceParser.cpp
   ${SRC_DIR}/TestAllocatedGrid.cpp
   ${SRC_DIR}/TestAngle.cpp
+  ${SRC_DIR}/TestArrayTrace.cpp
   ${SRC_DIR}/TestByteSizeFormatter.cpp
   ${SRC_DIR}/TestCRC8.cpp
   ${SRC_DIR}/TestCRC16.cpp
   ${SRC_DIR}/TestCSVLine.cpp
   ${SRC_DIR}/TestClimbAvCalc.cpp
   ${SRC_DIR}/TestColorRamp.cpp
+  ${SRC_DIR}/TestContestIncremental.cpp
   ${SRC_DIR}/TestDateTime.cpp
   ${SRC_DIR}/TestDiffFilter.cpp
   ${SRC_DIR}/TestDriver.cpp
@@ -162,13 +176,18 @@ set(TEST_LIST
   ${SRC_DIR}/TestNotify.cpp
   ${SRC_DIR}/TestOrderedTask.cpp
   ${SRC_DIR}/TestOverwritingRingBuffer.cpp
+  ${SRC_DIR}/TestPackedRTree.cpp
+  ${SRC_DIR}/TestPhaseHistory.cpp
   ${SRC_DIR}/TestPlanes.cpp
   ${SRC_DIR}/TestPolars.cpp
+  ${SRC_DIR}/TestPolygonIndex.cpp
   ${SRC_DIR}/TestProfile.cpp
   ${SRC_DIR}/TestProjection.cpp
   ${SRC_DIR}/TestQuadrilateral.cpp
   ${SRC_DIR}/TestRadixTree.cpp
+  ${SRC_DIR}/TestReachUpdate.cpp
   ${SRC_DIR}/TestRoughTime.cpp
+  ${SRC_DIR}/TestSnapshotBuffer.cpp
   ${SRC_DIR}/TestStrings.cpp
   ${SRC_DIR}/TestSunEphemeris.cpp
   ${SRC_DIR}/TestTaskPoint.cpp
@@ -178,6 +197,7 @@ set(TEST_LIST
   ${SRC_DIR}/TestThermalBand.cpp
   ${SRC_DIR}/TestThermalBase.cpp
   ${SRC_DIR}/TestTimeFormatter.cpp
+  ${SRC_DIR}/TestTopographyFile.cpp
   ${SRC_DIR}/TestTrace.cpp
   ${SRC_DIR}/TestUTF8.cpp
   ${SRC_DIR}/TestUTM.cpp
@@ -238,6 +258,8 @@ set(TEST_LIST
   # needs ParseArgs with getopt.h: ${SRC_DIR}/test_pressure.cpp
   # needs ParseArgs with getopt.h: ${SRC_DIR}/test_task.cpp
   ${SRC_DIR}/TestOverwritingRingBuffer.cpp
+  ${SRC_DIR}/TestPhaseHistory.cpp
+  ${SRC_DIR}/TestSnapshotBuffer.cpp
   ${SRC_DIR}/TestDateTime.cpp
   ${SRC_DIR}/TestRoughTime.cpp
   ${SRC_DIR}/TestWrapClock.cpp
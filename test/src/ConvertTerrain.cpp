@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program decodes all tiles of a map file and writes them to a
+ * #RasterTileStore in the specified cache directory, just like
+ * OpenSoar does when it loads the map for the first time.
+ */
+
+#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/RasterTileStore.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+
+#include <stdio.h>
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH CACHEDIR");
+  const auto map_path = args.ExpectNextPath();
+  const auto cache_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterTileCache rtc;
+
+  ConsoleOperationEnvironment operation;
+  LoadTerrainOverview(archive.get(), rtc, operation);
+
+  const auto size = RasterTileStore::CalcSize(rtc.GetTiles());
+  printf("store size = %zu bytes\n", size);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  FileCache cache(AllocatedPath{cache_path});
+  auto os = cache.Save(RasterTileStore::CACHE_NAME, map_path);
+  BufferedOutputStream bos(*os);
+  ConvertTerrainTiles(archive.get(), rtc, bos, operation);
+  bos.Flush();
+  os->Commit();
+
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+  printf("conversion took %.3f s\n", duration.count());
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -188,14 +188,15 @@ FLARMEmulator::BinaryReceived(std::span<const std::byte> s) noexcept
 }
 
 bool
-FLARMEmulator::DataReceived(std::span<const std::byte> s) noexcept
+FLARMEmulator::DataReceived(std::span<const std::byte> s,
+                            bool writable) noexcept
 {
   if (binary) {
     BinaryReceived(s);
     return true;
   } else {
     fwrite(s.data(), 1, s.size(), stdout);
-    return PortLineSplitter::DataReceived(s);
+    return PortLineSplitter::DataReceived(s, writable);
   }
 }
 
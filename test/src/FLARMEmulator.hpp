@@ -40,6 +40,7 @@ private:
   void BinaryReceived(std::span<const std::byte> s) noexcept;
 
 protected:
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
   bool LineReceived(const char *_line) noexcept override;
 };
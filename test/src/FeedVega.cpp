@@ -18,7 +18,7 @@
 
 class MyHandler : public DataHandler {
 public:
-  bool DataReceived(std::span<const std::byte> s) noexcept override {
+  bool DataReceived(std::span<const std::byte> s, bool) noexcept override {
     return fwrite(s.data(), 1, s.size(), stdout) == s.size();
   }
 };
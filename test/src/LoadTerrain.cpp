@@ -4,22 +4,49 @@
 /*
  * This program loads the terrain from a map file and exits.  Useful
  * for valgrind and profiling.
+ *
+ * If a cache directory is specified, the #RasterTileStore generated
+ * by ConvertTerrain is used instead of decoding JPEG2000 tiles.  The
+ * program pans across the map and prints the tile-in latency and the
+ * peak RSS.
+ *
+ * With "--prefetch", the tiles of the next pan step are prefetched
+ * (outside of the latency measurement), like TerrainThread does
+ * ahead of the aircraft, and the tile statistics are printed.
  */
 
 #include "Terrain/RasterTileCache.hpp"
+#include "Terrain/RasterTileStore.hpp"
 #include "Terrain/Loader.hpp"
 #include "Operation/ConsoleOperationEnvironment.hpp"
 #include "system/Args.hpp"
 #include "io/ZipArchive.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileMapping.hpp"
 #include "util/PrintException.hxx"
 
+#include <chrono>
+#include <memory>
+
 #include <stdio.h>
 #include <string.h>
 
+#ifdef HAVE_POSIX
+#include <sys/resource.h>
+#endif
+
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "PATH");
+  Args args(argc, argv, "[--prefetch] PATH [CACHEDIR]");
+
+  bool prefetch = false;
+  if (!args.IsEmpty() && strcmp(args.PeekNext(), "--prefetch") == 0) {
+    args.Skip();
+    prefetch = true;
+  }
+
   const auto map_path = args.ExpectNextPath();
+  const char *cache_path = args.IsEmpty() ? nullptr : args.GetNext();
   args.ExpectEnd();
 
   ZipArchive archive(map_path);
@@ -38,13 +65,76 @@ try {
          (double)bounds.GetEast().Degrees(),
          (double)bounds.GetSouth().Degrees());
 
+  std::unique_ptr<RasterTileStore> store;
+  if (cache_path != nullptr) {
+    FileCache cache{AllocatedPath{cache_path}};
+    std::span<const std::byte> payload;
+    auto mapping = cache.Map(RasterTileStore::CACHE_NAME, map_path, payload);
+    if (!mapping) {
+      fprintf(stderr, "No tile store in cache\n");
+      return EXIT_FAILURE;
+    }
+
+    store = std::make_unique<RasterTileStore>(std::move(mapping), payload);
+    if (!store->IsCompatible(rtc.GetTiles())) {
+      fprintf(stderr, "Tile store does not match the map file\n");
+      return EXIT_FAILURE;
+    }
+
+    rtc.SetTileStore(store.get());
+  }
+
+  /* pan across the map from west to east */
+  constexpr unsigned n_steps = 16;
+  const unsigned step = rtc.GetSize().x / n_steps;
+
+  std::chrono::steady_clock::duration total{}, worst{};
+
   SharedMutex mutex;
-  do {
-    UpdateTerrainTiles(archive.get(), rtc, mutex,
-                       SignedRasterLocation(rtc.GetSize().x / 2,
-                                            rtc.GetSize().y / 2),
-                       1000);
-  } while (rtc.IsDirty());
+  for (unsigned i = 0; i < n_steps; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+
+    do {
+      UpdateTerrainTiles(archive.get(), rtc, mutex,
+                         SignedRasterLocation(i * step + step / 2,
+                                              rtc.GetSize().y / 2),
+                         1000);
+    } while (rtc.IsDirty());
+
+    const auto duration = std::chrono::steady_clock::now() - start;
+    total += duration;
+    worst = std::max(worst, duration);
+
+    if (prefetch)
+      while (PrefetchTerrainTiles(archive.get(), rtc, mutex,
+                                  SignedRasterLocation((i + 1) * step + step / 2,
+                                                       rtc.GetSize().y / 2),
+                                  1000)) {}
+  }
+
+  /* read all heights along the path, which faults in the mapped
+     pages and allows comparing the results of both modes */
+  long checksum = 0;
+  for (unsigned y = rtc.GetSize().y / 2 - 256; y < rtc.GetSize().y / 2 + 256; ++y)
+    for (unsigned x = 0; x < rtc.GetSize().x; ++x)
+      checksum += rtc.GetHeight({x, y}).GetValueOr0();
+
+  printf("checksum = %ld\n", checksum);
+
+  using ms = std::chrono::duration<double, std::milli>;
+  printf("tile-in latency: total=%.3f ms avg=%.3f ms max=%.3f ms\n",
+         ms(total).count(), ms(total).count() / n_steps, ms(worst).count());
+
+  const auto &statistics = rtc.GetStatistics();
+  printf("tiles: %u hits, %u misses, %u evictions, %u prefetched, %u wasted\n",
+         statistics.hits, statistics.misses, statistics.evictions,
+         statistics.prefetched, statistics.wasted);
+
+#ifdef HAVE_POSIX
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    printf("max RSS = %ld kB\n", usage.ru_maxrss);
+#endif
 
   return EXIT_SUCCESS;
 } catch (const std::runtime_error &e) {
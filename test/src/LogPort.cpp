@@ -33,7 +33,7 @@ public:
 
 class MyHandler : public DataHandler {
 public:
-  bool DataReceived(std::span<const std::byte> s) noexcept override {
+  bool DataReceived(std::span<const std::byte> s, bool) noexcept override {
     char prefix[16];
     sprintf(prefix, "%12llu ", (unsigned long long)
             std::chrono::steady_clock::now().time_since_epoch().count());
@@ -91,7 +91,7 @@ LoadFiles(Airspaces &airspace_database)
   terrain = RasterTerrain::OpenTerrain(nullptr, operation).release();
 
   const AtmosphericPressure pressure = AtmosphericPressure::Standard();
-  ReadAirspace(airspace_database, pressure, operation);
+  ReadAirspace(airspace_database, pressure, nullptr, operation);
 
   if (terrain != nullptr)
     SetAirspaceGroundLevels(airspace_database, *terrain);
@@ -167,6 +167,7 @@ Main(UI::Display &display)
                                task_events);
   glide_computer.SetTerrain(terrain);
   glide_computer.SetContestIncremental(false);
+  glide_computer.SetRouteParallel(false);
   glide_computer.Initialise();
 
   LoadReplay(replay, glide_computer, blackboard);
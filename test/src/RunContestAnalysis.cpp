@@ -8,6 +8,7 @@
 #include "DebugReplay.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <stdio.h>
 
 using namespace std::chrono;
@@ -46,11 +47,70 @@ static ContestManager weglide_free(Contest::WEGLIDE_FREE,
 static ContestManager charron(Contest::CHARRON,
                               full_trace, triangle_trace, sprint_trace);
 
+/**
+ * Measures the wall time spent in a #ContestManager, both during the
+ * flight (incremental) and in the final exhaustive search.
+ */
+struct ContestTimer {
+  const char *name;
+  ContestManager &manager;
+  duration<double> incremental{}, exhaustive{};
+
+  void UpdateIdle() noexcept {
+    const auto start = steady_clock::now();
+    manager.UpdateIdle();
+    incremental += steady_clock::now() - start;
+  }
+
+  void SolveExhaustive() noexcept {
+    const auto start = steady_clock::now();
+    manager.SolveExhaustive();
+    exhaustive += steady_clock::now() - start;
+  }
+};
+
+static ContestTimer timers[] = {
+  { "classic", olc_classic },
+  { "fai", olc_fai },
+  { "sprint", olc_sprint },
+  { "league", olc_league },
+  { "plus", olc_plus },
+  { "dmst", dmst },
+  { "xcontest", xcontest },
+  { "sis_at", sis_at },
+  { "weglide", weglide_free },
+  { "charron", charron },
+};
+
+static void
+PrintTimers() noexcept
+{
+  printf("%-10s %12s %12s\n", "contest", "flight [ms]", "final [ms]");
+  for (const auto &i : timers)
+    printf("%-10s %12.1f %12.1f\n", i.name,
+           i.incremental.count() * 1000, i.exhaustive.count() * 1000);
+
+  putchar('\n');
+  printf("%-10s %-24s %12s %8s\n", "contest", "solver", "time [ms]", "calls");
+  for (const auto &i : timers)
+    i.manager.VisitTimings([&i](const char *solver,
+                                steady_clock::duration d,
+                                unsigned n_calls){
+      printf("%-10s %-24s %12.1f %8u\n", i.name, solver,
+             duration<double>(d).count() * 1000, n_calls);
+    });
+}
+
 static int
 TestContest(DebugReplay &replay)
 {
   bool released = false;
 
+  /* solve continuously during the flight, like ContestComputer
+     does */
+  for (auto &i : timers)
+    i.manager.SetIncremental(true);
+
   for (int i = 1; replay.Next(); i++) {
     if (i % 500 == 0) {
       putchar('.');
@@ -75,22 +135,18 @@ TestContest(DebugReplay &replay)
     full_trace.push_back(point);
     sprint_trace.push_back(point);
 
-    olc_sprint.UpdateIdle();
-    olc_league.UpdateIdle();
+    for (auto &i : timers)
+      i.UpdateIdle();
   }
 
-  olc_classic.SolveExhaustive();
-  olc_fai.SolveExhaustive();
-  olc_league.SolveExhaustive();
-  olc_plus.SolveExhaustive();
-  dmst.SolveExhaustive();
-  xcontest.SolveExhaustive();
-  sis_at.SolveExhaustive();
-  weglide_free.SolveExhaustive();
-  charron.SolveExhaustive();
+  for (auto &i : timers)
+    if (&i.manager != &olc_sprint)
+      i.SolveExhaustive();
 
   putchar('\n');
 
+  PrintTimers();
+
   std::cout << "classic\n";
   PrintHelper::print(olc_classic.GetStats().GetResult());
   std::cout << "league\n";
@@ -11,15 +11,21 @@
 #include "io/ZipArchive.hpp"
 #include "util/PrintException.hxx"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 
 unsigned Layout::scale_1024 = 1024;
 
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "PATH");
+  Args args(argc, argv, "PATH [RADIUS]");
   const auto map_path = args.ExpectNextPath();
+  const double radius = args.IsEmpty() ? 50000 : atof(args.GetNext());
   args.ExpectEnd();
 
   ZipArchive archive(map_path);
@@ -31,6 +37,10 @@ try {
     LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
   }
 
+  printf("%ux%u pixels, pyramid uses %.1f MB\n",
+         map.GetTileCache().GetSize().x, map.GetTileCache().GetSize().y,
+         map.GetTileCache().GetPyramidBytes() / (1024. * 1024.));
+
   map.UpdateProjection();
 
   SharedMutex mutex;
@@ -40,7 +50,6 @@ try {
                        map.GetMapCenter(), 50000);
   } while (map.IsDirty());
 
-  double radius = 50000;
   WindowProjection projection;
   projection.SetScreenSize({640, 480});
   projection.SetScaleFromRadius(radius);
@@ -48,15 +57,36 @@ try {
   projection.SetScreenOrigin(320, 240);
   projection.UpdateScreenBounds();
 
+  /* the median of several runs, because a single fill takes only a
+     few milliseconds */
   HeightMatrix matrix;
+  std::array<double, 101> durations;
+  for (auto &d : durations) {
+    const auto start = std::chrono::steady_clock::now();
+
 #ifdef ENABLE_OPENGL
-  matrix.Fill(map, projection.GetScreenBounds(),
-              (UnsignedPoint2D)projection.GetScreenSize(),
-              false);
+    matrix.Fill(map, projection.GetScreenBounds(),
+                (UnsignedPoint2D)projection.GetScreenSize(),
+                false);
 #else
-  matrix.Fill(map, projection, 1, false);
+    matrix.Fill(map, projection, 1, false);
 #endif
 
+    const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+    d = duration.count();
+  }
+
+  std::sort(durations.begin(), durations.end());
+
+  long sum = 0;
+  for (auto i = matrix.GetData(); i != matrix.GetDataEnd(); ++i)
+    sum += i->GetValueOr0();
+
+  printf("fill took %.3f ms (median of %zu), average height %ld m\n",
+         durations[durations.size() / 2], durations.size(),
+         sum / (long)(matrix.GetSize().x * matrix.GetSize().y));
+
   return EXIT_SUCCESS;
 } catch (const std::runtime_error &e) {
   PrintException(e);
@@ -7,6 +7,8 @@
 #define ENABLE_MAIN_WINDOW
 #define ENABLE_CLOSE_BUTTON
 #define ENABLE_LOOK
+#define ENABLE_CMDLINE
+#define USAGE "[-WxH] [--pan [--flush]]"
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/Patterns.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
@@ -29,6 +31,11 @@
 #include "io/ConfiguredFile.hpp"
 #include "io/FileReader.hxx"
 #include "thread/Debug.hpp"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
 
 void
 DeviceBlackboard::SetStartupLocation([[maybe_unused]] const GeoPoint &loc,
@@ -61,6 +68,18 @@ UIGlobals::GetMapIfActive()
 
 static Waypoints way_points;
 
+/**
+ * Pan the map along a scripted path and print frame times instead of
+ * running the event loop?
+ */
+static bool pan_benchmark = false;
+
+/**
+ * Flush all render caches before each frame of the pan benchmark, to
+ * compare with a full redraw.
+ */
+static bool pan_flush = false;
+
 static Airspaces airspace_database;
 
 static TopographyStore *topography;
@@ -114,7 +133,7 @@ LoadFiles(PlacesOfInterestSettings &poi_settings,
   ConsoleOperationEnvironment operation;
 
   topography = new TopographyStore();
-  LoadConfiguredTopography(*topography);
+  LoadConfiguredTopography(*topography, nullptr);
 
   terrain = RasterTerrain::OpenTerrain(nullptr, operation).release();
 
@@ -170,6 +189,73 @@ GenerateBlackboard(MapWindow &map, const ComputerSettings &settings_computer,
   map.UpdateScreenBounds();
 }
 
+static void
+ParseCommandLine(Args &args)
+{
+  while (!args.IsEmpty()) {
+    const char *a = args.GetNext();
+    if (StringIsEqual(a, "--pan"))
+      pan_benchmark = true;
+    else if (StringIsEqual(a, "--flush"))
+      pan_flush = true;
+    else
+      args.UsageError();
+  }
+}
+
+/**
+ * Pan the map in small steps, like dragging it with a finger: to the
+ * east, then back to the north-west, and print the time it takes to
+ * render each frame.
+ */
+static void
+RunPanBenchmark(TestMainWindow &main_window, TestMapWindow &map)
+{
+  constexpr unsigned N_FRAMES = 120;
+  constexpr int STEP = 8;
+
+  using Duration = std::chrono::duration<double, std::milli>;
+  std::vector<double> frame_times;
+  frame_times.reserve(N_FRAMES);
+
+  for (unsigned i = 0; i < N_FRAMES; ++i) {
+    const PixelPoint offset = i < N_FRAMES / 2
+      ? PixelPoint{STEP, 0}
+      : PixelPoint{-STEP, -STEP};
+
+    const auto &projection = map.VisibleProjection();
+    map.SetLocation(projection.ScreenToGeo(projection.GetScreenCenter()
+                                           + offset));
+    map.UpdateScreenBounds();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    if (pan_flush)
+      map.FlushCaches();
+
+#ifdef ENABLE_OPENGL
+    DrawThread::UpdateAll(map);
+    map.Invalidate();
+#else
+    DrawThread::Draw(map);
+#endif
+    main_window.Refresh();
+
+    frame_times.push_back(Duration(std::chrono::steady_clock::now()
+                                   - start).count());
+  }
+
+  double total = 0;
+  for (const double t : frame_times)
+    total += t;
+
+  std::sort(frame_times.begin(), frame_times.end());
+
+  printf("%u frames%s: average %.2f ms, median %.2f ms, maximum %.2f ms\n",
+         N_FRAMES, pan_flush ? " (caches flushed)" : "",
+         total / N_FRAMES, frame_times[N_FRAMES / 2], frame_times.back());
+}
+
 void
 Main(TestMainWindow &main_window)
 {
@@ -201,7 +287,10 @@ Main(TestMainWindow &main_window)
   map.initialised = true;
 #endif
 
-  main_window.RunEventLoop();
+  if (pan_benchmark)
+    RunPanBenchmark(main_window, map);
+  else
+    main_window.RunEventLoop();
 
   delete terrain;
   delete topography;
@@ -30,7 +30,7 @@ public:
 
 class MyHandler : public DataHandler {
 public:
-  bool DataReceived(std::span<const std::byte> s) noexcept override {
+  bool DataReceived(std::span<const std::byte> s, bool) noexcept override {
     return fwrite(s.data(), 1, s.size(), stdout) == s.size();
   }
 };
@@ -42,7 +42,7 @@ public:
     to_port = _to_port;
   }
 
-  bool DataReceived(std::span<const std::byte> s) noexcept override {
+  bool DataReceived(std::span<const std::byte> s, bool) noexcept override {
     char prefix[32];
     sprintf(prefix, "[%u] %12llu ", no, (unsigned long long)
             std::chrono::steady_clock::now().time_since_epoch().count());
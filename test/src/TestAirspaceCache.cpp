@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Save airspaces parsed from a text file to the binary cache, load
+ * them back and compare, and check that the cache becomes stale when
+ * the text file changes.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "system/FileUtil.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <iterator>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static void
+LoadText(Airspaces &airspaces, Path path)
+{
+  FileReader file_reader{path};
+  BufferedReader buffered_reader{file_reader};
+  ParseAirspaceFile(airspaces, buffered_reader);
+}
+
+static bool
+Equals(const AirspaceAltitude &a, const AirspaceAltitude &b) noexcept
+{
+  return a.altitude == b.altitude && a.flight_level == b.flight_level &&
+    a.altitude_above_terrain == b.altitude_above_terrain &&
+    a.reference == b.reference;
+}
+
+static bool
+Equals(TransponderCode a, TransponderCode b) noexcept
+{
+  return a.IsDefined()
+    ? b.IsDefined() && a.GetCode() == b.GetCode()
+    : !b.IsDefined();
+}
+
+static bool
+Equals(const AbstractAirspace &a, const AbstractAirspace &b) noexcept
+{
+  if (a.GetShape() != b.GetShape() ||
+      !StringIsEqual(a.GetName(), b.GetName()) ||
+      !StringIsEqual(a.GetStationName(), b.GetStationName()) ||
+      a.GetClass() != b.GetClass() || a.GetType() != b.GetType() ||
+      !Equals(a.GetBase(), b.GetBase()) || !Equals(a.GetTop(), b.GetTop()) ||
+      a.GetRadioFrequency() != b.GetRadioFrequency() ||
+      !Equals(a.GetTransponderCode(), b.GetTransponderCode()) ||
+      !a.GetDays().equals(b.GetDays()))
+    return false;
+
+  const auto &pa = a.GetPoints(), &pb = b.GetPoints();
+  if (pa.size() != pb.size())
+    return false;
+
+  for (std::size_t i = 0; i < pa.size(); ++i)
+    if (pa[i].GetLocation() != pb[i].GetLocation())
+      return false;
+
+  return true;
+}
+
+static bool
+Compare(const Airspaces &a, const Airspaces &b) noexcept
+{
+  if (a.GetSize() != b.GetSize())
+    return false;
+
+  /* both trees were bulk-loaded from the same airspaces in the same
+     order, so they have the same layout */
+  const auto range = b.QueryAll();
+  auto j = range.begin();
+  for (const auto &i : a.QueryAll()) {
+    if (!Equals(i.GetAirspace(), j->GetAirspace()))
+      return false;
+
+    ++j;
+  }
+
+  return true;
+}
+
+/**
+ * Copy a file, optionally appending a line.
+ */
+static bool
+CopyFile(const char *src, const char *dest, const char *append=nullptr)
+{
+  FILE *in = fopen(src, "rb");
+  if (in == nullptr)
+    return false;
+
+  FILE *out = fopen(dest, "wb");
+  if (out == nullptr) {
+    fclose(in);
+    return false;
+  }
+
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0)
+    fwrite(buffer, 1, n, out);
+
+  if (append != nullptr)
+    fputs(append, out);
+
+  fclose(in);
+  return fclose(out) == 0;
+}
+
+static void
+TestFile(FileCache &cache, const char *cache_dir, const char *src)
+{
+  /* work on a copy, which gets modified below */
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", cache_dir, "airspace.txt");
+  ok1(CopyFile(src, path));
+
+  Airspaces text_airspaces;
+  LoadText(text_airspaces, Path(path));
+  ok1(!text_airspaces.GetPending().empty());
+
+  {
+    Airspaces airspaces;
+    ok1(!LoadAirspaceCache(cache, Path(path), airspaces));
+  }
+
+  const auto &pending = text_airspaces.GetPending();
+  SaveAirspaceCache(cache, Path(path), pending.begin(), pending.end());
+  text_airspaces.Optimise();
+
+  Airspaces cache_airspaces;
+  ok1(LoadAirspaceCache(cache, Path(path), cache_airspaces));
+  cache_airspaces.Optimise();
+  ok1(Compare(text_airspaces, cache_airspaces));
+
+  /* change the source file; the cache must not be used anymore */
+  ok1(CopyFile(src, path, "\n* modified\n"));
+
+  Airspaces stale_airspaces;
+  ok1(!LoadAirspaceCache(cache, Path(path), stale_airspaces));
+  ok1(stale_airspaces.GetPending().empty());
+
+  File::Delete(Path(path));
+}
+
+int main()
+try {
+  static const char *const files[] = {
+    "test/data/airspace/openair.txt",
+    "test/data/airspace/tnp.sua",
+  };
+
+  plan_tests(std::size(files) * 8);
+
+  char cache_dir[] = "/tmp/TestAirspaceCache.XXXXXX";
+  if (mkdtemp(cache_dir) == nullptr) {
+    perror("mkdtemp() failed");
+    return EXIT_FAILURE;
+  }
+
+  FileCache cache{AllocatedPath{cache_dir}};
+
+  for (const char *i : files)
+    TestFile(cache, cache_dir, i);
+
+  struct DeleteVisitor final : File::Visitor {
+    void Visit(Path p, Path) override {
+      File::Delete(p);
+    }
+  } delete_visitor;
+  Directory::VisitFiles(Path{cache_dir}, delete_visitor);
+  rmdir(cache_dir);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Feed the same fixes into #Trace and #ArrayTrace and verify that
+ * both keep exactly the same points after appending (which thins the
+ * trace), erasing and appending again.
+ */
+
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/ArrayTrace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <iterator>
+
+using namespace std::chrono;
+
+using Time = TracePoint::Time;
+
+struct TraceConfig {
+  Time no_thin_time, max_time;
+  unsigned max_size;
+};
+
+static constexpr TraceConfig configs[] = {
+  /* like TraceComputer::full */
+  { minutes{2}, Trace::null_time, 1024 },
+  /* like TraceComputer::contest */
+  { {}, Trace::null_time, 256 },
+  /* like TraceComputer::sprint */
+  { {}, hours{2}, 128 },
+  { {}, Trace::null_time, 16 },
+};
+
+/**
+ * Generate a fix for each second: a circling glider drifting east,
+ * with a straight glide every few minutes, so the thinning has some
+ * points to choose from.
+ */
+static TracePoint
+MakeFix(unsigned i) noexcept
+{
+  const double t = i;
+  const bool circling = (i / 300) % 2 == 0;
+  const double angle = circling ? t * 0.3 : 0;
+  const double radius = circling ? 0.002 : 0;
+
+  const GeoPoint location(Angle::Degrees(7 + t * 0.0002 + radius * std::cos(angle)),
+                          Angle::Degrees(51 + radius * std::sin(angle)));
+  return TracePoint(location, Time{i}, 1000 + 200 * std::sin(t / 500),
+                    0, 0);
+}
+
+static bool
+Compare(const Trace &a, const ArrayTrace &b) noexcept
+{
+  if (a.size() != b.size() ||
+      a.GetAverageDeltaDistance() != b.GetAverageDeltaDistance() ||
+      a.GetAverageDeltaTime() != b.GetAverageDeltaTime())
+    return false;
+
+  auto j = b.begin();
+  for (const auto &i : a) {
+    if (i.GetTime() != j->GetTime() ||
+        i.GetFlatLocation() != j->GetFlatLocation() ||
+        i.GetAltitude() != j->GetAltitude())
+      return false;
+
+    ++j;
+  }
+
+  TracePointVector va, vb;
+  a.GetPoints(va);
+  b.GetPoints(vb);
+  if (va.size() != vb.size())
+    return false;
+
+  for (std::size_t k = 0; k < va.size(); ++k)
+    if (va[k].GetTime() != vb[k].GetTime())
+      return false;
+
+  return true;
+}
+
+static void
+Append(Trace &a, ArrayTrace &b, unsigned first, unsigned last) noexcept
+{
+  for (unsigned i = first; i < last; ++i) {
+    const auto fix = MakeFix(i);
+    a.push_back(fix);
+    b.push_back(fix);
+  }
+}
+
+static void
+TestConfig(const TraceConfig &config)
+{
+  Trace a(config.no_thin_time, config.max_time, config.max_size);
+  ArrayTrace b(config.no_thin_time, config.max_time, config.max_size);
+
+  /* a few times the maximum size, so the trace gets thinned */
+  Append(a, b, 0, 6000);
+  ok1(a.size() <= config.max_size);
+  ok1(Compare(a, b));
+
+  /* erase a quarter of the points at each end */
+  const Time earliest = std::next(a.begin(), a.size() / 4)->GetTime();
+  const Time latest = std::next(a.begin(), a.size() * 3 / 4)->GetTime();
+
+  a.EraseEarlierThan(TimeStamp{earliest});
+  b.EraseEarlierThan(TimeStamp{earliest});
+  ok1(!a.empty() && a.front().GetTime() >= earliest);
+  ok1(Compare(a, b));
+
+  a.EraseLaterThan(TimeStamp{latest});
+  b.EraseLaterThan(TimeStamp{latest});
+  ok1(!a.empty() && a.back().GetTime() <= latest);
+  ok1(Compare(a, b));
+
+  /* continue after the erased tail */
+  Append(a, b, latest.count() + 1, 9000);
+  ok1(Compare(a, b));
+
+  a.clear();
+  b.clear();
+  ok1(b.empty());
+
+  Append(a, b, 100, 400);
+  ok1(Compare(a, b));
+}
+
+int
+main()
+{
+  plan_tests(std::size(configs) * 9);
+
+  for (const auto &config : configs)
+    TestConfig(config);
+
+  return exit_status();
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replay an IGC file into bounded traces (which get thinned during
+ * the flight) and run the #ContestDijkstra solvers incrementally, like
+ * ContestComputer does.  The result found during the flight must be
+ * close to a full solve on the same traces, and after the final
+ * exhaustive search, it must be as good.
+ */
+
+#include "Contest/Solvers/OLCClassic.hpp"
+#include "Contest/Solvers/OLCSISAT.hpp"
+#include "Contest/Solvers/Charron.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+#include <array>
+#include <iterator>
+#include <memory>
+
+#include <stdio.h>
+
+struct Traces {
+  Trace full{{}, Trace::null_time, 512};
+  Trace triangle{{}, Trace::null_time, 512};
+
+  void push_back(const TracePoint &point) noexcept {
+    full.push_back(point);
+    triangle.push_back(point);
+  }
+};
+
+/**
+ * The #ContestDijkstra solvers, in the configuration used by
+ * #ContestManager.
+ */
+struct Solvers {
+  static constexpr std::size_t N = 4;
+
+  OLCClassic classic;
+  OLCSISAT sis_at;
+  Charron charron_small, charron_large;
+
+  explicit Solvers(const Traces &traces) noexcept
+    :classic(traces.full), sis_at(traces.full),
+     charron_small(traces.triangle, false),
+     charron_large(traces.triangle, true) {
+    for (auto *i : All())
+      i->Reset();
+  }
+
+  std::array<ContestDijkstra *, N> All() noexcept {
+    return {&classic, &sis_at, &charron_small, &charron_large};
+  }
+};
+
+static void
+TestFlight(const char *igc_path)
+{
+  Traces traces;
+  Solvers incremental{traces};
+  for (auto *i : incremental.All())
+    i->SetIncremental(true);
+
+  FileLineReaderA reader{Path(igc_path)};
+  IGCExtensions extensions;
+  extensions.clear();
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix)) {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    if (!fix.gps_valid)
+      continue;
+
+    const auto time = fix.time.DurationSinceMidnight();
+    traces.push_back(TracePoint(fix.location,
+                                std::chrono::duration_cast<std::chrono::duration<unsigned>>(time),
+                                fix.gps_altitude, 0, 0));
+
+    for (auto *i : incremental.All())
+      i->Solve(false);
+  }
+
+  /* reference: solve from scratch on the same traces */
+  Solvers full{traces};
+
+  const auto a = full.All(), b = incremental.All();
+  for (std::size_t i = 0; i < Solvers::N; ++i) {
+    /* the edge map survives the thinning, so the result found during
+       the flight is close to the optimum already */
+    const double flight_score = b[i]->GetBestResult().score;
+
+    b[i]->Solve(true);
+    a[i]->Solve(true);
+
+    const double full_score = a[i]->GetBestResult().score;
+    const double incremental_score = b[i]->GetBestResult().score;
+    if (!ok1(full_score > 0 && incremental_score >= full_score - 0.05))
+      printf("# %s solver %u: full %.1f, incremental %.1f\n",
+             igc_path, unsigned(i), full_score, incremental_score);
+
+    if (!ok1(flight_score >= full_score * 0.99))
+      printf("# %s solver %u: full %.1f, during the flight %.1f\n",
+             igc_path, unsigned(i), full_score, flight_score);
+  }
+}
+
+int main()
+{
+  plan_tests(Solvers::N * 2);
+
+  /* the longest flight in test/data, the traces get thinned many
+     times */
+  TestFlight("test/data/01lz1hq1.igc");
+
+  return exit_status();
+}
@@ -2889,6 +2889,12 @@ TestMalformedInput()
 
   /* GSA with completely empty fields — should not crash */
   ok1(parser.ParseLine("$GPGSA,,,,,,,,,,,,,,,,,*6E", nmea_info));
+
+  /* unknown sentence types are rejected, even if a known type is a
+     prefix or if they are too long for MakeNMEASentenceType() */
+  ok1(!parser.ParseLine("$GPXYZ,1*51", nmea_info));
+  ok1(!parser.ParseLine("$GPRMCX,082322.00,A*75", nmea_info));
+  ok1(!parser.ParseLine("$PFLAAAAAA,1*47", nmea_info));
 }
 
 int main()
@@ -2908,7 +2914,7 @@ int main()
     + 2     /* ReadGeoAngleNoDot */
     + 13    /* GLL */
     + 20    /* GSA */
-    + 23    /* MalformedInput */
+    + 26    /* MalformedInput */
     + 2     // TestDeclare(altair_pro_driver)
     + 2     // TestDeclare(vega_driver)
     + 3     // Flarm!
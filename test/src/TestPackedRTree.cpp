@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare the PackedRTree queries with a brute-force scan, after bulk
+ * loading, with an unindexed tail, and after erasing values.
+ */
+
+#include "util/PackedRTree.hxx"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+struct Item {
+  int x, y;
+  unsigned id;
+};
+
+struct ItemAccessor {
+  int GetX(const Item &item) const noexcept {
+    return item.x;
+  }
+
+  int GetY(const Item &item) const noexcept {
+    return item.y;
+  }
+};
+
+using Tree = PackedRTree<Item, ItemAccessor>;
+
+static Tree::square_distance_type
+SquareDistance(const Item &item, Tree::Point p) noexcept
+{
+  return Tree::Point(item.x, item.y).SquareDistanceTo(p);
+}
+
+static std::vector<unsigned>
+SortedIds(std::vector<unsigned> &&ids) noexcept
+{
+  std::sort(ids.begin(), ids.end());
+  return std::move(ids);
+}
+
+/**
+ * Check VisitWithinRange(), FindNearest() and FindNearestIf() at
+ * random locations.
+ *
+ * @return the number of queries which differ from the brute-force
+ * result
+ */
+static unsigned
+CountMismatches(const Tree &tree, std::mt19937 &rng)
+{
+  std::uniform_int_distribution<int> random_position(-120000, 120000);
+  std::uniform_int_distribution<unsigned> random_range(0, 30000);
+
+  unsigned mismatches = 0;
+
+  for (unsigned i = 0; i < 200; ++i) {
+    const Tree::Point location(random_position(rng), random_position(rng));
+    const unsigned range = random_range(rng);
+    const auto square_range = Tree::Square(range);
+
+    std::vector<unsigned> expected;
+    for (const auto &item : tree)
+      if (SquareDistance(item, location) <= square_range)
+        expected.push_back(item.id);
+
+    std::vector<unsigned> found;
+    const auto visitor = [&found](const Item &item){
+      found.push_back(item.id);
+    };
+    tree.VisitWithinRange(location, range, visitor);
+
+    if (SortedIds(std::move(found)) != SortedIds(std::move(expected)))
+      ++mismatches;
+
+    /* nearest: ties are possible, so compare the distance */
+    for (const bool odd : {false, true}) {
+      const auto predicate = [odd](const Item &item){
+        return !odd || item.id % 2 == 1;
+      };
+
+      const Item *nearest = nullptr;
+      for (const auto &item : tree)
+        if (predicate(item) &&
+            SquareDistance(item, location) <= square_range &&
+            (nearest == nullptr ||
+             SquareDistance(item, location) < SquareDistance(*nearest, location)))
+          nearest = &item;
+
+      const auto it = tree.FindNearestIf(location, range, predicate);
+      if (nearest == nullptr
+          ? it != tree.end()
+          : it == tree.end() || !predicate(*it) ||
+            SquareDistance(*it, location) != SquareDistance(*nearest, location))
+        ++mismatches;
+    }
+  }
+
+  return mismatches;
+}
+
+int main()
+{
+  plan_tests(16);
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> random_position(-100000, 100000);
+
+  Tree tree;
+  ok1(tree.IsEmpty());
+  ok1(CountMismatches(tree, rng) == 0);
+
+  /* bulk load */
+  unsigned next_id = 0;
+  for (unsigned i = 0; i < 5000; ++i)
+    tree.Add(Item{random_position(rng), random_position(rng), next_id++});
+
+  /* a few duplicate positions */
+  for (unsigned i = 0; i < 100; ++i) {
+    const Item &item = *std::next(tree.begin(), i * 7);
+    tree.Add(Item{item.x, item.y, next_id++});
+  }
+
+  tree.Optimise();
+  ok1(tree.IsOptimised());
+  ok1(tree.size() == 5100);
+  ok1(CountMismatches(tree, rng) == 0);
+
+  /* values appended after Optimise() are in the unindexed tail */
+  for (unsigned i = 0; i < 300; ++i)
+    tree.Add(Item{random_position(rng), random_position(rng), next_id++});
+
+  ok1(!tree.IsOptimised());
+  ok1(CountMismatches(tree, rng) == 0);
+
+  /* erasing tail values keeps the index */
+  tree.EraseIf([](const Item &item){ return item.id >= 5300; });
+  ok1(tree.size() == 5300);
+  ok1(CountMismatches(tree, rng) == 0);
+
+  tree.EraseIf([](const Item &item){ return item.id >= 5100; });
+  ok1(tree.size() == 5100);
+  ok1(tree.IsOptimised());
+
+  /* erasing indexed values drops the index */
+  tree.EraseIf([](const Item &item){ return item.id % 3 == 0; });
+  ok1(tree.size() == 3400);
+  ok1(!tree.IsOptimised());
+  ok1(CountMismatches(tree, rng) == 0);
+
+  tree.Optimise();
+  ok1(tree.IsOptimised());
+  ok1(CountMismatches(tree, rng) == 0);
+
+  return exit_status();
+}
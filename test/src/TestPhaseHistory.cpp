@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Screen/PhaseHistory.hpp"
+#include "TestUtil.hpp"
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+static void
+TestEmpty()
+{
+  PhaseHistory history;
+  const auto s = history.GetSummary();
+  ok1(s.count == 0);
+  ok1(s.window == 0);
+  ok1(s.p50.count() == 0);
+  ok1(s.p95.count() == 0);
+  ok1(s.max.count() == 0);
+}
+
+static void
+TestPercentiles()
+{
+  PhaseHistory history;
+
+  /* add 1..100 ms in shuffled order */
+  for (unsigned i = 0; i < 100; ++i)
+    history.Add(milliseconds{(i * 37) % 100 + 1});
+
+  const auto s = history.GetSummary();
+  ok1(s.count == 100);
+  ok1(s.window == 100);
+  ok1(s.p50 == milliseconds{50});
+  ok1(s.p95 == milliseconds{95});
+  ok1(s.max == milliseconds{100});
+
+  history.Add(microseconds{-5});
+  ok1(history.GetSummary().count == 101);
+
+  history.Clear();
+  ok1(history.GetSummary().count == 0);
+  ok1(history.GetSummary().window == 0);
+}
+
+static void
+TestWindow()
+{
+  PhaseHistory history;
+
+  /* these samples fall out of the window */
+  for (unsigned i = 0; i < PhaseHistory::GetWindowSize(); ++i)
+    history.Add(milliseconds{1000});
+
+  for (unsigned i = 0; i < PhaseHistory::GetWindowSize(); ++i)
+    history.Add(microseconds{i < 10 ? 300 : 200});
+
+  const auto s = history.GetSummary();
+  ok1(s.count == 2 * PhaseHistory::GetWindowSize());
+  ok1(s.window == PhaseHistory::GetWindowSize());
+  ok1(s.p50 == microseconds{200});
+  ok1(s.p95 == microseconds{200});
+  ok1(s.max == microseconds{300});
+}
+
+int
+main()
+{
+  plan_tests(5 + 8 + 5);
+
+  TestEmpty();
+  TestPercentiles();
+  TestWindow();
+
+  return exit_status();
+}
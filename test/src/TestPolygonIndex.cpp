@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare the #PolygonIndex queries with the plain code:
+ * IsInside() with PolygonInterior(), and VisitEdgesNear() with a
+ * bounding box check of each edge.  The query points include the
+ * vertex latitudes and the latitude band borders.
+ */
+
+#include "Geo/PolygonIndex.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Geo/ConvexHull/PolygonInterior.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+static const GeoPoint center(Angle::Degrees(7.7), Angle::Degrees(51.05));
+
+/**
+ * A concave star with many vertices.
+ */
+static SearchPointVector
+MakeStar(std::mt19937 &rng, unsigned n)
+{
+  std::uniform_real_distribution<double> jitter(0.8, 1.2);
+
+  SearchPointVector border;
+  for (unsigned i = 0; i < n; ++i) {
+    const double radius = (i % 2 == 0 ? 0.5 : 0.2) * jitter(rng);
+    const double angle = 2 * M_PI * i / n;
+    border.emplace_back(GeoPoint(center.longitude +
+                                 Angle::Degrees(radius * std::cos(angle)),
+                                 center.latitude +
+                                 Angle::Degrees(radius * std::sin(angle))));
+  }
+
+  border.push_back(border.front());
+  return border;
+}
+
+/**
+ * A comb with horizontal edges, which are omitted by the index, and
+ * many vertices sharing the same latitude.
+ */
+static SearchPointVector
+MakeComb(unsigned n_teeth)
+{
+  const auto step = Angle::Degrees(0.01);
+
+  SearchPointVector border;
+  for (unsigned i = 0; i < n_teeth; ++i) {
+    const Angle x = center.longitude + step * (2 * i);
+    border.emplace_back(GeoPoint(x, center.latitude));
+    border.emplace_back(GeoPoint(x, center.latitude + Angle::Degrees(0.3)));
+    border.emplace_back(GeoPoint(x + step,
+                                 center.latitude + Angle::Degrees(0.3)));
+    border.emplace_back(GeoPoint(x + step,
+                                 center.latitude + Angle::Degrees(0.1)));
+  }
+
+  const Angle right = center.longitude + step * (2 * n_teeth);
+  border.emplace_back(GeoPoint(right, center.latitude + Angle::Degrees(0.1)));
+  border.emplace_back(GeoPoint(right, center.latitude - Angle::Degrees(0.1)));
+  border.emplace_back(GeoPoint(center.longitude,
+                               center.latitude - Angle::Degrees(0.1)));
+  border.push_back(border.front());
+  return border;
+}
+
+static unsigned
+CountInsideMismatches(const SearchPointVector &border,
+                      const PolygonIndex &index,
+                      const std::vector<GeoPoint> &points) noexcept
+{
+  unsigned mismatches = 0;
+  for (const auto &p : points)
+    if (index.IsInside(p) != PolygonInterior(p, border.begin(), border.end()))
+      ++mismatches;
+  return mismatches;
+}
+
+static void
+TestInside(std::mt19937 &rng, const SearchPointVector &border)
+{
+  const PolygonIndex index(border);
+
+  double min_y = border.front().GetLocation().latitude.Native();
+  double max_y = min_y;
+  double min_x = border.front().GetLocation().longitude.Native();
+  double max_x = min_x;
+  for (const auto &i : border) {
+    min_y = std::min(min_y, i.GetLocation().latitude.Native());
+    max_y = std::max(max_y, i.GetLocation().latitude.Native());
+    min_x = std::min(min_x, i.GetLocation().longitude.Native());
+    max_x = std::max(max_x, i.GetLocation().longitude.Native());
+  }
+
+  const double margin = (max_y - min_y) / 10;
+  std::uniform_real_distribution<double> random_x(min_x - margin,
+                                                  max_x + margin);
+  std::uniform_real_distribution<double> random_y(min_y - margin,
+                                                  max_y + margin);
+
+  const auto MakePoint = [](double x, double y){
+    return GeoPoint(Angle::Radians(x), Angle::Radians(y));
+  };
+
+  /* random points around the polygon */
+  std::vector<GeoPoint> points;
+  for (unsigned i = 0; i < 2000; ++i)
+    points.push_back(MakePoint(random_x(rng), random_y(rng)));
+  ok1(CountInsideMismatches(border, index, points) == 0);
+
+  /* the vertices, and points at the latitude of each vertex */
+  points.clear();
+  for (const auto &i : border) {
+    points.push_back(i.GetLocation());
+    for (unsigned j = 0; j < 4; ++j)
+      points.push_back(MakePoint(random_x(rng),
+                                 i.GetLocation().latitude.Native()));
+  }
+  ok1(CountInsideMismatches(border, index, points) == 0);
+
+  /* the band borders (calculated like the PolygonIndex constructor
+     does) and their neighbours, including the bottom and the top of
+     the polygon */
+  const unsigned n_bands =
+    std::clamp<unsigned>((border.size() - 1) / 8, 1, 1024);
+  points.clear();
+  for (unsigned b = 0; b <= n_bands; ++b) {
+    const double y = b == n_bands
+      ? max_y
+      : min_y + b * (max_y - min_y) / n_bands;
+
+    for (const double y2 : {std::nextafter(y, min_y - 1), y,
+                            std::nextafter(y, max_y + 1)})
+      for (unsigned j = 0; j < 8; ++j)
+        points.push_back(MakePoint(random_x(rng), y2));
+  }
+  ok1(CountInsideMismatches(border, index, points) == 0);
+}
+
+static void
+TestEdgesNear(std::mt19937 &rng, SearchPointVector &border)
+{
+  const FlatProjection projection(center);
+  border.Project(projection);
+
+  PolygonIndex index(border);
+  index.Project(border);
+
+  std::uniform_real_distribution<double> offset(-0.7, 0.7);
+
+  /* a random point near the polygon, up to the given distance (in
+     degrees) from the center */
+  const auto RandomPoint = [&](double scale){
+    const GeoPoint p(center.longitude + Angle::Degrees(offset(rng) * scale),
+                     center.latitude + Angle::Degrees(offset(rng) * scale));
+    return projection.ProjectInteger(p);
+  };
+
+  unsigned mismatches = 0;
+  for (unsigned i = 0; i < 200; ++i) {
+    const auto a = RandomPoint(1), b = RandomPoint(0.2);
+
+    std::vector<std::size_t> visited;
+    index.VisitEdgesNear(a, b, [&visited](std::size_t k){
+      visited.push_back(k);
+    });
+
+    std::vector<std::size_t> expected;
+    for (std::size_t k = 0; k + 1 < border.size(); ++k) {
+      const auto p = border[k].GetFlatLocation();
+      const auto q = border[k + 1].GetFlatLocation();
+      if (std::max(p.x, q.x) >= std::min(a.x, b.x) &&
+          std::min(p.x, q.x) <= std::max(a.x, b.x) &&
+          std::max(p.y, q.y) >= std::min(a.y, b.y) &&
+          std::min(p.y, q.y) <= std::max(a.y, b.y))
+        expected.push_back(k);
+    }
+
+    if (visited != expected)
+      ++mismatches;
+  }
+
+  ok1(mismatches == 0);
+}
+
+int main()
+{
+  plan_tests(5 * 4);
+
+  std::mt19937 rng(42);
+
+  for (const unsigned n : {unsigned(PolygonIndex::MIN_SIZE), 1000u, 4000u}) {
+    auto border = MakeStar(rng, n);
+    TestInside(rng, border);
+    TestEdgesNear(rng, border);
+  }
+
+  for (const unsigned n : {16u, 500u}) {
+    auto border = MakeComb(n);
+    TestInside(rng, border);
+    TestEdgesNear(rng, border);
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare the reach calculated by TerrainRoute::SolveReach() with
+ * and without incremental updates (see ReachFan::Update()) against a
+ * full ReachFan::Solve() on real terrain.
+ */
+
+#include "Engine/Route/TerrainRoute.hpp"
+#include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/ReachResult.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/Math.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/Operation.hpp"
+#include "io/ZipArchive.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+#include <climits>
+#include <cstdlib>
+
+static constexpr unsigned N_STEPS = 24;
+static constexpr unsigned N_DESTINATIONS = 64;
+
+static void
+InitRoute(TerrainRoute &route, const RasterMap &map)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+
+  const GlidePolar polar(1);
+  route.UpdatePolar(settings, config, polar, polar, SpeedVector::Zero(),
+                    500);
+  route.SetTerrain(&map);
+}
+
+[[gnu::pure]]
+static GeoPoint
+GetDestination(const GeoPoint &origin, unsigned i)
+{
+  return FindLatitudeLongitude(origin, Angle::Degrees(360. * i / 16),
+                               1000 + 3000 * (i / 16));
+}
+
+/**
+ * Compare two reaches at #N_DESTINATIONS points around the origin.
+ *
+ * @return the number of points where the reachability differs, or
+ * -1 if an arrival height of a point reachable by both differs by
+ * more than #max_error
+ */
+static int
+CompareReach(const ReachFan &a, const ReachFan &b,
+             const RoutePolars &rpolars, const RasterMap &map,
+             const GeoPoint &origin, int max_error)
+{
+  int n_mismatches = 0;
+
+  for (unsigned i = 0; i < N_DESTINATIONS; ++i) {
+    const GeoPoint p = GetDestination(origin, i);
+    const AGeoPoint dest(p, map.GetInterpolatedHeight(p).GetValueOr0());
+
+    const auto ra = a.FindPositiveArrival(dest, rpolars);
+    const auto rb = b.FindPositiveArrival(dest, rpolars);
+    if (ra.has_value() != rb.has_value())
+      return -1;
+
+    if (!ra)
+      continue;
+
+    if (ra->IsReachableTerrain() != rb->IsReachableTerrain()) {
+      ++n_mismatches;
+      continue;
+    }
+
+    if (ra->IsReachableTerrain() &&
+        std::abs(ra->terrain - rb->terrain) > max_error)
+      return -1;
+  }
+
+  return n_mismatches;
+}
+
+int main()
+{
+  plan_tests(2 * N_STEPS + 1);
+
+  ZipArchive archive(Path("test/data/benalla9.xcm"));
+
+  RasterMap map;
+
+  {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  const GeoPoint start = map.GetMapCenter();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                       map.GetProjection(), start, 30000);
+  } while (map.IsDirty());
+
+  RoutePlannerConfig config;
+  config.SetDefaults();
+
+  TerrainRoute full, incremental;
+  InitRoute(full, map);
+  InitRoute(incremental, map);
+
+  RoutePlannerConfig incremental_config = config;
+  incremental_config.reach_incremental = true;
+
+  const double start_altitude =
+    map.GetHeight(start).GetValueOr0() + 400;
+
+  unsigned n_mismatches = 0;
+
+  /* glide north in steps of 150 m and 5 m; this allows a few
+     incremental updates between full solves */
+  for (unsigned i = 0; i < N_STEPS; ++i) {
+    const AGeoPoint origin(FindLatitudeLongitude(start, Angle::Zero(),
+                                                 150 * i),
+                           start_altitude - 5 * i);
+
+    const auto a = full.SolveReach(origin, config, INT_MAX, true, false);
+    const auto b = incremental.SolveReach(origin, incremental_config,
+                                          INT_MAX, true, false);
+
+    /* reference: a fresh ReachFan */
+    RoutePolars rpolars = full.GetReachPolar();
+    rpolars.SetConfig(config, origin.altitude, INT_MAX);
+    ReachFan reference;
+    reference.Solve(origin, rpolars, &map);
+
+    /* without incremental updates, the result must be exact */
+    ok1(CompareReach(reference, a, rpolars, map, origin, 0) == 0);
+
+    /* incremental updates may be a little off, but only near
+       terrain obstacles */
+    const int m = CompareReach(reference, b, rpolars, map, origin, 50);
+    ok1(m >= 0);
+    if (m > 0)
+      n_mismatches += m;
+  }
+
+  /* the reachability must not differ at more than 2% of the
+     points */
+  ok1(n_mismatches * 50 <= N_STEPS * N_DESTINATIONS);
+
+  return exit_status();
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/SnapshotBuffer.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/**
+ * A value which is large enough to be torn if it were copied without
+ * synchronisation.
+ */
+struct Value {
+  unsigned data[1024];
+
+  Value() noexcept {
+    Fill(0);
+  }
+
+  void Fill(unsigned x) noexcept {
+    std::fill(std::begin(data), std::end(data), x);
+  }
+
+  bool IsConsistent() const noexcept {
+    return std::all_of(std::begin(data), std::end(data), [this](unsigned x){
+      return x == data[0];
+    });
+  }
+};
+
+static void
+TestSingleThread()
+{
+  SnapshotBuffer<int> buffer;
+  ok1(buffer.GetVersion() == 0);
+
+  buffer.Publish(1);
+  ok1(buffer.GetVersion() == 1);
+
+  {
+    const SnapshotBuffer<int>::Lease a{buffer};
+    ok1(a == 1);
+
+    /* an existing lease keeps its value */
+    buffer.Publish(2);
+    buffer.Publish(3);
+    ok1(a == 1);
+
+    const SnapshotBuffer<int>::Lease b{buffer};
+    ok1(b == 3);
+    ok1(a == 1);
+  }
+
+  /* after the leases are gone, all slots can be reused */
+  for (int i = 4; i < 20; ++i)
+    buffer.Publish(i);
+
+  const SnapshotBuffer<int>::Lease c{buffer};
+  ok1(c == 19);
+
+  const auto s = buffer.GetStatistics();
+  ok1(s.writes == 19);
+  ok1(s.reads == 3);
+  ok1(s.read_retries == 0);
+  ok1(s.write_waits == 0);
+  ok1(s.GetWrittenBytes() == 19 * sizeof(int));
+}
+
+static void
+TestConcurrent()
+{
+  static constexpr unsigned N_READERS = 4;
+  static constexpr unsigned N_WRITES = 2000;
+
+  SnapshotBuffer<Value> buffer;
+  std::atomic<bool> done{false};
+  std::atomic<unsigned> inconsistent{0}, backwards{0};
+
+  std::thread readers[N_READERS];
+  for (auto &t : readers)
+    t = std::thread([&](){
+      unsigned last = 0;
+      while (!done.load()) {
+        const SnapshotBuffer<Value>::Lease lease{buffer};
+        const Value &value = lease;
+        if (!value.IsConsistent())
+          ++inconsistent;
+        if (value.data[0] < last)
+          ++backwards;
+        last = value.data[0];
+      }
+    });
+
+  Value value;
+  for (unsigned i = 1; i <= N_WRITES; ++i) {
+    value.Fill(i);
+    buffer.Publish(value);
+  }
+
+  done = true;
+  for (auto &t : readers)
+    t.join();
+
+  ok1(inconsistent == 0);
+  ok1(backwards == 0);
+  ok1(buffer.GetVersion() == N_WRITES);
+
+  const SnapshotBuffer<Value>::Lease lease{buffer};
+  ok1(lease->data[0] == N_WRITES);
+}
+
+int
+main()
+{
+  plan_tests(12 + 4);
+
+  TestSingleThread();
+  TestConcurrent();
+
+  return exit_status();
+}
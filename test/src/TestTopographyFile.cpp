@@ -0,0 +1,380 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Write a shapefile with three clusters of point shapes, pan a
+ * #TopographyFile between them and check the LRU statistics (reuse of
+ * resident shapes, eviction beyond MAX_RESIDENT_SHAPES).  Then do the
+ * same with a #ShapeCache and compare its shapes with the ones loaded
+ * from the shapefile.
+ */
+
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "io/FileCache.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "thread/Mutex.hxx"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static constexpr unsigned CLUSTER_SIZE = 1500;
+static constexpr unsigned N_CLUSTERS = 3;
+static constexpr unsigned N_SHAPES = CLUSTER_SIZE * N_CLUSTERS;
+
+static_assert(N_SHAPES > TopographyFile::MAX_RESIDENT_SHAPES);
+static_assert(2 * CLUSTER_SIZE < TopographyFile::MAX_RESIDENT_SHAPES);
+
+/**
+ * The clusters are far apart, so a view of one cluster does not
+ * include any other.
+ */
+static GeoPoint
+GetClusterCenter(unsigned cluster) noexcept
+{
+  return GeoPoint(Angle::Degrees(7 + 2 * cluster), Angle::Degrees(51));
+}
+
+static GeoPoint
+GetShapeLocation(unsigned i) noexcept
+{
+  const unsigned cluster = i / CLUSTER_SIZE, j = i % CLUSTER_SIZE;
+  const GeoPoint center = GetClusterCenter(cluster);
+
+  /* a 40x40 grid with 0.0005 degree spacing (about 50 m) */
+  return GeoPoint(center.longitude + Angle::Degrees((j % 40) * 0.0005),
+                  center.latitude + Angle::Degrees((j / 40) * 0.0005));
+}
+
+class ByteWriter {
+  std::vector<uint8_t> data;
+
+public:
+  void Int32BE(uint32_t value) noexcept {
+    for (int shift = 24; shift >= 0; shift -= 8)
+      data.push_back(value >> shift);
+  }
+
+  void Int32LE(uint32_t value) noexcept {
+    for (int shift = 0; shift < 32; shift += 8)
+      data.push_back(value >> shift);
+  }
+
+  void Int16LE(uint16_t value) noexcept {
+    data.push_back(value);
+    data.push_back(value >> 8);
+  }
+
+  void Byte(uint8_t value) noexcept {
+    data.push_back(value);
+  }
+
+  void DoubleLE(double value) noexcept {
+    uint64_t bits;
+    std::copy_n(reinterpret_cast<const uint8_t *>(&value), sizeof(bits),
+                reinterpret_cast<uint8_t *>(&bits));
+    for (int shift = 0; shift < 64; shift += 8)
+      data.push_back(bits >> shift);
+  }
+
+  void Fill(uint8_t value, std::size_t n) noexcept {
+    data.insert(data.end(), n, value);
+  }
+
+  void String(const char *s, std::size_t width) noexcept {
+    const std::size_t length = std::min(strlen(s), width);
+    data.insert(data.end(), s, s + length);
+    Fill(' ', width - length);
+  }
+
+  bool Save(const std::string &path) const noexcept {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+      return false;
+
+    fwrite(data.data(), 1, data.size(), file);
+    return fclose(file) == 0;
+  }
+};
+
+/**
+ * Write the header of a .shp or .shx file.
+ *
+ * @param length the file length in 16 bit words
+ */
+static void
+WriteShapeHeader(ByteWriter &w, uint32_t length)
+{
+  w.Int32BE(9994);
+  w.Fill(0, 5 * 4);
+  w.Int32BE(length);
+  w.Int32LE(1000);
+  w.Int32LE(SHP_POINT);
+
+  double min_x = 180, min_y = 90, max_x = -180, max_y = -90;
+  for (unsigned i = 0; i < N_SHAPES; ++i) {
+    const GeoPoint p = GetShapeLocation(i);
+    min_x = std::min(min_x, p.longitude.Degrees());
+    min_y = std::min(min_y, p.latitude.Degrees());
+    max_x = std::max(max_x, p.longitude.Degrees());
+    max_y = std::max(max_y, p.latitude.Degrees());
+  }
+
+  w.DoubleLE(min_x);
+  w.DoubleLE(min_y);
+  w.DoubleLE(max_x);
+  w.DoubleLE(max_y);
+
+  /* Z and M ranges */
+  w.Fill(0, 4 * 8);
+}
+
+/**
+ * Write a shapefile (.shp, .shx and .dbf with one label field)
+ * containing one point shape per location.
+ *
+ * @param base the path without the file name extension
+ */
+static bool
+WriteShapeFile(const std::string &base)
+{
+  /* all sizes in 16 bit words */
+  static constexpr uint32_t HEADER_SIZE = 50;
+  static constexpr uint32_t CONTENT_SIZE = (4 + 2 * 8) / 2;
+  static constexpr uint32_t RECORD_SIZE = 4 + CONTENT_SIZE;
+
+  ByteWriter shp, shx;
+  WriteShapeHeader(shp, HEADER_SIZE + N_SHAPES * RECORD_SIZE);
+  WriteShapeHeader(shx, HEADER_SIZE + N_SHAPES * 4);
+
+  for (unsigned i = 0; i < N_SHAPES; ++i) {
+    shx.Int32BE(HEADER_SIZE + i * RECORD_SIZE);
+    shx.Int32BE(CONTENT_SIZE);
+
+    const GeoPoint p = GetShapeLocation(i);
+    shp.Int32BE(i + 1);
+    shp.Int32BE(CONTENT_SIZE);
+    shp.Int32LE(1);
+    shp.DoubleLE(p.longitude.Degrees());
+    shp.DoubleLE(p.latitude.Degrees());
+  }
+
+  static constexpr unsigned LABEL_WIDTH = 8;
+
+  ByteWriter dbf;
+  dbf.Byte(0x03);
+  dbf.Byte(124);
+  dbf.Byte(1);
+  dbf.Byte(1);
+  dbf.Int32LE(N_SHAPES);
+  dbf.Int16LE(32 + 32 + 1);
+  dbf.Int16LE(1 + LABEL_WIDTH);
+  dbf.Fill(0, 20);
+
+  /* the field descriptor */
+  dbf.String("NAME", 4);
+  dbf.Fill(0, 7);
+  dbf.Byte('C');
+  dbf.Fill(0, 4);
+  dbf.Byte(LABEL_WIDTH);
+  dbf.Fill(0, 15);
+  dbf.Byte(0x0d);
+
+  for (unsigned i = 0; i < N_SHAPES; ++i) {
+    char label[16];
+    snprintf(label, sizeof(label), "P%u", i);
+    dbf.Byte(' ');
+    dbf.String(label, LABEL_WIDTH);
+  }
+
+  dbf.Byte(0x1a);
+
+  return shp.Save(base + ".shp") && shx.Save(base + ".shx") &&
+    dbf.Save(base + ".dbf");
+}
+
+static WindowProjection
+MakeProjection(unsigned cluster) noexcept
+{
+  WindowProjection projection;
+  projection.SetScreenSize({640, 480});
+  projection.SetScaleFromRadius(3000);
+  projection.SetGeoLocation(GetClusterCenter(cluster));
+  projection.SetScreenOrigin(320, 240);
+  projection.UpdateScreenBounds();
+  return projection;
+}
+
+static TopographyFile
+OpenTopographyFile(const std::string &shp_path)
+{
+  return TopographyFile(nullptr, shp_path.c_str(), 1e6, 1e6, 1e6,
+                        BGRA8Color(0, 0, 0), 0);
+}
+
+/**
+ * Show the given cluster and return the number of visible shapes.
+ */
+static unsigned
+View(TopographyFile &file, Mutex &zip_mutex, unsigned cluster)
+{
+  file.Update(MakeProjection(cluster), zip_mutex);
+
+  const std::lock_guard lock{file.mutex};
+  unsigned n = 0;
+  for (auto i = file.begin(); i != file.end(); ++i)
+    ++n;
+  return n;
+}
+
+static void
+TestLRU(const std::string &shp_path, FileCache *cache)
+{
+  Mutex zip_mutex;
+  auto file = OpenTopographyFile(shp_path);
+  if (cache != nullptr)
+    file.EnableShapeCache(*cache, Path(shp_path.c_str()),
+                          shp_path.c_str(), 1);
+
+  const auto &statistics = file.GetStatistics();
+
+  ok1(View(file, zip_mutex, 0) == CLUSTER_SIZE);
+  ok1(statistics.misses == CLUSTER_SIZE);
+  ok1(statistics.hits == 0);
+  ok1(statistics.resident == CLUSTER_SIZE);
+  ok1((statistics.bytes_mapped > 0) == (cache != nullptr));
+
+  /* the first cluster stays resident, but invisible */
+  ok1(View(file, zip_mutex, 1) == CLUSTER_SIZE);
+  ok1(statistics.misses == 2 * CLUSTER_SIZE);
+  ok1(statistics.resident == 2 * CLUSTER_SIZE);
+
+  /* coming back reuses the resident shapes */
+  ok1(View(file, zip_mutex, 0) == CLUSTER_SIZE);
+  ok1(statistics.hits == CLUSTER_SIZE);
+  ok1(statistics.misses == 2 * CLUSTER_SIZE);
+  ok1(statistics.evictions == 0);
+
+  /* the third cluster exceeds the limit; the least recently used
+     shapes (from the second cluster) get evicted */
+  constexpr unsigned excess =
+    N_SHAPES - TopographyFile::MAX_RESIDENT_SHAPES;
+  ok1(View(file, zip_mutex, 2) == CLUSTER_SIZE);
+  ok1(statistics.misses == N_SHAPES);
+  ok1(statistics.evictions == excess);
+  ok1(statistics.resident == TopographyFile::MAX_RESIDENT_SHAPES);
+
+  ok1(View(file, zip_mutex, 1) == CLUSTER_SIZE);
+  ok1(statistics.hits == CLUSTER_SIZE + CLUSTER_SIZE - excess);
+  ok1(statistics.misses == N_SHAPES + excess);
+}
+
+static bool
+Equals(const XShape &a, const XShape &b) noexcept
+{
+  if (a.get_type() != b.get_type() ||
+      a.get_bounds().GetSouthWest() != b.get_bounds().GetSouthWest() ||
+      a.get_bounds().GetNorthEast() != b.get_bounds().GetNorthEast() ||
+      !std::equal(a.GetLines().begin(), a.GetLines().end(),
+                  b.GetLines().begin(), b.GetLines().end()))
+    return false;
+
+  std::size_t n_points = 0;
+  for (const auto n : a.GetLines())
+    n_points += n;
+
+  if (!std::equal(a.GetPoints(), a.GetPoints() + n_points, b.GetPoints()))
+    return false;
+
+  return a.GetLabel() != nullptr
+    ? b.GetLabel() != nullptr && StringIsEqual(a.GetLabel(), b.GetLabel())
+    : b.GetLabel() == nullptr;
+}
+
+/**
+ * Load all shapes from the shapefile and from a (new) #ShapeCache
+ * and compare them.
+ */
+static void
+TestShapeCache(const std::string &shp_path, FileCache &cache)
+{
+  auto from_file = OpenTopographyFile(shp_path);
+  from_file.LoadAll();
+
+  /* the cache was created by TestLRU(); it must be used right
+     away */
+  auto from_cache = OpenTopographyFile(shp_path);
+  from_cache.EnableShapeCache(cache, Path(shp_path.c_str()),
+                              shp_path.c_str(), 1);
+  ok1(from_cache.GetStatistics().bytes_mapped > 0);
+  from_cache.LoadAll();
+
+  unsigned n = 0;
+  bool equal = true;
+  auto j = from_cache.begin();
+  for (const auto &i : from_file) {
+    if (j == from_cache.end() || !Equals(i, *j))
+      equal = false;
+    else
+      ++j;
+    ++n;
+  }
+
+  ok1(n == N_SHAPES);
+  ok1(from_cache.begin() != from_cache.end() &&
+      from_cache.begin()->GetLabel() != nullptr &&
+      StringIsEqual(from_cache.begin()->GetLabel(), "P0"));
+  ok1(equal && j == from_cache.end());
+
+  /* a different pixel scale invalidates the cache */
+  auto rescaled = OpenTopographyFile(shp_path);
+  rescaled.EnableShapeCache(cache, Path(shp_path.c_str()),
+                            shp_path.c_str(), 2);
+  ok1(rescaled.GetStatistics().bytes_mapped == 0);
+}
+
+int main()
+try {
+  plan_tests(1 + 2 * 19 + 5);
+
+  char tmp_dir[] = "/tmp/TestTopographyFile.XXXXXX";
+  if (mkdtemp(tmp_dir) == nullptr) {
+    perror("mkdtemp() failed");
+    return EXIT_FAILURE;
+  }
+
+  const std::string base = std::string(tmp_dir) + "/points";
+  ok1(WriteShapeFile(base));
+
+  const std::string shp_path = base + ".shp";
+
+  TestLRU(shp_path, nullptr);
+
+  FileCache cache{AllocatedPath{tmp_dir}};
+  TestLRU(shp_path, &cache);
+  TestShapeCache(shp_path, cache);
+
+  struct DeleteVisitor final : File::Visitor {
+    void Visit(Path p, Path) override {
+      File::Delete(p);
+    }
+  } delete_visitor;
+  Directory::VisitFiles(Path{tmp_dir}, delete_visitor);
+  rmdir(tmp_dir);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
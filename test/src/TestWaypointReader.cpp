@@ -370,6 +370,50 @@ TestCupRoundTrip(const wp_vector &org_wp)
   }
 }
 
+static void
+TestCupChunks(const wp_vector &org_wp)
+{
+  /* a description with a quoted newline must not be mistaken for
+     a record boundary, and the task section must not be parsed */
+  const auto s = WriteCupToString(org_wp, true) +
+    "\"Multi Line\",\"ML\",,4800.000N,01100.000E,500.0m,1,,,,,"
+    "\"first line\nsecond line, with \"\"quotes\"\"\"\n" +
+    WriteCupToString(org_wp, false) +
+    "-----Related Tasks-----\n"
+    "\"Task\",\"Bergneustadt\",\"Aconcagua\"\n";
+  const auto bytes = std::as_bytes(std::span{s.data(), s.size()});
+
+  WaypointFactory factory(WaypointOrigin::USER);
+
+  Waypoints serial;
+  MemoryReader mr(bytes);
+  BufferedReader br(mr);
+  ok1(ParseSeeYou(factory, serial, br));
+
+  /* tiny chunks: one record each */
+  const SeeYouChunks chunks(bytes, 1);
+  ok1(chunks.size() > 2 * org_wp.size());
+
+  Waypoints merged;
+  bool tasks_found = false;
+  for (std::size_t i = 0; i < chunks.size() && !tasks_found; ++i) {
+    std::vector<WaypointPtr> staging;
+    tasks_found = chunks.Parse(i, factory, staging);
+    merged.Append(std::move(staging));
+  }
+
+  ok1(tasks_found);
+  ok1(merged.size() == serial.size());
+
+  bool equal = merged.size() == serial.size();
+  for (auto a = serial.begin(), b = merged.begin();
+       equal && a != serial.end(); ++a, ++b)
+    equal = (*a)->id == (*b)->id && (*a)->name == (*b)->name &&
+      (*a)->comment == (*b)->comment &&
+      (*a)->location == (*b)->location;
+  ok1(equal);
+}
+
 static void
 TestCupx()
 {
@@ -499,7 +543,7 @@ int main()
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(507 + 4);
+  plan_tests(507 + 4 + 5);
 
   TestWinPilot(org_wp);
   TestSeeYou(org_wp);
@@ -512,6 +556,7 @@ int main()
   TestCompeGPS_UTM(org_wp);
   TestCupWriter(org_wp);
   TestCupRoundTrip(org_wp);
+  TestCupChunks(org_wp);
 
   return exit_status();
 }
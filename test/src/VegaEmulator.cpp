@@ -60,10 +60,11 @@ VegaEmulator::PDVSC(NMEAInputLine &line) noexcept
 }
 
 bool
-VegaEmulator::DataReceived(std::span<const std::byte> s) noexcept
+VegaEmulator::DataReceived(std::span<const std::byte> s,
+                           bool writable) noexcept
 {
   fwrite(s.data(), 1, s.size(), stdout);
-  return PortLineSplitter::DataReceived(s);
+  return PortLineSplitter::DataReceived(s, writable);
 }
 
 bool
@@ -25,6 +25,7 @@ private:
   void PDVSC(NMEAInputLine &line) noexcept;
 
 protected:
-  bool DataReceived(std::span<const std::byte> s) noexcept override;
+  bool DataReceived(std::span<const std::byte> s,
+                    bool writable) noexcept override;
   bool LineReceived(const char *_line) noexcept override;
 };